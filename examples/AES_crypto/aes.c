@@ -0,0 +1,591 @@
+/**
+  \file aes.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of AES-128 driver with hardware offload
+
+  implementation of block modes on top of a common multi-block ECB core,
+  which uses either the AES peripheral (with or w/o DMA) or the software
+  block cipher. AES peripheral sequence per run:
+    - select mode and enable AES
+    - write 16B key to AES_DINR
+    - per block: write 16B to AES_DINR, wait for CCF, read 16B from AES_DOUTR.
+      With DMA this is done by DMA1 channels 0 and 3 on request of the AES
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "aes.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// AES_CR modes (bits 1-2) and bits
+#define CR_MODE_ENC         0x00      ///< mode 1: encryption
+#define CR_MODE_KEY         0x02      ///< mode 2: key derivation
+#define CR_MODE_DEC         0x04      ///< mode 3: decryption with derived key
+#define CR_EN               0x01      ///< enable AES
+#define CR_CCFC             0x08      ///< clear CCF
+#define CR_ERRC             0x10      ///< clear RDERR and WRERR
+#define CR_DMAEN            0x80      ///< enable DMA requests
+
+// DMA1 channel configuration
+#define DMA_CR_EN           0x01      ///< channel enable
+#define DMA_CR_TCIE         0x02      ///< transfer complete interrupt
+#define DMA_CR_DIR          0x08      ///< memory to peripheral
+#define DMA_CR_MINC         0x20      ///< memory increment
+#define DMA_SPR_PL          0x30      ///< very high priority, 8-bit transfers
+
+/// max. blocks per DMA transfer (8-bit DMA counter)
+#define DMA_MAX_BLOCKS      15
+
+/// counter blocks processed per CTR chunk
+#define CTR_BLOCKS          4
+
+// save interrupt state (CC.I1/I0) and disable interrupts, restore saved state afterwards
+#if defined(__CSMC__)
+  #define SAVE_DISABLE_INTERRUPTS()   _asm("push cc\n pop _m_cc\n sim")
+  #define RESTORE_INTERRUPTS()        _asm("push _m_cc\n pop cc")
+#elif defined(__ICCSTM8__)
+  #define SAVE_DISABLE_INTERRUPTS()   { m_cc = __get_interrupt_state(); __disable_interrupt(); }
+  #define RESTORE_INTERRUPTS()        __set_interrupt_state(m_cc)
+#elif defined(__SDCC)
+  #define SAVE_DISABLE_INTERRUPTS()   __asm__("push cc\n pop _m_cc\n sim")
+  #define RESTORE_INTERRUPTS()        __asm__("push _m_cc\n pop cc")
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+#if (AES_DMA)
+  /// DMA transfer complete, set in ISR
+  static volatile uint8_t   m_dmaDone;
+
+  /// saved CC register of caller, see SAVE_DISABLE_INTERRUPTS()
+  static volatile uint8_t   m_cc;
+#endif
+
+
+
+#if (AES_HW)
+
+/**
+  \fn static void hwStart(uint8_t mode, const uint8_t *key)
+
+  \brief enable AES in mode and write key
+
+  \param[in]  mode    CR_MODE_xxx
+  \param[in]  key     key or derived key (16B)
+*/
+static void hwStart(uint8_t mode, const uint8_t *key) {
+
+  uint8_t   i;
+
+  sfr_AES.CR.byte = 0x00;
+  sfr_AES.CR.byte = mode | CR_ERRC | CR_CCFC;
+  sfr_AES.CR.byte = mode | CR_EN;
+  for (i=0; i<16; i++)
+    sfr_AES.DINR.byte = key[i];
+
+} // hwStart
+
+
+
+/**
+  \fn static void hwBlocks(const uint8_t *in, uint8_t *out, uint8_t blocks)
+
+  \brief process blocks by CPU
+
+  \param[in]  in      input data
+  \param[out] out     output data, may be identical to in
+  \param[in]  blocks  number of 16B blocks
+*/
+static void hwBlocks(const uint8_t *in, uint8_t *out, uint8_t blocks) {
+
+  uint8_t   i;
+
+  while (blocks--) {
+    for (i=0; i<16; i++)
+      sfr_AES.DINR.byte = *in++;
+    while (!(sfr_AES.SR.CCF));
+    for (i=0; i<16; i++)
+      *out++ = sfr_AES.DOUTR.byte;
+    sfr_AES.CR.byte |= CR_CCFC;
+  }
+
+} // hwBlocks
+
+#endif // AES_HW
+
+
+
+#if (AES_DMA)
+
+/**
+  \fn static void dmaBlocks(const uint8_t *in, uint8_t *out, uint8_t blocks)
+
+  \brief process blocks via DMA
+
+  \param[in]  in      input data
+  \param[out] out     output data, may be identical to in
+  \param[in]  blocks  number of 16B blocks, max. DMA_MAX_BLOCKS
+
+  DMA1 channel 0 feeds AES_DINR, channel 3 reads AES_DOUTR. The AES requests
+  input only after the previous output was read, i.e. in-place is safe. The
+  CPU waits in WAIT mode until channel 3 has completed. Interrupts are
+  enabled during the wait, afterwards the interrupt state of the caller is
+  restored.
+*/
+static void dmaBlocks(const uint8_t *in, uint8_t *out, uint8_t blocks) {
+
+  uint8_t   num = blocks << 4;
+
+  // channel 0: memory -> AES_DINR
+  sfr_DMA1.C0CR.byte    = 0x00;
+  sfr_DMA1.C0SPR.byte   = DMA_SPR_PL;
+  sfr_DMA1.C0NDTR.byte  = num;
+  sfr_DMA1.C0PARH.byte  = (uint8_t) (((uint16_t) &(sfr_AES.DINR)) >> 8);
+  sfr_DMA1.C0PARL.byte  = (uint8_t) ((uint16_t) &(sfr_AES.DINR));
+  sfr_DMA1.C0M0ARH.byte = (uint8_t) (((uint16_t) in) >> 8);
+  sfr_DMA1.C0M0ARL.byte = (uint8_t) ((uint16_t) in);
+  sfr_DMA1.C0CR.byte    = DMA_CR_DIR | DMA_CR_MINC | DMA_CR_EN;
+
+  // channel 3: AES_DOUTR -> memory, interrupt on completion
+  sfr_DMA1.C3CR.byte    = 0x00;
+  sfr_DMA1.C3SPR.byte   = DMA_SPR_PL;
+  sfr_DMA1.C3NDTR.byte  = num;
+  sfr_DMA1.C3PARH_C3M1ARH.byte = (uint8_t) (((uint16_t) &(sfr_AES.DOUTR)) >> 8);
+  sfr_DMA1.C3PARL_C3M1ARL.byte = (uint8_t) ((uint16_t) &(sfr_AES.DOUTR));
+  sfr_DMA1.C3M0EAR.byte = 0x00;
+  sfr_DMA1.C3M0ARH.byte = (uint8_t) (((uint16_t) out) >> 8);
+  sfr_DMA1.C3M0ARL.byte = (uint8_t) ((uint16_t) out);
+  m_dmaDone = 0;
+  sfr_DMA1.C3CR.byte    = DMA_CR_TCIE | DMA_CR_MINC | DMA_CR_EN;
+
+  // start AES DMA requests
+  sfr_AES.CR.byte |= CR_DMAEN;
+
+  // wait in WAIT mode. WFI re-enables interrupts atomically, i.e. no lost wake-up.
+  // Afterwards restore interrupt state of caller
+  SAVE_DISABLE_INTERRUPTS();
+  while (!m_dmaDone) {
+    WAIT_FOR_INTERRUPT();
+    DISABLE_INTERRUPTS();
+  }
+  RESTORE_INTERRUPTS();
+
+  // stop DMA
+  sfr_AES.CR.byte &= (uint8_t) ~CR_DMAEN;
+  sfr_DMA1.C0CR.byte   = 0x00;
+  sfr_DMA1.C0SPR.byte  = 0x00;
+
+} // dmaBlocks
+
+#endif // AES_DMA
+
+
+
+/**
+  \fn static void ecb(const aes_ctx_t *ctx, uint8_t decrypt, const uint8_t *in, uint8_t *out, uint16_t blocks)
+
+  \brief multi-block ECB core
+
+  \param[in]  ctx       key context
+  \param[in]  decrypt   0=encrypt, 1=decrypt
+  \param[in]  in        input data
+  \param[out] out       output data, may be identical to in
+  \param[in]  blocks    number of 16B blocks
+*/
+static void ecb(const aes_ctx_t *ctx, uint8_t decrypt, const uint8_t *in, uint8_t *out, uint16_t blocks) {
+
+#if (AES_HW)
+
+  uint8_t   num;
+
+  while (blocks) {
+    num = (blocks > DMA_MAX_BLOCKS) ? DMA_MAX_BLOCKS : (uint8_t) blocks;
+
+    // key is written once per chunk
+    if (decrypt)
+      hwStart(CR_MODE_DEC, ctx->decKey);
+    else
+      hwStart(CR_MODE_ENC, ctx->encKey);
+
+    // single blocks by CPU (DMA setup is slower), else DMA
+    #if (AES_DMA)
+      if (num > 1)
+        dmaBlocks(in, out, num);
+      else
+    #endif
+        hwBlocks(in, out, num);
+
+    sfr_AES.CR.byte = 0x00;
+    in     += (uint16_t) num << 4;
+    out    += (uint16_t) num << 4;
+    blocks -= num;
+  }
+
+#else // AES_HW
+
+  uint8_t   i;
+
+  while (blocks--) {
+    for (i=0; i<16; i++)
+      out[i] = in[i];
+    if (decrypt)
+      AES_SOFT_decrypt(ctx->roundKey, out);
+    else
+      AES_SOFT_encrypt(ctx->roundKey, out);
+    in  += 16;
+    out += 16;
+  }
+
+#endif // AES_HW
+
+} // ecb
+
+
+
+/**
+  \fn void AES_begin(void)
+
+  \brief enable AES and DMA clocks
+
+  for hardware AES enable clocks of AES and DMA1. For software AES no action.
+*/
+void AES_begin(void) {
+
+  #if (AES_HW)
+    sfr_CLK.PCKENR3.byte |= 0x01;     // AES
+  #endif
+
+  #if (AES_DMA)
+    sfr_CLK.PCKENR2.byte |= 0x10;     // DMA1
+    sfr_DMA1.GCSR.GEN = 1;
+  #endif
+
+} // AES_begin
+
+
+
+/**
+  \fn void AES_setKey(aes_ctx_t *ctx, const uint8_t *key)
+
+  \brief set 128-bit key
+
+  \param[out] ctx     key context
+  \param[in]  key     key (16B)
+
+  hardware: store key and derive decryption key (AES mode 2).
+  Software: expand key to round keys.
+*/
+void AES_setKey(aes_ctx_t *ctx, const uint8_t *key) {
+
+#if (AES_HW)
+
+  uint8_t   i;
+
+  for (i=0; i<16; i++)
+    ctx->encKey[i] = key[i];
+
+  // derive decryption key
+  hwStart(CR_MODE_KEY, key);
+  while (!(sfr_AES.SR.CCF));
+  for (i=0; i<16; i++)
+    ctx->decKey[i] = sfr_AES.DOUTR.byte;
+  sfr_AES.CR.byte = 0x00;
+
+#else // AES_HW
+
+  AES_SOFT_expandKey(ctx->roundKey, key);
+
+#endif // AES_HW
+
+} // AES_setKey
+
+
+
+/**
+  \fn uint8_t AES_ecbEncrypt(const aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, uint16_t len)
+
+  \brief ECB encryption
+
+  \param[in]  ctx     key context
+  \param[in]  in      plaintext
+  \param[out] out     ciphertext, may be identical to in
+  \param[in]  len     length [B], multiple of 16
+
+  \return 1 on success, 0 on invalid length
+*/
+uint8_t AES_ecbEncrypt(const aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, uint16_t len) {
+
+  if (len & 0x0F)
+    return(0);
+
+  ecb(ctx, 0, in, out, len >> 4);
+
+  return(1);
+
+} // AES_ecbEncrypt
+
+
+
+/**
+  \fn uint8_t AES_ecbDecrypt(const aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, uint16_t len)
+
+  \brief ECB decryption
+
+  \param[in]  ctx     key context
+  \param[in]  in      ciphertext
+  \param[out] out     plaintext, may be identical to in
+  \param[in]  len     length [B], multiple of 16
+
+  \return 1 on success, 0 on invalid length
+*/
+uint8_t AES_ecbDecrypt(const aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, uint16_t len) {
+
+  if (len & 0x0F)
+    return(0);
+
+  ecb(ctx, 1, in, out, len >> 4);
+
+  return(1);
+
+} // AES_ecbDecrypt
+
+
+
+/**
+  \fn uint8_t AES_cbcEncrypt(const aes_ctx_t *ctx, uint8_t *iv, const uint8_t *in, uint8_t *out, uint16_t len)
+
+  \brief CBC encryption
+
+  \param[in]      ctx     key context
+  \param[in,out]  iv      initialization vector, updated for next call (16B)
+  \param[in]      in      plaintext
+  \param[out]     out     ciphertext, may be identical to in
+  \param[in]      len     length [B], multiple of 16
+
+  \return 1 on success, 0 on invalid length
+
+  CBC encryption is sequential, i.e. blocks are processed one by one.
+*/
+uint8_t AES_cbcEncrypt(const aes_ctx_t *ctx, uint8_t *iv, const uint8_t *in, uint8_t *out, uint16_t len) {
+
+  uint8_t   i;
+
+  if (len & 0x0F)
+    return(0);
+
+  for (; len; len-=16) {
+    for (i=0; i<16; i++)
+      iv[i] ^= in[i];
+    ecb(ctx, 0, iv, iv, 1);
+    for (i=0; i<16; i++)
+      out[i] = iv[i];
+    in  += 16;
+    out += 16;
+  }
+
+  return(1);
+
+} // AES_cbcEncrypt
+
+
+
+/**
+  \fn uint8_t AES_cbcDecrypt(const aes_ctx_t *ctx, uint8_t *iv, const uint8_t *in, uint8_t *out, uint16_t len)
+
+  \brief CBC decryption
+
+  \param[in]      ctx     key context
+  \param[in,out]  iv      initialization vector, updated for next call (16B)
+  \param[in]      in      ciphertext
+  \param[out]     out     plaintext, must not overlap with in
+  \param[in]      len     length [B], multiple of 16
+
+  \return 1 on success, 0 on invalid length
+
+  all blocks are decrypted in one ECB run (DMA), then XORed with the
+  previous ciphertext block.
+*/
+uint8_t AES_cbcDecrypt(const aes_ctx_t *ctx, uint8_t *iv, const uint8_t *in, uint8_t *out, uint16_t len) {
+
+  uint16_t  i;
+
+  if ((len & 0x0F) || (in == out))
+    return(0);
+  if (len == 0)
+    return(1);
+
+  // decrypt all blocks
+  ecb(ctx, 1, in, out, len >> 4);
+
+  // XOR first block with IV, others with previous ciphertext
+  for (i=0; i<16; i++)
+    out[i] ^= iv[i];
+  for (i=16; i<len; i++)
+    out[i] ^= in[i-16];
+
+  // last ciphertext block is next IV
+  for (i=0; i<16; i++)
+    iv[i] = in[len-16+i];
+
+  return(1);
+
+} // AES_cbcDecrypt
+
+
+
+/**
+  \fn void AES_ctrCrypt(const aes_ctx_t *ctx, uint8_t *ctr, const uint8_t *in, uint8_t *out, uint16_t len)
+
+  \brief CTR encryption and decryption
+
+  \param[in]      ctx     key context
+  \param[in,out]  ctr     counter block, updated for next call (16B)
+  \param[in]      in      input data
+  \param[out]     out     output data, may be identical to in
+  \param[in]      len     length [B]
+
+  key stream is generated for CTR_BLOCKS counter blocks per ECB run and
+  XORed with the data.
+*/
+void AES_ctrCrypt(const aes_ctx_t *ctx, uint8_t *ctr, const uint8_t *in, uint8_t *out, uint16_t len) {
+
+  uint8_t   stream[CTR_BLOCKS*AES_BLOCK];
+  uint8_t   blocks, num, i, j;
+
+  while (len) {
+
+    // prepare counter blocks
+    blocks = (uint8_t) ((len > CTR_BLOCKS*AES_BLOCK) ? CTR_BLOCKS : ((len + 15) >> 4));
+    for (i=0; i<blocks; i++) {
+      for (j=0; j<16; j++)
+        stream[(i<<4)+j] = ctr[j];
+      for (j=15; (++ctr[j] == 0) && (j != 0); j--);
+    }
+
+    // key stream
+    ecb(ctx, 0, stream, stream, blocks);
+
+    // XOR data
+    num = (len > (uint16_t) blocks << 4) ? (blocks << 4) : (uint8_t) len;
+    for (i=0; i<num; i++)
+      out[i] = in[i] ^ stream[i];
+    in  += num;
+    out += num;
+    len -= num;
+  }
+
+} // AES_ctrCrypt
+
+
+
+/**
+  \fn static void cmacDouble(uint8_t *block)
+
+  \brief multiply by x in GF(2^128) for CMAC subkeys
+
+  \param[in,out] block  16B block
+*/
+static void cmacDouble(uint8_t *block) {
+
+  uint8_t   i, msb = block[0] & 0x80;
+
+  for (i=0; i<15; i++)
+    block[i] = (block[i] << 1) | (block[i+1] >> 7);
+  block[15] <<= 1;
+  if (msb)
+    block[15] ^= 0x87;
+
+} // cmacDouble
+
+
+
+/**
+  \fn void AES_cmac(const aes_ctx_t *ctx, const uint8_t *msg, uint16_t len, uint8_t *mac)
+
+  \brief AES-CMAC (RFC 4493)
+
+  \param[in]  ctx     key context
+  \param[in]  msg     message
+  \param[in]  len     message length [B]
+  \param[out] mac     message authentication code (16B). May be truncated by caller
+*/
+void AES_cmac(const aes_ctx_t *ctx, const uint8_t *msg, uint16_t len, uint8_t *mac) {
+
+  uint8_t   sub[16];
+  uint8_t   i, last;
+
+  // subkey K1 = 2*E(0)
+  for (i=0; i<16; i++) {
+    sub[i] = 0x00;
+    mac[i] = 0x00;
+  }
+  ecb(ctx, 0, sub, sub, 1);
+  cmacDouble(sub);
+
+  // all but last block
+  while (len > 16) {
+    for (i=0; i<16; i++)
+      mac[i] ^= msg[i];
+    ecb(ctx, 0, mac, mac, 1);
+    msg += 16;
+    len -= 16;
+  }
+
+  // last block: complete -> XOR K1, else pad and XOR K2 = 2*K1
+  last = (uint8_t) len;
+  if (last < 16)
+    cmacDouble(sub);
+  for (i=0; i<16; i++) {
+    if (i < last)
+      mac[i] ^= msg[i];
+    else if (i == last)
+      mac[i] ^= 0x80;
+    mac[i] ^= sub[i];
+  }
+  ecb(ctx, 0, mac, mac, 1);
+
+} // AES_cmac
+
+
+
+#if (AES_DMA)
+
+/**
+  \fn void AES_DMA_ISR(void)
+
+  \brief ISR for DMA1 channel 3 transfer complete
+
+  AES output was transferred completely, end WAIT in dmaBlocks().
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(AES_DMA_ISR, _DMA1_CH3_TC_VECTOR_) {
+
+  // stop channel and clear flag
+  sfr_DMA1.C3CR.byte  = 0x00;
+  sfr_DMA1.C3SPR.byte = 0x00;
+
+  m_dmaDone = 1;
+
+} // AES_DMA_ISR
+
+#endif // AES_DMA
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
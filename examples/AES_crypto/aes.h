@@ -0,0 +1,120 @@
+/**
+  \file aes.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of AES-128 driver with hardware offload
+
+  declaration of AES-128 functions for ECB, CBC and CTR streams and CMAC
+  authentication. Features:
+    - on devices with AES peripheral (STM8L162, STM8AL31E8x, STM8AL3LE8x)
+      the hardware block is used. Streams of several blocks are transferred
+      via DMA1 (channel 0: memory to AES_DINR, channel 3: AES_DOUTR to memory),
+      while the CPU waits in WAIT mode
+    - on other devices, or if AES_SOFTWARE is defined in config.h, a
+      software implementation is used with identical API and results
+    - decryption key for hardware is derived once in AES_setKey()
+
+  \note
+  - hardware path: the DMA transfer complete interrupt ends the WAIT, i.e.
+    interrupts are enabled during DMA transfers. Afterwards the interrupt
+    state of the caller is restored
+  - ECB and CTR may be in place (in == out). CBC decryption requires
+    separate buffers
+  - CTR: counter block is incremented (big endian) per 16B block. For
+    continuing a stream, pass lengths of multiples of 16B
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _AES_H_
+#define _AES_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "aes_soft.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+/// AES block size [B]
+#define AES_BLOCK               16
+
+// use hardware if available and not disabled in config.h
+#if defined(sfr_AES) && !defined(AES_SOFTWARE)
+  #define AES_HW                1
+#else
+  #define AES_HW                0
+#endif
+
+// use DMA for multi-block transfers (hardware only). Default can be overwritten in config.h
+#if !(AES_HW)
+  #undef  AES_DMA
+  #define AES_DMA               0
+#elif !defined(AES_DMA)
+  #define AES_DMA               1
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// key context, see AES_setKey()
+typedef struct {
+  #if (AES_HW)
+    uint8_t   encKey[16];                   ///< key for encryption
+    uint8_t   decKey[16];                   ///< derived key for decryption
+  #else
+    uint8_t   roundKey[AES_SOFT_KEYEXP];    ///< expanded key
+  #endif
+} aes_ctx_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// enable AES and DMA clocks
+void AES_begin(void);
+
+/// set 128-bit key
+void AES_setKey(aes_ctx_t *ctx, const uint8_t *key);
+
+/// ECB encryption. Length must be multiple of 16. Returns 0 on error
+uint8_t AES_ecbEncrypt(const aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, uint16_t len);
+
+/// ECB decryption. Length must be multiple of 16. Returns 0 on error
+uint8_t AES_ecbDecrypt(const aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, uint16_t len);
+
+/// CBC encryption. IV is updated for next call. Length must be multiple of 16. Returns 0 on error
+uint8_t AES_cbcEncrypt(const aes_ctx_t *ctx, uint8_t *iv, const uint8_t *in, uint8_t *out, uint16_t len);
+
+/// CBC decryption (in != out). IV is updated for next call. Length must be multiple of 16. Returns 0 on error
+uint8_t AES_cbcDecrypt(const aes_ctx_t *ctx, uint8_t *iv, const uint8_t *in, uint8_t *out, uint16_t len);
+
+/// CTR encryption/decryption of any length. Counter block is updated for next call
+void AES_ctrCrypt(const aes_ctx_t *ctx, uint8_t *ctr, const uint8_t *in, uint8_t *out, uint16_t len);
+
+/// AES-CMAC (RFC 4493) over message, 16B result
+void AES_cmac(const aes_ctx_t *ctx, const uint8_t *msg, uint16_t len, uint8_t *mac);
+
+/// ISR for DMA1 channel 3 transfer complete (AES output)
+#if (AES_DMA)
+  ISR_HANDLER(AES_DMA_ISR, _DMA1_CH3_TC_VECTOR_);
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _AES_H_
@@ -0,0 +1,252 @@
+/**
+  \file aes_soft.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of software AES-128 block cipher
+
+  implementation of AES-128 (FIPS-197) encryption and decryption of single
+  blocks. The state is stored column-wise, i.e. byte i is in row i%4 and
+  column i/4.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "aes_soft.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+/// multiply by x in GF(2^8)
+#define XTIME(x)        ((uint8_t) (((x) << 1) ^ (((x) & 0x80) ? 0x1B : 0x00)))
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// S-box
+static const uint8_t m_sbox[256] = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+/// inverse S-box
+static const uint8_t m_rsbox[256] = {
+  0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+  0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+  0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+  0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+  0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+  0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+  0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+  0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+  0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+  0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+  0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+  0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+  0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+  0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+  0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+  0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
+};
+
+
+
+/**
+  \fn void AES_SOFT_expandKey(uint8_t *roundKey, const uint8_t *key)
+
+  \brief expand key
+
+  \param[out] roundKey  expanded key (176B)
+  \param[in]  key       128-bit key (16B)
+*/
+void AES_SOFT_expandKey(uint8_t *roundKey, const uint8_t *key) {
+
+  uint8_t   i, rcon = 0x01;
+  uint8_t   t0, t1, t2, t3, tmp;
+
+  // first round key is the key itself
+  for (i=0; i<16; i++)
+    roundKey[i] = key[i];
+
+  // next word from previous word and word 4 positions back
+  for (i=16; i<AES_SOFT_KEYEXP; i+=4) {
+    t0 = roundKey[i-4];
+    t1 = roundKey[i-3];
+    t2 = roundKey[i-2];
+    t3 = roundKey[i-1];
+
+    // first word of round key: rotate, substitute, add round constant
+    if ((i & 0x0F) == 0) {
+      tmp  = t0;
+      t0   = m_sbox[t1] ^ rcon;
+      t1   = m_sbox[t2];
+      t2   = m_sbox[t3];
+      t3   = m_sbox[tmp];
+      rcon = XTIME(rcon);
+    }
+
+    roundKey[i]   = roundKey[i-16] ^ t0;
+    roundKey[i+1] = roundKey[i-15] ^ t1;
+    roundKey[i+2] = roundKey[i-14] ^ t2;
+    roundKey[i+3] = roundKey[i-13] ^ t3;
+  }
+
+} // AES_SOFT_expandKey
+
+
+
+/**
+  \fn static void addRoundKey(uint8_t *block, const uint8_t *roundKey)
+
+  \brief XOR round key to state
+
+  \param[in,out] block     state
+  \param[in]     roundKey  round key (16B)
+*/
+static void addRoundKey(uint8_t *block, const uint8_t *roundKey) {
+
+  uint8_t   i;
+
+  for (i=0; i<16; i++)
+    block[i] ^= roundKey[i];
+
+} // addRoundKey
+
+
+
+/**
+  \fn static void mixColumns(uint8_t *block)
+
+  \brief MixColumns transformation
+
+  \param[in,out] block     state
+*/
+static void mixColumns(uint8_t *block) {
+
+  uint8_t   i, a0, a1, a2, a3, all;
+
+  for (i=0; i<16; i+=4) {
+    a0  = block[i];
+    a1  = block[i+1];
+    a2  = block[i+2];
+    a3  = block[i+3];
+    all = a0 ^ a1 ^ a2 ^ a3;
+    block[i]   ^= all ^ XTIME(a0 ^ a1);
+    block[i+1] ^= all ^ XTIME(a1 ^ a2);
+    block[i+2] ^= all ^ XTIME(a2 ^ a3);
+    block[i+3] ^= all ^ XTIME(a3 ^ a0);
+  }
+
+} // mixColumns
+
+
+
+/**
+  \fn void AES_SOFT_encrypt(const uint8_t *roundKey, uint8_t *block)
+
+  \brief encrypt one block in place
+
+  \param[in]     roundKey  expanded key, see AES_SOFT_expandKey()
+  \param[in,out] block     plaintext in, ciphertext out (16B)
+*/
+void AES_SOFT_encrypt(const uint8_t *roundKey, uint8_t *block) {
+
+  uint8_t   round, i, t;
+
+  addRoundKey(block, roundKey);
+
+  for (round=1; round<=10; round++) {
+
+    // SubBytes
+    for (i=0; i<16; i++)
+      block[i] = m_sbox[block[i]];
+
+    // ShiftRows: rotate row 1 by 1, row 2 by 2, row 3 by 3 columns to the left
+    t = block[1];  block[1]  = block[5];  block[5]  = block[9];  block[9]  = block[13]; block[13] = t;
+    t = block[2];  block[2]  = block[10]; block[10] = t;
+    t = block[6];  block[6]  = block[14]; block[14] = t;
+    t = block[15]; block[15] = block[11]; block[11] = block[7];  block[7]  = block[3];  block[3]  = t;
+
+    // MixColumns, not in last round
+    if (round != 10)
+      mixColumns(block);
+
+    addRoundKey(block, roundKey + (round << 4));
+
+  } // loop over rounds
+
+} // AES_SOFT_encrypt
+
+
+
+/**
+  \fn void AES_SOFT_decrypt(const uint8_t *roundKey, uint8_t *block)
+
+  \brief decrypt one block in place
+
+  \param[in]     roundKey  expanded key, see AES_SOFT_expandKey()
+  \param[in,out] block     ciphertext in, plaintext out (16B)
+*/
+void AES_SOFT_decrypt(const uint8_t *roundKey, uint8_t *block) {
+
+  uint8_t   round, i, t, u, v;
+
+  addRoundKey(block, roundKey + 160);
+
+  for (round=9; ; round--) {
+
+    // InvShiftRows: rotate row 1 by 1, row 2 by 2, row 3 by 3 columns to the right
+    t = block[13]; block[13] = block[9];  block[9]  = block[5];  block[5]  = block[1];  block[1]  = t;
+    t = block[2];  block[2]  = block[10]; block[10] = t;
+    t = block[6];  block[6]  = block[14]; block[14] = t;
+    t = block[3];  block[3]  = block[7];  block[7]  = block[11]; block[11] = block[15]; block[15] = t;
+
+    // InvSubBytes
+    for (i=0; i<16; i++)
+      block[i] = m_rsbox[block[i]];
+
+    addRoundKey(block, roundKey + (round << 4));
+    if (round == 0)
+      break;
+
+    // InvMixColumns = pre-processing with {04}(a0^a2), {04}(a1^a3), followed by MixColumns
+    for (i=0; i<16; i+=4) {
+      u = XTIME(XTIME(block[i]   ^ block[i+2]));
+      v = XTIME(XTIME(block[i+1] ^ block[i+3]));
+      block[i]   ^= u;
+      block[i+1] ^= v;
+      block[i+2] ^= u;
+      block[i+3] ^= v;
+    }
+    mixColumns(block);
+
+  } // loop over rounds
+
+} // AES_SOFT_decrypt
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
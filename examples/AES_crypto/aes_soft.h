@@ -0,0 +1,56 @@
+/**
+  \file aes_soft.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of software AES-128 block cipher
+
+  declaration of a table based AES-128 (FIPS-197) block cipher for devices
+  without AES peripheral. Used as fallback by aes.c.
+
+  \note
+  - expanded key requires 176B RAM per key
+  - S-boxes (2x 256B) are located in flash
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _AES_SOFT_H_
+#define _AES_SOFT_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+/// size of expanded key [B]
+#define AES_SOFT_KEYEXP       176
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// expand 128-bit key to 11 round keys
+void AES_SOFT_expandKey(uint8_t *roundKey, const uint8_t *key);
+
+/// encrypt one 16B block in place
+void AES_SOFT_encrypt(const uint8_t *roundKey, uint8_t *block);
+
+/// decrypt one 16B block in place
+void AES_SOFT_decrypt(const uint8_t *roundKey, uint8_t *block);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _AES_SOFT_H_
@@ -0,0 +1,46 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define STM8L162_BOARD
+//#define STM8L_DISCOVERY
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8L162_BOARD)
+  #include "../../include/STM8L162R8.h"     // with AES -> hardware + DMA
+#elif defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"     // no AES -> software fallback
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    AES CONFIGURATION
+----------------------------------------------------------*/
+
+// force software AES, e.g. for benchmark. Default: hardware if available
+//#define AES_SOFTWARE
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
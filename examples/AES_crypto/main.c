@@ -0,0 +1,264 @@
+/**********************
+  AES-128 with hardware offload (AES + DMA) and authenticated message format
+
+  supported hardware:
+    - STM8L162R8 board with USART1 on PC2/PC3 -> hardware AES with DMA
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html) -> software AES
+
+  Functionality:
+    - check ECB, CBC, CTR and CMAC against test vectors of NIST SP 800-38A and RFC 4493
+    - check ECB and CTR in place over 20 blocks, i.e. split into several DMA transfers
+    - measure CTR throughput for 320B chunks
+    - seal telemetry and firmware update messages (AES-CTR + AES-CMAC) and
+      open them again. Check that modified and replayed frames are rejected
+    - print results via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "aes.h"
+  #include "secure_msg.h"
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    GLOBAL VARIABLES
+----------------------------------------------------------*/
+
+// test vectors: NIST SP 800-38A (F.1.1, F.2.1, F.5.1, 4 blocks) and RFC 4493 (examples 1-4)
+const uint8_t key[16]   = { 0x2b,0x7e,0x15,0x16, 0x28,0xae,0xd2,0xa6, 0xab,0xf7,0x15,0x88, 0x09,0xcf,0x4f,0x3c };
+const uint8_t ivCbc[16] = { 0x00,0x01,0x02,0x03, 0x04,0x05,0x06,0x07, 0x08,0x09,0x0a,0x0b, 0x0c,0x0d,0x0e,0x0f };
+const uint8_t ivCtr[16] = { 0xf0,0xf1,0xf2,0xf3, 0xf4,0xf5,0xf6,0xf7, 0xf8,0xf9,0xfa,0xfb, 0xfc,0xfd,0xfe,0xff };
+const uint8_t plain[64] = {
+  0x6b,0xc1,0xbe,0xe2, 0x2e,0x40,0x9f,0x96, 0xe9,0x3d,0x7e,0x11, 0x73,0x93,0x17,0x2a,
+  0xae,0x2d,0x8a,0x57, 0x1e,0x03,0xac,0x9c, 0x9e,0xb7,0x6f,0xac, 0x45,0xaf,0x8e,0x51,
+  0x30,0xc8,0x1c,0x46, 0xa3,0x5c,0xe4,0x11, 0xe5,0xfb,0xc1,0x19, 0x1a,0x0a,0x52,0xef,
+  0xf6,0x9f,0x24,0x45, 0xdf,0x4f,0x9b,0x17, 0xad,0x2b,0x41,0x7b, 0xe6,0x6c,0x37,0x10
+};
+const uint8_t ecbRef[64] = {
+  0x3a,0xd7,0x7b,0xb4, 0x0d,0x7a,0x36,0x60, 0xa8,0x9e,0xca,0xf3, 0x24,0x66,0xef,0x97,
+  0xf5,0xd3,0xd5,0x85, 0x03,0xb9,0x69,0x9d, 0xe7,0x85,0x89,0x5a, 0x96,0xfd,0xba,0xaf,
+  0x43,0xb1,0xcd,0x7f, 0x59,0x8e,0xce,0x23, 0x88,0x1b,0x00,0xe3, 0xed,0x03,0x06,0x88,
+  0x7b,0x0c,0x78,0x5e, 0x27,0xe8,0xad,0x3f, 0x82,0x23,0x20,0x71, 0x04,0x72,0x5d,0xd4
+};
+const uint8_t cbcRef[64] = {
+  0x76,0x49,0xab,0xac, 0x81,0x19,0xb2,0x46, 0xce,0xe9,0x8e,0x9b, 0x12,0xe9,0x19,0x7d,
+  0x50,0x86,0xcb,0x9b, 0x50,0x72,0x19,0xee, 0x95,0xdb,0x11,0x3a, 0x91,0x76,0x78,0xb2,
+  0x73,0xbe,0xd6,0xb8, 0xe3,0xc1,0x74,0x3b, 0x71,0x16,0xe6,0x9e, 0x22,0x22,0x95,0x16,
+  0x3f,0xf1,0xca,0xa1, 0x68,0x1f,0xac,0x09, 0x12,0x0e,0xca,0x30, 0x75,0x86,0xe1,0xa7
+};
+const uint8_t ctrRef[64] = {
+  0x87,0x4d,0x61,0x91, 0xb6,0x20,0xe3,0x26, 0x1b,0xef,0x68,0x64, 0x99,0x0d,0xb6,0xce,
+  0x98,0x06,0xf6,0x6b, 0x79,0x70,0xfd,0xff, 0x86,0x17,0x18,0x7b, 0xb9,0xff,0xfd,0xff,
+  0x5a,0xe4,0xdf,0x3e, 0xdb,0xd5,0xd3,0x5e, 0x5b,0x4f,0x09,0x02, 0x0d,0xb0,0x3e,0xab,
+  0x1e,0x03,0x1d,0xda, 0x2f,0xbe,0x03,0xd1, 0x79,0x21,0x70,0xa0, 0xf3,0x00,0x9c,0xee
+};
+
+// CMAC for message length 0, 16, 40 and 64B
+const uint16_t cmacLen[4] = { 0, 16, 40, 64 };
+const uint8_t cmacRef[4*16] = {
+  0xbb,0x1d,0x69,0x29, 0xe9,0x59,0x37,0x28, 0x7f,0xa3,0x7d,0x12, 0x9b,0x75,0x67,0x46,
+  0x07,0x0a,0x16,0xb4, 0x6b,0x4d,0x41,0x44, 0xf7,0x9b,0xdd,0x9d, 0xd0,0x4a,0x28,0x7c,
+  0xdf,0xa6,0x67,0x47, 0xde,0x9a,0xe6,0x30, 0x30,0xca,0x32,0x61, 0x14,0x97,0xc8,0x27,
+  0x51,0xf0,0xbe,0xbf, 0x7e,0x3b,0x9d,0x92, 0xfc,0x49,0x74,0x17, 0x79,0x36,0x3c,0xfe
+};
+
+// link keys for message format (example only, use device specific keys)
+const uint8_t encKey[16] = { 0x10,0x11,0x12,0x13, 0x14,0x15,0x16,0x17, 0x18,0x19,0x1a,0x1b, 0x1c,0x1d,0x1e,0x1f };
+const uint8_t macKey[16] = { 0x20,0x21,0x22,0x23, 0x24,0x25,0x26,0x27, 0x28,0x29,0x2a,0x2b, 0x2c,0x2d,0x2e,0x2f };
+
+// buffers. Size is multiple of test vector length (64B) and > DMA_MAX_BLOCKS blocks
+aes_ctx_t   ctx;
+msg_ctx_t   meter, hub;
+uint8_t     buf[5*64], buf2[5*64];
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/**
+  \fn void check(const char *name, const uint8_t *result, const uint8_t *ref, uint16_t len)
+
+  \brief compare result with reference and print
+
+  \param[in]  name    name of test
+  \param[in]  result  calculated result
+  \param[in]  ref     reference value
+  \param[in]  len     length to compare [B]
+*/
+void check(const char *name, const uint8_t *result, const uint8_t *ref, uint16_t len) {
+
+  printf("%s: %s\n", name, (memcmp(result, ref, len) == 0) ? "ok" : "FAILED");
+
+} // check
+
+
+
+/**
+  \fn void fillPlain(uint8_t *dst)
+
+  \brief fill buf-sized buffer with repeated 64B test vector plaintext
+
+  \param[out] dst     buffer of sizeof(buf)
+*/
+void fillPlain(uint8_t *dst) {
+
+  uint16_t  i;
+
+  for (i=0; i<sizeof(buf); i+=64)
+    memcpy(dst+i, plain, 64);
+
+} // fillPlain
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint8_t     iv[16], out[64], ok;
+  uint16_t    len, num, i;
+  uint32_t    start;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init peripherals
+  UART_begin(115200);
+  TIM4_init();
+  AES_begin();
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  printf("\nAES-128 %s\n", (AES_HW) ? ((AES_DMA) ? "hardware + DMA" : "hardware") : "software");
+
+  // test vectors with 4 blocks (hardware: via DMA)
+  AES_setKey(&ctx, key);
+  AES_ecbEncrypt(&ctx, plain, out, 64);
+  check("ECB encrypt", out, ecbRef, 64);
+  AES_ecbDecrypt(&ctx, ecbRef, out, 64);
+  check("ECB decrypt", out, plain, 64);
+  memcpy(iv, ivCbc, 16);
+  AES_cbcEncrypt(&ctx, iv, plain, out, 64);
+  check("CBC encrypt", out, cbcRef, 64);
+  memcpy(iv, ivCbc, 16);
+  AES_cbcDecrypt(&ctx, iv, cbcRef, out, 64);
+  check("CBC decrypt", out, plain, 64);
+  memcpy(iv, ivCtr, 16);
+  AES_ctrCrypt(&ctx, iv, plain, out, 64);
+  check("CTR", out, ctrRef, 64);
+  for (i=0; i<4; i++) {
+    AES_cmac(&ctx, plain, cmacLen[i], out);
+    printf("CMAC %uB: %s\n", cmacLen[i], (memcmp(out, cmacRef + (i<<4), 16) == 0) ? "ok" : "FAILED");
+  }
+
+  // ECB in place over 20 blocks (hardware: split into several DMA transfers)
+  fillPlain(buf);
+  AES_ecbEncrypt(&ctx, buf, buf, sizeof(buf));
+  ok = 1;
+  for (i=0; i<sizeof(buf); i+=64)
+    ok &= (memcmp(buf+i, ecbRef, 64) == 0);
+  AES_ecbDecrypt(&ctx, buf, buf, sizeof(buf));
+  fillPlain(buf2);
+  ok &= (memcmp(buf, buf2, sizeof(buf)) == 0);
+  printf("ECB %uB in place: %s\n", (uint16_t) sizeof(buf), ok ? "ok" : "FAILED");
+
+  // CTR in place over 20 blocks vs. reference from single block calls
+  fillPlain(buf);
+  memcpy(iv, ivCtr, 16);
+  AES_ctrCrypt(&ctx, iv, buf, buf, sizeof(buf));
+  memcpy(iv, ivCtr, 16);
+  for (i=0; i<sizeof(buf); i+=16)
+    AES_ctrCrypt(&ctx, iv, plain + (i & 63), buf2 + i, 16);
+  ok = (memcmp(buf, ctrRef, 64) == 0) && (memcmp(buf, buf2, sizeof(buf)) == 0);
+  printf("CTR %uB in place: %s\n", (uint16_t) sizeof(buf), ok ? "ok" : "FAILED");
+
+  // CTR throughput over 1s
+  memcpy(iv, ivCtr, 16);
+  num = 0;
+  start = millis();
+  while ((uint32_t) (millis() - start) < 1000) {
+    AES_ctrCrypt(&ctx, iv, buf, buf, sizeof(buf));
+    num++;
+  }
+  printf("CTR: %lu B/s\n", (uint32_t) num * sizeof(buf));
+
+  // telemetry from meter to hub
+  MSG_begin(&meter, 0x01, encKey, macKey);
+  MSG_begin(&hub,   0x00, encKey, macKey);
+  len = sprintf((char*) MSG_PAYLOAD(buf), "energy=%u Wh", 12345);
+  len = MSG_seal(&meter, MSG_TYPE_TELEMETRY, buf, len);
+  memcpy(buf2, buf, len);
+  if (MSG_open(&hub, buf, len) == MSG_OK) {
+    MSG_PAYLOAD(buf)[MSG_LENGTH(buf)] = '\0';
+    printf("telemetry from %u: %s\n", (uint16_t) MSG_SOURCE(buf), (char*) MSG_PAYLOAD(buf));
+  }
+  else
+    printf("telemetry: FAILED\n");
+  printf("replay rejected: %s\n", (MSG_open(&hub, buf2, len) == MSG_ERR_REPLAY) ? "ok" : "FAILED");
+
+  // firmware chunk: 4B address + 64B data. Modify one ciphertext bit
+  MSG_PAYLOAD(buf)[0] = 0x00;
+  MSG_PAYLOAD(buf)[1] = 0x00;
+  MSG_PAYLOAD(buf)[2] = 0x90;
+  MSG_PAYLOAD(buf)[3] = 0x00;
+  for (i=0; i<64; i++)
+    MSG_PAYLOAD(buf)[4+i] = (uint8_t) i;
+  len = MSG_seal(&meter, MSG_TYPE_FW_DATA, buf, 4+64);
+  memcpy(buf2, buf, len);
+  buf2[MSG_HEADER_LEN + 10] ^= 0x01;
+  printf("modified rejected: %s\n", (MSG_open(&hub, buf2, len) == MSG_ERR_AUTH) ? "ok" : "FAILED");
+  if ((MSG_open(&hub, buf, len) == MSG_OK) && (MSG_TYPE(buf) == MSG_TYPE_FW_DATA))
+    printf("firmware chunk: %u B for 0x%02x%02x\n", MSG_LENGTH(buf) - 4, (uint16_t) MSG_PAYLOAD(buf)[2], (uint16_t) MSG_PAYLOAD(buf)[3]);
+  else
+    printf("firmware chunk: FAILED\n");
+
+  // main loop
+  while(1) {
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,168 @@
+/**
+  \file secure_msg.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of authenticated and encrypted message format
+
+  implementation of sealing (encrypt-then-MAC) and opening (verify, check
+  replay, decrypt) of frames, see secure_msg.h for the layout.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "secure_msg.h"
+
+
+
+/**
+  \fn static void counterBlock(uint8_t *ctr, const uint8_t *frame)
+
+  \brief build initial CTR counter block from frame header
+
+  \param[out] ctr     counter block (16B)
+  \param[in]  frame   frame with valid header
+
+  layout: node ID, 4B sequence number, 7B zero, 4B block counter starting at 0.
+*/
+static void counterBlock(uint8_t *ctr, const uint8_t *frame) {
+
+  uint8_t   i;
+
+  for (i=0; i<16; i++)
+    ctr[i] = 0x00;
+  ctr[0] = MSG_SOURCE(frame);
+  for (i=0; i<4; i++)
+    ctr[i+1] = frame[i+2];
+
+} // counterBlock
+
+
+
+/**
+  \fn void MSG_begin(msg_ctx_t *ctx, uint8_t node, const uint8_t *encKey, const uint8_t *macKey)
+
+  \brief initialize link context
+
+  \param[out] ctx       link context
+  \param[in]  node      own node ID
+  \param[in]  encKey    key for payload encryption (16B)
+  \param[in]  macKey    key for authentication (16B), must differ from encKey
+
+  sequence numbers are reset to 0. Restore them from non-volatile memory
+  after calling this function.
+*/
+void MSG_begin(msg_ctx_t *ctx, uint8_t node, const uint8_t *encKey, const uint8_t *macKey) {
+
+  AES_setKey(&(ctx->enc), encKey);
+  AES_setKey(&(ctx->mac), macKey);
+  ctx->node  = node;
+  ctx->txSeq = 0;
+  ctx->rxSeq = 0;
+
+} // MSG_begin
+
+
+
+/**
+  \fn uint16_t MSG_seal(msg_ctx_t *ctx, uint8_t type, uint8_t *frame, uint16_t len)
+
+  \brief encrypt and authenticate payload
+
+  \param[in]      ctx     link context
+  \param[in]      type    message type MSG_TYPE_xxx
+  \param[in,out]  frame   frame buffer with payload at MSG_PAYLOAD(frame). Size >= len + MSG_OVERHEAD
+  \param[in]      len     payload length [B]
+
+  \return total frame length [B]
+
+  fill header with next sequence number, encrypt payload in place and append tag.
+*/
+uint16_t MSG_seal(msg_ctx_t *ctx, uint8_t type, uint8_t *frame, uint16_t len) {
+
+  uint8_t   ctr[16], tag[16];
+  uint8_t   i;
+  uint32_t  seq = ++(ctx->txSeq);
+
+  // header
+  frame[0] = type;
+  frame[1] = ctx->node;
+  frame[2] = (uint8_t) (seq >> 24);
+  frame[3] = (uint8_t) (seq >> 16);
+  frame[4] = (uint8_t) (seq >> 8);
+  frame[5] = (uint8_t) seq;
+  frame[6] = (uint8_t) (len >> 8);
+  frame[7] = (uint8_t) len;
+
+  // encrypt payload
+  counterBlock(ctr, frame);
+  AES_ctrCrypt(&(ctx->enc), ctr, MSG_PAYLOAD(frame), MSG_PAYLOAD(frame), len);
+
+  // append truncated tag over header and ciphertext
+  AES_cmac(&(ctx->mac), frame, MSG_HEADER_LEN + len, tag);
+  for (i=0; i<MSG_TAG_LEN; i++)
+    frame[MSG_HEADER_LEN + len + i] = tag[i];
+
+  return(MSG_HEADER_LEN + len + MSG_TAG_LEN);
+
+} // MSG_seal
+
+
+
+/**
+  \fn uint8_t MSG_open(msg_ctx_t *ctx, uint8_t *frame, uint16_t len)
+
+  \brief verify and decrypt frame
+
+  \param[in]      ctx     link context
+  \param[in,out]  frame   received frame. On success, payload at MSG_PAYLOAD(frame) is decrypted
+  \param[in]      len     frame length [B]
+
+  \return MSG_OK on success, else MSG_ERR_xxx
+
+  tag is checked before decryption and compared in constant time. The
+  sequence number is only accepted after successful verification.
+*/
+uint8_t MSG_open(msg_ctx_t *ctx, uint8_t *frame, uint16_t len) {
+
+  uint8_t   ctr[16], tag[16];
+  uint8_t   i, diff = 0;
+  uint16_t  payload;
+  uint32_t  seq;
+
+  // check length
+  if (len < MSG_OVERHEAD)
+    return(MSG_ERR_LENGTH);
+  payload = MSG_LENGTH(frame);
+  if (payload != len - MSG_OVERHEAD)
+    return(MSG_ERR_LENGTH);
+
+  // verify tag
+  AES_cmac(&(ctx->mac), frame, MSG_HEADER_LEN + payload, tag);
+  for (i=0; i<MSG_TAG_LEN; i++)
+    diff |= tag[i] ^ frame[MSG_HEADER_LEN + payload + i];
+  if (diff)
+    return(MSG_ERR_AUTH);
+
+  // check replay
+  seq = ((uint32_t) frame[2] << 24) | ((uint32_t) frame[3] << 16) | ((uint16_t) frame[4] << 8) | frame[5];
+  if (seq <= ctx->rxSeq)
+    return(MSG_ERR_REPLAY);
+  ctx->rxSeq = seq;
+
+  // decrypt payload
+  counterBlock(ctr, frame);
+  AES_ctrCrypt(&(ctx->enc), ctr, MSG_PAYLOAD(frame), MSG_PAYLOAD(frame), payload);
+
+  return(MSG_OK);
+
+} // MSG_open
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
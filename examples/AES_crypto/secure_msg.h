@@ -0,0 +1,112 @@
+/**
+  \file secure_msg.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of authenticated and encrypted message format
+
+  declaration of a compact message format for telemetry and firmware
+  update, based on aes.h. Frame layout (multi-byte values big endian):
+    - 0: message type, see MSG_TYPE_xxx
+    - 1: source node ID
+    - 2..5: sequence number, strictly increasing per sender
+    - 6..7: payload length N
+    - 8..8+N-1: payload, AES-CTR encrypted
+    - 8+N..8+N+7: tag = AES-CMAC over bytes 0..8+N-1, truncated to 8B
+
+  The CTR counter block is built from node ID, sequence number and a block
+  counter, i.e. it is unique as long as sequence numbers are not reused for
+  a key. Separate keys are used for encryption and authentication
+  (encrypt-then-MAC). The receiver rejects modified frames and replays.
+
+  Firmware update payloads:
+    - MSG_TYPE_FW_DATA: 4B flash address + data
+    - MSG_TYPE_FW_DONE: 4B image length + 16B AES-CMAC over image
+
+  \note
+  - the last sequence numbers must be kept in non-volatile memory by the
+    application, e.g. in EEPROM, else replay protection is lost on reset
+  - the receiver tracks a single peer
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _SECURE_MSG_H_
+#define _SECURE_MSG_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "aes.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// frame layout
+#define MSG_HEADER_LEN          8             ///< header length [B]
+#define MSG_TAG_LEN             8             ///< tag length [B]
+#define MSG_OVERHEAD            (MSG_HEADER_LEN + MSG_TAG_LEN)    ///< total overhead [B]
+
+/// get payload in frame
+#define MSG_PAYLOAD(frame)      ((frame) + MSG_HEADER_LEN)
+
+/// get type of frame
+#define MSG_TYPE(frame)         ((frame)[0])
+
+/// get source node ID of frame
+#define MSG_SOURCE(frame)       ((frame)[1])
+
+/// get payload length of frame
+#define MSG_LENGTH(frame)       (((uint16_t) (frame)[6] << 8) | (frame)[7])
+
+// message types
+#define MSG_TYPE_TELEMETRY      0x01          ///< application data
+#define MSG_TYPE_FW_DATA        0x10          ///< firmware chunk: address + data
+#define MSG_TYPE_FW_DONE        0x11          ///< firmware complete: length + image CMAC
+
+// results of MSG_open()
+#define MSG_OK                  0             ///< valid frame, payload decrypted
+#define MSG_ERR_LENGTH          1             ///< frame length does not match header
+#define MSG_ERR_AUTH            2             ///< tag invalid, i.e. frame modified or wrong key
+#define MSG_ERR_REPLAY          3             ///< sequence number not newer than last accepted
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// link context
+typedef struct {
+  aes_ctx_t   enc;          ///< encryption key
+  aes_ctx_t   mac;          ///< authentication key
+  uint8_t     node;         ///< own node ID
+  uint32_t    txSeq;        ///< last sent sequence number
+  uint32_t    rxSeq;        ///< last accepted sequence number
+} msg_ctx_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// initialize link context with own node ID and keys (16B each)
+void MSG_begin(msg_ctx_t *ctx, uint8_t node, const uint8_t *encKey, const uint8_t *macKey);
+
+/// encrypt and authenticate payload at MSG_PAYLOAD(frame) in place. Returns frame length
+uint16_t MSG_seal(msg_ctx_t *ctx, uint8_t type, uint8_t *frame, uint16_t len);
+
+/// verify and decrypt frame in place. Returns MSG_OK or MSG_ERR_xxx
+uint8_t MSG_open(msg_ctx_t *ctx, uint8_t *frame, uint16_t len);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _SECURE_MSG_H_
@@ -0,0 +1,557 @@
+/**
+  \file can.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of interrupt driven beCAN driver
+
+  implementation of functions for beCAN initialization, acceptance filters,
+  queued transmission via all 3 Tx mailboxes and reception into a SW ring.
+  The beCAN registers are paged, see CAN_PSR. Pages used:
+    - 0, 1, 5: Tx mailbox 0, 1, 2
+    - 2, 3, 4: filter banks 0+1, 2+3, 4+5
+    - 6: configuration and diagnostics
+    - 7: Rx FIFO output mailbox
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "can.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// CAN only exists on some devices
+#if !defined(sfr_CAN)
+  #error device has no CAN
+#endif
+
+// check settings (negative array size on error)
+typedef char can_check_txQueue[((CAN_TX_QUEUE & (CAN_TX_QUEUE-1)) == 0) && (CAN_TX_QUEUE <= 64) ? 1 : -1];
+typedef char can_check_rxQueue[((CAN_RX_QUEUE & (CAN_RX_QUEUE-1)) == 0) && (CAN_RX_QUEUE <= 64) ? 1 : -1];
+
+// register pages
+#define PAGE_CONFIG         6         ///< configuration and diagnostics
+#define PAGE_RX             7         ///< Rx FIFO output mailbox
+#define PAGE_FILTER         2         ///< filter banks 0+1. Banks 2+3, 4+5 in next pages
+
+// timeout for init mode handshake
+#define INAK_TIMEOUT        0xFFFF
+
+// CAN_TPR bits
+#define TPR_TME0            0x04      ///< Tx mailbox 0 empty
+#define TPR_TME1            0x08      ///< Tx mailbox 1 empty
+#define TPR_TME2            0x10      ///< Tx mailbox 2 empty
+
+// CAN_RFR bits
+#define RFR_FMP             0x03      ///< number of pending frames in FIFO
+#define RFR_FULL            0x08      ///< FIFO full
+#define RFR_FOVR            0x10      ///< FIFO overrun
+#define RFR_RFOM            0x20      ///< release FIFO output mailbox
+
+// CAN_MIDR1 bits
+#define MIDR1_IDE           0x40      ///< extended identifier
+#define MIDR1_RTR           0x20      ///< remote frame
+
+// CAN_ESR and CAN_EIER bits (page 6)
+#define ESR_BOFF            0x04      ///< bus-off
+#define EIER_ERR            0x87      ///< ERRIE | BOFIE | EPVIE | EWGIE
+
+// bit timing: 16 tq/bit = 1 (sync) + 13 (BS1) + 2 (BS2) -> sample point 87.5%, SJW=1tq
+#define BIT_TQ              16
+#define BTR2_VALUE          ((1 << 4) | 12)
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// acceptance filters from config.h
+static const can_filter_t m_filter[] = CAN_FILTERS;
+
+/// register page of Tx mailbox 0..2
+static const uint8_t      m_txPage[3] = { 0, 1, 5 };
+
+/// Tx queue. Indices run over 2*size to distinguish full from empty
+static can_msg_t          m_txQueue[CAN_TX_QUEUE];
+static volatile uint8_t   m_txHead;           ///< write index, modified with TMEIE=0 only
+static volatile uint8_t   m_txTail;           ///< read index, modified with TMEIE=0 or in ISR
+
+/// Rx ring. Indices run over 2*size to distinguish full from empty
+static can_msg_t          m_rxRing[CAN_RX_QUEUE];
+static volatile uint8_t   m_rxHead;           ///< write index, modified in ISR only
+static volatile uint8_t   m_rxTail;           ///< read index, modified by CAN_read() only
+
+// statistics
+static volatile uint16_t  m_rxOverrun;        ///< frames lost in HW FIFO or SW ring
+static volatile uint16_t  m_txError;          ///< failed transmissions
+static volatile uint8_t   m_busOff;           ///< number of bus-off events
+static volatile uint8_t   m_busOffState;      ///< currently in bus-off
+
+
+
+/**
+  \fn static void loadMailbox(uint8_t mbx, const can_msg_t *msg)
+
+  \brief copy frame to Tx mailbox and request transmission
+
+  \param[in]  mbx     Tx mailbox 0..2
+  \param[in]  msg     frame to send
+
+  must be called with TMEIE=0 or from Tx ISR. Page select is restored.
+*/
+static void loadMailbox(uint8_t mbx, const can_msg_t *msg) {
+
+  uint8_t   psr = sfr_CAN.PSR.byte;
+  uint8_t   midr1, i, dlc;
+  uint32_t  id = msg->id;
+
+  // select mailbox page
+  sfr_CAN.PSR.byte = m_txPage[mbx];
+
+  // identifier and flags
+  midr1 = (id & CAN_RTR) ? MIDR1_RTR : 0x00;
+  if (id & CAN_EXT) {
+    sfr_CAN.MIDR1.byte = midr1 | MIDR1_IDE | ((uint8_t) (id >> 24) & 0x1F);
+    sfr_CAN.MIDR2.byte = (uint8_t) (id >> 16);
+    sfr_CAN.MIDR3.byte = (uint8_t) (id >> 8);
+    sfr_CAN.MIDR4.byte = (uint8_t) id;
+  }
+  else {
+    sfr_CAN.MIDR1.byte = midr1 | ((uint8_t) (id >> 6) & 0x1F);
+    sfr_CAN.MIDR2.byte = (uint8_t) (id << 2);
+  }
+
+  // length and data
+  dlc = (msg->dlc > 8) ? 8 : msg->dlc;
+  sfr_CAN.MDLCR.byte = dlc;
+  for (i=0; i<dlc; i++)
+    (&(sfr_CAN.MDAR1.byte))[i] = msg->data[i];
+
+  // request transmission
+  sfr_CAN.MCSR.byte = 0x01;
+
+  // restore page
+  sfr_CAN.PSR.byte = psr;
+
+} // loadMailbox
+
+
+
+/**
+  \fn static void txRefill(void)
+
+  \brief move queued frames to empty Tx mailboxes
+
+  fill all empty mailboxes from Tx queue. As mailboxes are sent in
+  chronological order (MCR.TXFP=1), the queue order is kept.
+  Must be called with TMEIE=0 or from Tx ISR.
+*/
+static void txRefill(void) {
+
+  uint8_t   tpr, mbx;
+
+  while (m_txTail != m_txHead) {
+
+    // find empty mailbox
+    tpr = sfr_CAN.TPR.byte;
+    if (tpr & TPR_TME0)
+      mbx = 0;
+    else if (tpr & TPR_TME1)
+      mbx = 1;
+    else if (tpr & TPR_TME2)
+      mbx = 2;
+    else
+      return;
+
+    // send oldest queued frame
+    loadMailbox(mbx, &(m_txQueue[m_txTail & (CAN_TX_QUEUE-1)]));
+    m_txTail = (m_txTail + 1) & (2*CAN_TX_QUEUE-1);
+
+  }
+
+} // txRefill
+
+
+
+/**
+  \fn static void setFilter(const can_filter_t *filter)
+
+  \brief configure one acceptance filter bank
+
+  \param[in]  filter    filter bank configuration
+
+  must be called in init mode. Bank is activated after configuration.
+*/
+static void setFilter(const can_filter_t *filter) {
+
+  uint8_t   bank = filter->bank;
+  uint8_t   shift, i;
+
+  // filter mode (FMR1: banks 0-3, FMR2: banks 4-5)
+  sfr_CAN.PSR.byte = PAGE_CONFIG;
+  shift = (bank & 0x03) << 1;
+  (&(sfr_CAN.FMR1.byte))[bank >> 2] &= (uint8_t) ~(0x03 << shift);
+  (&(sfr_CAN.FMR1.byte))[bank >> 2] |= (uint8_t) ((filter->mode & 0x03) << shift);
+
+  // filter scale (FCR1: banks 0-1, FCR2: 2-3, FCR3: 4-5). Keep bank inactive
+  shift = (bank & 0x01) << 2;
+  (&(sfr_CAN.FCR1.byte))[bank >> 1] &= (uint8_t) ~(0x07 << shift);
+  (&(sfr_CAN.FCR1.byte))[bank >> 1] |= (uint8_t) ((filter->scale & 0x03) << (shift + 1));
+
+  // filter registers. 2 banks per page
+  sfr_CAN.PSR.byte = PAGE_FILTER + (bank >> 1);
+  for (i=0; i<8; i++)
+    (&(sfr_CAN.F0R1.byte))[((bank & 0x01) << 3) + i] = filter->fr[i];
+
+  // activate bank
+  sfr_CAN.PSR.byte = PAGE_CONFIG;
+  (&(sfr_CAN.FCR1.byte))[bank >> 1] |= (uint8_t) (0x01 << shift);
+
+} // setFilter
+
+
+
+/**
+  \fn uint8_t CAN_begin(uint32_t baud)
+
+  \brief initialize beCAN
+
+  \param[in]  baud    CAN baudrate [Baud], e.g. 500000
+
+  \return 1 on success, 0 on invalid baudrate or if init mode handshake failed
+
+  enter init mode, set options, bit timing and acceptance filters from table
+  CAN_FILTERS. Then enable interrupts and go to normal (or loopback) mode.
+*/
+uint8_t CAN_begin(uint32_t baud) {
+
+  uint16_t  timeout;
+  uint32_t  brp;
+  uint8_t   i;
+
+  // check baudrate: CAN_CLOCK must be multiple of 16*baud, BRP 1..64
+  if (baud == 0)
+    return(0);
+  brp = CAN_CLOCK / (BIT_TQ * baud);
+  if ((brp == 0) || (brp > 64) || (brp * BIT_TQ * baud != CAN_CLOCK))
+    return(0);
+
+  // reset SW queues and statistics
+  sfr_CAN.IER.byte = 0x00;
+  m_txHead      = 0;
+  m_txTail      = 0;
+  m_rxHead      = 0;
+  m_rxTail      = 0;
+  m_rxOverrun   = 0;
+  m_txError     = 0;
+  m_busOff      = 0;
+  m_busOffState = 0;
+
+  // leave sleep and enter init mode
+  sfr_CAN.MCR.byte = 0x01;
+  timeout = INAK_TIMEOUT;
+  while ((!sfr_CAN.MSR.INAK) && (--timeout));
+  if (!timeout)
+    return(0);
+
+  // Tx in chronological order, automatic bus-off recovery, auto retransmission
+  sfr_CAN.MCR.TXFP = 1;
+  sfr_CAN.MCR.ABOM = 1;
+
+  // use all 3 Tx mailboxes. Optional silent loopback for test w/o bus
+  sfr_CAN.DGR.byte = 0x00;
+  sfr_CAN.DGR.TXM2E = 1;
+  #if (CAN_LOOPBACK)
+    sfr_CAN.DGR.LBKM = 1;
+    sfr_CAN.DGR.SILM = 1;
+  #endif
+
+  // bit timing
+  sfr_CAN.PSR.byte  = PAGE_CONFIG;
+  sfr_CAN.BTR1.byte = (uint8_t) (brp - 1);
+  sfr_CAN.BTR2.byte = BTR2_VALUE;
+
+  // deactivate all filters, then configure table
+  sfr_CAN.FCR1.byte = 0x00;
+  sfr_CAN.FCR2.byte = 0x00;
+  sfr_CAN.FCR3.byte = 0x00;
+  sfr_CAN.FMR1.byte = 0x00;
+  sfr_CAN.FMR2.byte = 0x00;
+  for (i=0; i<sizeof(m_filter)/sizeof(m_filter[0]); i++)
+    setFilter(&(m_filter[i]));
+
+  // error interrupts (bus-off, passive, warning)
+  sfr_CAN.PSR.byte  = PAGE_CONFIG;
+  sfr_CAN.EIER.byte = EIER_ERR;
+
+  // leave init mode. Requires 11 recessive bits on bus
+  sfr_CAN.MCR.INRQ = 0;
+  timeout = INAK_TIMEOUT;
+  while ((sfr_CAN.MSR.INAK) && (--timeout));
+  if (!timeout)
+    return(0);
+
+  // enable Rx (pending, overrun) and Tx interrupts
+  sfr_CAN.IER.FMPIE = 1;
+  sfr_CAN.IER.FOVIE = 1;
+  sfr_CAN.IER.TMEIE = 1;
+
+  return(1);
+
+} // CAN_begin
+
+
+
+/**
+  \fn uint8_t CAN_send(const can_msg_t *msg)
+
+  \brief queue frame for transmission
+
+  \param[in]  msg     frame to send
+
+  \return 1 on success, 0 if Tx queue is full
+
+  append frame to Tx queue and fill empty mailboxes. Tx ISR is locked via
+  TMEIE; a pending request completed interrupt is served after unlock.
+*/
+uint8_t CAN_send(const can_msg_t *msg) {
+
+  uint8_t   result = 0;
+
+  // lock Tx ISR
+  sfr_CAN.IER.TMEIE = 0;
+
+  // append to queue if not full
+  if (((uint8_t) (m_txHead - m_txTail) & (2*CAN_TX_QUEUE-1)) < CAN_TX_QUEUE) {
+    m_txQueue[m_txHead & (CAN_TX_QUEUE-1)] = *msg;
+    m_txHead = (m_txHead + 1) & (2*CAN_TX_QUEUE-1);
+    txRefill();
+    result = 1;
+  }
+
+  // unlock Tx ISR
+  sfr_CAN.IER.TMEIE = 1;
+
+  return(result);
+
+} // CAN_send
+
+
+
+/**
+  \fn uint8_t CAN_txFree(void)
+
+  \brief get number of free slots in Tx queue
+
+  \return number of frames which can be queued without blocking
+*/
+uint8_t CAN_txFree(void) {
+
+  return(CAN_TX_QUEUE - ((uint8_t) (m_txHead - m_txTail) & (2*CAN_TX_QUEUE-1)));
+
+} // CAN_txFree
+
+
+
+/**
+  \fn uint8_t CAN_available(void)
+
+  \brief get number of frames in Rx ring
+
+  \return number of received frames
+*/
+uint8_t CAN_available(void) {
+
+  return((uint8_t) (m_rxHead - m_rxTail) & (2*CAN_RX_QUEUE-1));
+
+} // CAN_available
+
+
+
+/**
+  \fn uint8_t CAN_read(can_msg_t *msg)
+
+  \brief get oldest received frame
+
+  \param[out] msg     received frame
+
+  \return 1 if frame was read, 0 if ring is empty
+
+  As the ISR only writes the head and this function only writes the tail,
+  no interrupt lock is required.
+*/
+uint8_t CAN_read(can_msg_t *msg) {
+
+  uint8_t   tail = m_rxTail;
+
+  // ring empty
+  if (tail == m_rxHead)
+    return(0);
+
+  // copy frame, then release slot
+  *msg = m_rxRing[tail & (CAN_RX_QUEUE-1)];
+  m_rxTail = (tail + 1) & (2*CAN_RX_QUEUE-1);
+
+  return(1);
+
+} // CAN_read
+
+
+
+/**
+  \fn void CAN_status(can_status_t *status)
+
+  \brief get error counters and statistics
+
+  \param[out] status    error counters and statistics
+*/
+void CAN_status(can_status_t *status) {
+
+  uint8_t   ier, psr;
+
+  // copy statistics with CAN interrupts locked
+  ier = sfr_CAN.IER.byte;
+  sfr_CAN.IER.byte = 0x00;
+  status->rxOverrun = m_rxOverrun;
+  status->txError   = m_txError;
+  status->busOff    = m_busOff;
+  sfr_CAN.IER.byte = ier;
+
+  // error registers
+  psr = sfr_CAN.PSR.byte;
+  sfr_CAN.PSR.byte = PAGE_CONFIG;
+  status->esr = sfr_CAN.ESR.byte;
+  status->tec = sfr_CAN.TECR.byte;
+  status->rec = sfr_CAN.RECR.byte;
+  sfr_CAN.PSR.byte = psr;
+
+} // CAN_status
+
+
+
+/**
+  \fn void CAN_RX_ISR(void)
+
+  \brief ISR for CAN receive
+
+  drain HW FIFO into SW ring and count overruns. Reading the FIFO promptly
+  keeps the 3-frame HW FIFO from overflowing at high bus load.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(CAN_RX_ISR, _CAN_FMP_VECTOR_) {
+
+  uint8_t     psr = sfr_CAN.PSR.byte;
+  uint8_t     rfr, head, midr1, dlc, i;
+  can_msg_t   *msg;
+
+  // HW FIFO overrun or full: count and clear (rc_w1)
+  rfr = sfr_CAN.RFR.byte;
+  if (rfr & RFR_FOVR)
+    m_rxOverrun++;
+  if (rfr & (RFR_FOVR | RFR_FULL))
+    sfr_CAN.RFR.byte = rfr & (RFR_FOVR | RFR_FULL);
+
+  // drain FIFO
+  sfr_CAN.PSR.byte = PAGE_RX;
+  while (sfr_CAN.RFR.byte & RFR_FMP) {
+
+    // copy to ring if space left
+    head = m_rxHead;
+    if (((uint8_t) (head - m_rxTail) & (2*CAN_RX_QUEUE-1)) < CAN_RX_QUEUE) {
+      msg = &(m_rxRing[head & (CAN_RX_QUEUE-1)]);
+
+      // identifier and flags
+      midr1 = sfr_CAN.MIDR1.byte;
+      if (midr1 & MIDR1_IDE)
+        msg->id = CAN_EXT | ((uint32_t) (midr1 & 0x1F) << 24) | ((uint32_t) sfr_CAN.MIDR2.byte << 16) |
+                  ((uint16_t) sfr_CAN.MIDR3.byte << 8) | sfr_CAN.MIDR4.byte;
+      else
+        msg->id = ((uint16_t) (midr1 & 0x1F) << 6) | (sfr_CAN.MIDR2.byte >> 2);
+      if (midr1 & MIDR1_RTR)
+        msg->id |= CAN_RTR;
+
+      // length, data and filter match index
+      dlc = sfr_CAN.MDLCR.byte & 0x0F;
+      if (dlc > 8)
+        dlc = 8;
+      msg->dlc = dlc;
+      for (i=0; i<dlc; i++)
+        msg->data[i] = (&(sfr_CAN.MDAR1.byte))[i];
+      msg->fmi = sfr_CAN.MFMIR.byte;
+
+      m_rxHead = (head + 1) & (2*CAN_RX_QUEUE-1);
+    }
+    else
+      m_rxOverrun++;
+
+    // release output mailbox and wait until next frame is available
+    sfr_CAN.RFR.byte = RFR_RFOM;
+    while (sfr_CAN.RFR.byte & RFR_RFOM);
+
+  } // while FIFO not empty
+
+  // restore page
+  sfr_CAN.PSR.byte = psr;
+
+} // CAN_RX_ISR
+
+
+
+/**
+  \fn void CAN_TX_ISR(void)
+
+  \brief ISR for CAN transmit and errors
+
+  on request completed, count failed transmissions and refill empty
+  mailboxes from Tx queue. On error interrupt, track bus-off events.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(CAN_TX_ISR, _CAN_RQCP0_VECTOR_) {
+
+  uint8_t   psr = sfr_CAN.PSR.byte;
+  uint8_t   tsr, i, esr;
+
+  // request completed: count errors (RQCPx w/o TXOKx), clear RQCPx (rc_w1).
+  // Skip if locked by CAN_send(), i.e. ISR was entered via error interrupt
+  tsr = sfr_CAN.TSR.byte;
+  if ((sfr_CAN.IER.TMEIE) && (tsr & 0x07)) {
+    for (i=0; i<3; i++) {
+      if ((tsr & (0x01 << i)) && (!(tsr & (0x10 << i))))
+        m_txError++;
+    }
+    sfr_CAN.TSR.byte = tsr & 0x07;
+
+    // keep mailboxes busy
+    txRefill();
+  }
+
+  // error interrupt: track bus-off, clear ERRI (rc_w1)
+  if (sfr_CAN.MSR.ERRI) {
+    sfr_CAN.PSR.byte = PAGE_CONFIG;
+    esr = sfr_CAN.ESR.byte & ESR_BOFF;
+    if ((esr) && (!m_busOffState))
+      m_busOff++;
+    m_busOffState = esr;
+    sfr_CAN.MSR.byte = 0x04;
+  }
+
+  // restore page
+  sfr_CAN.PSR.byte = psr;
+
+} // CAN_TX_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,58 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define NUCLEO_8S208RB
+//#define STM8AF_ECU
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(NUCLEO_8S208RB)
+  #include "../../include/STM8S208RB.h"
+  #define CAN_LOOPBACK    1             // no CAN transceiver -> silent loopback mode
+#elif defined(STM8AF_ECU)
+  #include "../../include/STM8AF5288.h"
+  #define CAN_LOOPBACK    0             // CAN_TX=PG0, CAN_RX=PG1 via transceiver
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    CAN CONFIGURATION
+----------------------------------------------------------*/
+
+// CAN clock = fMaster [Hz]. Note: for a real bus use a crystal (HSE)
+#define CAN_CLOCK         16000000L
+
+// acceptance filters, see can.h. Frames not matching any filter are discarded in hardware
+//   - bank 0: standard IDs 0x100..0x17F (32-bit mask)
+//   - bank 1: standard IDs 0x7DF and 0x7E0 (16-bit list)
+//   - bank 2: extended IDs 0x18DA00F1 and 0x18DAF100 (32-bit list)
+#define CAN_FILTERS       { \
+  CAN_FILTER_MASK32(0, CAN_ID32_STD(0x100), CAN_MASK32_STD(0x780)), \
+  CAN_FILTER_LIST16(1, CAN_ID16_STD(0x7DF), CAN_ID16_STD(0x7E0), CAN_ID16_STD(0x7DF), CAN_ID16_STD(0x7E0)), \
+  CAN_FILTER_LIST32(2, CAN_ID32_EXT(0x18DA00F1), CAN_ID32_EXT(0x18DAF100)) \
+}
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
@@ -0,0 +1,149 @@
+/**********************
+  beCAN driver with HW acceptance filters, queued Tx via all mailboxes and Rx ring
+
+  supported hardware:
+    - Nucleo-8S208RB (https://www.st.com/en/evaluation-tools/nucleo-8s208rb.html), silent loopback
+    - STM8AF52xx ECU with CAN transceiver on PG0/PG1
+
+  Functionality:
+    - acceptance filters are set from table CAN_FILTERS in config.h
+    - every 10ms queue a burst of 8 frames (IDs 0x100..0x107) with a sequence
+      counter at 500kBaud. The Tx ISR keeps all 3 Tx mailboxes busy
+    - received frames are drained from the HW FIFO into a SW ring in the
+      Rx ISR. Main loop checks the sequence counter for lost frames
+    - every 1s print number of received frames, lost frames and error status via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "can.h"
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// CAN baudrate [Baud]
+#define CAN_BAUD        500000L
+
+// number of frames per burst
+#define BURST           8
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  can_msg_t     tx, rx;
+  can_status_t  status;
+  uint32_t      nextSend = 10, nextPrint = 1000;
+  uint16_t      seqTx = 0, seqRx = 0, numRx = 0, numLost = 0, seq;
+  uint8_t       i;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init UART for 115.2kBaud
+  UART_begin(115200);
+
+  // init 1ms tick
+  TIM4_init();
+
+  // init CAN
+  if (!CAN_begin(CAN_BAUD))
+    printf("CAN init failed\n");
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // every 10ms queue a burst of frames
+    if ((int32_t) (millis() - nextSend) >= 0) {
+      nextSend += 10;
+      if (CAN_txFree() >= BURST) {
+        for (i=0; i<BURST; i++) {
+          tx.id      = 0x100 + i;
+          tx.dlc     = 8;
+          tx.data[0] = (uint8_t) (seqTx >> 8);
+          tx.data[1] = (uint8_t) seqTx;
+          tx.data[2] = i;
+          tx.data[3] = 0x00;
+          tx.data[4] = 0x00;
+          tx.data[5] = 0x00;
+          tx.data[6] = 0x00;
+          tx.data[7] = 0x00;
+          CAN_send(&tx);
+          seqTx++;
+        }
+      }
+    }
+
+    // read received frames and check sequence
+    while (CAN_read(&rx)) {
+      numRx++;
+      seq = ((uint16_t) rx.data[0] << 8) | rx.data[1];
+      if (seq != seqRx)
+        numLost += seq - seqRx;
+      seqRx = seq + 1;
+    }
+
+    // every 1s print statistics
+    if ((int32_t) (millis() - nextPrint) >= 0) {
+      nextPrint += 1000;
+      CAN_status(&status);
+      printf("rx %u/s, lost %u, overrun %u, txErr %u, TEC %u, REC %u, ESR 0x%02x, bus-off %u\n",
+        numRx, numLost, status.rxOverrun, status.txError, (uint16_t) status.tec, (uint16_t) status.rec,
+        (uint16_t) status.esr, (uint16_t) status.busOff);
+      numRx = 0;
+    }
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,176 @@
+/**
+  \file can.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of interrupt driven beCAN driver
+
+  declaration of a driver for the beCAN controller of STM8S208 and STM8AF5x
+  devices. Features:
+    - acceptance filter banks are configured from a compile-time table
+      CAN_FILTERS in config.h, see CAN_FILTER_xxx() macros
+    - transmission via SW queue. The Tx ISR keeps all 3 Tx mailboxes busy,
+      mailboxes are sent in chronological order (MCR.TXFP=1)
+    - the Rx ISR drains the hardware FIFO (3 frames) into a lock-free SW ring
+    - error counters, last error code and bus-off events are tracked,
+      bus-off recovery is automatic (MCR.ABOM=1)
+
+  \note
+  - bit timing uses 16 time quanta per bit with sample point at 87.5%, i.e.
+    CAN_CLOCK must be a multiple of 16*baudrate
+  - paged registers: ISRs save and restore the page select register CAN_PSR,
+    i.e. the main program may access paged registers without locking
+  - SW queue sizes must be powers of 2
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CAN_H_
+#define _CAN_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// size of Tx queue [frames]. Must be power of 2. Default can be overwritten in config.h
+#ifndef CAN_TX_QUEUE
+  #define CAN_TX_QUEUE          16
+#endif
+
+// size of Rx ring [frames]. Must be power of 2. Default can be overwritten in config.h
+#ifndef CAN_RX_QUEUE
+  #define CAN_RX_QUEUE          16
+#endif
+
+// silent loopback mode for test w/o bus. Default can be overwritten in config.h
+#ifndef CAN_LOOPBACK
+  #define CAN_LOOPBACK          0
+#endif
+
+// identifier flags in can_msg_t.id
+#define CAN_EXT                 0x80000000    ///< extended (29b) identifier
+#define CAN_RTR                 0x40000000    ///< remote frame
+#define CAN_ID_MASK             0x1FFFFFFF    ///< identifier bits
+
+// filter scale (CAN_FCRx.FSCx)
+#define CAN_SCALE_8             0x00          ///< 4x 8-bit
+#define CAN_SCALE_16_8          0x01          ///< 1x 16-bit + 2x 8-bit
+#define CAN_SCALE_16            0x02          ///< 2x 16-bit
+#define CAN_SCALE_32            0x03          ///< 1x 32-bit
+
+// filter mode of lower/upper half of bank (CAN_FMRx.FMLx/FMHx)
+#define CAN_MODE_MASK           0x00          ///< identifier + mask
+#define CAN_MODE_LIST           0x03          ///< identifier list
+
+/// 32-bit filter register bytes for standard identifier (IDE=0, RTR=0)
+#define CAN_ID32_STD(id)        (uint8_t) ((id) >> 3), (uint8_t) (((id) << 5) & 0xE0), 0x00, 0x00
+
+/// 32-bit filter register bytes for extended identifier (IDE=1, RTR=0)
+#define CAN_ID32_EXT(id)        (uint8_t) ((id) >> 21), (uint8_t) ((((id) >> 13) & 0xE0) | 0x08 | (((id) >> 15) & 0x07)), \
+                                (uint8_t) ((id) >> 7), (uint8_t) (((id) << 1) & 0xFE)
+
+/// 32-bit mask bytes for standard identifier. IDE must match, RTR is ignored
+#define CAN_MASK32_STD(mask)    (uint8_t) ((mask) >> 3), (uint8_t) ((((mask) << 5) & 0xE0) | 0x08), 0x00, 0x00
+
+/// 32-bit mask bytes for extended identifier. IDE must match, RTR is ignored
+#define CAN_MASK32_EXT(mask)    CAN_ID32_EXT(mask)
+
+/// 16-bit filter register bytes for standard identifier (IDE=0, RTR=0)
+#define CAN_ID16_STD(id)        (uint8_t) ((id) >> 3), (uint8_t) (((id) << 5) & 0xE0)
+
+/// 16-bit mask bytes for standard identifier. IDE must match, RTR is ignored
+#define CAN_MASK16_STD(mask)    (uint8_t) ((mask) >> 3), (uint8_t) ((((mask) << 5) & 0xE0) | 0x08)
+
+/// filter bank with 1x 32-bit identifier + mask
+#define CAN_FILTER_MASK32(bank, id, mask)             { bank, CAN_SCALE_32, CAN_MODE_MASK, { id, mask } }
+
+/// filter bank with 2x 32-bit identifier list
+#define CAN_FILTER_LIST32(bank, id1, id2)             { bank, CAN_SCALE_32, CAN_MODE_LIST, { id1, id2 } }
+
+/// filter bank with 2x 16-bit identifier + mask
+#define CAN_FILTER_MASK16(bank, id1, mask1, id2, mask2) { bank, CAN_SCALE_16, CAN_MODE_MASK, { id1, mask1, id2, mask2 } }
+
+/// filter bank with 4x 16-bit identifier list
+#define CAN_FILTER_LIST16(bank, id1, id2, id3, id4)   { bank, CAN_SCALE_16, CAN_MODE_LIST, { id1, id2, id3, id4 } }
+
+// default: accept all frames
+#ifndef CAN_FILTERS
+  #define CAN_FILTERS           { CAN_FILTER_MASK32(0, CAN_ID32_STD(0), CAN_ID32_STD(0)) }
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// CAN frame
+typedef struct {
+  uint32_t    id;           ///< identifier incl. flags CAN_EXT and CAN_RTR
+  uint8_t     dlc;          ///< data length 0..8
+  uint8_t     data[8];      ///< data bytes
+  uint8_t     fmi;          ///< Rx: filter match index
+} can_msg_t;
+
+/// acceptance filter bank, see CAN_FILTER_xxx()
+typedef struct {
+  uint8_t     bank;         ///< filter bank 0..5
+  uint8_t     scale;        ///< CAN_SCALE_xxx
+  uint8_t     mode;         ///< CAN_MODE_xxx
+  uint8_t     fr[8];        ///< filter registers FxR1..FxR8
+} can_filter_t;
+
+/// error status and statistics
+typedef struct {
+  uint8_t     tec;          ///< transmit error counter
+  uint8_t     rec;          ///< receive error counter
+  uint8_t     esr;          ///< error status register (EWGF, EPVF, BOFF, LEC)
+  uint8_t     busOff;       ///< number of bus-off events
+  uint16_t    rxOverrun;    ///< frames lost in HW FIFO or SW ring
+  uint16_t    txError;      ///< failed transmissions (arbitration lost or error)
+} can_status_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// initialize beCAN with baudrate [Baud] and filter table. Returns 0 on error
+uint8_t CAN_begin(uint32_t baud);
+
+/// queue frame for transmission. Returns 0 if queue is full
+uint8_t CAN_send(const can_msg_t *msg);
+
+/// get number of free slots in Tx queue
+uint8_t CAN_txFree(void);
+
+/// get number of frames in Rx ring
+uint8_t CAN_available(void);
+
+/// get oldest received frame. Returns 0 if ring is empty
+uint8_t CAN_read(can_msg_t *msg);
+
+/// get error counters and statistics
+void CAN_status(can_status_t *status);
+
+/// ISR for CAN receive (FIFO message pending, full, overrun)
+ISR_HANDLER(CAN_RX_ISR, _CAN_FMP_VECTOR_);
+
+/// ISR for CAN transmit (request completed) and errors
+ISR_HANDLER(CAN_TX_ISR, _CAN_RQCP0_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CAN_H_
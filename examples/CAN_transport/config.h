@@ -0,0 +1,66 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define NUCLEO_8S208RB
+//#define STM8AF_ECU
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(NUCLEO_8S208RB)
+  #include "../../include/STM8S208RB.h"
+  #define CAN_LOOPBACK    1             // no CAN transceiver -> silent loopback mode
+#elif defined(STM8AF_ECU)
+  #include "../../include/STM8AF5288.h"
+  #define CAN_LOOPBACK    0             // CAN_TX=PG0, CAN_RX=PG1 via transceiver
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    CAN CONFIGURATION
+----------------------------------------------------------*/
+
+// CAN clock = fMaster [Hz]. Note: for a real bus use a crystal (HSE)
+#define CAN_CLOCK         16000000L
+
+// Rx ring must hold at least one ISO-TP block (ISOTP_BS) plus PDOs
+#define CAN_RX_QUEUE      16
+
+// acceptance filters, see can.h. Only ISO-TP and PDO identifiers pass
+//   - bank 0: ISO-TP 0x7E0 (request), 0x7E8 (response), RPDO 0x181, 0x201
+#define CAN_FILTERS       { \
+  CAN_FILTER_LIST16(0, CAN_ID16_STD(0x7E0), CAN_ID16_STD(0x7E8), CAN_ID16_STD(0x181), CAN_ID16_STD(0x201)) \
+}
+
+
+/*----------------------------------------------------------
+    TRANSPORT CONFIGURATION
+----------------------------------------------------------*/
+
+// ISO-TP flow control sent by receiver: block size [frames] (0=unlimited) and STmin [ms]
+#define ISOTP_BS          8
+#define ISOTP_STMIN       0
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
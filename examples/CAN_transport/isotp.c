@@ -0,0 +1,468 @@
+/**
+  \file isotp.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of ISO-TP (ISO 15765-2) transport on beCAN
+
+  implementation of segmentation, reassembly and flow control for ISO-TP
+  channels. Frame types are given by the upper nibble of the first data
+  byte (PCI):
+    - 0x0: single frame, length 1..7 in lower nibble
+    - 0x1: first frame, 12-bit length in lower nibble and second byte
+    - 0x2: consecutive frame, sequence number 0..15 in lower nibble
+    - 0x3: flow control, status in lower nibble, block size, STmin
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "isotp.h"
+#include "timer4.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// frame types (PCI upper nibble)
+#define PCI_SF              0x00      ///< single frame
+#define PCI_FF              0x10      ///< first frame
+#define PCI_CF              0x20      ///< consecutive frame
+#define PCI_FC              0x30      ///< flow control
+
+// flow status (FC lower nibble)
+#define FS_CTS              0x00      ///< continue to send
+#define FS_WAIT             0x01      ///< wait for next flow control
+#define FS_OVFLW            0x02      ///< overflow, abort
+
+// reception states
+#define RX_IDLE             0         ///< no message
+#define RX_BUSY             1         ///< receiving consecutive frames
+#define RX_READY            2         ///< message complete, buffer not released
+
+// transmission states
+#define TX_IDLE             0         ///< no message
+#define TX_WAIT_FC          1         ///< wait for flow control
+#define TX_SENDING          2         ///< sending consecutive frames
+
+// check settings (negative array size on error)
+typedef char isotp_check_bs[(ISOTP_BS <= 0xFF) ? 1 : -1];
+typedef char isotp_check_stmin[(ISOTP_STMIN <= 0x7F) ? 1 : -1];
+
+
+
+/**
+  \fn static uint8_t sendFrame(const isotp_t *ch, uint8_t pci, const uint8_t *data, uint8_t len)
+
+  \brief queue single CAN frame
+
+  \param[in]  ch      ISO-TP channel
+  \param[in]  pci     first data byte (PCI)
+  \param[in]  data    payload after PCI
+  \param[in]  len     payload length 0..7
+
+  \return 1 on success, 0 if CAN Tx queue is full
+
+  frame is padded to 8 bytes with ISOTP_PADDING.
+*/
+static uint8_t sendFrame(const isotp_t *ch, uint8_t pci, const uint8_t *data, uint8_t len) {
+
+  can_msg_t   msg;
+  uint8_t     i;
+
+  msg.id      = ch->txId;
+  msg.dlc     = 8;
+  msg.data[0] = pci;
+  for (i=0; i<7; i++)
+    msg.data[i+1] = (i < len) ? data[i] : ISOTP_PADDING;
+
+  return(CAN_send(&msg));
+
+} // sendFrame
+
+
+
+/**
+  \fn static void sendFlowControl(const isotp_t *ch, uint8_t status)
+
+  \brief send flow control with ISOTP_BS and ISOTP_STMIN
+
+  \param[in]  ch      ISO-TP channel
+  \param[in]  status  flow status FS_xxx
+*/
+static void sendFlowControl(const isotp_t *ch, uint8_t status) {
+
+  uint8_t   fc[2] = { ISOTP_BS, ISOTP_STMIN };
+
+  // if Tx queue is full the sender runs into N_Bs timeout
+  sendFrame(ch, PCI_FC | status, fc, 2);
+
+} // sendFlowControl
+
+
+
+/**
+  \fn void ISOTP_init(isotp_t *ch)
+
+  \brief reset channel state
+
+  \param[in]  ch      ISO-TP channel, configured via ISOTP_CHANNEL()
+
+  abort ongoing transfers and release receive buffer.
+*/
+void ISOTP_init(isotp_t *ch) {
+
+  ch->rxState = RX_IDLE;
+  ch->txState = TX_IDLE;
+  ch->error   = ISOTP_ERR_NONE;
+
+} // ISOTP_init
+
+
+
+/**
+  \fn uint8_t ISOTP_send(isotp_t *ch, const uint8_t *data, uint16_t len)
+
+  \brief start sending message
+
+  \param[in]  ch      ISO-TP channel
+  \param[in]  data    message data
+  \param[in]  len     message length 1..4095 [B]
+
+  \return 1 on success, 0 if channel is busy, length is invalid or CAN Tx queue is full
+
+  messages up to 7 bytes are sent as single frame. Longer messages are sent
+  as first frame, followed by consecutive frames in ISOTP_task() after flow
+  control was received. Data is not copied, i.e. it must not be changed
+  until ISOTP_txBusy() returns 0.
+*/
+uint8_t ISOTP_send(isotp_t *ch, const uint8_t *data, uint16_t len) {
+
+  uint8_t   ff[7], i;
+
+  // check state and length
+  if ((ch->txState != TX_IDLE) || (len == 0) || (len > ISOTP_MAX_LEN))
+    return(0);
+
+  // single frame
+  if (len <= 7)
+    return(sendFrame(ch, PCI_SF | (uint8_t) len, data, (uint8_t) len));
+
+  // first frame with 12-bit length and first 6 bytes
+  ff[0] = (uint8_t) len;
+  for (i=0; i<6; i++)
+    ff[i+1] = data[i];
+  if (!sendFrame(ch, PCI_FF | (uint8_t) (len >> 8), ff, 7))
+    return(0);
+
+  // wait for flow control
+  ch->txData  = data;
+  ch->txLen   = len;
+  ch->txPos   = 6;
+  ch->txSn    = 1;
+  ch->txTime  = millis();
+  ch->txState = TX_WAIT_FC;
+
+  return(1);
+
+} // ISOTP_send
+
+
+
+/**
+  \fn uint8_t ISOTP_txBusy(const isotp_t *ch)
+
+  \brief check if message transmission is ongoing
+
+  \param[in]  ch      ISO-TP channel
+
+  \return 1 if sending, 0 if idle, i.e. data buffer may be reused
+*/
+uint8_t ISOTP_txBusy(const isotp_t *ch) {
+
+  return(ch->txState != TX_IDLE);
+
+} // ISOTP_txBusy
+
+
+
+/**
+  \fn static void handleFlowControl(isotp_t *ch, const can_msg_t *msg)
+
+  \brief process received flow control
+
+  \param[in]  ch      ISO-TP channel
+  \param[in]  msg     received CAN frame
+*/
+static void handleFlowControl(isotp_t *ch, const can_msg_t *msg) {
+
+  uint8_t   stmin;
+
+  // ignore unexpected flow control
+  if ((ch->txState == TX_IDLE) || (msg->dlc < 3))
+    return;
+
+  switch (msg->data[0] & 0x0F) {
+
+    // continue to send: start block. First CF is sent without delay
+    case FS_CTS:
+      ch->txBlock = msg->data[1];
+      stmin = msg->data[2];
+      if ((stmin >= 0xF1) && (stmin <= 0xF9))   // 100-900us -> 1ms tick
+        stmin = 1;
+      else if (stmin > 0x7F)                    // reserved -> max. value
+        stmin = 0x7F;
+      ch->txStmin = stmin;
+      ch->txTime  = millis() - stmin - 1;
+      ch->txState = TX_SENDING;
+      break;
+
+    // wait: restart N_Bs timeout
+    case FS_WAIT:
+      ch->txTime = millis();
+      break;
+
+    // overflow or invalid status: abort
+    default:
+      ch->txState = TX_IDLE;
+      ch->error   = ISOTP_ERR_OVERFLOW;
+
+  } // switch (FS)
+
+} // handleFlowControl
+
+
+
+/**
+  \fn uint8_t ISOTP_handle(isotp_t *ch, const can_msg_t *msg)
+
+  \brief process received CAN frame
+
+  \param[in]  ch      ISO-TP channel
+  \param[in]  msg     received CAN frame, e.g. from CAN_read()
+
+  \return 1 if frame belongs to channel, else 0
+
+  reassemble single, first and consecutive frames in the receive buffer and
+  send flow control. Flow control frames are passed to the sender.
+*/
+uint8_t ISOTP_handle(isotp_t *ch, const can_msg_t *msg) {
+
+  uint8_t   pci, len, i;
+  uint16_t  size;
+
+  // check identifier
+  if ((msg->id != ch->rxId) || (msg->dlc == 0))
+    return(0);
+  pci = msg->data[0];
+
+  switch (pci & 0xF0) {
+
+    // single frame
+    case PCI_SF:
+      len = pci & 0x0F;
+      if ((len == 0) || (len > 7) || (len >= msg->dlc))
+        break;
+      if ((ch->rxState == RX_READY) || (len > ch->rxSize)) {
+        ch->error = ISOTP_ERR_OVERFLOW;
+        break;
+      }
+      if (ch->rxState == RX_BUSY)
+        ch->error = ISOTP_ERR_ABORT;
+      for (i=0; i<len; i++)
+        ch->rxBuf[i] = msg->data[i+1];
+      ch->rxLen   = len;
+      ch->rxState = RX_READY;
+      break;
+
+    // first frame: check size, then copy and send flow control
+    case PCI_FF:
+      size = ((uint16_t) (pci & 0x0F) << 8) | msg->data[1];
+      if ((size < 8) || (msg->dlc < 8))
+        break;
+      if ((ch->rxState == RX_READY) || (size > ch->rxSize)) {
+        ch->error = ISOTP_ERR_OVERFLOW;
+        sendFlowControl(ch, FS_OVFLW);
+        break;
+      }
+      if (ch->rxState == RX_BUSY)
+        ch->error = ISOTP_ERR_ABORT;
+      for (i=0; i<6; i++)
+        ch->rxBuf[i] = msg->data[i+2];
+      ch->rxLen   = size;
+      ch->rxPos   = 6;
+      ch->rxSn    = 1;
+      ch->rxBlock = 0;
+      ch->rxTime  = millis();
+      ch->rxState = RX_BUSY;
+      sendFlowControl(ch, FS_CTS);
+      break;
+
+    // consecutive frame: check sequence, copy directly to buffer
+    case PCI_CF:
+      if (ch->rxState != RX_BUSY)
+        break;
+      if ((pci & 0x0F) != ch->rxSn) {
+        ch->error   = ISOTP_ERR_SEQUENCE;
+        ch->rxState = RX_IDLE;
+        break;
+      }
+      len = (ch->rxLen - ch->rxPos > 7) ? 7 : (uint8_t) (ch->rxLen - ch->rxPos);
+      if (len >= msg->dlc)
+        break;
+      for (i=0; i<len; i++)
+        ch->rxBuf[ch->rxPos++] = msg->data[i+1];
+      ch->rxSn   = (ch->rxSn + 1) & 0x0F;
+      ch->rxTime = millis();
+
+      // message complete
+      if (ch->rxPos >= ch->rxLen)
+        ch->rxState = RX_READY;
+
+      // end of block: request next block
+      else if ((ISOTP_BS != 0) && (++(ch->rxBlock) >= ISOTP_BS)) {
+        ch->rxBlock = 0;
+        sendFlowControl(ch, FS_CTS);
+      }
+      break;
+
+    // flow control for own transmission
+    case PCI_FC:
+      handleFlowControl(ch, msg);
+      break;
+
+    // ignore unknown frame types
+    default:
+      break;
+
+  } // switch (PCI)
+
+  return(1);
+
+} // ISOTP_handle
+
+
+
+/**
+  \fn void ISOTP_task(isotp_t *ch)
+
+  \brief send pending consecutive frames and check timeouts
+
+  \param[in]  ch      ISO-TP channel
+
+  send consecutive frames as long as STmin and block size allow and the
+  CAN Tx queue has space. Call as often as possible for max. throughput.
+*/
+void ISOTP_task(isotp_t *ch) {
+
+  uint8_t   len;
+
+  // reception timeout (N_Cr)
+  if ((ch->rxState == RX_BUSY) && ((uint32_t) (millis() - ch->rxTime) > ISOTP_TIMEOUT)) {
+    ch->rxState = RX_IDLE;
+    ch->error   = ISOTP_ERR_TIMEOUT_CR;
+  }
+
+  // flow control timeout (N_Bs)
+  if ((ch->txState == TX_WAIT_FC) && ((uint32_t) (millis() - ch->txTime) > ISOTP_TIMEOUT)) {
+    ch->txState = TX_IDLE;
+    ch->error   = ISOTP_ERR_TIMEOUT_BS;
+  }
+
+  // send consecutive frames
+  while (ch->txState == TX_SENDING) {
+
+    // wait for STmin. With 1ms tick, >STmin ticks guarantee >=STmin ms
+    if ((ch->txStmin) && ((uint32_t) (millis() - ch->txTime) <= ch->txStmin))
+      return;
+
+    // send next frame, retry later if CAN Tx queue is full
+    len = (ch->txLen - ch->txPos > 7) ? 7 : (uint8_t) (ch->txLen - ch->txPos);
+    if (!sendFrame(ch, PCI_CF | ch->txSn, ch->txData + ch->txPos, len))
+      return;
+    ch->txPos += len;
+    ch->txSn   = (ch->txSn + 1) & 0x0F;
+    ch->txTime = millis();
+
+    // message complete
+    if (ch->txPos >= ch->txLen)
+      ch->txState = TX_IDLE;
+
+    // end of block: wait for next flow control
+    else if ((ch->txBlock != 0) && (--(ch->txBlock) == 0))
+      ch->txState = TX_WAIT_FC;
+
+  } // while sending
+
+} // ISOTP_task
+
+
+
+/**
+  \fn uint16_t ISOTP_available(const isotp_t *ch)
+
+  \brief get length of received message
+
+  \param[in]  ch      ISO-TP channel
+
+  \return message length [B] in ch->rxBuf, or 0 if no complete message
+
+  the message is accessed in place in ch->rxBuf, i.e. without copying. The
+  buffer is locked until ISOTP_release() is called.
+*/
+uint16_t ISOTP_available(const isotp_t *ch) {
+
+  if (ch->rxState != RX_READY)
+    return(0);
+
+  return(ch->rxLen);
+
+} // ISOTP_available
+
+
+
+/**
+  \fn void ISOTP_release(isotp_t *ch)
+
+  \brief release receive buffer
+
+  \param[in]  ch      ISO-TP channel
+
+  until release, new messages are rejected with flow status overflow.
+*/
+void ISOTP_release(isotp_t *ch) {
+
+  if (ch->rxState == RX_READY)
+    ch->rxState = RX_IDLE;
+
+} // ISOTP_release
+
+
+
+/**
+  \fn uint8_t ISOTP_error(isotp_t *ch)
+
+  \brief get and clear last error
+
+  \param[in]  ch      ISO-TP channel
+
+  \return last error, see ISOTP_ERR_xxx
+*/
+uint8_t ISOTP_error(isotp_t *ch) {
+
+  uint8_t   error = ch->error;
+
+  ch->error = ISOTP_ERR_NONE;
+
+  return(error);
+
+} // ISOTP_error
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,152 @@
+/**
+  \file isotp.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of ISO-TP (ISO 15765-2) transport on beCAN
+
+  declaration of a transport layer for messages up to 4095 bytes over CAN,
+  e.g. for diagnostics and parameter download. Features:
+    - segmentation into single, first and consecutive frames, and
+      reassembly with sequence number check
+    - flow control with configurable block size and STmin, see ISOTP_BS
+      and ISOTP_STMIN. Received flow control (CTS, WAIT, OVFLW) is obeyed
+    - zero-copy: consecutive frames are reassembled directly in the
+      receive buffer of the channel, which is accessed in place by the
+      application. Send data is read directly from the application buffer
+    - multiple independent channels, each with own Tx/Rx identifiers
+    - N_Bs and N_Cr timeouts
+
+  \note
+  - the application polls CAN_read() and passes frames to ISOTP_handle(),
+    and calls ISOTP_task() periodically for sending and timeouts
+  - timing is based on the 1ms tick, i.e. STmin 100-900us is rounded up to 1ms
+  - frames are always padded to 8 bytes with ISOTP_PADDING
+  - only normal addressing, i.e. no extended or mixed addressing
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _ISOTP_H_
+#define _ISOTP_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "can.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// block size sent in flow control [frames], 0=unlimited. Default can be overwritten in config.h
+#ifndef ISOTP_BS
+  #define ISOTP_BS              8
+#endif
+
+// minimum separation time sent in flow control [ms]. Default can be overwritten in config.h
+#ifndef ISOTP_STMIN
+  #define ISOTP_STMIN           0
+#endif
+
+// timeout for flow control (N_Bs) and consecutive frame (N_Cr) [ms]. Default can be overwritten in config.h
+#ifndef ISOTP_TIMEOUT
+  #define ISOTP_TIMEOUT         1000
+#endif
+
+// padding byte for unused frame data. Default can be overwritten in config.h
+#ifndef ISOTP_PADDING
+  #define ISOTP_PADDING         0xCC
+#endif
+
+/// max. message length [B]
+#define ISOTP_MAX_LEN           4095
+
+// error codes, see ISOTP_error()
+#define ISOTP_ERR_NONE          0     ///< no error
+#define ISOTP_ERR_TIMEOUT_BS    1     ///< no flow control received (N_Bs)
+#define ISOTP_ERR_TIMEOUT_CR    2     ///< no consecutive frame received (N_Cr)
+#define ISOTP_ERR_SEQUENCE      3     ///< wrong sequence number
+#define ISOTP_ERR_OVERFLOW      4     ///< message too long or receive buffer not released
+#define ISOTP_ERR_ABORT         5     ///< reception aborted by new first or single frame
+
+/// static initializer for channel with Tx/Rx identifier and receive buffer array. Internal members are zeroed
+#define ISOTP_CHANNEL(txId, rxId, buf)    { txId, rxId, buf, sizeof(buf), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// ISO-TP channel. Initialize with ISOTP_CHANNEL(), remaining members are internal
+typedef struct {
+
+  // configuration
+  uint32_t        txId;       ///< identifier for sending incl. CAN_EXT
+  uint32_t        rxId;       ///< identifier for receiving incl. CAN_EXT
+  uint8_t         *rxBuf;     ///< reassembly buffer
+  uint16_t        rxSize;     ///< size of reassembly buffer [B]
+
+  // reception
+  uint8_t         rxState;    ///< idle, receiving or message ready
+  uint16_t        rxLen;      ///< message length [B]
+  uint16_t        rxPos;      ///< bytes received
+  uint8_t         rxSn;       ///< expected sequence number
+  uint8_t         rxBlock;    ///< frames received in current block
+  uint32_t        rxTime;     ///< time of last frame [ms]
+
+  // transmission
+  uint8_t         txState;    ///< idle, wait for flow control or sending
+  const uint8_t   *txData;    ///< message data (not copied)
+  uint16_t        txLen;      ///< message length [B]
+  uint16_t        txPos;      ///< bytes sent
+  uint8_t         txSn;       ///< next sequence number
+  uint8_t         txBlock;    ///< remaining frames in block, 0=unlimited
+  uint8_t         txStmin;    ///< separation time [ms ticks]
+  uint32_t        txTime;     ///< time of last frame [ms]
+
+  uint8_t         error;      ///< last error, see ISOTP_ERR_xxx
+
+} isotp_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// reset channel state
+void ISOTP_init(isotp_t *ch);
+
+/// start sending message. Data must be kept until ISOTP_txBusy() returns 0. Returns 0 on error
+uint8_t ISOTP_send(isotp_t *ch, const uint8_t *data, uint16_t len);
+
+/// check if message transmission is ongoing
+uint8_t ISOTP_txBusy(const isotp_t *ch);
+
+/// process received CAN frame. Returns 1 if frame belongs to channel
+uint8_t ISOTP_handle(isotp_t *ch, const can_msg_t *msg);
+
+/// send pending consecutive frames and check timeouts. Call periodically
+void ISOTP_task(isotp_t *ch);
+
+/// get length of received message in ch->rxBuf, 0 if none
+uint16_t ISOTP_available(const isotp_t *ch);
+
+/// release receive buffer for next message
+void ISOTP_release(isotp_t *ch);
+
+/// get and clear last error, see ISOTP_ERR_xxx
+uint8_t ISOTP_error(isotp_t *ch);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _ISOTP_H_
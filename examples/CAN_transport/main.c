@@ -0,0 +1,220 @@
+/**********************
+  ISO-TP transport and PDO-style cyclic process data on beCAN
+
+  supported hardware:
+    - Nucleo-8S208RB (https://www.st.com/en/evaluation-tools/nucleo-8s208rb.html), silent loopback
+    - STM8AF52xx ECU with CAN transceiver on PG0/PG1
+
+  Functionality:
+    - ISO-TP server on 0x7E0 (request) / 0x7E8 (response) echoes received
+      messages. The response is sent directly from the receive buffer (zero-copy)
+    - in loopback mode, an ISO-TP client on the same node sends messages of
+      varying length (8..255B) to the server and checks the echo
+    - transmit PDO 0x181 with counter every 100ms. Receive PDO 0x181 (loopback)
+      or 0x201 (ECU) with timeout monitoring
+    - every 1s print transfer statistics via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "can.h"
+  #include "isotp.h"
+  #include "pdo.h"
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// CAN baudrate [Baud]
+#define CAN_BAUD        500000L
+
+// identifier of receive PDO
+#if (CAN_LOOPBACK)
+  #define RPDO_ID       0x181
+#else
+  #define RPDO_ID       0x201
+#endif
+
+
+/*----------------------------------------------------------
+    GLOBAL VARIABLES
+----------------------------------------------------------*/
+
+// ISO-TP reassembly buffers
+uint8_t   serverBuf[256];
+uint8_t   clientBuf[256];
+uint8_t   clientTx[255];
+
+// process data mapped to PDOs
+struct {
+  uint16_t  counter;
+  uint16_t  errors;
+} txData, rxData;
+
+// PDO tables
+pdo_t     tpdo[] = { PDO_ENTRY(0x181, 100, txData) };
+pdo_t     rpdo[] = { PDO_ENTRY(RPDO_ID, 500, rxData) };
+
+// ISO-TP channels
+isotp_t   server = ISOTP_CHANNEL(0x7E8, 0x7E0, serverBuf);
+isotp_t   client = ISOTP_CHANNEL(0x7E0, 0x7E8, clientBuf);
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  can_msg_t   msg;
+  uint32_t    nextPrint = 1000;
+  uint16_t    len, i, clientLen = 0;
+  uint16_t    numOk = 0, numBad = 0, numBytes = 0, numRpdo = 0;
+  uint8_t     echoing = 0, waiting = 0, seq = 0, err;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init UART for 115.2kBaud
+  UART_begin(115200);
+
+  // init 1ms tick
+  TIM4_init();
+
+  // init CAN
+  if (!CAN_begin(CAN_BAUD))
+    printf("CAN init failed\n");
+
+  // init transport
+  ISOTP_init(&server);
+  ISOTP_init(&client);
+  PDO_begin(tpdo, sizeof(tpdo)/sizeof(pdo_t), rpdo, sizeof(rpdo)/sizeof(pdo_t));
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // dispatch received frames
+    while (CAN_read(&msg)) {
+      if (ISOTP_handle(&server, &msg))
+        continue;
+      if (ISOTP_handle(&client, &msg))
+        continue;
+      PDO_handle(&msg);
+    }
+
+    // send pending frames and check timeouts
+    ISOTP_task(&server);
+    ISOTP_task(&client);
+    PDO_task();
+
+    // server: echo request directly from receive buffer, release after sending
+    len = ISOTP_available(&server);
+    if ((len) && (!echoing)) {
+      if (ISOTP_send(&server, server.rxBuf, len))
+        echoing = 1;
+    }
+    if ((echoing) && (!ISOTP_txBusy(&server))) {
+      ISOTP_release(&server);
+      echoing = 0;
+    }
+    if ((err = ISOTP_error(&server)))
+      printf("server error %u\n", (uint16_t) err);
+
+    // client: send next request after echo was received (loopback only)
+    #if (CAN_LOOPBACK)
+      if (!waiting) {
+        clientLen = 8 + (seq % 248);
+        for (i=0; i<clientLen; i++)
+          clientTx[i] = seq + (uint8_t) i;
+        if (ISOTP_send(&client, clientTx, clientLen)) {
+          waiting = 1;
+          seq++;
+        }
+      }
+      len = ISOTP_available(&client);
+      if (len) {
+        for (i=0; (i<len) && (client.rxBuf[i] == clientTx[i]); i++);
+        if ((len == clientLen) && (i == len)) {
+          numOk++;
+          numBytes += len;
+        }
+        else
+          numBad++;
+        ISOTP_release(&client);
+        waiting = 0;
+      }
+      if ((err = ISOTP_error(&client))) {
+        printf("client error %u\n", (uint16_t) err);
+        numBad++;
+        waiting = 0;
+      }
+    #endif // CAN_LOOPBACK
+
+    // update transmitted process data
+    txData.counter++;
+    txData.errors = numBad;
+
+    // count received process data
+    if (PDO_received(0))
+      numRpdo++;
+
+    // every 1s print statistics
+    if ((int32_t) (millis() - nextPrint) >= 0) {
+      nextPrint += 1000;
+      printf("echo ok %u, bad %u, %u B/s, RPDO %u/s, counter %u, timeout %u\n",
+        numOk, numBad, numBytes, numRpdo, rxData.counter, (uint16_t) PDO_timeout(0));
+      numOk    = 0;
+      numBytes = 0;
+      numRpdo  = 0;
+    }
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
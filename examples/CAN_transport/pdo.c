@@ -0,0 +1,219 @@
+/**
+  \file pdo.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of PDO-style cyclic process data on beCAN
+
+  implementation of cyclic transmission and reception of process data
+  mapped to application variables.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "pdo.h"
+#include "timer4.h"
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+static pdo_t      *m_tx;          ///< transmit PDO table
+static pdo_t      *m_rx;          ///< receive PDO table
+static uint8_t    m_numTx;        ///< number of transmit PDOs
+static uint8_t    m_numRx;        ///< number of receive PDOs
+
+
+
+/**
+  \fn void PDO_begin(pdo_t *tx, uint8_t numTx, pdo_t *rx, uint8_t numRx)
+
+  \brief set PDO tables
+
+  \param[in]  tx      transmit PDO table, see PDO_ENTRY()
+  \param[in]  numTx   number of transmit PDOs
+  \param[in]  rx      receive PDO table, see PDO_ENTRY()
+  \param[in]  numRx   number of receive PDOs
+
+  all transmit PDOs are sent on next PDO_task(). Receive timeouts start now.
+*/
+void PDO_begin(pdo_t *tx, uint8_t numTx, pdo_t *rx, uint8_t numRx) {
+
+  uint8_t   i;
+
+  m_tx    = tx;
+  m_numTx = numTx;
+  m_rx    = rx;
+  m_numRx = numRx;
+
+  for (i=0; i<numTx; i++) {
+    if (tx[i].len > 8)
+      tx[i].len = 8;
+    tx[i].flags = PDO_NEW;
+  }
+  for (i=0; i<numRx; i++) {
+    if (rx[i].len > 8)
+      rx[i].len = 8;
+    rx[i].flags = 0;
+    rx[i].time  = millis();
+  }
+
+} // PDO_begin
+
+
+
+/**
+  \fn void PDO_task(void)
+
+  \brief send due transmit PDOs and check receive timeouts
+
+  a transmit PDO is sent if its period has elapsed or it was triggered. If
+  the CAN Tx queue is full it is sent on the next call. The data is copied
+  from the mapped variable on sending, i.e. the latest value is sent.
+*/
+void PDO_task(void) {
+
+  can_msg_t   msg;
+  pdo_t       *pdo;
+  uint8_t     i, j;
+
+  // transmit PDOs
+  for (i=0; i<m_numTx; i++) {
+    pdo = &(m_tx[i]);
+    if ((pdo->period) && ((uint32_t) (millis() - pdo->time) >= pdo->period))
+      pdo->flags |= PDO_NEW;
+    if (!(pdo->flags & PDO_NEW))
+      continue;
+
+    // copy mapped variable and send
+    msg.id  = pdo->id;
+    msg.dlc = pdo->len;
+    for (j=0; j<pdo->len; j++)
+      msg.data[j] = pdo->data[j];
+    if (!CAN_send(&msg))
+      return;
+
+    // next cycle relative to last, resync after long delay
+    pdo->flags &= ~PDO_NEW;
+    if ((pdo->period) && ((uint32_t) (millis() - pdo->time) < 2*pdo->period))
+      pdo->time += pdo->period;
+    else
+      pdo->time = millis();
+  }
+
+  // receive timeouts
+  for (i=0; i<m_numRx; i++) {
+    pdo = &(m_rx[i]);
+    if ((pdo->period) && ((uint32_t) (millis() - pdo->time) > pdo->period))
+      pdo->flags |= PDO_TIMEOUT;
+  }
+
+} // PDO_task
+
+
+
+/**
+  \fn uint8_t PDO_handle(const can_msg_t *msg)
+
+  \brief process received CAN frame
+
+  \param[in]  msg     received CAN frame, e.g. from CAN_read()
+
+  \return 1 if frame is a receive PDO, else 0
+
+  copy data to mapped variable and set new data flag. Frames shorter than
+  the mapped variable are ignored.
+*/
+uint8_t PDO_handle(const can_msg_t *msg) {
+
+  pdo_t     *pdo;
+  uint8_t   i, j;
+
+  for (i=0; i<m_numRx; i++) {
+    pdo = &(m_rx[i]);
+    if (msg->id != pdo->id)
+      continue;
+
+    // copy to mapped variable
+    if (msg->dlc >= pdo->len) {
+      for (j=0; j<pdo->len; j++)
+        pdo->data[j] = msg->data[j];
+      pdo->flags = PDO_NEW;
+      pdo->time  = millis();
+    }
+    return(1);
+  }
+
+  return(0);
+
+} // PDO_handle
+
+
+
+/**
+  \fn void PDO_trigger(uint8_t idx)
+
+  \brief request sending transmit PDO
+
+  \param[in]  idx     index in transmit PDO table
+
+  PDO is sent on next PDO_task(), e.g. on change of mapped variable.
+*/
+void PDO_trigger(uint8_t idx) {
+
+  if (idx < m_numTx)
+    m_tx[idx].flags |= PDO_NEW;
+
+} // PDO_trigger
+
+
+
+/**
+  \fn uint8_t PDO_received(uint8_t idx)
+
+  \brief check and clear new data flag of receive PDO
+
+  \param[in]  idx     index in receive PDO table
+
+  \return 1 if new data was received since last call, else 0
+*/
+uint8_t PDO_received(uint8_t idx) {
+
+  if ((idx >= m_numRx) || (!(m_rx[idx].flags & PDO_NEW)))
+    return(0);
+
+  m_rx[idx].flags &= ~PDO_NEW;
+
+  return(1);
+
+} // PDO_received
+
+
+
+/**
+  \fn uint8_t PDO_timeout(uint8_t idx)
+
+  \brief check if receive PDO timed out
+
+  \param[in]  idx     index in receive PDO table
+
+  \return 1 if not received within period, else 0. Cleared on next reception
+*/
+uint8_t PDO_timeout(uint8_t idx) {
+
+  if (idx >= m_numRx)
+    return(0);
+
+  return((m_rx[idx].flags & PDO_TIMEOUT) ? 1 : 0);
+
+} // PDO_timeout
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,91 @@
+/**
+  \file pdo.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of PDO-style cyclic process data on beCAN
+
+  declaration of a CANopen-like process data exchange. Each PDO maps one
+  variable (max. 8 bytes) to a CAN identifier. Features:
+    - transmit PDOs are sent cyclically and/or on request via PDO_trigger()
+    - receive PDOs are copied directly into the mapped variable, with
+      new-data flag and timeout monitoring
+    - PDO tables are defined by the application via PDO_ENTRY()
+
+  \note
+  - no SDO, NMT, SYNC or dynamic mapping, i.e. only the process data part of CANopen
+  - mapped variables are accessed from main loop only, i.e. no locking required
+  - byte order of mapped variables is that of the CPU (big endian)
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _PDO_H_
+#define _PDO_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "can.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+/// PDO table entry with identifier, period [ms] and mapped variable (max. 8 bytes)
+#define PDO_ENTRY(id, period, var)    { id, period, (uint8_t*) &(var), sizeof(var), 0, 0 }
+
+// PDO flags
+#define PDO_NEW                 0x01      ///< RPDO: new data received. TPDO: send on next PDO_task()
+#define PDO_TIMEOUT             0x02      ///< RPDO: not received within period
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// PDO table entry. Initialize with PDO_ENTRY(), remaining members are internal
+typedef struct {
+  uint32_t    id;           ///< identifier incl. CAN_EXT
+  uint16_t    period;       ///< TPDO: cycle time, RPDO: timeout [ms]. 0=event only / no timeout
+  uint8_t     *data;        ///< mapped variable
+  uint8_t     len;          ///< length of mapped variable 0..8 [B]
+  uint8_t     flags;        ///< PDO_NEW, PDO_TIMEOUT
+  uint32_t    time;         ///< time of last Tx/Rx [ms]
+} pdo_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// set transmit and receive PDO tables. Tables must be kept
+void PDO_begin(pdo_t *tx, uint8_t numTx, pdo_t *rx, uint8_t numRx);
+
+/// send due transmit PDOs and check receive timeouts. Call periodically
+void PDO_task(void);
+
+/// process received CAN frame. Returns 1 if frame is a receive PDO
+uint8_t PDO_handle(const can_msg_t *msg);
+
+/// request sending transmit PDO on next PDO_task()
+void PDO_trigger(uint8_t idx);
+
+/// check and clear new data flag of receive PDO
+uint8_t PDO_received(uint8_t idx);
+
+/// check if receive PDO timed out
+uint8_t PDO_timeout(uint8_t idx);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _PDO_H_
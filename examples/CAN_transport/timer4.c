@@ -0,0 +1,106 @@
+/**
+  \file timer4.c
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief implementation of timer TIM4 (1ms clock) functions/macros
+   
+  implementation of timer TIM4 functions as 1ms master clock (fMaster=16MHz).
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "timer4.h"
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void TIM4_init(void)
+   
+  \brief init timer 4 for 1ms master clock with interrupt
+   
+  init 8-bit timer TIM4 with 1ms tick. Is used for SW master clock
+  via below interrupt.
+*/
+void TIM4_init(void) {
+
+  // for low-power device activate TIM4 clock
+  #if defined(FAMILY_STM8L)
+    sfr_CLK.PCKENR1.PCKEN12 = 1;
+  #endif
+   
+  // stop the timer
+  sfr_TIM4.CR1.CEN = 0;
+  
+  // initialize global clock variables
+  g_flagMilli = 0;
+  g_millis    = 0;
+  
+  // clear counter
+  sfr_TIM4.CNTR.byte = 0x00;
+
+  // auto-reload value buffered
+  sfr_TIM4.CR1.ARPE = 1;
+
+  // clear pending events
+  sfr_TIM4.EGR.byte  = 0x00;
+
+  // set clock to 16Mhz/2^7 = 125kHz -> 8us period
+  sfr_TIM4.PSCR.PSC = 7;
+
+  // set autoreload value for 1ms (=125*8us). Period is ARR+1
+  sfr_TIM4.ARR.byte  = 124;
+
+  // enable timer 4 interrupt
+  sfr_TIM4.IER.UIE = 1;
+  
+  // start the timer
+  sfr_TIM4.CR1.CEN = 1;
+  
+} // TIM4_init
+
+
+
+/**
+  \fn void TIM4_UPD_ISR(void)
+   
+  \brief ISR for timer 4 (1ms master clock)
+   
+  interrupt service routine for timer TIM4.
+  Used for 1ms system clock.
+
+  Note: 
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+#if defined(_TIM4_OVR_UIF_VECTOR_)
+  ISR_HANDLER(TIM4_UPD_ISR, _TIM4_OVR_UIF_VECTOR_)
+#elif defined(_TIM4_UIF_VECTOR_)
+  ISR_HANDLER(TIM4_UPD_ISR, _TIM4_UIF_VECTOR_)
+#else
+  #error TIM4 vector undefined
+#endif
+{
+  // clear timer 4 interrupt flag. Register name differs between devices, e.g. STM8S208 vs. STM8AF52
+  #if defined(sfr_TIM4_SR_RESET_VALUE)
+    sfr_TIM4.SR.UIF = 0;
+  #else
+    sfr_TIM4.SR1.UIF = 0;
+  #endif
+
+  // set/increase global variables
+  g_millis++;
+  g_flagMilli = 1;
+    
+  return;
+
+} // TIM4_UPD_ISR
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,64 @@
+/**
+  \file uart.h
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief declaration of UART functions/macros
+   
+  declaration of UART functions for blocking transmission and polling reception.
+  Uses the UART at 0x5230, i.e. UART1 (STM8S208) or USART (STM8AF52/51)
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_H_
+#define _UART_H_
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+// select UART instance
+#if defined(sfr_UART1)
+  #define sfr_UART           sfr_UART1
+#elif defined(sfr_USART)
+  #define sfr_UART           sfr_USART
+#else
+  #error UART not defined
+#endif
+
+/// check if byte received
+#define UART_available()   ( sfr_UART.SR.RXNE )
+
+/// read received byte
+#define UART_read()        ( sfr_UART.DR.byte )
+
+/// send byte
+#define UART_write(x)      { while (!(sfr_UART.SR.TXE)); sfr_UART.DR.byte = x; }
+
+/// flush UART Tx
+#define UART_flush()       { while (!(sfr_UART.SR.TC)); }
+
+
+/*----------------------------------------------------------
+    GLOBAL FUNCTIONS
+----------------------------------------------------------*/
+
+/// initialize UART for blocking transmission, polling reception
+void UART_begin(uint32_t BR);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_H_
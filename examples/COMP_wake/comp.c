@@ -0,0 +1,421 @@
+/**
+  \file comp.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of comparator and routing interface (COMP/RI) event chains
+
+  implementation of COMP1/COMP2 configuration, RI switch and timer routing
+  and halt with comparator wake-up, see comp.h.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "comp.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// PCKENR2 bit for COMP and RI. Bit names differ between devices
+#define PCK2_COMP         0x20
+
+// max. RI I/O channel
+#if defined(sfr_RI_IOSR4_RESET_VALUE)
+  #define RI_MAX_CH       29
+#else
+  #define RI_MAX_CH       24
+#endif
+
+
+/*----------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+----------------------------------------------------------*/
+
+/// RI I/O channel connected to COMP1 (0=none)
+static uint8_t            m_ch1;
+
+/// events latched by ISR, see COMP_events()
+static volatile uint8_t   m_events;
+
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void COMP_begin(void)
+
+  \brief init comparators and routing interface
+
+  enable COMP/RI clock, disable both comparators and their interrupts,
+  open all RI I/O and analog switches. Keep VREFINT on during halt.
+*/
+void COMP_begin(void) {
+
+  // enable COMP and RI clock
+  sfr_CLK.PCKENR2.byte |= PCK2_COMP;
+
+  // reset comparators
+  COMP_SFR.CSR1.byte = 0x00;
+  COMP_SFR.CSR2.byte = 0x00;
+  COMP_SFR.CSR3.byte = 0x00;
+  COMP_SFR.CSR4.byte = 0x00;
+  COMP_SFR.CSR5.byte = 0x00;
+
+  // open all RI switches
+  sfr_RI.IOSR1.byte = 0x00;
+  sfr_RI.IOSR2.byte = 0x00;
+  sfr_RI.IOSR3.byte = 0x00;
+  #if defined(sfr_RI_IOSR4_RESET_VALUE)
+    sfr_RI.IOSR4.byte = 0x00;
+  #endif
+  sfr_RI.ASCR1.byte = 0x00;
+  sfr_RI.ASCR2.byte = 0x00;
+
+  // VREFINT is the COMP reference -> don't switch it off in halt
+  sfr_PWR.CSR2.ULP = 0;
+
+  m_ch1    = 0;
+  m_events = 0;
+
+} // COMP_begin
+
+
+
+/**
+  \fn void RI_ioSwitch(uint8_t ch, uint8_t on)
+
+  \brief control RI I/O switch
+
+  \param[in]  ch    I/O channel 1..24 (1..29 if RI_IOSR4 exists)
+  \param[in]  on    1=close switch, 0=open switch
+
+  a closed I/O switch connects the I/O to the COMP1 non-inverting input.
+  Channels 1..24 are interleaved over RI_IOSR1..3, i.e. CH1->IOSR1.0,
+  CH2->IOSR2.0, CH3->IOSR3.0, CH4->IOSR1.1 etc.
+*/
+void RI_ioSwitch(uint8_t ch, uint8_t on) {
+
+  uint8_t   *reg;
+  uint8_t   mask;
+
+  // check channel
+  if ((ch == 0) || (ch > RI_MAX_CH))
+    return;
+
+  // channels 1..24 in IOSR1..3
+  if (ch <= 24) {
+    reg  = &(sfr_RI.IOSR1.byte) + ((ch-1) % 3);
+    mask = (uint8_t) (1 << ((ch-1) / 3));
+  }
+
+  // channels 26..29 in IOSR4 (irregular)
+  #if defined(sfr_RI_IOSR4_RESET_VALUE)
+    else {
+      reg = &(sfr_RI.IOSR4.byte);
+      if (ch == 26)
+        mask = 0x02;
+      else if (ch == 27)
+        mask = 0x40;
+      else if (ch == 28)
+        mask = 0x80;
+      else if (ch == 29)
+        mask = 0x01;
+      else
+        return;
+    }
+  #endif
+
+  // set switch
+  if (on)
+    *reg |= mask;
+  else
+    *reg &= (uint8_t) ~mask;
+
+} // RI_ioSwitch
+
+
+
+/**
+  \fn void RI_analogSwitch(uint8_t sw, uint8_t on)
+
+  \brief control RI analog switch
+
+  \param[in]  sw    analog switch 0..14 (available switches depend on device)
+  \param[in]  on    1=close switch, 0=open switch
+
+  analog switches connect analog I/O groups, e.g. to the ADC or COMP1 input.
+*/
+void RI_analogSwitch(uint8_t sw, uint8_t on) {
+
+  uint8_t   *reg;
+  uint8_t   mask;
+
+  // check switch
+  if (sw > 14)
+    return;
+
+  // AS0..7 in ASCR1, AS8..14 in ASCR2
+  if (sw < 8) {
+    reg  = &(sfr_RI.ASCR1.byte);
+    mask = (uint8_t) (1 << sw);
+  }
+  else {
+    reg  = &(sfr_RI.ASCR2.byte);
+    mask = (uint8_t) (1 << (sw - 8));
+  }
+
+  // set switch
+  if (on)
+    *reg |= mask;
+  else
+    *reg &= (uint8_t) ~mask;
+
+} // RI_analogSwitch
+
+
+
+/**
+  \fn void RI_timerCapture(uint8_t capture, uint8_t ch)
+
+  \brief route I/O channel to TIM1 input capture
+
+  \param[in]  capture   RI_TIM1_IC2 or RI_TIM1_IC3
+  \param[in]  ch        I/O channel 1..24, or 0 for default TIM1 pin
+
+  e.g. timestamp a signal which is not on a TIM1 pin.
+*/
+void RI_timerCapture(uint8_t capture, uint8_t ch) {
+
+  // check channel
+  if (ch > 24)
+    return;
+
+  if (capture == RI_TIM1_IC2)
+    sfr_RI.ICR1.IC2CS = ch;
+  else if (capture == RI_TIM1_IC3)
+    sfr_RI.ICR2.IC3CS = ch;
+
+} // RI_timerCapture
+
+
+
+/**
+  \fn void COMP1_config(uint8_t ch, uint8_t edge)
+
+  \brief configure comparator 1
+
+  \param[in]  ch      RI I/O channel for non-inverting input, 0=disable COMP1
+  \param[in]  edge    event edge COMP_EDGE_xxx
+
+  COMP1 compares the I/O against VREFINT. Previous I/O is disconnected.
+  VREFINT needs up to 3ms to settle, so configure before enabling interrupt.
+*/
+void COMP1_config(uint8_t ch, uint8_t edge) {
+
+  // disconnect previous input, connect new input
+  RI_ioSwitch(m_ch1, 0);
+  RI_ioSwitch(ch, 1);
+  m_ch1 = ch;
+
+  // VREFINT to inverting input. Also enables COMP1
+  COMP_SFR.CSR3.VREFEN = (ch != 0);
+
+  // set event edge
+  COMP_SFR.CSR1.CMP1 = (ch != 0) ? edge : COMP_EDGE_NONE;
+
+} // COMP1_config
+
+
+
+/**
+  \fn void COMP2_config(uint8_t inv, uint8_t out, uint8_t edge, uint8_t fast)
+
+  \brief configure comparator 2
+
+  \param[in]  inv     inverting input COMP2_INV_xxx. COMP2_INV_OFF disables COMP2
+  \param[in]  out     output routing COMP2_OUT_xxx
+  \param[in]  edge    event edge COMP_EDGE_xxx
+  \param[in]  fast    speed: 1=fast, 0=slow (lower current)
+
+  COMP2 compares the COMP2 non-inverting input (pin or, in window mode,
+  COMP1 input) against the selected threshold. Output is routed to
+  a timer without CPU involvement.
+*/
+void COMP2_config(uint8_t inv, uint8_t out, uint8_t edge, uint8_t fast) {
+
+  // set output routing and speed before enabling
+  COMP_SFR.CSR3.OUTSEL = out;
+  COMP_SFR.CSR2.SPEED  = (fast != 0);
+
+  // select inverting input. Also enables COMP2
+  COMP_SFR.CSR3.INSEL  = inv;
+
+  // set event edge
+  COMP_SFR.CSR2.CMP2   = (inv != COMP2_INV_OFF) ? edge : COMP_EDGE_NONE;
+
+} // COMP2_config
+
+
+
+/**
+  \fn void COMP_window(uint8_t on)
+
+  \brief set window mode
+
+  \param[in]  on    1=connect non-inverting inputs of COMP1 and COMP2
+
+  in window mode the COMP1 input (via RI) is compared against VREFINT
+  (upper threshold) and against COMP2 inverting input (lower threshold).
+*/
+void COMP_window(uint8_t on) {
+
+  COMP_SFR.CSR3.WNDWE = (on != 0);
+
+} // COMP_window
+
+
+
+/**
+  \fn void COMP_interrupt(uint8_t comp, uint8_t on)
+
+  \brief enable or disable comparator interrupt
+
+  \param[in]  comp    COMP1, COMP2 or COMP1|COMP2
+  \param[in]  on      1=enable, 0=disable
+
+  pending events are discarded before enabling, e.g. from input settling.
+*/
+void COMP_interrupt(uint8_t comp, uint8_t on) {
+
+  if (comp & COMP1) {
+    COMP_SFR.CSR1.EF1 = 0;
+    COMP_SFR.CSR1.IE1 = (on != 0);
+  }
+  if (comp & COMP2) {
+    COMP_SFR.CSR2.EF2 = 0;
+    COMP_SFR.CSR2.IE2 = (on != 0);
+  }
+
+  // discard latched events
+  DISABLE_INTERRUPTS();
+  m_events &= (uint8_t) ~comp;
+  ENABLE_INTERRUPTS();
+
+} // COMP_interrupt
+
+
+
+/**
+  \fn uint8_t COMP_output(void)
+
+  \brief read comparator outputs
+
+  \return bit mask COMP1|COMP2 of comparators with non-inverting input above threshold
+*/
+uint8_t COMP_output(void) {
+
+  uint8_t   out = 0;
+
+  if (COMP_SFR.CSR1.CMP1OUT)
+    out |= COMP1;
+  if (COMP_SFR.CSR2.CMP2OUT)
+    out |= COMP2;
+
+  return(out);
+
+} // COMP_output
+
+
+
+/**
+  \fn uint8_t COMP_events(void)
+
+  \brief get and clear events
+
+  \return bit mask COMP1|COMP2 of comparators with event since last call
+*/
+uint8_t COMP_events(void) {
+
+  uint8_t   events;
+
+  DISABLE_INTERRUPTS();
+  events = m_events;
+  m_events = 0;
+  ENABLE_INTERRUPTS();
+
+  return(events);
+
+} // COMP_events
+
+
+
+/**
+  \fn uint8_t COMP_sleep(void)
+
+  \brief stay in halt until next comparator event
+
+  \return events (bit mask COMP1|COMP2) which ended the sleep
+
+  enter halt until a comparator event occurs. Other interrupts are
+  serviced, but don't end the sleep. Comparators and VREFINT stay active
+  in halt, all clocks are stopped. UART etc. must be idle before the call.
+*/
+uint8_t COMP_sleep(void) {
+
+  uint8_t   events;
+
+  // disable interrupts until HALT (re-enables interrupts)
+  DISABLE_INTERRUPTS();
+  while (!m_events) {
+    ENTER_HALT();
+    DISABLE_INTERRUPTS();
+  }
+  events = m_events;
+  m_events = 0;
+  ENABLE_INTERRUPTS();
+
+  return(events);
+
+} // COMP_sleep
+
+
+
+/**
+  \fn void COMP_ISR(void)
+
+  \brief ISR for comparator events
+
+  interrupt service routine for COMP1 and COMP2 edge events. Latch event
+  and clear flag (write 0). Also wakes from halt.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(COMP_ISR, _COMP_EF1_VECTOR_)
+{
+  // COMP1 event
+  if (COMP_SFR.CSR1.EF1) {
+    COMP_SFR.CSR1.EF1 = 0;
+    m_events |= COMP1;
+  }
+
+  // COMP2 event
+  if (COMP_SFR.CSR2.EF2) {
+    COMP_SFR.CSR2.EF2 = 0;
+    m_events |= COMP2;
+  }
+
+} // COMP_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,133 @@
+/**
+  \file comp.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of comparator and routing interface (COMP/RI) event chains
+
+  declaration of functions for analog comparators COMP1/COMP2 and routing
+  interface RI of STM8L/STM8AL medium and high density devices:
+    - RI: connect I/O channels to COMP1 non-inverting input, close analog
+      switches and route I/Os to TIM1 input capture 2/3
+    - COMP1: non-inverting input via RI I/O switches, inverting input VREFINT
+    - COMP2: inverting input I/O, VREFINT (fractions) or DAC, output routed
+      to TIM1 break, TIM1 OCREF clear or TIM2/TIM3 input capture 2
+    - window mode: non-inverting inputs of COMP1 and COMP2 connected, i.e.
+      one signal is checked against 2 thresholds
+    - edge events with interrupt. These also wake from halt, i.e. a threshold
+      crossing can be detected without periodic ADC sampling
+
+  \note
+  - VREFINT must stay on in halt, i.e. PWR_CSR2.ULP is cleared in COMP_begin()
+  - COMP and ADC1 share interrupt vector 18
+  - I/O channel to pin mapping see reference manual, section routing interface
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _COMP_H_
+#define _COMP_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// module name differs between devices
+#if defined(sfr_COMP1_2)
+  #define COMP_SFR              sfr_COMP1_2
+#elif defined(sfr_COMP)
+  #define COMP_SFR              sfr_COMP
+#else
+  #error device has no COMP1/COMP2
+#endif
+#if !defined(sfr_RI)
+  #error device has no routing interface RI
+#endif
+
+// comparator selection
+#define COMP1                   0x01      ///< comparator 1
+#define COMP2                   0x02      ///< comparator 2
+
+// edge detection (COMP_CSRx.CMPx)
+#define COMP_EDGE_NONE          0x00      ///< no event
+#define COMP_EDGE_FALLING       0x01      ///< event on falling edge
+#define COMP_EDGE_RISING        0x02      ///< event on rising edge
+#define COMP_EDGE_BOTH          0x03      ///< event on both edges
+
+// COMP2 inverting input (COMP_CSR3.INSEL). COMP2 is off for COMP2_INV_OFF
+#define COMP2_INV_OFF           0x00      ///< COMP2 disabled
+#define COMP2_INV_IO            0x01      ///< external I/O COMP2_INM
+#define COMP2_INV_VREF          0x02      ///< VREFINT (1.224V typ.)
+#define COMP2_INV_VREF_3_4      0x03      ///< 3/4 VREFINT
+#define COMP2_INV_VREF_1_2      0x04      ///< 1/2 VREFINT
+#define COMP2_INV_VREF_1_4      0x05      ///< 1/4 VREFINT
+#define COMP2_INV_DAC1          0x06      ///< DAC channel 1 output
+#define COMP2_INV_DAC2          0x07      ///< DAC channel 2 output
+
+// COMP2 output routing (COMP_CSR3.OUTSEL)
+#define COMP2_OUT_TIM2_IC2      0x00      ///< TIM2 input capture 2
+#define COMP2_OUT_TIM3_IC2      0x01      ///< TIM3 input capture 2
+#define COMP2_OUT_TIM1_BRK      0x02      ///< TIM1 break input, e.g. PWM emergency stop
+#define COMP2_OUT_TIM1_OCREFCLR 0x03      ///< TIM1 OCREF clear, e.g. peak current control
+
+// RI TIM1 input capture routing
+#define RI_TIM1_IC2             2         ///< TIM1 input capture 2 (RI_ICR1)
+#define RI_TIM1_IC3             3         ///< TIM1 input capture 3 (RI_ICR2)
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// enable COMP/RI clock, reset comparators and open all RI switches
+void COMP_begin(void);
+
+/// close (on=1) or open (on=0) RI I/O switch of channel 1..24, i.e. connect I/O to COMP1 non-inverting input
+void RI_ioSwitch(uint8_t ch, uint8_t on);
+
+/// close (on=1) or open (on=0) RI analog switch 0..14
+void RI_analogSwitch(uint8_t sw, uint8_t on);
+
+/// route I/O channel (1..24) to TIM1 input capture RI_TIM1_ICx. Channel 0 restores default pin
+void RI_timerCapture(uint8_t capture, uint8_t ch);
+
+/// configure COMP1: input via RI I/O channel (0=none), inverting input VREFINT, event edge
+void COMP1_config(uint8_t ch, uint8_t edge);
+
+/// configure COMP2: inverting input COMP2_INV_xxx, output routing COMP2_OUT_xxx, event edge, speed (1=fast)
+void COMP2_config(uint8_t inv, uint8_t out, uint8_t edge, uint8_t fast);
+
+/// connect non-inverting inputs of COMP1 and COMP2 (window mode)
+void COMP_window(uint8_t on);
+
+/// enable (on=1) or disable (on=0) event interrupt of COMP1 and/or COMP2
+void COMP_interrupt(uint8_t comp, uint8_t on);
+
+/// read comparator outputs (bit mask COMP1|COMP2, 1=non-inverting input above threshold)
+uint8_t COMP_output(void);
+
+/// get and clear events since last call (bit mask COMP1|COMP2)
+uint8_t COMP_events(void);
+
+/// stay in halt until next comparator event. Returns events (bit mask COMP1|COMP2)
+uint8_t COMP_sleep(void);
+
+/// ISR for comparator events
+ISR_HANDLER(COMP_ISR, _COMP_EF1_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _COMP_H_
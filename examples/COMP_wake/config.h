@@ -0,0 +1,53 @@
+/**
+  \file config.h
+
+  \brief set project configurations
+
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define STM8L_DISCOVERY
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"
+  #define LED_HIGH_PORT   sfr_PORTE     // green LED PE7 (high active)
+  #define LED_HIGH_PIN    PIN7
+  #define LED_LOW_PORT    sfr_PORTC     // blue LED PC7 (high active)
+  #define LED_LOW_PIN     PIN7
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    COMPARATOR CONFIGURATION
+----------------------------------------------------------*/
+
+// RI I/O channel of analog input. For pin see reference manual, section routing interface
+#define COMP_INPUT_CH     1
+
+// lower threshold (COMP2 inverting input). Upper threshold is VREFINT (COMP1)
+#define COMP_LOW_REF      COMP2_INV_VREF_1_4
+
+// COMP2 output routing, e.g. TIM1 break for PWM emergency stop (TIM1 unused here)
+#define COMP_LOW_OUT      COMP2_OUT_TIM1_BRK
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
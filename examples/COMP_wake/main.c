@@ -0,0 +1,86 @@
+/**********************
+  Wake from halt on analog threshold crossing via comparators
+
+  supported hardware:
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html),
+      analog input on RI I/O channel COMP_INPUT_CH (see config.h)
+
+  Functionality:
+    - COMP1: input via RI I/O switch against VREFINT (upper threshold 1.22V)
+    - COMP2: same input (window mode) against 1/4 VREFINT (lower threshold 0.3V).
+      Output routed to TIM1 break input
+    - both edges of both comparators wake the CPU from halt. No ADC sampling,
+      no periodic wake-up
+    - after wake-up show zone: green LED = above upper, blue LED = below lower,
+      both off = inside window
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "comp.h"
+#undef _MAIN_
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint8_t   out;
+  uint16_t  i;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // configure LED pins
+  LED_HIGH_PORT.DDR.byte |= LED_HIGH_PIN;   // input(=0) or output(=1)
+  LED_HIGH_PORT.CR1.byte |= LED_HIGH_PIN;   // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+  LED_LOW_PORT.DDR.byte  |= LED_LOW_PIN;
+  LED_LOW_PORT.CR1.byte  |= LED_LOW_PIN;
+
+  // COMP1 upper threshold, COMP2 lower threshold on same input (window mode)
+  COMP_begin();
+  COMP_window(1);
+  COMP1_config(COMP_INPUT_CH, COMP_EDGE_BOTH);
+  COMP2_config(COMP_LOW_REF, COMP_LOW_OUT, COMP_EDGE_BOTH, 0);
+
+  // wait for VREFINT and comparators to settle (~4ms), then enable events
+  for (i=0; i<10000; i++)
+    NOP();
+  COMP_interrupt(COMP1 | COMP2, 1);
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // show zone. Comparator output is 1 if input is above threshold
+    out = COMP_output();
+    if (out & COMP1)
+      LED_HIGH_PORT.ODR.byte |= LED_HIGH_PIN;
+    else
+      LED_HIGH_PORT.ODR.byte &= (uint8_t) ~LED_HIGH_PIN;
+    if (!(out & COMP2))
+      LED_LOW_PORT.ODR.byte |= LED_LOW_PIN;
+    else
+      LED_LOW_PORT.ODR.byte &= (uint8_t) ~LED_LOW_PIN;
+
+    // halt until input crosses a threshold
+    COMP_sleep();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
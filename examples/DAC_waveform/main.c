@@ -0,0 +1,148 @@
+/**********************
+  DAC waveform output via timer-triggered DMA
+
+  supported hardware:
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html), DAC output on PF0
+
+  Functionality:
+    - 2s: 1kHz sine from 32 sample table at 32kSps. Table replay by
+      TIM4 -> DAC -> DMA1 without CPU
+    - 2s: alert tone alternating 880Hz/1320Hz every 250ms at 16kSps.
+      Synthesized (DDS) by producer callback into a double buffer
+    - 1s: silence
+    - repeat. CPU waits in WAIT mode
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "wave.h"
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// scale 12-bit table values to WAVE_BITS
+#define S(x)        ((wave_sample_t) ((x) >> (12 - WAVE_BITS)))
+
+// stream parameters
+#define TONE_RATE   16000       // sample rate [Hz]
+#define TONE_LOW    880         // frequencies [Hz]
+#define TONE_HIGH   1320
+#define TONE_SWITCH 4000        // samples per tone (250ms)
+
+// DDS phase increments for 32 sample table (index = phase >> 11)
+#define INC_LOW     ((uint16_t) (((uint32_t) TONE_LOW  << 16) / TONE_RATE))
+#define INC_HIGH    ((uint16_t) (((uint32_t) TONE_HIGH << 16) / TONE_RATE))
+
+
+/*----------------------------------------------------------
+    GLOBAL VARIABLES
+----------------------------------------------------------*/
+
+// one period of sine
+const wave_sample_t sine[32] = {
+  S(2048), S(2447), S(2831), S(3185), S(3495), S(3750), S(3939), S(4055),
+  S(4094), S(4055), S(3939), S(3750), S(3495), S(3185), S(2831), S(2447),
+  S(2048), S(1648), S(1264), S( 910), S( 600), S( 345), S( 156), S(  40),
+  S(   0), S(  40), S( 156), S( 345), S( 600), S( 910), S(1264), S(1648)
+};
+
+// stream double buffer
+wave_sample_t       buf[128];
+
+// DDS state. Modified in DMA ISR (callback)
+uint16_t            phase, inc;
+uint16_t            toneCount;
+volatile uint32_t   g_samples;
+
+
+
+/**
+  \fn void tone(wave_sample_t *dst, uint8_t num)
+
+  \brief producer callback: synthesize alert tone
+
+  \param[out] dst   buffer to fill
+  \param[in]  num   number of samples
+
+  direct digital synthesis from sine table, switch frequency every TONE_SWITCH
+  samples. Called from DMA ISR.
+*/
+void tone(wave_sample_t *dst, uint8_t num) {
+
+  uint8_t   i;
+
+  for (i=0; i<num; i++) {
+    dst[i] = sine[phase >> 11];
+    phase += inc;
+    if (++toneCount >= TONE_SWITCH) {
+      toneCount = 0;
+      inc = (inc == INC_LOW) ? INC_HIGH : INC_LOW;
+    }
+  }
+  g_samples += num;
+
+} // tone
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint32_t  i;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init DAC, DMA and trigger timer
+  WAVE_begin();
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // 1kHz sine by table replay. CPU idle, simple wait ~2s @ 16MHz
+    WAVE_setRate(32000);
+    WAVE_play(sine, 32);
+    for (i=0; i<1200000L; i++)
+      NOP();
+
+    // alert tone by streaming. Duration by number of produced samples
+    phase     = 0;
+    inc       = INC_LOW;
+    toneCount = 0;
+    g_samples = 0;
+    WAVE_setRate(TONE_RATE);
+    WAVE_stream(buf, sizeof(buf)/sizeof(wave_sample_t), tone);
+    DISABLE_INTERRUPTS();
+    while (g_samples < 2L*TONE_RATE) {
+      WAIT_FOR_INTERRUPT();       // re-enables interrupts
+      DISABLE_INTERRUPTS();
+    }
+    ENABLE_INTERRUPTS();
+
+    // silence ~1s
+    WAVE_stop();
+    for (i=0; i<600000L; i++)
+      NOP();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,336 @@
+/**
+  \file wave.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of DAC waveform engine with timer-triggered DMA
+
+  implementation of table replay and double-buffered streaming via
+  TIM4 TRGO -> DAC trigger -> DMA1 channel 3 request, see wave.h.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "wave.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// DMA1 channel configuration
+#define DMA_CR_EN           0x01      ///< channel enable
+#define DMA_CR_TCIE         0x02      ///< transfer complete interrupt
+#define DMA_CR_HTIE         0x04      ///< half transfer interrupt
+#define DMA_CR_DIR          0x08      ///< memory to peripheral
+#define DMA_CR_CIRC         0x10      ///< circular mode
+#define DMA_CR_MINC         0x20      ///< memory increment
+#define DMA_SPR_TSIZE       0x08      ///< 16-bit transfers
+#define DMA_SPR_PL          0x30      ///< very high priority
+
+// DAC_CR1 bits
+#define DAC_CR1_EN          0x01      ///< enable DAC
+#define DAC_CR1_TEN         0x04      ///< enable trigger
+#define DAC_CR1_TSEL_TIM4   0x00      ///< trigger TIM4 TRGO
+
+// DMA transfer size and target register
+#if (WAVE_BITS == 12)
+  #define WAVE_DMA_SIZE     DMA_SPR_TSIZE
+  #define WAVE_DMA_TARGET   (&(sfr_DAC.RDHRH))
+#else
+  #define WAVE_DMA_SIZE     0x00
+  #define WAVE_DMA_TARGET   (&(sfr_DAC.DHR8))
+#endif
+
+
+/*----------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+----------------------------------------------------------*/
+
+/// stream buffer
+static wave_sample_t      *m_buf;
+
+/// samples per half of stream buffer
+static uint8_t            m_half;
+
+/// producer callback (NULL = table replay)
+static wave_fill_t        m_fill;
+
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn static void setLevel(wave_sample_t val)
+
+  \brief set DAC output immediately
+
+  \param[in]  val   sample value
+
+  set output via holding register without trigger.
+*/
+static void setLevel(wave_sample_t val) {
+
+  sfr_DAC.CR1.byte = DAC_CR1_EN;
+  #if (WAVE_BITS == 12)
+    sfr_DAC.RDHRH.byte = (uint8_t) (val >> 8);
+    sfr_DAC.RDHRL.byte = (uint8_t) val;
+  #else
+    sfr_DAC.DHR8.byte  = val;
+  #endif
+
+} // setLevel
+
+
+
+/**
+  \fn static void startDma(const wave_sample_t *buf, uint8_t len, uint8_t irq)
+
+  \brief start circular DMA output
+
+  \param[in]  buf   sample buffer
+  \param[in]  len   number of samples
+  \param[in]  irq   DMA interrupt enable bits
+
+  configure DMA1 channel 3 for circular transfer to DAC, enable DAC trigger
+  and DMA request, then start TIM4.
+*/
+static void startDma(const wave_sample_t *buf, uint8_t len, uint8_t irq) {
+
+  // stop trigger and DMA
+  sfr_TIM4.CR1.CEN   = 0;
+  sfr_DAC.CR2.DMAEN  = 0;
+  sfr_DMA1.C3CR.byte = 0x00;
+
+  // DMA1 channel 3: memory -> DAC data holding register, circular
+  sfr_DMA1.C3SPR.byte  = DMA_SPR_PL | WAVE_DMA_SIZE;
+  sfr_DMA1.C3NDTR.byte = len;
+  sfr_DMA1.C3PARH_C3M1ARH.byte = (uint8_t) (((uint16_t) WAVE_DMA_TARGET) >> 8);
+  sfr_DMA1.C3PARL_C3M1ARL.byte = (uint8_t) ((uint16_t) WAVE_DMA_TARGET);
+  #if defined(sfr_DMA1_C3M0EAR_RESET_VALUE)
+    sfr_DMA1.C3M0EAR.byte = 0x00;
+  #endif
+  sfr_DMA1.C3M0ARH.byte = (uint8_t) (((uint16_t) buf) >> 8);
+  sfr_DMA1.C3M0ARL.byte = (uint8_t) ((uint16_t) buf);
+  sfr_DMA1.C3CR.byte    = DMA_CR_DIR | DMA_CR_CIRC | DMA_CR_MINC | irq | DMA_CR_EN;
+
+  // DAC: trigger by TIM4 TRGO, DMA request per trigger
+  sfr_DAC.CR1.byte  = DAC_CR1_TSEL_TIM4 | DAC_CR1_TEN | DAC_CR1_EN;
+  sfr_DAC.CR2.DMAEN = 1;
+
+  // start trigger
+  sfr_TIM4.CNTR.byte = 0x00;
+  sfr_TIM4.CR1.CEN   = 1;
+
+} // startDma
+
+
+
+/**
+  \fn void WAVE_begin(void)
+
+  \brief enable clocks and DAC output
+
+  enable DAC, TIM4 and DMA1 clocks, set TIM4 update as TRGO and set
+  DAC output to mid level. Default sample rate is 8kHz.
+*/
+void WAVE_begin(void) {
+
+  // enable DAC, TIM4 (PCKEN17, PCKEN12) and DMA1 (PCKEN24) clocks. Bit names differ between devices
+  sfr_CLK.PCKENR1.byte |= 0x84;
+  sfr_CLK.PCKENR2.byte |= 0x10;
+
+  // enable DMA globally
+  sfr_DMA1.GCSR.GEN = 1;
+
+  // TIM4 update event -> TRGO (MMS=010), buffered reload
+  sfr_TIM4.CR1.byte = 0x00;
+  sfr_TIM4.CR2.byte = 0x20;
+  sfr_TIM4.CR1.ARPE = 1;
+  WAVE_setRate(8000);
+
+  // output buffer on, mid level
+  m_fill = 0;
+  setLevel(WAVE_MID);
+
+} // WAVE_begin
+
+
+
+/**
+  \fn uint32_t WAVE_setRate(uint32_t rate)
+
+  \brief set sample rate
+
+  \param[in]  rate    sample rate [Hz] (2..1000000)
+
+  \return actual sample rate [Hz], or 0 if out of range
+
+  set TIM4 prescaler and reload for fMaster=16MHz. Can be changed
+  during output.
+*/
+uint32_t WAVE_setRate(uint32_t rate) {
+
+  uint32_t  period;
+  uint8_t   psc = 0;
+
+  // check range
+  if ((rate < 2) || (rate > 1000000L))
+    return(0);
+
+  // smallest prescaler with period <= 256
+  period = (16000000L + rate/2) / rate;
+  while ((period > ((uint32_t) 256 << psc)) && (psc < 15))
+    psc++;
+  period = (period + (((uint32_t) 1 << psc) >> 1)) >> psc;
+  if ((period < 1) || (period > 256))
+    return(0);
+
+  // set timer. Period is ARR+1
+  sfr_TIM4.PSCR.byte = psc;
+  sfr_TIM4.ARR.byte  = (uint8_t) (period - 1);
+  sfr_TIM4.EGR.UG    = 1;
+
+  return((16000000L >> psc) / period);
+
+} // WAVE_setRate
+
+
+
+/**
+  \fn void WAVE_play(const wave_sample_t *table, uint8_t len)
+
+  \brief replay sample table endlessly
+
+  \param[in]  table   samples, must stay valid during output
+  \param[in]  len     number of samples (1..255)
+
+  output frequency is sample rate / len. No interrupts are used.
+*/
+void WAVE_play(const wave_sample_t *table, uint8_t len) {
+
+  if (len == 0)
+    return;
+
+  m_fill = 0;
+  startDma(table, len, 0x00);
+
+} // WAVE_play
+
+
+
+/**
+  \fn void WAVE_stream(wave_sample_t *buf, uint8_t len, wave_fill_t fill)
+
+  \brief stream via double buffer
+
+  \param[in]  buf     buffer for 2 halves, must stay valid during output
+  \param[in]  len     total number of samples (2..254, even)
+  \param[in]  fill    producer callback
+
+  both halves are filled via callback, then output starts. Each time a
+  half was transferred, the callback refills it from the DMA ISR while
+  the other half is output.
+*/
+void WAVE_stream(wave_sample_t *buf, uint8_t len, wave_fill_t fill) {
+
+  if ((len < 2) || (fill == 0))
+    return;
+
+  // stop previous output before changing the buffer
+  WAVE_stop();
+
+  // prefill both halves
+  m_buf  = buf;
+  m_half = len >> 1;
+  m_fill = fill;
+  m_fill(m_buf, m_half);
+  m_fill(m_buf + m_half, m_half);
+
+  // start with interrupts at half and full transfer
+  startDma(buf, m_half << 1, DMA_CR_HTIE | DMA_CR_TCIE);
+
+} // WAVE_stream
+
+
+
+/**
+  \fn void WAVE_stop(void)
+
+  \brief stop output
+
+  stop trigger and DMA and set output to mid level.
+*/
+void WAVE_stop(void) {
+
+  sfr_TIM4.CR1.CEN    = 0;
+  sfr_DAC.CR2.DMAEN   = 0;
+  sfr_DMA1.C3CR.byte  = 0x00;
+  sfr_DMA1.C3SPR.byte = 0x00;
+  m_fill = 0;
+  setLevel(WAVE_MID);
+
+} // WAVE_stop
+
+
+
+/**
+  \fn uint8_t WAVE_underrun(void)
+
+  \brief check and clear DMA underrun
+
+  \return 1 if a trigger occurred before the previous DMA request was served
+
+  an underrun indicates a too high sample rate. Restart output afterwards.
+*/
+uint8_t WAVE_underrun(void) {
+
+  if (sfr_DAC.SR.DMAUDR) {
+    sfr_DAC.SR.byte = 0x01;
+    return(1);
+  }
+  return(0);
+
+} // WAVE_underrun
+
+
+
+/**
+  \fn void WAVE_DMA_ISR(void)
+
+  \brief ISR for DMA1 channel 3 half and full transfer
+
+  interrupt service routine for stream refill. After half transfer the
+  first half is refilled, after full transfer the second half.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(WAVE_DMA_ISR, _DMA1_CH3_TC_VECTOR_)
+{
+  // first half done -> refill while second half is output
+  if (sfr_DMA1.C3SPR.HTIF) {
+    sfr_DMA1.C3SPR.HTIF = 0;
+    if (m_fill)
+      m_fill(m_buf, m_half);
+  }
+
+  // second half done -> refill while first half is output
+  if (sfr_DMA1.C3SPR.TCIF) {
+    sfr_DMA1.C3SPR.TCIF = 0;
+    if (m_fill)
+      m_fill(m_buf + m_half, m_half);
+  }
+
+} // WAVE_DMA_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+/**
+  \file wave.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of DAC waveform engine with timer-triggered DMA
+
+  declaration of waveform output via DAC channel 1 for STM8L/STM8AL.
+  The DAC is triggered by TIM4 TRGO at the sample rate and its DMA request
+  is served by DMA1 channel 3, i.e. the CPU is not involved per sample.
+  Modes:
+    - WAVE_play(): replay sample table in circular mode, e.g. sine or
+      arbitrary waveform. No CPU load at all
+    - WAVE_stream(): circular double buffer. When one half was output, the
+      producer callback is called from the DMA ISR to refill it, e.g. for
+      audio or synthesized tones
+
+  Sample format is set via WAVE_BITS in config.h:
+    - 12: uint16_t, right aligned 0..4095, 16-bit DMA to DAC_RDHR
+    - 8:  uint8_t, 0..255, 8-bit DMA to DAC_DHR8, half memory
+
+  \note
+  - the DMA counter is 8-bit, i.e. max. 255 samples per table/buffer
+  - TIM4 is used as DAC trigger and is not available e.g. for 1ms tick
+  - producer callback runs in ISR context and must finish within
+    (buffer length / 2) sample periods
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _WAVE_H_
+#define _WAVE_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// check for DAC and DMA
+#if !defined(sfr_DAC) || !defined(sfr_DMA1)
+  #error device has no DAC or DMA1
+#endif
+
+// sample resolution 8 or 12 bit. Default can be overwritten in config.h
+#ifndef WAVE_BITS
+  #define WAVE_BITS             12
+#endif
+
+/// max. samples per table or stream buffer
+#define WAVE_MAX_LEN            255
+
+/// sample value for mid level
+#define WAVE_MID                ((wave_sample_t) (1 << (WAVE_BITS - 1)))
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// sample type
+#if (WAVE_BITS == 12)
+  typedef uint16_t    wave_sample_t;
+#elif (WAVE_BITS == 8)
+  typedef uint8_t     wave_sample_t;
+#else
+  #error WAVE_BITS must be 8 or 12
+#endif
+
+/// producer callback: fill num samples into buf
+typedef void (*wave_fill_t)(wave_sample_t *buf, uint8_t num);
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// enable clocks and DAC output (mid level)
+void WAVE_begin(void);
+
+/// set sample rate [Hz]. Returns actual rate, or 0 if out of range
+uint32_t WAVE_setRate(uint32_t rate);
+
+/// replay sample table (1..255 samples) in endless loop
+void WAVE_play(const wave_sample_t *table, uint8_t len);
+
+/// stream via double buffer (2..254 samples, even). Both halves are filled before start
+void WAVE_stream(wave_sample_t *buf, uint8_t len, wave_fill_t fill);
+
+/// stop output and return to mid level
+void WAVE_stop(void);
+
+/// check and clear DAC DMA underrun, i.e. sample rate too high
+uint8_t WAVE_underrun(void);
+
+/// ISR for DMA1 channel 3 half and full transfer (stream refill)
+ISR_HANDLER(WAVE_DMA_ISR, _DMA1_CH3_TC_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _WAVE_H_
@@ -0,0 +1,40 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "../../include/STLUX385A.h"
+
+
+/*----------------------------------------------------------
+    PROJECT SETTINGS
+----------------------------------------------------------*/
+
+// master clock [Hz]. Used for DALI clock prescaler
+#define F_MASTER        16000000L
+
+// lamp output (on/off demo). Replace by SMED PWM for real dimming
+#define LAMP_PORT       sfr_PORT0          // lamp=P0.0
+#define LAMP_PIN        PIN0
+
+// key/value store: keys used by DALI gear, see dali_gear.c
+#define KV_NUM_KEYS     8
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
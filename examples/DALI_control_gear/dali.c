@@ -0,0 +1,317 @@
+/**
+  \file dali.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of interrupt-driven DALI physical layer
+
+  implementation of functions for DALI frame reception in the DALI interrupt
+  and for sending backward frames within the IEC 62386-101 timing window.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "dali.h"
+#include "stmr.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// DALI only exists on STLUX devices
+#if !defined(sfr_DALI)
+  #error device has no DALI
+#endif
+
+// check settings (negative array size on error)
+typedef char dali_check_queue[((DALI_RX_QUEUE & (DALI_RX_QUEUE-1)) == 0) ? 1 : -1];
+typedef char dali_check_prescaler[(DALI_PRESCALER < 1024) ? 1 : -1];
+
+// DALI_CSR bits
+#define CSR_WDGF        0x04      ///< line watchdog flag (bus low too long)
+#define CSR_WDGE        0x08      ///< line watchdog interrupt enable
+#define CSR_RTF         0x10      ///< backward frame transmitted
+#define CSR_EF          0x20      ///< receive error flag
+#define CSR_ITF         0x40      ///< forward frame received
+#define CSR_IEN         0x80      ///< receive interrupt enable
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// receive queue, filled in ISR
+static dali_frame_t       m_rxQueue[DALI_RX_QUEUE];
+static volatile uint8_t   m_rxHead;           ///< write index, modified in ISR only
+static volatile uint8_t   m_rxTail;           ///< read index, modified by DALI_read() only
+
+/// time of last bus activity [ms]
+static volatile uint32_t  m_lastActivity;
+
+/// bus power failure detected by line watchdog
+static volatile uint8_t   m_busFail;
+
+/// number of receive errors
+static volatile uint8_t   m_errors;
+
+
+
+/**
+  \fn void DALI_begin(void)
+
+  \brief initialize DALI peripheral in control gear mode
+
+  set bit clock, select slave mode with 16b forward frames, enable line
+  watchdog for bus power failure detection, and enable the receive interrupt.
+*/
+void DALI_begin(void) {
+
+  // disable DALI interrupts and reset module variables
+  sfr_DALI.DALI_CSR.byte = 0x00;
+  m_rxHead       = 0;
+  m_rxTail       = 0;
+  m_lastActivity = 0;
+  m_busFail      = 0;
+  m_errors       = 0;
+
+  // set bit clock prescaler
+  sfr_DALI.DALI_H.byte = (uint8_t) (DALI_PRESCALER >> 8);
+  sfr_DALI.DALI_L.byte = (uint8_t) DALI_PRESCALER;
+
+  // slave mode (SMK=0), 16b forward frames (MLN=0), line watchdog on
+  sfr_DALI.DALI_CR.byte = 0x00;
+  sfr_DALI.DALI_CR.LNWDG_EN = 1;
+
+  // line watchdog prescaler. Receiver ready for next frame
+  sfr_DALI.DALI_CSR1.WDG_PRSC = DALI_WDG_PRESCALER;
+  sfr_DALI.DALI_CSR1.RDY_REC  = 1;
+
+  // enable receive and line watchdog interrupts
+  sfr_DALI.DALI_CSR.byte = CSR_IEN | CSR_WDGE;
+
+} // DALI_begin
+
+
+
+/**
+  \fn uint8_t DALI_available(void)
+
+  \brief get number of queued forward frames
+
+  \return number of frames in receive queue
+*/
+uint8_t DALI_available(void) {
+
+  return((uint8_t) (m_rxHead - m_rxTail) & (2*DALI_RX_QUEUE-1));
+
+} // DALI_available
+
+
+
+/**
+  \fn uint8_t DALI_read(dali_frame_t *frame)
+
+  \brief get oldest forward frame from queue
+
+  \param[out] frame   received frame incl. timestamp
+
+  \return 1 if frame was read, 0 if queue is empty
+
+  Indices run over 2*DALI_RX_QUEUE to distinguish full from empty queue.
+  As the ISR only writes the head and this function only writes the tail,
+  no interrupt lock is required.
+*/
+uint8_t DALI_read(dali_frame_t *frame) {
+
+  uint8_t   tail = m_rxTail;
+
+  // queue empty
+  if (tail == m_rxHead)
+    return(0);
+
+  // copy frame, then release slot
+  *frame = m_rxQueue[tail & (DALI_RX_QUEUE-1)];
+  m_rxTail = (tail + 1) & (2*DALI_RX_QUEUE-1);
+
+  return(1);
+
+} // DALI_read
+
+
+
+/**
+  \fn uint8_t DALI_answer(const dali_frame_t *frame, uint8_t data)
+
+  \brief send backward frame as answer to forward frame
+
+  \param[in]  frame   forward frame to answer
+  \param[in]  data    answer byte (0xFF = YES)
+
+  \return 1 if answer was sent, 0 if timing window was missed
+
+  wait until the settling time after the forward frame has passed, then
+  start the backward frame. If the frame was processed too late, the master
+  has already timed out and the answer is dropped. As frames are processed
+  directly after reception, the wait is max. DALI_ANSWER_MIN.
+*/
+uint8_t DALI_answer(const dali_frame_t *frame, uint8_t data) {
+
+  uint16_t  dt;
+
+  // wait for settling time
+  do {
+    dt = (uint16_t) millis() - frame->time;
+  } while (dt < DALI_ANSWER_MIN);
+
+  // too late -> drop answer
+  if (dt > DALI_ANSWER_MAX)
+    return(0);
+
+  // start backward frame
+  sfr_DALI.DALI_BD.byte = data;
+  sfr_DALI.DALI_CR.RTS  = 1;
+
+  return(1);
+
+} // DALI_answer
+
+
+
+/**
+  \fn uint8_t DALI_busFail(void)
+
+  \brief check for bus power failure
+
+  \return 1 if line watchdog detected bus low for too long, else 0
+
+  flag is set by line watchdog and cleared by the next valid frame.
+*/
+uint8_t DALI_busFail(void) {
+
+  return(m_busFail);
+
+} // DALI_busFail
+
+
+
+/**
+  \fn uint16_t DALI_idle(void)
+
+  \brief time since last bus activity
+
+  \return time since last frame [ms], saturated at 65535
+
+  used to defer slow actions, e.g. EEPROM writes, to idle bus phases.
+*/
+uint16_t DALI_idle(void) {
+
+  uint32_t  last, dt;
+
+  // read timestamp consistently w/o blocking other interrupts
+  sfr_DALI.DALI_CSR.IEN = 0;
+  last = m_lastActivity;
+  sfr_DALI.DALI_CSR.IEN = 1;
+
+  dt = millis() - last;
+  if (dt > 0xFFFF)
+    return(0xFFFF);
+
+  return((uint16_t) dt);
+
+} // DALI_idle
+
+
+
+/**
+  \fn uint8_t DALI_errors(void)
+
+  \brief get and clear number of receive errors
+
+  \return number of framing errors and queue overflows since last call
+*/
+uint8_t DALI_errors(void) {
+
+  uint8_t   num;
+
+  sfr_DALI.DALI_CSR.IEN = 0;
+  num = m_errors;
+  m_errors = 0;
+  sfr_DALI.DALI_CSR.IEN = 1;
+
+  return(num);
+
+} // DALI_errors
+
+
+
+/**
+  \fn void DALI_ISR(void)
+
+  \brief ISR for DALI frame reception and line watchdog
+
+  queue received forward frames with timestamp, count receive errors and
+  detect bus power failure. Frame registers are read and released
+  immediately, i.e. the next frame can be received while the application
+  processes the queue.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(DALI_ISR, _DALI_ITF_VECTOR_) {
+
+  uint8_t   csr = sfr_DALI.DALI_CSR.byte;
+  uint8_t   clr = 0;
+  uint8_t   head;
+
+  // line watchdog: bus low for too long -> bus power failure
+  if (csr & CSR_WDGF) {
+    m_busFail = 1;
+    clr |= CSR_WDGF;
+  }
+
+  // forward frame received
+  if (csr & CSR_ITF) {
+
+    m_lastActivity = millis();
+    clr |= (uint8_t) (csr & (CSR_ITF | CSR_EF));
+
+    // framing error
+    if (csr & CSR_EF)
+      m_errors++;
+
+    // valid frame: store if queue has space, else count overflow
+    else {
+      head = m_rxHead;
+      if (((uint8_t) (head - m_rxTail) & (2*DALI_RX_QUEUE-1)) < DALI_RX_QUEUE) {
+        m_rxQueue[head & (DALI_RX_QUEUE-1)].addr = sfr_DALI.DALI_FB1.byte;
+        m_rxQueue[head & (DALI_RX_QUEUE-1)].data = sfr_DALI.DALI_FB0.byte;
+        m_rxQueue[head & (DALI_RX_QUEUE-1)].time = (uint16_t) m_lastActivity;
+        m_rxHead = (head + 1) & (2*DALI_RX_QUEUE-1);
+      }
+      else
+        m_errors++;
+      m_busFail = 0;
+    }
+
+    // receiver ready for next frame
+    sfr_DALI.DALI_CSR1.RDY_REC = 1;
+
+  } // ITF
+
+  // clear only handled flags (write 0 clears, write 1 no effect). Flags set
+  // after reading CSR and unhandled RTF remain pending. Keep interrupt enables
+  sfr_DALI.DALI_CSR.byte = (csr | CSR_WDGF | CSR_RTF | CSR_EF | CSR_ITF) & (uint8_t) ~clr;
+
+  return;
+
+} // DALI_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,116 @@
+/**
+  \file dali.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of interrupt-driven DALI physical layer
+
+  declaration of a driver for the DALI peripheral of STLUX devices in
+  control gear (slave) mode. Features:
+    - forward frames (16b) are received in the DALI interrupt and queued
+      together with a timestamp. Frames arriving back-to-back are not lost
+      while the application is still processing older frames
+    - backward frames (answers) are sent within the timing window of
+      IEC 62386-101, i.e. after the settling time and before the master
+      times out. Late answers are dropped
+    - bus power failure is detected via the DALI line watchdog
+
+  \note
+  - requires 1ms system tick millis(), see stmr.h
+  - DALI bit clock prescaler and line watchdog prescaler depend on fMaster,
+    see DALI_PRESCALER and DALI_WDG_PRESCALER. Check values against the
+    reference manual for your clock setting
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _DALI_H_
+#define _DALI_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// DALI bit rate [Hz]. Default can be overwritten in config.h
+#ifndef DALI_BAUD
+  #define DALI_BAUD             1200
+#endif
+
+// DALI bit clock prescaler DALI_CLK (10b). Default can be overwritten in config.h
+#ifndef DALI_PRESCALER
+  #define DALI_PRESCALER        ((uint16_t) (F_MASTER / (16L * DALI_BAUD) - 1))
+#endif
+
+// line watchdog prescaler DALI_CSR1.WDG_PRSC (0..7). Default can be overwritten in config.h
+#ifndef DALI_WDG_PRESCALER
+  #define DALI_WDG_PRESCALER    7
+#endif
+
+// size of receive queue [frames]. Must be power of 2. Default can be overwritten in config.h
+#ifndef DALI_RX_QUEUE
+  #define DALI_RX_QUEUE         8
+#endif
+
+/// min. delay between end of forward frame and backward frame [ms], incl. 1ms tick jitter
+#define DALI_ANSWER_MIN         4
+
+/// max. delay between end of forward frame and backward frame [ms]
+#define DALI_ANSWER_MAX         8
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// received forward frame
+typedef struct {
+  uint8_t     addr;         ///< address byte (1st byte on bus)
+  uint8_t     data;         ///< opcode or data byte (2nd byte on bus)
+  uint16_t    time;         ///< time of reception [ms], lower 16b of millis()
+} dali_frame_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// initialize DALI peripheral in control gear mode and enable interrupt
+void DALI_begin(void);
+
+/// get number of queued forward frames
+uint8_t DALI_available(void);
+
+/// get oldest forward frame from queue. Returns 0 if queue is empty
+uint8_t DALI_read(dali_frame_t *frame);
+
+/// send backward frame as answer to forward frame. Returns 0 if too late
+uint8_t DALI_answer(const dali_frame_t *frame, uint8_t data);
+
+/// check for bus power failure. Is cleared by next valid frame
+uint8_t DALI_busFail(void);
+
+/// time since last bus activity [ms], saturated at 65535
+uint16_t DALI_idle(void);
+
+/// get and clear number of receive errors (framing or queue overflow)
+uint8_t DALI_errors(void);
+
+/// ISR for DALI frame reception and line watchdog
+ISR_HANDLER(DALI_ISR, _DALI_ITF_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _DALI_H_
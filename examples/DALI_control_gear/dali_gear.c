@@ -0,0 +1,1019 @@
+/**
+  \file dali_gear.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of DALI control gear application layer
+
+  implementation of the IEC 62386-102 command set subset, fading and
+  persistence of the control gear variables.
+
+  Persistent variables are packed into keys of the key/value store:
+    - key 0: max. level, min. level, power-on level, system failure level
+    - key 1: short address, fade time, fade rate
+    - key 2: group membership (16b)
+    - key 3: random address (24b)
+    - key 4..7: scene levels, 4 scenes per key
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "dali_gear.h"
+#include "kv_store.h"
+#include "stmr.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// check settings (negative array size on error)
+typedef char gear_check_keys[(GEAR_NUM_KEYS <= KV_NUM_KEYS) ? 1 : -1];
+typedef char gear_check_phm[((GEAR_PHM >= 1) && (GEAR_PHM <= 254)) ? 1 : -1];
+
+// keys in key/value store
+#define KEY_LEVELS          0         ///< max, min, power-on, system failure level
+#define KEY_CONFIG          1         ///< short address, fade time, fade rate
+#define KEY_GROUPS          2         ///< group membership
+#define KEY_RANDOM          3         ///< random address
+#define KEY_SCENES          4         ///< scenes 0-3, 4-7, 8-11, 12-15 in keys 4..7
+
+// special values
+#define NO_ADDRESS          0xFF      ///< no short address assigned
+#define YES                 0xFF      ///< answer "YES"
+
+// timing [ms]
+#define TWICE_TIME          100       ///< max. time between config commands sent twice
+#define UP_DOWN_TIME        200       ///< fade duration of UP and DOWN
+#define INIT_TIME           900000L   ///< duration of initialisation state (15min)
+
+// STATUS bits
+#define STATUS_LAMP_ON      0x04      ///< lamp arc power on
+#define STATUS_LIMIT        0x08      ///< limit error
+#define STATUS_FADE         0x10      ///< fade running
+#define STATUS_RESET        0x20      ///< reset state
+#define STATUS_NO_ADDRESS   0x40      ///< missing short address
+#define STATUS_POWER_FAIL   0x80      ///< power failure
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// fade time for X=0..15 [ms]. Fade time 0 is immediate
+static const uint32_t   m_fadeTime[16] = {
+  0, 707, 1000, 1414, 2000, 2828, 4000, 5657,
+  8000, 11314, 16000, 22627, 32000, 45255, 64000, 90510
+};
+
+/// fade rate for X=1..15 [steps/ms in 16.16 fixed point]. X=0 is invalid
+static const uint16_t   m_fadeRate[16] = {
+  23449, 23449, 16581, 11724, 8290, 5862, 4145, 2931,
+  2073, 1466, 1036, 733, 518, 366, 259, 183
+};
+
+// persistent variables (stored in EEPROM)
+static uint8_t          m_shortAddr;          ///< short address 0..63 or NO_ADDRESS
+static uint8_t          m_maxLevel;           ///< max. level
+static uint8_t          m_minLevel;           ///< min. level
+static uint8_t          m_powerOnLevel;       ///< power-on level
+static uint8_t          m_sysFailLevel;       ///< system failure level
+static uint8_t          m_fadeTimeX;          ///< fade time index 0..15
+static uint8_t          m_fadeRateX;          ///< fade rate index 1..15
+static uint16_t         m_groups;             ///< group membership bitmask
+static uint32_t         m_random;             ///< random address (24b)
+static uint8_t          m_scene[16];          ///< scene levels or GEAR_MASK
+
+/// keys to be written to EEPROM (bitmask)
+static uint8_t          m_dirty;
+
+// volatile variables
+static uint8_t          m_actual;             ///< actual arc power level
+static uint8_t          m_lastActive;         ///< last active level != 0
+static uint8_t          m_dtr[3];             ///< data transfer registers DTR0..2
+static uint8_t          m_limitError;         ///< last requested level was out of limits
+static uint8_t          m_powerFail;          ///< no arc power command since power-on
+static uint8_t          m_sysFail;            ///< system failure level applied
+
+// fading
+static uint8_t          m_fading;             ///< fade running
+static uint8_t          m_fadeOff;            ///< switch off at end of fade
+static uint8_t          m_target;             ///< target level of fade
+static uint32_t         m_level32;            ///< fading level [16.16 fixed point]
+static uint32_t         m_step32;             ///< fade step per ms [16.16 fixed point]
+static uint16_t         m_fadeLeft;           ///< remaining fade duration [ms], 0=until target
+static uint16_t         m_lastTick;           ///< time of last fade update [ms]
+
+// send-twice and addressing
+static dali_frame_t     m_twice;              ///< last config frame, waiting for repetition
+static uint8_t          m_twicePending;       ///< m_twice is valid
+static uint8_t          m_initialised;        ///< initialisation state active
+static uint32_t         m_initStart;          ///< start of initialisation state [ms]
+static uint8_t          m_withdrawn;          ///< withdrawn from compare process
+static uint32_t         m_search;             ///< search address (24b)
+static uint32_t         m_seed;               ///< state of random generator
+
+
+
+/**
+  \fn static void setParam(uint8_t *param, uint8_t value, uint8_t key)
+
+  \brief change persistent byte variable
+
+  \param[in]  param   variable to change
+  \param[in]  value   new value
+  \param[in]  key     key containing variable
+
+  mark key for EEPROM write only if value actually changed.
+*/
+static void setParam(uint8_t *param, uint8_t value, uint8_t key) {
+
+  if (*param != value) {
+    *param = value;
+    m_dirty |= (uint8_t) (1 << key);
+  }
+
+} // setParam
+
+
+
+/**
+  \fn static uint32_t packKey(uint8_t key)
+
+  \brief pack persistent variables of key into 32b value
+
+  \param[in]  key     key to pack
+
+  \return value for key/value store
+*/
+static uint32_t packKey(uint8_t key) {
+
+  uint8_t   *s;
+
+  switch (key) {
+    case KEY_LEVELS:
+      return(((uint32_t) m_sysFailLevel << 24) | ((uint32_t) m_powerOnLevel << 16) | ((uint16_t) m_minLevel << 8) | m_maxLevel);
+    case KEY_CONFIG:
+      return(((uint32_t) m_fadeRateX << 16) | ((uint16_t) m_fadeTimeX << 8) | m_shortAddr);
+    case KEY_GROUPS:
+      return(m_groups);
+    case KEY_RANDOM:
+      return(m_random);
+    default:
+      s = &(m_scene[(key - KEY_SCENES) << 2]);
+      return(((uint32_t) s[3] << 24) | ((uint32_t) s[2] << 16) | ((uint16_t) s[1] << 8) | s[0]);
+  }
+
+} // packKey
+
+
+
+/**
+  \fn static void unpackKey(uint8_t key, uint32_t value)
+
+  \brief unpack persistent variables of key from 32b value
+
+  \param[in]  key     key to unpack
+  \param[in]  value   value from key/value store
+*/
+static void unpackKey(uint8_t key, uint32_t value) {
+
+  uint8_t   *s;
+
+  switch (key) {
+    case KEY_LEVELS:
+      m_maxLevel     = (uint8_t) value;
+      m_minLevel     = (uint8_t) (value >> 8);
+      m_powerOnLevel = (uint8_t) (value >> 16);
+      m_sysFailLevel = (uint8_t) (value >> 24);
+      break;
+    case KEY_CONFIG:
+      m_shortAddr = (uint8_t) value;
+      m_fadeTimeX = (uint8_t) (value >> 8);
+      m_fadeRateX = (uint8_t) (value >> 16);
+      break;
+    case KEY_GROUPS:
+      m_groups = (uint16_t) value;
+      break;
+    case KEY_RANDOM:
+      m_random = value & 0x00FFFFFF;
+      break;
+    default:
+      s = &(m_scene[(key - KEY_SCENES) << 2]);
+      s[0] = (uint8_t) value;
+      s[1] = (uint8_t) (value >> 8);
+      s[2] = (uint8_t) (value >> 16);
+      s[3] = (uint8_t) (value >> 24);
+  }
+
+} // unpackKey
+
+
+
+/**
+  \fn static void setDefaults(void)
+
+  \brief set persistent variables to reset values
+
+  set all persistent variables except short address and random address to
+  their IEC 62386-102 reset values and mark them for EEPROM write.
+*/
+static void setDefaults(void) {
+
+  uint8_t   i;
+
+  setParam(&m_maxLevel,     254,      KEY_LEVELS);
+  setParam(&m_minLevel,     GEAR_PHM, KEY_LEVELS);
+  setParam(&m_powerOnLevel, 254,      KEY_LEVELS);
+  setParam(&m_sysFailLevel, 254,      KEY_LEVELS);
+  setParam(&m_fadeTimeX,    0,        KEY_CONFIG);
+  setParam(&m_fadeRateX,    7,        KEY_CONFIG);
+  for (i=0; i<16; i++)
+    setParam(&(m_scene[i]), GEAR_MASK, KEY_SCENES + (i >> 2));
+  if (m_groups != 0x0000) {
+    m_groups = 0x0000;
+    m_dirty |= (1 << KEY_GROUPS);
+  }
+
+} // setDefaults
+
+
+
+/**
+  \fn static uint8_t isResetState(void)
+
+  \brief check if all variables have reset values
+
+  \return 1 if in reset state, else 0
+*/
+static uint8_t isResetState(void) {
+
+  uint8_t   i;
+
+  if ((m_actual != 254) || (m_maxLevel != 254) || (m_minLevel != GEAR_PHM) || (m_powerOnLevel != 254) ||
+      (m_sysFailLevel != 254) || (m_fadeTimeX != 0) || (m_fadeRateX != 7) || (m_groups != 0x0000) ||
+      (m_random != 0x00FFFFFF) || (m_search != 0x00FFFFFF))
+    return(0);
+  for (i=0; i<16; i++) {
+    if (m_scene[i] != GEAR_MASK)
+      return(0);
+  }
+
+  return(1);
+
+} // isResetState
+
+
+
+/**
+  \fn static void startFade(uint8_t target, uint32_t step, uint16_t duration)
+
+  \brief start fade from actual level to target level
+
+  \param[in]  target    target level (0=off)
+  \param[in]  step      fade step per ms [16.16 fixed point]
+  \param[in]  duration  max. fade duration [ms], 0=until target is reached
+
+  fading to off ends at min. level, then the lamp is switched off. Fading
+  from off starts at min. level.
+*/
+static void startFade(uint8_t target, uint32_t step, uint16_t duration) {
+
+  // fade to off: fade to min. level, then switch off
+  m_fadeOff = (target == 0);
+  if (m_fadeOff)
+    target = m_minLevel;
+
+  // fade from off: start at min. level
+  if (m_actual == 0)
+    m_actual = m_minLevel;
+
+  m_target   = target;
+  m_level32  = (uint32_t) m_actual << 16;
+  m_step32   = (step != 0) ? step : 1;
+  m_fadeLeft = duration;
+  m_lastTick = (uint16_t) millis();
+  m_fading   = 1;
+
+} // startFade
+
+
+
+/**
+  \fn static void fadeUpdate(uint16_t dt)
+
+  \brief update fading level
+
+  \param[in]  dt    time since last update [ms]
+*/
+static void fadeUpdate(uint16_t dt) {
+
+  uint32_t  target32 = (uint32_t) m_target << 16;
+  uint32_t  delta    = m_step32 * dt;
+
+  // move level towards target
+  if (m_level32 < target32) {
+    if (target32 - m_level32 <= delta)
+      m_level32 = target32;
+    else
+      m_level32 += delta;
+  }
+  else {
+    if (m_level32 - target32 <= delta)
+      m_level32 = target32;
+    else
+      m_level32 -= delta;
+  }
+  m_actual = (uint8_t) (m_level32 >> 16);
+
+  // check end of fade (target reached or max. duration elapsed)
+  if (m_level32 == target32)
+    m_fading = 0;
+  else if (m_fadeLeft != 0) {
+    if (m_fadeLeft <= dt)
+      m_fading = 0;
+    else
+      m_fadeLeft -= dt;
+  }
+
+  // fade to off finished
+  if ((!m_fading) && (m_fadeOff)) {
+    m_actual  = 0;
+    m_fadeOff = 0;
+  }
+
+} // fadeUpdate
+
+
+
+/**
+  \fn static void setArc(uint8_t level, uint8_t fade)
+
+  \brief set arc power level
+
+  \param[in]  level   new level (0=off, GEAR_MASK=stop fading)
+  \param[in]  fade    1: fade with fade time, 0: immediate
+
+  clip level to min/max, set limit error and start fade or set level
+  immediately. Clears the power failure flag.
+*/
+static void setArc(uint8_t level, uint8_t fade) {
+
+  uint8_t   diff;
+
+  m_powerFail = 0;
+
+  // MASK stops a running fade
+  if (level == GEAR_MASK) {
+    m_fading  = 0;
+    m_fadeOff = 0;
+    return;
+  }
+
+  // clip to min/max
+  m_limitError = 0;
+  if (level != 0) {
+    if (level > m_maxLevel) {
+      level = m_maxLevel;
+      m_limitError = 1;
+    }
+    else if (level < m_minLevel) {
+      level = m_minLevel;
+      m_limitError = 1;
+    }
+    m_lastActive = level;
+  }
+
+  // immediate, or lamp already off
+  if ((!fade) || (m_fadeTimeX == 0) || ((level == 0) && (m_actual == 0))) {
+    m_fading  = 0;
+    m_fadeOff = 0;
+    m_actual  = level;
+    return;
+  }
+
+  // fade with fade time, i.e. step depends on distance
+  diff = (level == 0) ? m_minLevel : level;
+  if (m_actual == 0)
+    diff = (diff > m_minLevel) ? (diff - m_minLevel) : 0;
+  else
+    diff = (diff > m_actual) ? (diff - m_actual) : (m_actual - diff);
+  startFade(level, ((uint32_t) diff << 16) / m_fadeTime[m_fadeTimeX], 0);
+
+} // setArc
+
+
+
+/**
+  \fn static uint8_t addressed(uint8_t addr)
+
+  \brief check if frame is addressed to this gear
+
+  \param[in]  addr    address byte of frame
+
+  \return 1 if addressed, else 0
+*/
+static uint8_t addressed(uint8_t addr) {
+
+  // broadcast 1111111S
+  if ((addr & 0xFE) == 0xFE)
+    return(1);
+
+  // broadcast unaddressed 1111110S
+  if ((addr & 0xFE) == 0xFC)
+    return(m_shortAddr == NO_ADDRESS);
+
+  // short address 0AAAAAAS
+  if (!(addr & 0x80))
+    return((addr >> 1) == m_shortAddr);
+
+  // group address 100GGGGS
+  if ((addr & 0xE0) == 0x80)
+    return((uint8_t) (m_groups >> ((addr >> 1) & 0x0F)) & 0x01);
+
+  return(0);
+
+} // addressed
+
+
+
+/**
+  \fn static uint8_t isConfig(const dali_frame_t *frame)
+
+  \brief check if frame must be sent twice
+
+  \param[in]  frame   forward frame
+
+  \return 1 for configuration commands, INITIALISE and RANDOMISE
+*/
+static uint8_t isConfig(const dali_frame_t *frame) {
+
+  // special commands 101CCCC1 and 110CCCC1
+  if (((frame->addr & 0xE1) == 0xA1) || ((frame->addr & 0xE1) == 0xC1))
+    return((frame->addr == 0xA5) || (frame->addr == 0xA7));
+
+  // commands 32..129 (not direct arc power)
+  return((frame->addr & 0x01) && (frame->data >= 32) && (frame->data <= 129));
+
+} // isConfig
+
+
+
+/**
+  \fn static uint8_t twice(const dali_frame_t *frame)
+
+  \brief check send-twice condition
+
+  \param[in]  frame   forward frame with configuration command
+
+  \return 1 if frame is identical repetition within 100ms, else 0
+
+  a configuration command is only executed if the identical frame was
+  received within 100ms before, without another frame in between.
+*/
+static uint8_t twice(const dali_frame_t *frame) {
+
+  if ((m_twicePending) && (frame->addr == m_twice.addr) && (frame->data == m_twice.data) &&
+      ((uint16_t) (frame->time - m_twice.time) <= TWICE_TIME)) {
+    m_twicePending = 0;
+    return(1);
+  }
+
+  // 1st frame, wait for repetition
+  m_twice = *frame;
+  m_twicePending = 1;
+
+  return(0);
+
+} // twice
+
+
+
+/**
+  \fn static uint32_t randomAddr(void)
+
+  \brief generate new 24b random address
+
+  \return random address 0x000000..0xFFFFFE
+
+  xorshift generator seeded by reception times of frames.
+*/
+static uint32_t randomAddr(void) {
+
+  m_seed ^= millis();
+  if (m_seed == 0)
+    m_seed = 0x2545F491;
+  m_seed ^= m_seed << 13;
+  m_seed ^= m_seed >> 17;
+  m_seed ^= m_seed << 5;
+
+  // 0xFFFFFF is reserved for "no random address"
+  if ((m_seed & 0x00FFFFFF) == 0x00FFFFFF)
+    return(0x00FFFFFE);
+
+  return(m_seed & 0x00FFFFFF);
+
+} // randomAddr
+
+
+
+/**
+  \fn static void command(const dali_frame_t *frame, uint8_t confirmed)
+
+  \brief execute addressed command
+
+  \param[in]  frame       forward frame with command in data byte
+  \param[in]  confirmed   configuration command was sent twice
+*/
+static void command(const dali_frame_t *frame, uint8_t confirmed) {
+
+  uint8_t   cmd = frame->data;
+  uint8_t   tmp, status;
+  uint16_t  groups;
+
+  // arc power control commands 0..31
+  if (cmd < 32) {
+
+    // commands w/o effect if lamp is off
+    if ((m_actual == 0) && ((cmd >= 1) && (cmd <= 4)))
+      return;
+
+    switch (cmd) {
+      case 0:   // OFF
+        setArc(0, 0);
+        break;
+      case 1:   // UP
+        m_powerFail = 0;
+        startFade(m_maxLevel, m_fadeRate[m_fadeRateX], UP_DOWN_TIME);
+        break;
+      case 2:   // DOWN
+        m_powerFail = 0;
+        startFade(m_minLevel, m_fadeRate[m_fadeRateX], UP_DOWN_TIME);
+        break;
+      case 3:   // STEP UP
+        if (m_actual < m_maxLevel)
+          setArc(m_actual + 1, 0);
+        break;
+      case 4:   // STEP DOWN
+        if (m_actual > m_minLevel)
+          setArc(m_actual - 1, 0);
+        break;
+      case 5:   // RECALL MAX LEVEL
+        setArc(m_maxLevel, 0);
+        break;
+      case 6:   // RECALL MIN LEVEL
+        setArc(m_minLevel, 0);
+        break;
+      case 7:   // STEP DOWN AND OFF
+        setArc((m_actual <= m_minLevel) ? 0 : m_actual - 1, 0);
+        break;
+      case 8:   // ON AND STEP UP
+        setArc((m_actual == 0) ? m_minLevel : ((m_actual < m_maxLevel) ? m_actual + 1 : m_actual), 0);
+        break;
+      case 10:  // GO TO LAST ACTIVE LEVEL
+        setArc(m_lastActive, 1);
+        break;
+      default:  // GO TO SCENE 16..31, others ignored
+        if ((cmd >= 16) && (m_scene[cmd & 0x0F] != GEAR_MASK))
+          setArc(m_scene[cmd & 0x0F], 1);
+        break;
+    }
+    return;
+
+  } // arc power control
+
+  // configuration commands 32..129, only if sent twice
+  if (cmd <= 129) {
+
+    if (!confirmed)
+      return;
+
+    switch (cmd) {
+      case 32:  // RESET
+        setDefaults();
+        m_actual = 254;
+        m_fading = 0;
+        m_search = 0x00FFFFFF;
+        if (m_random != 0x00FFFFFF) {
+          m_random = 0x00FFFFFF;
+          m_dirty |= (1 << KEY_RANDOM);
+        }
+        m_powerFail = 0;
+        break;
+      case 33:  // STORE ACTUAL LEVEL IN DTR0
+        m_dtr[0] = m_actual;
+        break;
+      case 42:  // SET MAX LEVEL (DTR0)
+        tmp = m_dtr[0];
+        if (tmp < m_minLevel) tmp = m_minLevel;
+        if (tmp > 254)        tmp = 254;
+        setParam(&m_maxLevel, tmp, KEY_LEVELS);
+        if (m_actual > m_maxLevel)
+          setArc(m_maxLevel, 0);
+        break;
+      case 43:  // SET MIN LEVEL (DTR0)
+        tmp = m_dtr[0];
+        if (tmp < GEAR_PHM)   tmp = GEAR_PHM;
+        if (tmp > m_maxLevel) tmp = m_maxLevel;
+        setParam(&m_minLevel, tmp, KEY_LEVELS);
+        if ((m_actual != 0) && (m_actual < m_minLevel))
+          setArc(m_minLevel, 0);
+        break;
+      case 44:  // SET SYSTEM FAILURE LEVEL (DTR0)
+        setParam(&m_sysFailLevel, m_dtr[0], KEY_LEVELS);
+        break;
+      case 45:  // SET POWER ON LEVEL (DTR0)
+        setParam(&m_powerOnLevel, m_dtr[0], KEY_LEVELS);
+        break;
+      case 46:  // SET FADE TIME (DTR0)
+        setParam(&m_fadeTimeX, (m_dtr[0] > 15) ? 15 : m_dtr[0], KEY_CONFIG);
+        break;
+      case 47:  // SET FADE RATE (DTR0)
+        tmp = m_dtr[0];
+        if (tmp == 0) tmp = 1;
+        if (tmp > 15) tmp = 15;
+        setParam(&m_fadeRateX, tmp, KEY_CONFIG);
+        break;
+      case 128: // SET SHORT ADDRESS (DTR0)
+        if (m_dtr[0] == 0xFF)
+          setParam(&m_shortAddr, NO_ADDRESS, KEY_CONFIG);
+        else if ((m_dtr[0] & 0x81) == 0x01)
+          setParam(&m_shortAddr, m_dtr[0] >> 1, KEY_CONFIG);
+        break;
+      default:
+        // SET SCENE 64..79 (DTR0), REMOVE FROM SCENE 80..95
+        if ((cmd >= 64) && (cmd <= 95))
+          setParam(&(m_scene[cmd & 0x0F]), (cmd < 80) ? m_dtr[0] : GEAR_MASK, KEY_SCENES + ((cmd & 0x0F) >> 2));
+
+        // ADD TO GROUP 96..111, REMOVE FROM GROUP 112..127
+        else if ((cmd >= 96) && (cmd <= 127)) {
+          groups = m_groups;
+          if (cmd < 112)
+            groups |= (uint16_t) (1 << (cmd & 0x0F));
+          else
+            groups &= (uint16_t) ~(1 << (cmd & 0x0F));
+          if (groups != m_groups) {
+            m_groups = groups;
+            m_dirty |= (1 << KEY_GROUPS);
+          }
+        }
+        break;
+    }
+    return;
+
+  } // configuration commands
+
+  // queries. Answer "NO" means no backward frame
+  switch (cmd) {
+    case 144: // QUERY STATUS
+      status = 0x00;
+      if (m_actual != 0)             status |= STATUS_LAMP_ON;
+      if (m_limitError)              status |= STATUS_LIMIT;
+      if (m_fading)                  status |= STATUS_FADE;
+      if (isResetState())            status |= STATUS_RESET;
+      if (m_shortAddr == NO_ADDRESS) status |= STATUS_NO_ADDRESS;
+      if (m_powerFail)               status |= STATUS_POWER_FAIL;
+      DALI_answer(frame, status);
+      break;
+    case 145: // QUERY CONTROL GEAR PRESENT
+      DALI_answer(frame, YES);
+      break;
+    case 147: // QUERY LAMP POWER ON
+      if (m_actual != 0)
+        DALI_answer(frame, YES);
+      break;
+    case 148: // QUERY LIMIT ERROR
+      if (m_limitError)
+        DALI_answer(frame, YES);
+      break;
+    case 149: // QUERY RESET STATE
+      if (isResetState())
+        DALI_answer(frame, YES);
+      break;
+    case 150: // QUERY MISSING SHORT ADDRESS
+      if (m_shortAddr == NO_ADDRESS)
+        DALI_answer(frame, YES);
+      break;
+    case 151: // QUERY VERSION NUMBER
+      DALI_answer(frame, 1);
+      break;
+    case 152: // QUERY CONTENT DTR0
+      DALI_answer(frame, m_dtr[0]);
+      break;
+    case 153: // QUERY DEVICE TYPE
+      DALI_answer(frame, GEAR_DEVICE_TYPE);
+      break;
+    case 154: // QUERY PHYSICAL MINIMUM
+      DALI_answer(frame, GEAR_PHM);
+      break;
+    case 155: // QUERY POWER FAILURE
+      if (m_powerFail)
+        DALI_answer(frame, YES);
+      break;
+    case 156: // QUERY CONTENT DTR1
+      DALI_answer(frame, m_dtr[1]);
+      break;
+    case 157: // QUERY CONTENT DTR2
+      DALI_answer(frame, m_dtr[2]);
+      break;
+    case 160: // QUERY ACTUAL LEVEL
+      DALI_answer(frame, m_actual);
+      break;
+    case 161: // QUERY MAX LEVEL
+      DALI_answer(frame, m_maxLevel);
+      break;
+    case 162: // QUERY MIN LEVEL
+      DALI_answer(frame, m_minLevel);
+      break;
+    case 163: // QUERY POWER ON LEVEL
+      DALI_answer(frame, m_powerOnLevel);
+      break;
+    case 164: // QUERY SYSTEM FAILURE LEVEL
+      DALI_answer(frame, m_sysFailLevel);
+      break;
+    case 165: // QUERY FADE TIME/FADE RATE
+      DALI_answer(frame, (uint8_t) ((m_fadeTimeX << 4) | m_fadeRateX));
+      break;
+    case 192: // QUERY GROUPS 0-7
+      DALI_answer(frame, (uint8_t) m_groups);
+      break;
+    case 193: // QUERY GROUPS 8-15
+      DALI_answer(frame, (uint8_t) (m_groups >> 8));
+      break;
+    case 194: // QUERY RANDOM ADDRESS (H)
+      DALI_answer(frame, (uint8_t) (m_random >> 16));
+      break;
+    case 195: // QUERY RANDOM ADDRESS (M)
+      DALI_answer(frame, (uint8_t) (m_random >> 8));
+      break;
+    case 196: // QUERY RANDOM ADDRESS (L)
+      DALI_answer(frame, (uint8_t) m_random);
+      break;
+    default:
+      // QUERY SCENE LEVEL 176..191, others ignored
+      if ((cmd >= 176) && (cmd <= 191))
+        DALI_answer(frame, m_scene[cmd & 0x0F]);
+      break;
+  }
+
+} // command
+
+
+
+/**
+  \fn static void special(const dali_frame_t *frame, uint8_t confirmed)
+
+  \brief execute special command
+
+  \param[in]  frame       forward frame with special command in address byte
+  \param[in]  confirmed   INITIALISE or RANDOMISE was sent twice
+*/
+static void special(const dali_frame_t *frame, uint8_t confirmed) {
+
+  uint8_t   data = frame->data;
+
+  switch (frame->addr) {
+    case 0xA1:  // TERMINATE
+      m_initialised = 0;
+      break;
+    case 0xA3:  // DATA TRANSFER REGISTER 0
+      m_dtr[0] = data;
+      break;
+    case 0xA5:  // INITIALISE (twice)
+      if ((confirmed) && ((data == 0x00) || ((data == 0xFF) && (m_shortAddr == NO_ADDRESS)) ||
+          (((data & 0x81) == 0x01) && ((data >> 1) == m_shortAddr)))) {
+        m_initialised = 1;
+        m_initStart   = millis();
+        m_withdrawn   = 0;
+      }
+      break;
+    case 0xA7:  // RANDOMISE (twice)
+      if ((confirmed) && (m_initialised)) {
+        m_random = randomAddr();
+        m_dirty |= (1 << KEY_RANDOM);
+      }
+      break;
+    case 0xA9:  // COMPARE
+      if ((m_initialised) && (!m_withdrawn) && (m_random <= m_search))
+        DALI_answer(frame, YES);
+      break;
+    case 0xAB:  // WITHDRAW
+      if ((m_initialised) && (m_random == m_search))
+        m_withdrawn = 1;
+      break;
+    case 0xB1:  // SEARCHADDRH
+      m_search = (m_search & 0x0000FFFF) | ((uint32_t) data << 16);
+      break;
+    case 0xB3:  // SEARCHADDRM
+      m_search = (m_search & 0x00FF00FF) | ((uint16_t) data << 8);
+      break;
+    case 0xB5:  // SEARCHADDRL
+      m_search = (m_search & 0x00FFFF00) | data;
+      break;
+    case 0xB7:  // PROGRAM SHORT ADDRESS
+      if ((m_initialised) && (m_random == m_search)) {
+        if (data == 0xFF)
+          setParam(&m_shortAddr, NO_ADDRESS, KEY_CONFIG);
+        else if ((data & 0x81) == 0x01)
+          setParam(&m_shortAddr, data >> 1, KEY_CONFIG);
+      }
+      break;
+    case 0xB9:  // VERIFY SHORT ADDRESS
+      if ((m_initialised) && (m_shortAddr != NO_ADDRESS) && (data == (uint8_t) ((m_shortAddr << 1) | 0x01)))
+        DALI_answer(frame, YES);
+      break;
+    case 0xBB:  // QUERY SHORT ADDRESS
+      if ((m_initialised) && (m_random == m_search))
+        DALI_answer(frame, (m_shortAddr == NO_ADDRESS) ? 0xFF : (uint8_t) ((m_shortAddr << 1) | 0x01));
+      break;
+    case 0xC3:  // DATA TRANSFER REGISTER 1
+      m_dtr[1] = data;
+      break;
+    case 0xC5:  // DATA TRANSFER REGISTER 2
+      m_dtr[2] = data;
+      break;
+    default:    // PHYSICAL SELECTION, ENABLE DEVICE TYPE etc. not supported
+      break;
+  }
+
+} // special
+
+
+
+/**
+  \fn void GEAR_frame(const dali_frame_t *frame)
+
+  \brief process single forward frame
+
+  \param[in]  frame   received forward frame
+
+  check send-twice condition for all frames on the bus, then execute special
+  commands or commands addressed to this gear.
+*/
+void GEAR_frame(const dali_frame_t *frame) {
+
+  uint8_t   confirmed = 0;
+
+  // any other frame cancels a pending send-twice
+  if (isConfig(frame))
+    confirmed = twice(frame);
+  else
+    m_twicePending = 0;
+
+  // reception times seed random generator
+  m_seed += frame->time;
+
+  // special commands
+  if (((frame->addr & 0xE1) == 0xA1) || ((frame->addr & 0xE1) == 0xC1)) {
+    special(frame, confirmed);
+    return;
+  }
+
+  // ignore frames for other gears
+  if (!addressed(frame->addr))
+    return;
+
+  // direct arc power control YAAAAAA0
+  if (!(frame->addr & 0x01))
+    setArc(frame->data, 1);
+
+  // command YAAAAAA1
+  else
+    command(frame, confirmed);
+
+} // GEAR_frame
+
+
+
+/**
+  \fn void GEAR_begin(void)
+
+  \brief load persistent variables and go to power-on level
+
+  read persistent variables from key/value store. Keys not found (e.g. after
+  first programming) are initialized with reset values. Then go to power-on
+  level and set power failure flag.
+*/
+void GEAR_begin(void) {
+
+  uint8_t   key;
+  uint32_t  value;
+
+  // reset values
+  m_shortAddr    = NO_ADDRESS;
+  m_random       = 0x00FFFFFF;
+  m_search       = 0x00FFFFFF;
+  m_groups       = 0x0000;
+  m_maxLevel     = 0;
+  m_minLevel     = 0;
+  m_powerOnLevel = 0;
+  m_sysFailLevel = 0;
+  m_fadeTimeX    = 0;
+  m_fadeRateX    = 0;
+  for (key=0; key<16; key++)
+    m_scene[key] = 0;
+  setDefaults();
+
+  // overwrite with stored values. Only missing keys remain dirty
+  KV_begin();
+  for (key=0; key<GEAR_NUM_KEYS; key++) {
+    if (KV_read(key, &value)) {
+      unpackKey(key, value);
+      m_dirty &= (uint8_t) ~(1 << key);
+    }
+  }
+
+  // go to power-on level. MASK recalls max. level (actual level is not stored)
+  m_actual     = 0;
+  m_lastActive = m_maxLevel;
+  setArc((m_powerOnLevel == GEAR_MASK) ? m_maxLevel : m_powerOnLevel, 0);
+  m_powerFail  = 1;
+  m_lastTick   = (uint16_t) millis();
+
+} // GEAR_begin
+
+
+
+/**
+  \fn void GEAR_task(void)
+
+  \brief background task of control gear
+
+  call in main loop. Actions:
+    - process all queued forward frames
+    - update fading level
+    - apply system failure level on bus power failure
+    - end initialisation state after 15min
+    - write one changed key to EEPROM if bus is idle. Writing is deferred,
+      as EEPROM programming blocks interrupts for several ms
+*/
+void GEAR_task(void) {
+
+  dali_frame_t  frame;
+  uint16_t      now, dt;
+  uint8_t       key;
+
+  // process queued frames
+  while (DALI_read(&frame))
+    GEAR_frame(&frame);
+
+  // update fading
+  now = (uint16_t) millis();
+  dt  = now - m_lastTick;
+  if (dt != 0) {
+    m_lastTick = now;
+    if (m_fading)
+      fadeUpdate(dt);
+  }
+
+  // system failure
+  if (DALI_busFail()) {
+    if (!m_sysFail) {
+      m_sysFail = 1;
+      if (m_sysFailLevel != GEAR_MASK)
+        setArc(m_sysFailLevel, 0);
+    }
+  }
+  else
+    m_sysFail = 0;
+
+  // end of initialisation state
+  if ((m_initialised) && ((millis() - m_initStart) > INIT_TIME))
+    m_initialised = 0;
+
+  // deferred EEPROM write, one key per call
+  if ((m_dirty) && (DALI_idle() >= GEAR_SAVE_IDLE)) {
+    for (key=0; key<GEAR_NUM_KEYS; key++) {
+      if (m_dirty & (1 << key)) {
+        if (KV_write(key, packKey(key)))
+          m_dirty &= (uint8_t) ~(1 << key);
+        break;
+      }
+    }
+  }
+
+} // GEAR_task
+
+
+
+/**
+  \fn uint8_t GEAR_level(void)
+
+  \brief get actual arc power level
+
+  \return actual level (0=off, GEAR_PHM..254)
+*/
+uint8_t GEAR_level(void) {
+
+  return(m_actual);
+
+} // GEAR_level
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,92 @@
+/**
+  \file dali_gear.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of DALI control gear application layer
+
+  declaration of a DALI control gear (IEC 62386-102 subset) on top of the
+  DALI physical layer in dali.c. Features:
+    - short, group, broadcast and broadcast unaddressed addressing
+    - direct arc power control, commands OFF..GO TO LAST ACTIVE LEVEL and
+      GO TO SCENE with fade time and fade rate
+    - configuration commands with send-twice check (100ms)
+    - queries for status, levels, scenes, groups and random address
+    - special commands for addressing (INITIALISE, RANDOMISE, COMPARE,
+      WITHDRAW, SEARCHADDR, PROGRAM/VERIFY/QUERY SHORT ADDRESS) and DTR0..2
+    - system failure level on bus power failure
+    - persistent variables (short address, levels, fade, groups, scenes,
+      random address) are stored in the wear-leveled key/value store in
+      EEPROM. Writes are deferred until the bus is idle, see GEAR_SAVE_IDLE
+
+  \note
+  - the actual level is not stored. Power-on level MASK recalls max. level
+  - device type and memory banks are not supported
+  - the output stage reads the arc power level via GEAR_level(). Conversion
+    to a (logarithmic) dimming curve is done by the application
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _DALI_GEAR_H_
+#define _DALI_GEAR_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "dali.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// physical minimum level (1..254). Default can be overwritten in config.h
+#ifndef GEAR_PHM
+  #define GEAR_PHM              1
+#endif
+
+// device type reported by QUERY DEVICE TYPE (6=LED). Default can be overwritten in config.h
+#ifndef GEAR_DEVICE_TYPE
+  #define GEAR_DEVICE_TYPE      6
+#endif
+
+// min. bus idle time before EEPROM write [ms]. Default can be overwritten in config.h
+#ifndef GEAR_SAVE_IDLE
+  #define GEAR_SAVE_IDLE        200
+#endif
+
+/// number of keys used in key/value store
+#define GEAR_NUM_KEYS           8
+
+/// level / scene value "MASK", i.e. no change
+#define GEAR_MASK               0xFF
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// load persistent variables and go to power-on level. Requires DALI_begin()
+void GEAR_begin(void);
+
+/// process queued frames, fading, timers and deferred EEPROM writes. Call in main loop
+void GEAR_task(void);
+
+/// process single forward frame. Is called by GEAR_task()
+void GEAR_frame(const dali_frame_t *frame);
+
+/// get actual arc power level (0=off, GEAR_PHM..254)
+uint8_t GEAR_level(void);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _DALI_GEAR_H_
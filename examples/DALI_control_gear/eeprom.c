@@ -0,0 +1,202 @@
+/**
+  \file eeprom.c
+   
+  \author G. Icking-Konert
+  \date 2013-11-22
+  \version 0.1
+   
+  \brief implementation of EEPROM functions/macros
+   
+  implementation of EEPROM functions.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "eeprom.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// STLUX flash registers are prefixed and DWord programming bit is called WWO
+#if defined(FAMILY_STLUX)
+  #define FLASH_DUKR        sfr_FLASH.FLASH_DUKR
+  #define FLASH_IAPSR       sfr_FLASH.FLASH_IAPSR
+  #define FLASH_WPRG        sfr_FLASH.FLASH_CR2.WWO
+  #define FLASH_NWPRG       sfr_FLASH.FLASH_NCR2.NWWO
+#else
+  #define FLASH_DUKR        sfr_FLASH.DUKR
+  #define FLASH_IAPSR       sfr_FLASH.IAPSR
+  #define FLASH_WPRG        sfr_FLASH.CR2.WPRG
+  #define FLASH_NWPRG       sfr_FLASH.NCR2.NWPRG
+#endif
+
+
+
+/**
+  \fn uint8_t EEPROM_writeByte(uint16_t logAddr, uint8_t data)
+  
+  \brief write 1B to D-flash / EEPROM
+  
+  \param[in] logAddr    logical address to write to (starting from EEPROM_ADDR_START)
+  \param[in] data       byte to program
+  
+  \return write successful(=1) or error(=0)
+
+  write single byte to logical address in D-flash / EEPROM
+*/
+uint8_t EEPROM_writeByte(uint16_t logAddr, uint8_t data) {
+
+  uint16_t   addr = EEPROM_ADDR_START + logAddr;  // physical address 
+  uint8_t    countTimeout;                        // timeout counter
+  
+  // address range check
+  if (logAddr > EEPROM_SIZE)
+    return(0);
+  
+  // begin critical cection (disable interrupts)
+  DISABLE_INTERRUPTS();
+  
+  // unlock w/e access to EEPROM
+  FLASH_DUKR.byte = 0xAE;
+  FLASH_DUKR.byte = 0x56;
+    
+  // wait until access granted
+  while(!FLASH_IAPSR.DUL);
+  
+  // write byte in 16-bit address range
+  *((uint8_t*) addr) = data;
+
+  // wait until done or timeout (normal flash write measured with 0 --> 100 is more than sufficient)
+  countTimeout = 100;                                // ~0.95us/inc -> ~0.1ms
+  while ((!FLASH_IAPSR.EOP) && (countTimeout--));
+    
+  // lock EEPROM again against accidental erase/write
+  FLASH_IAPSR.DUL = 0;
+  
+  // critical section (enable interrupts)
+  ENABLE_INTERRUPTS();
+
+  // write successful -> return 1
+  return(countTimeout != 0);
+
+} // EEPROM_writeByte
+
+
+
+/**
+  \fn uint8_t EEPROM_readByte(uint16_t logAddr)
+  
+  \brief read 1B from D-flash / EEPROM
+  
+  \param[in] logAddr    logical address to read from (starting from EEPROM_ADDR_START)
+  
+  \return read byte (0xFF on error)
+
+  read single byte from logical address in D-flash / EEPROM
+*/
+uint8_t EEPROM_readByte(uint16_t logAddr) {
+
+  uint16_t   addr = EEPROM_ADDR_START + logAddr;  // physical address 
+  
+  // address range check
+  if (logAddr > EEPROM_SIZE)
+    return(0xFF);
+  
+  // return read data
+  return(*((uint8_t*) addr));
+
+} // EEPROM_readByte
+
+
+
+/**
+  \fn uint8_t EEPROM_writeDWord(uint16_t logAddr, uint32_t data)
+  
+  \brief write 4B to D-flash / EEPROM (big-endian)
+  
+  \param[in] logAddr    logical address to write to (starting from EEPROM_ADDR_START)
+  \param[in] data       double word (4B) to program
+  
+  \return write successful(=1) or error(=0)
+
+  write 4 bytes to logical address in D-flash / EEPROM (big-endian). Note: ECC is over 4B
+*/
+uint8_t EEPROM_writeDWord(uint16_t logAddr, uint32_t data) {
+
+  uint16_t   addr = EEPROM_ADDR_START + logAddr;  // physical address 
+  uint8_t    countTimeout;                        // timeout counter
+  
+  // address range check
+  if (logAddr > EEPROM_SIZE-3)
+    return(0);
+  
+  // begin critical cection (disable interrupts)
+  DISABLE_INTERRUPTS();
+  
+  // unlock w/e access to EEPROM
+  FLASH_DUKR.byte = 0xAE;
+  FLASH_DUKR.byte = 0x56;
+    
+  // wait until access granted
+  while(!FLASH_IAPSR.DUL);
+    
+  // enable DWord programming mode
+  FLASH_WPRG = 1;
+  FLASH_NWPRG = 0;
+
+  // write byte in 16-bit address range
+  *((uint32_t*) addr) = data;
+
+  // wait until done or timeout (normal flash write measured with 0 --> 100 is more than sufficient)
+  countTimeout = 100;                                // ~0.95us/inc -> ~0.1ms
+  while ((!FLASH_IAPSR.EOP) && (countTimeout--));
+    
+  // lock EEPROM again against accidental erase/write
+  FLASH_IAPSR.DUL = 0;
+   
+  // reset programming mode
+  FLASH_WPRG = 0;
+  FLASH_NWPRG = 1;
+  
+  // critical section (enable interrupts)
+  ENABLE_INTERRUPTS();
+
+  // write successful -> return 1
+  return(countTimeout != 0);
+
+} // EEPROM_writeDWord
+
+
+
+/**
+  \fn uint32_t EEPROM_readDWord(uint16_t logAddr)
+  
+  \brief read 4B from D-flash / EEPROM
+  
+  \param[in] logAddr    logical address to read from (starting from EEPROM_ADDR_START)
+  
+  \return read 4B from D-flash / EEPROM (0xFFFFFFFF on error)
+
+  read 4 bytes to logical address in D-flash / EEPROM (big-endian)
+*/
+uint32_t EEPROM_readDWord(uint16_t logAddr) {
+
+  uint16_t   addr = EEPROM_ADDR_START + logAddr;  // physical address 
+  
+  // address range check
+  if (logAddr > EEPROM_SIZE-3)
+    return(0xFFFFFFFF);
+  
+  // return read data
+  return(*((uint32_t*) addr));
+
+} // EEPROM_readDWord
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
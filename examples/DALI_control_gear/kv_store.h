@@ -0,0 +1,84 @@
+/**
+  \file kv_store.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of wear-leveled key/value store in D-flash / EEPROM
+
+  declaration of a log-structured key/value store in D-flash / EEPROM. Each update
+  appends a new CRC protected record, older records of the same key become stale.
+  This spreads write cycles evenly over the whole area (wear leveling), and a
+  reset during a write leaves the previous value intact (power-fail safe).
+
+  Record format (12B = 3 DWords, big-endian):
+    - DWord 0: value
+    - DWord 1: sequence number (incremented with each write)
+    - DWord 2: key (1B), reserved (1B, 0x00), CRC16-CCITT over bytes 0-9 (2B)
+
+  \note
+  - DWords are written in above order. As the CRC is written last, an
+    interrupted write results in an invalid record, which is ignored
+  - records are DWord aligned, i.e. each DWord write covers one ECC word
+  - number of keys KV_NUM_KEYS must be < number of slots - 1
+  - lookup via RAM index of KV_NUM_KEYS bytes, which is rebuilt by KV_begin()
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _KV_STORE_H_
+#define _KV_STORE_H_
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+// number of keys [0..KV_NUM_KEYS-1]. Default can be overwritten in config.h
+#ifndef KV_NUM_KEYS
+  #define KV_NUM_KEYS       16
+#endif
+
+// logical start address of store in EEPROM. Default can be overwritten in config.h
+#ifndef KV_ADDR_START
+  #define KV_ADDR_START     0
+#endif
+
+// size of store in EEPROM [B]. Default is complete EEPROM, can be overwritten in config.h
+#ifndef KV_SIZE
+  #define KV_SIZE           (EEPROM_SIZE - KV_ADDR_START)
+#endif
+
+/// size of one record [B]
+#define KV_RECORD_SIZE      12
+
+/// number of record slots in store
+#define KV_NUM_SLOTS        (KV_SIZE / KV_RECORD_SIZE)
+
+
+/*----------------------------------------------------------
+    GLOBAL FUNCTIONS
+----------------------------------------------------------*/
+
+/// scan EEPROM and build RAM index. Returns number of stored keys
+uint8_t KV_begin(void);
+
+/// read value of key. Returns 1 if found, else 0
+uint8_t KV_read(uint8_t key, uint32_t *value);
+
+/// write value of key. Returns 1 on success, else 0
+uint8_t KV_write(uint8_t key, uint32_t value);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _KV_STORE_H_
@@ -0,0 +1,76 @@
+/**********************
+  DALI control gear with interrupt-driven frame handling and persistent settings
+
+  supported hardware:
+    - STLUX385A with DALI bus interface (other STLUX devices after changing config.h)
+
+  Functionality:
+    - forward frames are received in the DALI interrupt and queued, answers
+      (backward frames) are sent within the IEC 62386-101 timing window
+    - IEC 62386-102 subset: addressing, arc power, scenes, groups, fading,
+      queries and special commands for address assignment by a DALI master
+    - settings (short address, levels, fade, scenes, groups) are stored in
+      the wear-leveled key/value store in EEPROM while the bus is idle
+    - demo lamp output on P0.0 is switched on/off by the arc power level.
+      For real dimming, drive a SMED PWM from GEAR_level() instead
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "stmr.h"
+  #include "dali.h"
+  #include "dali_gear.h"
+#undef _MAIN_
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.DIVR.byte = 0x00;
+
+  // lamp pin to push-pull output
+  LAMP_PORT.DDR.byte |= LAMP_PIN;   // input(=0) or output(=1)
+  LAMP_PORT.CR1.byte |= LAMP_PIN;   // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+
+  // init 1ms tick
+  STMR_init();
+
+  // init DALI interface
+  DALI_begin();
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // load settings and go to power-on level. Requires 1ms tick for timestamps
+  GEAR_begin();
+
+  // main loop
+  while(1) {
+
+    // process queued frames, fading, timers and EEPROM writes
+    GEAR_task();
+
+    // set lamp output
+    if (GEAR_level() != 0)
+      LAMP_PORT.ODR.byte |= LAMP_PIN;
+    else
+      LAMP_PORT.ODR.byte &= (uint8_t) ~LAMP_PIN;
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
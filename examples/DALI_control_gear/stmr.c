@@ -0,0 +1,93 @@
+/**
+  \file stmr.c
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief implementation of system timer STMR (1ms clock) functions/macros
+   
+  implementation of system timer STMR functions as 1ms master clock (fMaster=16MHz).
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "stmr.h"
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void STMR_init(void)
+   
+  \brief init system timer STMR for 1ms master clock with interrupt
+   
+  init 16-bit timer STMR with 1ms tick. Is used for SW master clock
+  via below interrupt.
+*/
+void STMR_init(void) {
+
+  // stop the timer
+  sfr_STMR.STMR_CR1.CEN = 0;
+  
+  // initialize global clock variables
+  g_flagMilli = 0;
+  g_millis    = 0;
+  
+  // clear counter
+  sfr_STMR.STMR_CNTH.byte = 0x00;
+  sfr_STMR.STMR_CNTL.byte = 0x00;
+
+  // auto-reload value buffered
+  sfr_STMR.STMR_CR1.ARPE = 1;
+
+  // clear pending events
+  sfr_STMR.STMR_EGR.byte  = 0x00;
+
+  // set clock to 16Mhz/2^7 = 125kHz -> 8us period
+  sfr_STMR.STMR_PSCL.PSC = 7;
+
+  // set autoreload value for 1ms (=125*8us). Period is ARR+1
+  sfr_STMR.STMR_ARRH.byte = 0;
+  sfr_STMR.STMR_ARRL.byte = 124;
+
+  // enable STMR interrupt
+  sfr_STMR.STMR_IER.UIE = 1;
+  
+  // start the timer
+  sfr_STMR.STMR_CR1.CEN = 1;
+  
+} // STMR_init
+
+
+
+/**
+  \fn void STMR_UPD_ISR(void)
+   
+  \brief ISR for system timer STMR (1ms master clock)
+   
+  interrupt service routine for system timer STMR.
+  Used for 1ms system clock.
+
+  Note: 
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(STMR_UPD_ISR, _STMR_OVF_VECTOR_) {
+
+  // clear STMR interrupt flag
+  sfr_STMR.STMR_SR1.UIF = 0;
+
+  // set/increase global variables
+  g_millis++;
+  g_flagMilli = 1;
+    
+  return;
+
+} // STMR_UPD_ISR
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,66 @@
+/**
+  \file stmr.h
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief declaration of system timer STMR (1ms clock) functions/macros
+   
+  declaration of system timer STMR functions as 1ms master clock (fMaster=16MHz).
+  STLUX devices have no TIM4, therefore the basic timer STMR is used instead
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _STMR_H_
+#define _STMR_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL VARIABLES
+-----------------------------------------------------------------------------*/
+
+// declare or reference to global variables, depending on '_MAIN_'
+#if defined(_MAIN_)
+  volatile uint8_t            g_flagMilli;                 ///< flag for 1ms timer interrupt. Set in STMR ISR
+  volatile uint32_t           g_millis;                    ///< 1ms counter. Increased in STMR ISR
+#else // _MAIN_
+  extern volatile uint8_t     g_flagMilli;
+  extern volatile uint32_t    g_millis;
+#endif // _MAIN_
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+#define flagMilli()           g_flagMilli                   ///< 1ms flag. Set in 1ms ISR
+#define clearFlagMilli()      g_flagMilli=0                 ///< clear 1ms flag
+#define millis()              g_millis                      ///< get milliseconds since start of program
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init system timer STMR (1ms master clock). Requires fMaster=16MHz
+void STMR_init(void);
+
+/// ISR for system timer STMR (1ms master clock)
+ISR_HANDLER(STMR_UPD_ISR, _STMR_OVF_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _STMR_H_
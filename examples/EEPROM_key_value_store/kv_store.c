@@ -0,0 +1,336 @@
+/**
+  \file kv_store.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of wear-leveled key/value store in D-flash / EEPROM
+
+  implementation of a log-structured key/value store in D-flash / EEPROM.
+  Records are written round-robin to all slots. Before a slot is re-used, a
+  still valid (=live) record in the following slot is copied forward. This
+  keeps the slot after the write position always free, so that a reset never
+  destroys the last valid record of any key.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "kv_store.h"
+#include "eeprom.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+/// index value for key not stored
+#define KV_NO_SLOT          0xFF
+
+/// initial value of CRC16-CCITT
+#define KV_CRC_INIT         0xFFFF
+
+// check configuration at compile time (negative array size on error)
+typedef char kv_check_slots[((KV_NUM_SLOTS > KV_NUM_KEYS + 1) && (KV_NUM_SLOTS < KV_NO_SLOT)) ? 1 : -1];
+typedef char kv_check_range[(KV_ADDR_START + KV_SIZE <= EEPROM_SIZE) ? 1 : -1];
+typedef char kv_check_align[((KV_ADDR_START % 4) == 0) ? 1 : -1];
+
+
+/*----------------------------------------------------------
+    TYPEDEFS
+----------------------------------------------------------*/
+
+/// content of one record
+typedef struct {
+  uint32_t  value;          ///< stored value
+  uint32_t  seq;            ///< sequence number
+  uint8_t   key;            ///< key
+} kv_record_t;
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// RAM index: slot of latest record per key, or KV_NO_SLOT
+static uint8_t    m_index[KV_NUM_KEYS];
+
+/// slot for next write. Is always free (no live record)
+static uint8_t    m_head;
+
+/// sequence number for next write
+static uint32_t   m_seq;
+
+
+
+/**
+  \fn uint16_t KV_crc(uint16_t crc, uint32_t data, uint8_t num)
+
+  \brief update CRC16-CCITT with up to 4 bytes
+
+  \param[in] crc        current CRC value
+  \param[in] data       data to add (big-endian)
+  \param[in] num        number of bytes to add, starting with MSB
+
+  \return updated CRC value
+*/
+static uint16_t KV_crc(uint16_t crc, uint32_t data, uint8_t num) {
+
+  uint8_t   i, j;
+
+  for (i=0; i<num; i++) {
+    crc ^= (uint16_t) ((data >> 16) & 0xFF00);
+    data <<= 8;
+    for (j=0; j<8; j++) {
+      if (crc & 0x8000)
+        crc = (crc << 1) ^ 0x1021;
+      else
+        crc = (crc << 1);
+    }
+  }
+
+  return(crc);
+
+} // KV_crc
+
+
+
+/**
+  \fn uint8_t KV_readRecord(uint8_t slot, kv_record_t *rec)
+
+  \brief read record from slot and check CRC
+
+  \param[in]  slot      slot to read
+  \param[out] rec       record content
+
+  \return valid record(=1) or empty/corrupt slot(=0)
+*/
+static uint8_t KV_readRecord(uint8_t slot, kv_record_t *rec) {
+
+  uint16_t  addr = KV_ADDR_START + (uint16_t) slot * KV_RECORD_SIZE;
+  uint32_t  last;
+  uint16_t  crc;
+
+  // read 3 DWords
+  rec->value = EEPROM_readDWord(addr);
+  rec->seq   = EEPROM_readDWord(addr+4);
+  last       = EEPROM_readDWord(addr+8);
+  rec->key   = (uint8_t) (last >> 24);
+
+  // check CRC over bytes 0-9. Note: erased slot (all 0x00) has invalid CRC
+  crc = KV_crc(KV_CRC_INIT, rec->value, 4);
+  crc = KV_crc(crc, rec->seq, 4);
+  crc = KV_crc(crc, last, 2);
+
+  return((crc == (uint16_t) last) && (rec->key < KV_NUM_KEYS));
+
+} // KV_readRecord
+
+
+
+/**
+  \fn uint8_t KV_writeRecord(uint8_t slot, kv_record_t *rec)
+
+  \brief write record to slot and verify it
+
+  \param[in] slot       slot to write
+  \param[in] rec        record content
+
+  \return write successful(=1) or error(=0)
+
+  write record as 3 DWords with the CRC last, then read back and check
+*/
+static uint8_t KV_writeRecord(uint8_t slot, kv_record_t *rec) {
+
+  uint16_t    addr = KV_ADDR_START + (uint16_t) slot * KV_RECORD_SIZE;
+  uint32_t    last;
+  uint16_t    crc;
+  kv_record_t verify;
+
+  // calculate CRC over bytes 0-9
+  last = ((uint32_t) rec->key) << 24;
+  crc = KV_crc(KV_CRC_INIT, rec->value, 4);
+  crc = KV_crc(crc, rec->seq, 4);
+  crc = KV_crc(crc, last, 2);
+  last |= crc;
+
+  // write value & sequence, then key & CRC. Slot is only valid after last write
+  if (!EEPROM_writeDWord(addr, rec->value))
+    return(0);
+  if (!EEPROM_writeDWord(addr+4, rec->seq))
+    return(0);
+  if (!EEPROM_writeDWord(addr+8, last))
+    return(0);
+
+  // read back and compare
+  if (!KV_readRecord(slot, &verify))
+    return(0);
+  return((verify.value == rec->value) && (verify.seq == rec->seq) && (verify.key == rec->key));
+
+} // KV_writeRecord
+
+
+
+/**
+  \fn uint8_t KV_liveKey(uint8_t slot)
+
+  \brief get key of live record in slot
+
+  \param[in] slot       slot to check
+
+  \return key of latest record stored in slot, or KV_NO_SLOT if slot is free
+*/
+static uint8_t KV_liveKey(uint8_t slot) {
+
+  uint8_t   key;
+
+  for (key=0; key<KV_NUM_KEYS; key++) {
+    if (m_index[key] == slot)
+      return(key);
+  }
+  return(KV_NO_SLOT);
+
+} // KV_liveKey
+
+
+
+/**
+  \fn uint8_t KV_begin(void)
+
+  \brief scan EEPROM and build RAM index
+
+  \return number of stored keys
+
+  scan all slots for valid records. For each key the record with the highest
+  sequence number is used. Next write position is the slot after the newest record.
+*/
+uint8_t KV_begin(void) {
+
+  kv_record_t rec, old;
+  uint8_t     slot, num, newest;
+
+  // reset index
+  for (slot=0; slot<KV_NUM_KEYS; slot++)
+    m_index[slot] = KV_NO_SLOT;
+  m_seq  = 0;
+  newest = KV_NUM_SLOTS - 1;
+
+  // scan all slots
+  for (slot=0; slot<KV_NUM_SLOTS; slot++) {
+    if (!KV_readRecord(slot, &rec))
+      continue;
+
+    // keep newest record per key
+    if ((m_index[rec.key] == KV_NO_SLOT) || (!KV_readRecord(m_index[rec.key], &old)) || (rec.seq > old.seq))
+      m_index[rec.key] = slot;
+
+    // track newest record overall
+    if (rec.seq >= m_seq) {
+      m_seq  = rec.seq + 1;
+      newest = slot;
+    }
+  }
+
+  // next write position after newest record
+  m_head = (newest + 1) % KV_NUM_SLOTS;
+
+  // count stored keys
+  num = 0;
+  for (slot=0; slot<KV_NUM_KEYS; slot++)
+    num += (m_index[slot] != KV_NO_SLOT);
+  return(num);
+
+} // KV_begin
+
+
+
+/**
+  \fn uint8_t KV_read(uint8_t key, uint32_t *value)
+
+  \brief read value of key
+
+  \param[in]  key       key to read [0..KV_NUM_KEYS-1]
+  \param[out] value     stored value
+
+  \return key found(=1) or not(=0)
+*/
+uint8_t KV_read(uint8_t key, uint32_t *value) {
+
+  kv_record_t rec;
+
+  // key not stored
+  if ((key >= KV_NUM_KEYS) || (m_index[key] == KV_NO_SLOT))
+    return(0);
+
+  // read record via index
+  if (!KV_readRecord(m_index[key], &rec))
+    return(0);
+  *value = rec.value;
+  return(1);
+
+} // KV_read
+
+
+
+/**
+  \fn uint8_t KV_write(uint8_t key, uint32_t value)
+
+  \brief write value of key
+
+  \param[in] key        key to write [0..KV_NUM_KEYS-1]
+  \param[in] value      value to store
+
+  \return write successful(=1) or error(=0)
+
+  append new record at write position. If the slot after it holds a live record
+  of another key, that record is first copied to the write position. Unchanged
+  values are not written to save EEPROM cycles.
+*/
+uint8_t KV_write(uint8_t key, uint32_t value) {
+
+  kv_record_t rec;
+  uint8_t     next, live;
+  uint32_t    old;
+
+  // key out of range
+  if (key >= KV_NUM_KEYS)
+    return(0);
+
+  // value unchanged -> skip write
+  if ((KV_read(key, &old)) && (old == value))
+    return(1);
+
+  // copy live records of other keys forward, until slot after write position is free
+  next = (m_head + 1) % KV_NUM_SLOTS;
+  while (((live = KV_liveKey(next)) != KV_NO_SLOT) && (live != key)) {
+    if (!KV_readRecord(next, &rec))
+      return(0);
+    rec.seq = m_seq;
+    if (!KV_writeRecord(m_head, &rec))
+      return(0);
+    m_seq++;
+    m_index[live] = m_head;
+    m_head = next;
+    next = (m_head + 1) % KV_NUM_SLOTS;
+  }
+
+  // write new record
+  rec.value = value;
+  rec.seq   = m_seq;
+  rec.key   = key;
+  if (!KV_writeRecord(m_head, &rec))
+    return(0);
+  m_seq++;
+  m_index[key] = m_head;
+  m_head = next;
+
+  return(1);
+
+} // KV_write
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
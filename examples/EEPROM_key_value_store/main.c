@@ -0,0 +1,115 @@
+/**********************
+  Wear-leveled, power-fail safe key/value store in EEPROM
+  
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+  
+  Functionality:
+    - restore key/value store from EEPROM at boot
+    - count resets in key KEY_BOOTS
+    - update operating time counter in key KEY_SECONDS every second
+    - print values to terminal 
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "uart2.h"
+  #include "kv_store.h"
+#undef _MAIN_
+
+// used keys
+#define KEY_BOOTS     0
+#define KEY_SECONDS   1
+
+
+/**
+  \fn int putchar(int byte)
+   
+  \brief output routine for printf()
+  
+  \param[in]  data   byte to send
+  
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Use send routine set via putchar_attach()
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data) {
+#else // Standard C
+  int putchar(int data) {
+#endif
+
+  // send byte
+  UART2_write(data);
+  
+  // return sent byte
+  return(data);
+  
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void) {
+
+  uint32_t  boots, seconds;
+  uint32_t  i;
+  uint8_t   num;
+  
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+    
+  // init UART2 for 19.2kBaud
+  UART2_begin(19200);
+  
+  // enable interrupts
+  ENABLE_INTERRUPTS();   
+  
+  // restore store from EEPROM
+  num = KV_begin();
+  printf("\nkey/value store: %d keys in %d slots\n", (int) num, (int) KV_NUM_SLOTS);
+
+  // increase boot counter
+  if (!KV_read(KEY_BOOTS, &boots))
+    boots = 0;
+  boots++;
+  KV_write(KEY_BOOTS, boots);
+  printf("boot #%ld\n", (long) boots);
+
+  // restore operating time
+  if (!KV_read(KEY_SECONDS, &seconds))
+    seconds = 0;
+
+  // main loop
+  while(1) {
+
+    // wait ~1s
+    for (i=0; i<800000L; i++)
+      NOP();
+    
+    // update operating time. Reset at any time, value is never lost
+    seconds++;
+    if (KV_write(KEY_SECONDS, seconds))
+      printf("operating time %lds\n", (long) seconds);
+    else
+      printf("write error\n");
+
+  } // main loop
+  
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,131 @@
+/**********************
+  Example application for IAP bootloader in ../
+  
+  supported hardware:
+    - muBoard (http://www.cream-tea.de/presentations/160305_PiAndMore.pdf)
+  
+  Functionality:
+    - linked to IAP_APP_START (see Makefile) and uploaded via ../Utils/iap_upload.py
+    - blink LED in TIM4 ISR, which is forwarded by the bootloader
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES / MACROS
+----------------------------------------------------------*/
+
+// STM8 device header & LED pin (muBoard)
+#include "../../../include/STM8S207MB.h"
+#define LED_PORT   sfr_PORTH
+#define LED_PIN    PIN2
+
+// required for global variables
+#define _MAIN_
+  // no modules with globals required
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    GLOBAL FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void TIM4_UPD_ISR(void)
+   
+  \brief ISR for timer 4 (1ms master clock)
+   
+  interrupt service routine for timer TIM4. Called via vector
+  table of bootloader, which jumps to vector table of application
+
+  Note: 
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(TIM4_UPD_ISR, _TIM4_OVR_UIF_VECTOR_)
+{
+
+  static uint16_t count = 0;
+  
+  // blink LED
+  count++;
+  if (count == 500) {
+    count = 0;
+
+    // toggle LED
+    LED_PORT.ODR.byte ^= LED_PIN;    
+
+  } // 500ms
+  
+  // clear timer 4 interrupt flag
+  sfr_TIM4.SR.UIF = 0;
+  
+  return;
+
+} // TIM4_UPD_ISR
+
+
+/**
+  \fn void TIM4_init(void)
+   
+  \brief init timer 4 for 1ms master clock with interrupt
+*/
+void TIM4_init(void) {
+
+  // stop the timer
+  sfr_TIM4.CR1.CEN = 0;
+  
+  // clear counter
+  sfr_TIM4.CNTR.byte = 0x00;
+
+  // auto-reload value buffered
+  sfr_TIM4.CR1.ARPE = 1;
+
+  // clear pending events
+  sfr_TIM4.EGR.byte  = 0x00;
+
+  // set clock to 16Mhz/2^6 = 250kHz -> 4us period
+  sfr_TIM4.PSCR.PSC = 6;
+
+  // set autoreload value for 1ms (=250*4us)
+  sfr_TIM4.ARR.byte  = 250;
+
+  // enable timer 4 interrupt
+  sfr_TIM4.IER.UIE = 1;
+  
+  // start the timer
+  sfr_TIM4.CR1.CEN = 1;
+  
+} // TIM4_init
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void) {
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (bootloader restores default 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+  
+  // configure LED pin as output
+  LED_PORT.DDR.byte = LED_PIN;    // input(=0) or output(=1)
+  LED_PORT.CR1.byte = LED_PIN;    // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+  LED_PORT.CR2.byte = LED_PIN;    // input: 0=no exint, 1=exint; output: 0=2MHz slope, 1=10MHz slope
+  
+  // init 1ms interrupt
+  TIM4_init();
+  
+  // enable interrupts
+  ENABLE_INTERRUPTS();   
+  
+  // dummy main loop. Action happens in ISR TIM4 TIM4_UPD 
+  while(1) {
+    WAIT_FOR_INTERRUPT();
+  }
+  
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
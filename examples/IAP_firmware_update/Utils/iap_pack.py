@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+
+"""
+Pack STM8 application into a compressed, block-indexed image for the IAP bootloader
+
+Each P-flash block is LZSS compressed separately, so that an interrupted upload
+can be resumed at any block. Back-references may point into previous blocks,
+which the bootloader reads from the staging area. Blocks which do not shrink are
+stored uncompressed. For the stream format see ../lzss.h
+
+File format (big-endian):
+  - header: "IAPZ", version (1B), reserved (1B), block size (2B), start address (4B),
+            image size (4B), image CRC32 (4B), number of blocks (2B)
+  - index:  per block offset in data section (4B) and length (2B). Length = block size -> uncompressed
+  - data:   concatenated blocks
+
+usage:
+  iap_pack.py [-s 0xA000] [-k 128] App/SDCC/main.ihx app.iapz
+"""
+
+import sys
+import zlib
+import struct
+import argparse
+
+# must match ../lzss.h
+LZSS_MIN_MATCH = 3
+LZSS_MAX_MATCH = LZSS_MIN_MATCH + 15
+LZSS_WINDOW = 4096
+
+# max. number of hash candidates checked per position (speed vs. ratio)
+MAX_CANDIDATES = 256
+
+# file format
+MAGIC = b'IAPZ'
+VERSION = 1
+HEADER = '>4sBBHIIIH'
+INDEX = '>IH'
+
+# opcode of STM8 vector table entries (INT)
+OPCODE_INT = 0x82
+
+
+def read_ihx(filename):
+  """ read Intel hex file. Returns dict {address: byte} """
+  mem = {}
+  base = 0
+  with open(filename, 'r') as f:
+    for line in f:
+      line = line.strip()
+      if not line.startswith(':'):
+        continue
+      rec = bytes.fromhex(line[1:])
+      if (sum(rec) & 0xFF) != 0:
+        sys.exit("error: checksum error in '%s'" % line)
+      num, addr, typ = rec[0], (rec[1] << 8) | rec[2], rec[3]
+      data = rec[4:4 + num]
+      if typ == 0x00:
+        for i, b in enumerate(data):
+          mem[base + addr + i] = b
+      elif typ == 0x01:
+        break
+      elif typ == 0x02:
+        base = ((data[0] << 8) | data[1]) << 4
+      elif typ == 0x04:
+        base = ((data[0] << 8) | data[1]) << 16
+  return mem
+
+
+def read_image(filename, start):
+  """ read Intel hex or binary file. Returns (start address, image) """
+  if filename.lower().endswith('.bin'):
+    if start is None:
+      sys.exit("error: start address required for binary file")
+    with open(filename, 'rb') as f:
+      return start, bytearray(f.read())
+  mem = read_ihx(filename)
+  if len(mem) == 0:
+    sys.exit("error: no data in '%s'" % filename)
+  if start is None:
+    start = min(mem)
+  if min(mem) < start:
+    sys.exit("error: data below start address 0x%x" % start)
+  image = bytearray(max(mem) - start + 1)
+  for addr, b in mem.items():
+    image[addr - start] = b
+  return start, image
+
+
+def compress_block(data, pos, end, chains):
+  """ LZSS compress data[pos:end] with history data[pos-LZSS_WINDOW:pos]. Updates hash chains """
+  out = bytearray()
+  flags_idx, bit = 0, 8
+  while pos < end:
+
+    # start new flag byte
+    if bit == 8:
+      flags_idx, bit = len(out), 0
+      out.append(0)
+
+    # find longest match within window. Matches must not cross end of block
+    best_len, best_dist = 0, 0
+    max_len = min(LZSS_MAX_MATCH, end - pos)
+    if max_len >= LZSS_MIN_MATCH:
+      for cand in reversed(chains.get(bytes(data[pos:pos + LZSS_MIN_MATCH]), [])[-MAX_CANDIDATES:]):
+        if pos - cand > LZSS_WINDOW:
+          break
+        n = LZSS_MIN_MATCH
+        while (n < max_len) and (data[cand + n] == data[pos + n]):
+          n += 1
+        if n > best_len:
+          best_len, best_dist = n, pos - cand
+          if n == max_len:
+            break
+
+    # emit match or literal
+    if best_len >= LZSS_MIN_MATCH:
+      code = ((best_len - LZSS_MIN_MATCH) << 12) | (best_dist - 1)
+      out += struct.pack('>H', code)
+      step = best_len
+    else:
+      out[flags_idx] |= (1 << bit)
+      out.append(data[pos])
+      step = 1
+    bit += 1
+
+    # add skipped positions to hash chains
+    for p in range(pos, pos + step):
+      chains.setdefault(bytes(data[p:p + LZSS_MIN_MATCH]), []).append(p)
+    pos += step
+
+  return out
+
+
+def pack(image, block_size):
+  """ compress image block-wise. Returns list of blocks (bytes). Uncompressed blocks have block_size """
+  data = image + bytes((-len(image)) % block_size)
+  chains = {}
+  blocks = []
+  for pos in range(0, len(data), block_size):
+    comp = compress_block(data, pos, pos + block_size, chains)
+    blocks.append(bytes(comp) if len(comp) < block_size else bytes(data[pos:pos + block_size]))
+  return blocks
+
+
+def write_iapz(filename, start, image, block_size):
+  """ pack image and save as .iapz. Returns list of blocks """
+  blocks = pack(image, block_size)
+  crc = zlib.crc32(bytes(image)) & 0xFFFFFFFF
+  with open(filename, 'wb') as f:
+    f.write(struct.pack(HEADER, MAGIC, VERSION, 0, block_size, start, len(image), crc, len(blocks)))
+    offset = 0
+    for b in blocks:
+      f.write(struct.pack(INDEX, offset, len(b)))
+      offset += len(b)
+    for b in blocks:
+      f.write(b)
+  return blocks
+
+
+def read_iapz(filename):
+  """ read .iapz file. Returns dict with header fields and list of blocks """
+  with open(filename, 'rb') as f:
+    raw = f.read()
+  magic, version, _, block_size, start, size, crc, num = struct.unpack_from(HEADER, raw, 0)
+  if (magic != MAGIC) or (version != VERSION):
+    sys.exit("error: '%s' is no valid .iapz file" % filename)
+  base = struct.calcsize(HEADER) + num * struct.calcsize(INDEX)
+  blocks = []
+  for i in range(num):
+    offset, length = struct.unpack_from(INDEX, raw, struct.calcsize(HEADER) + i * struct.calcsize(INDEX))
+    blocks.append(raw[base + offset:base + offset + length])
+  return {'block': block_size, 'start': start, 'size': size, 'crc': crc, 'blocks': blocks}
+
+
+def main():
+
+  parser = argparse.ArgumentParser(description='pack STM8 application into compressed image for IAP bootloader')
+  parser.add_argument('infile', help='application as Intel hex (.ihx/.hex) or binary (.bin)')
+  parser.add_argument('outfile', help='compressed image (.iapz)')
+  parser.add_argument('-s', '--start', type=lambda x: int(x, 0), default=None, help='start address (default: lowest address in hexfile)')
+  parser.add_argument('-k', '--block', type=int, default=128, help='P-flash block size [B] (default 128)')
+  args = parser.parse_args()
+
+  start, image = read_image(args.infile, args.start)
+  if image[0] != OPCODE_INT:
+    sys.exit("error: no vector table at start of image")
+  blocks = write_iapz(args.outfile, start, image, args.block)
+  packed = sum(len(b) for b in blocks)
+  print("packed %dB @ 0x%x into %d blocks: %dB (%d%%), %d uncompressed" %
+        (len(image), start, len(blocks), packed, 100 * packed // len(image),
+         sum(1 for b in blocks if len(b) == args.block)))
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+
+"""
+Upload application to STM8 IAP bootloader via UART
+
+Reads an Intel hex (SDCC output), binary or compressed (.iapz, see iap_pack.py)
+file, connects to the bootloader and transfers the image block-wise. An
+interrupted upload is resumed at the last block committed by the device.
+For frame format and commands see ../main.c
+
+usage:
+  iap_upload.py -p /dev/ttyUSB0 [-b 115200] [-z] App/SDCC/main.ihx
+  iap_upload.py -p /dev/ttyUSB0 -s 0xA000 app.bin
+  iap_upload.py -p /dev/ttyUSB0 app.iapz
+"""
+
+import sys
+import time
+import zlib
+import struct
+import argparse
+import serial
+import iap_pack
+
+# must match ../main.c
+FRAME_SOF = 0x5A
+STATE_NAMES = ['idle', 'receiving', 'verified']
+ERROR_NAMES = {0x00: 'ok', 0x01: 'wrong state', 0x02: 'wrong size', 0x03: 'wrong block', 0x04: 'flash error',
+               0x05: 'EEPROM error', 0x06: 'CRC mismatch', 0x07: 'decompression error', 0x80: 'unknown command', 0x81: 'wrong length',
+               0x82: 'no valid application'}
+
+# feature bits in info reply
+FEATURE_LZSS = 0x01
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+  """ CRC16-CCITT (poly 0x1021, init 0xFFFF, no final xor) """
+  for b in data:
+    crc ^= b << 8
+    for _ in range(8):
+      crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+      crc &= 0xFFFF
+  return crc
+
+
+class Bootloader:
+  """ frame based communication with IAP bootloader """
+
+  def __init__(self, port, baudrate):
+    self.ser = serial.Serial(port, baudrate, timeout=0.2)
+
+  def command(self, cmd, payload=b'', timeout=1.0):
+    """ send command and return reply payload (status first), or None on timeout """
+    body = bytes([ord(cmd)]) + struct.pack('>H', len(payload)) + payload
+    self.ser.reset_input_buffer()
+    self.ser.write(bytes([FRAME_SOF]) + body + struct.pack('>H', crc16_ccitt(body)))
+    self.ser.timeout = timeout
+    while True:
+      b = self.ser.read(1)
+      if len(b) == 0:
+        return None
+      if b[0] == FRAME_SOF:
+        break
+    head = self.ser.read(3)
+    if len(head) != 3:
+      return None
+    length = (head[1] << 8) | head[2]
+    rest = self.ser.read(length + 2)
+    if (len(rest) != length + 2) or (crc16_ccitt(head + rest) != 0) or (head[0] != ord(cmd)):
+      return None
+    return rest[:length]
+
+  def info(self, timeout=1.0):
+    """ get bootloader status as dict, or None on timeout """
+    r = self.command('I', timeout=timeout)
+    if (r is None) or (len(r) != 23):
+      return None
+    state, block, slot, start, progress, size, crc, features = struct.unpack('>BHIIHIIB', r[1:])
+    return {'state': state, 'block': block, 'slot': slot, 'start': start, 'progress': progress, 'size': size, 'crc': crc,
+            'features': features}
+
+
+def check(reply, what):
+  """ check reply status and exit on error """
+  if reply is None:
+    sys.exit("error: no response to '%s'" % what)
+  if reply[0] != 0:
+    sys.exit("error: '%s' failed (%s)" % (what, ERROR_NAMES.get(reply[0], 'error 0x%02x' % reply[0])))
+
+
+def main():
+
+  parser = argparse.ArgumentParser(description='upload application to STM8 IAP bootloader')
+  parser.add_argument('file', help='application as Intel hex (.ihx/.hex), binary (.bin) or compressed image (.iapz)')
+  parser.add_argument('-p', '--port', required=True, help='serial port, e.g. /dev/ttyUSB0')
+  parser.add_argument('-b', '--baudrate', type=int, default=115200, help='baudrate (default 115200)')
+  parser.add_argument('-s', '--start', type=lambda x: int(x, 0), default=None, help='start address of binary file (default: from device)')
+  parser.add_argument('-w', '--wait', type=float, default=30.0, help='max. time to wait for bootloader [s] (default 30)')
+  parser.add_argument('-z', '--compress', action='store_true', help='compress hex or binary file before upload')
+  parser.add_argument('-r', '--run', action='store_true', help='start application after upload')
+  args = parser.parse_args()
+
+  # connect. Bootloader only listens shortly after reset (IAP_BOOT_WAIT), therefore poll fast
+  bsl = Bootloader(args.port, args.baudrate)
+  print("connect to bootloader (reset device) ... ", end='', flush=True)
+  timeout = time.time() + args.wait
+  info = None
+  while (info is None) and (time.time() < timeout):
+    info = bsl.info(timeout=0.05)
+  if info is None:
+    sys.exit("timeout")
+  print("ok\n  state %s, block size %dB, application @ 0x%x, max. size %dB" %
+        (STATE_NAMES[info['state']] if info['state'] < len(STATE_NAMES) else info['state'],
+         info['block'], info['start'], info['slot']))
+
+  # read image. Compressed images are already split into blocks
+  if args.file.lower().endswith('.iapz'):
+    z = iap_pack.read_iapz(args.file)
+    start, size, crc, blocks = z['start'], z['size'], z['crc'], z['blocks']
+    if z['block'] != info['block']:
+      sys.exit("error: image block size %dB differs from device %dB" % (z['block'], info['block']))
+  else:
+    start, image = iap_pack.read_image(args.file, info['start'] if args.start is None else args.start)
+    if image[0] != iap_pack.OPCODE_INT:
+      sys.exit("error: no vector table at start of image")
+    size = len(image)
+    crc = zlib.crc32(bytes(image)) & 0xFFFFFFFF
+    if args.compress:
+      blocks = iap_pack.pack(image, info['block'])
+    else:
+      image += bytes((-size) % info['block'])
+      blocks = [bytes(image[i:i + info['block']]) for i in range(0, len(image), info['block'])]
+  num_blocks = len(blocks)
+
+  # check image
+  if start != info['start']:
+    sys.exit("error: image start 0x%x differs from application start 0x%x. Check --code-loc" % (start, info['start']))
+  if size > info['slot']:
+    sys.exit("error: image size %dB exceeds slot size %dB" % (size, info['slot']))
+  compressed = any(len(b) < info['block'] for b in blocks)
+  if compressed and not (info['features'] & FEATURE_LZSS):
+    sys.exit("error: bootloader does not support compressed images")
+  if compressed:
+    packed = sum(len(b) for b in blocks)
+    print("compressed image %dB (%d%%)" % (packed, 100 * packed // size))
+
+  # start or resume transfer
+  check(bsl.command('S', struct.pack('>II', size, crc)), 'start')
+  status = bsl.info()
+  first = status['progress'] if (status is not None) and (status['size'] == size) and (status['crc'] == crc) else 0
+  if first > 0:
+    print("resume at block %d" % first)
+
+  # send blocks
+  print("upload %dB (CRC32 0x%08x) ... " % (size, crc), end='', flush=True)
+  for block in range(first, num_blocks):
+    cmd = 'W' if len(blocks[block]) == info['block'] else 'C'
+    check(bsl.command(cmd, struct.pack('>H', block) + blocks[block]), 'write block %d' % block)
+    print("\rupload %dB (CRC32 0x%08x) ... %d%%" % (size, crc, 100 * (block + 1) // num_blocks), end='', flush=True)
+  print("")
+
+  # verify and copy to application area. Copy takes ~6ms per block
+  print("verify & install ... ", end='', flush=True)
+  check(bsl.command('F', timeout=2.0 + 0.02 * num_blocks), 'finish')
+  print("ok")
+
+  # optionally start application
+  if args.run:
+    check(bsl.command('R'), 'run')
+    print("application started")
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,63 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device, UART and flash layout for
+  in-application programming (IAP).
+
+  Flash layout:
+    - FLASH_ADDR_START .. IAP_APP_START-1:  this bootloader incl. vector table
+    - IAP_APP_START .. +IAP_SLOT_SIZE-1:    active application (linked to IAP_APP_START)
+    - IAP_STAGE_START .. +IAP_SLOT_SIZE-1:  staging area for received image
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+
+// muBoard (http://www.cream-tea.de/presentations/160305_PiAndMore.pdf)
+#include "../../include/STM8S207MB.h"
+
+
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+// UART for update protocol (muBoard: UART1 via USB bridge)
+#define sfr_UART          sfr_UART1
+#define IAP_BAUDRATE      115200
+
+// start address of application. Literal value, as it is also used by assembler. Must match App/Makefile!
+#define IAP_APP_START     0xA000
+
+// size of application and staging slot [B]. Half of remaining flash, multiple of block size
+#define IAP_SLOT_SIZE     ((((uint32_t) FLASH_ADDR_END + 1 - IAP_APP_START) / 2) & ~((uint32_t) FLASH_BLOCK_SIZE - 1))
+
+// start address of staging area
+#define IAP_STAGE_START   ((uint32_t) IAP_APP_START + IAP_SLOT_SIZE)
+
+// commit receive/copy progress to EEPROM every N blocks. Lower value -> less re-transmission after reset
+#define IAP_COMMIT_BLOCKS 4
+
+// time window after reset to start an update, if a valid application exists [ms]
+#define IAP_BOOT_WAIT     500
+
+// verify CRC32 of application before start (1=yes, 0=no). Takes ~1s for 60kB
+#define IAP_CHECK_APP     1
+
+// keys used in key/value store
+#define KV_NUM_KEYS       8
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
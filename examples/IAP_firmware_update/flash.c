@@ -0,0 +1,423 @@
+/**
+  \file flash.c
+   
+  \author G. Icking-Konert
+  \date 2017-02-19
+  \version 0.1
+   
+  \brief implementation of P-FLASH functions/macros
+   
+  implementation of P-FLASH functions.
+    
+  Note: board selection in Makefile / project options
+*/
+
+/*----------------------------------------------------------
+    SELECT BOARD (via Makefile / IDE project options)
+----------------------------------------------------------*/
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "flash.h"
+#include "memory_access.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// max. size of RAM routine [B] (SDCC & Cosmic only)
+#define FLASH_RAMCODE_SIZE    80
+
+// status bits of register FLASH_IAPSR
+#define FLASH_IAPSR_WR_PG_DIS 0x01
+#define FLASH_IAPSR_EOP       0x04
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// start address of block for RAM routine (big-endian, for SDCC accessed by assembler)
+static volatile uint32_t        m_blockAddr;
+
+/// data source for RAM routine. Must reside in RAM
+static const uint8_t            *m_blockData;
+
+/// number of bytes to write by RAM routine (4 for erase, FLASH_BLOCK_SIZE for programming)
+static volatile uint8_t         m_blockNum;
+
+// for SDCC & Cosmic routine is copied to RAM before first use
+#if !defined(__ICCSTM8__)
+
+  /// buffer for RAM routine
+  static uint8_t                m_ramCode[FLASH_RAMCODE_SIZE];
+
+  /// RAM routine was copied (=1) or not (=0)
+  static uint8_t                m_ramCodeReady = 0;
+
+#endif
+
+
+
+/**
+  \fn uint8_t FLASH_blockRam(void)
+  
+  \brief write data to P-flash block and wait until done (executed from RAM)
+  
+  \return IAPSR status (EOP=success, WR_PG_DIS=write protected, 0=timeout)
+
+  Write m_blockNum bytes from m_blockData to m_blockAddr, then wait until P-flash
+  is ready again. Programming mode must be set by the calling routine.
+  As flash is not accessible during block operations, this routine is executed
+  from RAM and must not call any other routine. For SDCC & Cosmic it must also be
+  position independent, i.e. only relative jumps and absolute data access.
+*/
+#if defined(__ICCSTM8__)
+  __ramfunc uint8_t FLASH_blockRam(void) {
+#else
+  uint8_t FLASH_blockRam(void) {
+#endif
+
+  uint16_t   countTimeout;                       // timeout counter
+  uint8_t    status;                             // status of P-flash
+
+  // SDCC without far pointers: use assembler loop with extended addressing
+#if defined(__SDCC) && (FLASH_ADDR_WIDTH==32)
+  __asm
+    push a
+    pushw x
+    pushw y
+    ldw  y,_m_blockData
+    clrw x
+  00001$:
+    ld   a,(y)
+    ldf  ([_m_blockAddr+1].e,x),a
+    incw y
+    incw x
+    ld   a,xl
+    cp   a,_m_blockNum
+    jrne 00001$
+    popw y
+    popw x
+    pop  a
+  __endasm;
+
+  // 16-bit address range or compiler with far pointers
+#else
+  {
+    uint8_t  i;
+    #if (FLASH_ADDR_WIDTH==16)
+      uint8_t            *pDest = (uint8_t*) ((uint16_t) m_blockAddr);
+    #elif defined(__CSMC__)
+      @far uint8_t       *pDest = (@far uint8_t*) m_blockAddr;
+    #else // IAR
+      uint8_t __far      *pDest = (uint8_t __far*) m_blockAddr;
+    #endif
+    for (i=0; i<m_blockNum; i++)
+      pDest[i] = m_blockData[i];
+  }
+#endif
+
+  // wait until done, write protection error or timeout (block operation takes max. ~6ms)
+  countTimeout = 0xFFFF;                         // ~0.5us/inc @ 16MHz -> ~30ms
+  do {
+    status = sfr_FLASH.IAPSR.byte;
+  } while ((!(status & (FLASH_IAPSR_EOP | FLASH_IAPSR_WR_PG_DIS))) && (--countTimeout));
+
+  // return status. Note: reading IAPSR clears EOP and WR_PG_DIS
+  if (!countTimeout)
+    return(0);
+  return(status & (FLASH_IAPSR_EOP | FLASH_IAPSR_WR_PG_DIS));
+
+} // FLASH_blockRam
+
+
+#if !defined(__ICCSTM8__)
+
+/**
+  \fn void FLASH_blockRamEnd(void)
+  
+  \brief dummy routine to mark end of FLASH_blockRam()
+  
+  dummy routine directly after FLASH_blockRam(). Used to determine size of
+  RAM routine for copying. Must not be moved or removed.
+*/
+void FLASH_blockRamEnd(void) {
+
+} // FLASH_blockRamEnd
+
+#endif // !__ICCSTM8__
+
+
+
+/**
+  \fn uint8_t FLASH_blockExec(uint32_t addr, const uint8_t *buf, uint8_t num)
+  
+  \brief execute block operation via RAM routine
+  
+  \param[in] addr       start address of block
+  \param[in] buf        data to write (in RAM)
+  \param[in] num        number of bytes to write
+  
+  \return success(=1) or error(=0)
+
+  Unlock P-flash, execute RAM routine and lock P-flash again. Programming mode
+  in FLASH_CR2/NCR2 must be set by the calling routine with interrupts disabled.
+*/
+static uint8_t FLASH_blockExec(uint32_t addr, const uint8_t *buf, uint8_t num) {
+
+  uint8_t    status;
+
+  // for SDCC & Cosmic copy routine to RAM before first use
+#if !defined(__ICCSTM8__)
+  if (!m_ramCodeReady) {
+    uint8_t  *pSrc = (uint8_t*) FLASH_blockRam;
+    uint16_t len   = (uint16_t) FLASH_blockRamEnd - (uint16_t) FLASH_blockRam;
+    uint16_t i;
+    if (len > FLASH_RAMCODE_SIZE)
+      return(0);
+    for (i=0; i<len; i++)
+      m_ramCode[i] = pSrc[i];
+    m_ramCodeReady = 1;
+  }
+#endif
+
+  // set parameters for RAM routine
+  m_blockAddr = addr;
+  m_blockData = buf;
+  m_blockNum  = num;
+
+  // unlock w/e access to P-flash
+  sfr_FLASH.PUKR.byte = 0x56;
+  sfr_FLASH.PUKR.byte = 0xAE;
+  
+  // wait until access granted
+  while(!sfr_FLASH.IAPSR.PUL);
+
+  // execute write routine from RAM
+#if defined(__ICCSTM8__)
+  status = FLASH_blockRam();
+#else
+  status = ((uint8_t (*)(void)) m_ramCode)();
+#endif
+
+  // lock P-flash again against accidental erase/write
+  sfr_FLASH.IAPSR.PUL = 0;
+
+  // return success
+  return(status == FLASH_IAPSR_EOP);
+
+} // FLASH_blockExec
+
+
+
+
+/**
+  \fn uint8_t FLASH_writeByte(uint32_t addr, uint8_t data)
+  
+  \brief write 1B to P-flash
+  
+  \param[in] addr       physical address to write to
+  \param[in] data       byte to program
+  
+  \return write successful(=1) or error(=0)
+
+  write single byte to physical address in P-flash
+*/
+uint8_t FLASH_writeByte(uint32_t addr, uint8_t data) {
+
+  uint8_t    countTimeout;                        // timeout counter
+  
+  // address range check
+  if ((addr < FLASH_ADDR_START) || (addr > FLASH_ADDR_END))
+    return(0);
+  
+  // begin critical section (save interrupt state, disable interrupts)
+  SAVE_DISABLE_INTERRUPTS();
+  
+  // unlock w/e access to P-flash
+  sfr_FLASH.PUKR.byte = 0x56;
+  sfr_FLASH.PUKR.byte = 0xAE;
+  
+  // wait until access granted
+  while(!sfr_FLASH.IAPSR.PUL);
+  
+  // write byte using 16-bit or 32-bit macro/function
+  write_1B(addr, data);
+    
+  // wait until done or timeout (normal flash write measured with 0 --> 100 is more than sufficient)
+  countTimeout = 100;                                // ~0.95us/inc -> ~0.1ms
+  while ((!sfr_FLASH.IAPSR.EOP) && (countTimeout--));
+
+  // lock P-flash again against accidental erase/write
+  sfr_FLASH.IAPSR.PUL = 0;
+  
+  // end critical section (restore interrupt state)
+  RESTORE_INTERRUPTS();
+
+  // write successful -> return 1
+  return(countTimeout != 0);
+
+} // FLASH_writeByte
+
+
+
+/**
+  \fn uint8_t FLASH_writeDWord(uint32_t addr, uint32_t data)
+  
+  \brief write 4B to P-flash (big-endian)
+  
+  \param[in] addr       physical address to write to
+  \param[in] data       double word (4B) to program
+  
+  \return write successful(=1) or error(=0)
+
+  write 4 bytes to physical address in P-flash (big-endian). Note: ECC is over 4B
+*/
+uint8_t FLASH_writeDWord(uint32_t addr, uint32_t data) {
+
+  uint8_t    countTimeout;                        // timeout counter
+  
+  // address range check
+  if ((addr < FLASH_ADDR_START) || (addr-3 > FLASH_ADDR_END))
+    return(0);
+  
+  // begin critical section (save interrupt state, disable interrupts)
+  SAVE_DISABLE_INTERRUPTS();
+  
+  // unlock w/e access to P-flash
+  sfr_FLASH.PUKR.byte = 0x56;
+  sfr_FLASH.PUKR.byte = 0xAE;
+  
+  // wait until access granted
+  while(!sfr_FLASH.IAPSR.PUL);
+  
+  // enable DWord programming mode
+  sfr_FLASH.CR2.WPRG = 1;
+  sfr_FLASH.NCR2.NWPRG = 0;
+  
+  // write 4 bytes using 16-bit or 32-bit macro/function (big-endian)
+  write_4B(addr, data);
+
+  // wait until done or timeout (normal flash write measured with 0 --> 100 is more than sufficient)
+  countTimeout = 100;                                // ~0.95us/inc -> ~0.1ms
+  while ((!sfr_FLASH.IAPSR.EOP) && (countTimeout--));
+    
+  // lock P-flash again against accidental erase/write
+  sfr_FLASH.IAPSR.PUL = 0;
+   
+  // reset programming mode
+  sfr_FLASH.CR2.WPRG = 0;
+  sfr_FLASH.NCR2.NWPRG = 1;
+ 
+  // end critical section (restore interrupt state)
+  RESTORE_INTERRUPTS();
+
+  // write successful -> return 1
+  return(countTimeout != 0);
+
+} // FLASH_writeDWord
+
+
+
+/**
+  \fn uint8_t FLASH_eraseBlock(uint32_t addr)
+  
+  \brief erase 1 block in P-flash
+  
+  \param[in] addr       start address of block (aligned to FLASH_BLOCK_SIZE)
+  
+  \return erase successful(=1) or error(=0)
+
+  erase a complete P-flash block (FLASH_BLOCK_SIZE bytes) by writing 4 zero
+  bytes to the block start in erase mode. Takes ~3ms, interrupts are disabled
+  meanwhile
+*/
+uint8_t FLASH_eraseBlock(uint32_t addr) {
+
+  static uint8_t        zero[4] = {0, 0, 0, 0};   // not const, data must reside in RAM
+  uint8_t               result;
+
+  // address range and alignment check
+  if ((addr < FLASH_ADDR_START) || (addr > FLASH_ADDR_END) || (addr % FLASH_BLOCK_SIZE))
+    return(0);
+
+  // begin critical section (save interrupt state, disable interrupts)
+  SAVE_DISABLE_INTERRUPTS();
+
+  // enable block erase mode
+  sfr_FLASH.CR2.ERASE = 1;
+  #if !defined(FAMILY_STM8L) && !defined(FAMILY_STM8L101)
+    sfr_FLASH.NCR2.NERASE = 0;
+  #endif
+
+  // erase block via RAM routine. Mode is reset by hardware
+  result = FLASH_blockExec(addr, zero, 4);
+
+  // end critical section (restore interrupt state)
+  RESTORE_INTERRUPTS();
+
+  return(result);
+
+} // FLASH_eraseBlock
+
+
+
+/**
+  \fn uint8_t FLASH_writeBlock(uint32_t addr, const uint8_t *buf, uint8_t mode)
+  
+  \brief write 1 block to P-flash
+  
+  \param[in] addr       start address of block (aligned to FLASH_BLOCK_SIZE)
+  \param[in] buf        FLASH_BLOCK_SIZE bytes to write. Must reside in RAM
+  \param[in] mode       FLASH_BLOCK_STANDARD (erase & write) or FLASH_BLOCK_FAST (block already erased)
+  
+  \return write successful(=1) or error(=0)
+
+  write a complete P-flash block (FLASH_BLOCK_SIZE bytes) in one programming
+  cycle. Standard mode takes ~6ms, fast mode ~3ms. Interrupts are disabled meanwhile
+*/
+uint8_t FLASH_writeBlock(uint32_t addr, const uint8_t *buf, uint8_t mode) {
+
+  uint8_t    result;
+
+  // address range and alignment check
+  if ((addr < FLASH_ADDR_START) || (addr > FLASH_ADDR_END) || (addr % FLASH_BLOCK_SIZE))
+    return(0);
+
+  // begin critical section (save interrupt state, disable interrupts)
+  SAVE_DISABLE_INTERRUPTS();
+
+  // enable standard or fast block programming mode
+  if (mode == FLASH_BLOCK_FAST) {
+    sfr_FLASH.CR2.FPRG = 1;
+    #if !defined(FAMILY_STM8L) && !defined(FAMILY_STM8L101)
+      sfr_FLASH.NCR2.NFPRG = 0;
+    #endif
+  }
+  else {
+    sfr_FLASH.CR2.PRG = 1;
+    #if !defined(FAMILY_STM8L) && !defined(FAMILY_STM8L101)
+      sfr_FLASH.NCR2.NPRG = 0;
+    #endif
+  }
+
+  // write block via RAM routine. Mode is reset by hardware
+  result = FLASH_blockExec(addr, buf, FLASH_BLOCK_SIZE);
+
+  // end critical section (restore interrupt state)
+  RESTORE_INTERRUPTS();
+
+  return(result);
+
+} // FLASH_writeBlock
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,381 @@
+/**
+  \file iap.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of resumable in-application programming (IAP) engine
+
+  implementation of a power-fail safe firmware update engine. Received blocks are
+  written to the staging area, then the verified image is copied to the
+  application area. Progress is saved in the EEPROM key/value store.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "iap.h"
+#include "flash.h"
+#include "kv_store.h"
+#include "lzss.h"
+#include "crc_ref.h"
+#include "memory_access.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// check configuration at compile time (negative array size on error)
+typedef char iap_check_keys[(KV_NUM_KEYS > IAP_KEY_APP_CRC) ? 1 : -1];
+typedef char iap_check_start[((IAP_APP_START % FLASH_BLOCK_SIZE) == 0) && (IAP_APP_START > FLASH_ADDR_START) ? 1 : -1];
+typedef char iap_check_slot[(IAP_STAGE_START + IAP_SLOT_SIZE <= (uint32_t) FLASH_ADDR_END + 1) ? 1 : -1];
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// current status, mirrors EEPROM except uncommitted progress
+static iap_status_t   m_status;
+
+/// buffer for copying and decompressing blocks. Block programming requires data in RAM
+static uint8_t        m_buf[FLASH_BLOCK_SIZE];
+
+
+
+/**
+  \fn uint32_t IAP_crc(uint32_t addr, uint32_t size)
+
+  \brief calculate CRC32 over P-flash
+
+  \param[in] addr       start address
+  \param[in] size       number of bytes
+
+  \return CRC32 (IEEE 802.3, same as zlib.crc32())
+*/
+static uint32_t IAP_crc(uint32_t addr, uint32_t size) {
+
+  uint32_t  crc = 0xFFFFFFFF;
+
+  while (size--)
+    crc = crc32_update(crc, read_1B(addr++));
+
+  return(crc ^ 0xFFFFFFFF);
+
+} // IAP_crc
+
+
+
+/**
+  \fn uint8_t IAP_commit(uint8_t force)
+
+  \brief save progress to EEPROM
+
+  \param[in] force      save always(=1) or only every IAP_COMMIT_BLOCKS blocks(=0)
+
+  \return IAP_OK or IAP_ERR_EEPROM
+*/
+static uint8_t IAP_commit(uint8_t force) {
+
+  if ((force) || ((m_status.progress % IAP_COMMIT_BLOCKS) == 0)) {
+    if (!KV_write(IAP_KEY_PROGRESS, m_status.progress))
+      return(IAP_ERR_EEPROM);
+  }
+  return(IAP_OK);
+
+} // IAP_commit
+
+
+
+/**
+  \fn uint8_t IAP_copy(void)
+
+  \brief copy verified staging area to application area
+
+  \return IAP_OK or error code
+
+  copy staging area block-wise to application area, starting at committed progress.
+  A reset during copy is uncritical, as IAP_begin() resumes in state IAP_STATE_VERIFIED.
+  After the copy the application is verified and the new image is activated.
+*/
+static uint8_t IAP_copy(void) {
+
+  uint16_t  numBlocks = IAP_NUM_BLOCKS(m_status.size);
+  uint32_t  offset;
+  uint8_t   i;
+
+  // copy remaining blocks via RAM buffer
+  while (m_status.progress < numBlocks) {
+    offset = (uint32_t) m_status.progress * FLASH_BLOCK_SIZE;
+    for (i=0; i<FLASH_BLOCK_SIZE; i++)
+      m_buf[i] = read_1B(IAP_STAGE_START + offset + i);
+    if (!FLASH_writeBlock(IAP_APP_START + offset, m_buf, FLASH_BLOCK_STANDARD))
+      return(IAP_ERR_FLASH);
+    m_status.progress++;
+    if (IAP_commit(0) != IAP_OK)
+      return(IAP_ERR_EEPROM);
+  }
+
+  // verify application. On error restart copy after next reset
+  if (IAP_crc(IAP_APP_START, m_status.size) != m_status.crc) {
+    m_status.progress = 0;
+    IAP_commit(1);
+    return(IAP_ERR_CRC);
+  }
+
+  // activate new application. Until IAP_KEY_STATE is written, a reset repeats these steps
+  if (!KV_write(IAP_KEY_APP_SIZE, m_status.size))
+    return(IAP_ERR_EEPROM);
+  if (!KV_write(IAP_KEY_APP_CRC, m_status.crc))
+    return(IAP_ERR_EEPROM);
+  if (!KV_write(IAP_KEY_STATE, IAP_STATE_IDLE))
+    return(IAP_ERR_EEPROM);
+  m_status.state = IAP_STATE_IDLE;
+
+  return(IAP_OK);
+
+} // IAP_copy
+
+
+
+/**
+  \fn uint8_t IAP_begin(void)
+
+  \brief init engine and finish interrupted copy
+
+  \return IAP_OK or error code
+
+  read status from EEPROM key/value store. If a verified image was not yet
+  completely copied to the application area, resume the copy.
+*/
+uint8_t IAP_begin(void) {
+
+  uint32_t  val;
+
+  // read status. Missing keys default to 0
+  KV_begin();
+  m_status.state    = (KV_read(IAP_KEY_STATE, &val))    ? (uint8_t) val  : IAP_STATE_IDLE;
+  m_status.progress = (KV_read(IAP_KEY_PROGRESS, &val)) ? (uint16_t) val : 0;
+  m_status.size     = (KV_read(IAP_KEY_SIZE, &val))     ? val : 0;
+  m_status.crc      = (KV_read(IAP_KEY_CRC, &val))      ? val : 0;
+
+  // resume interrupted copy
+  if (m_status.state == IAP_STATE_VERIFIED)
+    return(IAP_copy());
+
+  return(IAP_OK);
+
+} // IAP_begin
+
+
+
+/**
+  \fn uint8_t IAP_start(uint32_t size, uint32_t crc)
+
+  \brief start or resume transfer of new image
+
+  \param[in] size       size of image [B]
+  \param[in] crc        CRC32 of image
+
+  \return IAP_OK or error code
+
+  if a transfer of the same image (size & CRC) was interrupted, keep the progress.
+  Else start a new transfer at block 0.
+*/
+uint8_t IAP_start(uint32_t size, uint32_t crc) {
+
+  // check state and size
+  if (m_status.state == IAP_STATE_VERIFIED)
+    return(IAP_ERR_STATE);
+  if ((size == 0) || (size > IAP_SLOT_SIZE))
+    return(IAP_ERR_SIZE);
+
+  // same image -> resume at committed progress
+  if ((m_status.state == IAP_STATE_RECEIVING) && (m_status.size == size) && (m_status.crc == crc))
+    return(IAP_OK);
+
+  // new image. Reset progress first, so that a reset in between is uncritical
+  m_status.progress = 0;
+  if (IAP_commit(1) != IAP_OK)
+    return(IAP_ERR_EEPROM);
+  if ((!KV_write(IAP_KEY_SIZE, size)) || (!KV_write(IAP_KEY_CRC, crc)) || (!KV_write(IAP_KEY_STATE, IAP_STATE_RECEIVING)))
+    return(IAP_ERR_EEPROM);
+  m_status.size  = size;
+  m_status.crc   = crc;
+  m_status.state = IAP_STATE_RECEIVING;
+
+  return(IAP_OK);
+
+} // IAP_start
+
+
+
+/**
+  \fn uint8_t IAP_writeBlock(uint16_t block, const uint8_t *data)
+
+  \brief write one block to staging area
+
+  \param[in] block      block number [0..IAP_NUM_BLOCKS(size)-1]
+  \param[in] data       block data (FLASH_BLOCK_SIZE bytes in RAM)
+
+  \return IAP_OK or error code
+
+  blocks must be written in order. Blocks before the current progress may be
+  re-written, e.g. after a reset between two commits.
+*/
+uint8_t IAP_writeBlock(uint16_t block, const uint8_t *data) {
+
+  // check state and block number
+  if (m_status.state != IAP_STATE_RECEIVING)
+    return(IAP_ERR_STATE);
+  if ((block > m_status.progress) || (block >= IAP_NUM_BLOCKS(m_status.size)))
+    return(IAP_ERR_BLOCK);
+
+  // erase & write block
+  if (!FLASH_writeBlock(IAP_STAGE_START + (uint32_t) block * FLASH_BLOCK_SIZE, data, FLASH_BLOCK_STANDARD))
+    return(IAP_ERR_FLASH);
+
+  // update progress
+  if (block == m_status.progress) {
+    m_status.progress++;
+    return(IAP_commit(m_status.progress == IAP_NUM_BLOCKS(m_status.size)));
+  }
+
+  return(IAP_OK);
+
+} // IAP_writeBlock
+
+
+
+/**
+  \fn uint8_t IAP_writeCompressed(uint16_t block, const uint8_t *data, uint8_t len)
+
+  \brief decompress one block and write to staging area
+
+  \param[in] block      block number [0..IAP_NUM_BLOCKS(size)-1]
+  \param[in] data       LZSS compressed block data, see lzss.h
+  \param[in] len        length of compressed data [B]
+
+  \return IAP_OK or error code
+
+  decompress block to RAM buffer, then write it like IAP_writeBlock(). Back-references
+  are read from the preceding blocks in the staging area, which must already be written.
+*/
+uint8_t IAP_writeCompressed(uint16_t block, const uint8_t *data, uint8_t len) {
+
+  uint32_t  offset = (uint32_t) block * FLASH_BLOCK_SIZE;
+
+  // check state and block number before reading history from staging area
+  if (m_status.state != IAP_STATE_RECEIVING)
+    return(IAP_ERR_STATE);
+  if ((block > m_status.progress) || (block >= IAP_NUM_BLOCKS(m_status.size)))
+    return(IAP_ERR_BLOCK);
+
+  // decompress block. History is limited by window and start of staging area
+  if (!LZSS_decodeBlock(data, len, m_buf, IAP_STAGE_START + offset, (offset < LZSS_WINDOW) ? (uint16_t) offset : LZSS_WINDOW))
+    return(IAP_ERR_DECODE);
+
+  // write block
+  return(IAP_writeBlock(block, m_buf));
+
+} // IAP_writeCompressed
+
+
+
+/**
+  \fn uint8_t IAP_finish(void)
+
+  \brief verify staging area and copy to application area
+
+  \return IAP_OK or error code
+
+  check CRC32 of staging area. On success, switch to state IAP_STATE_VERIFIED,
+  which is the single point of no return, then copy image to application area.
+  On CRC mismatch the transfer is discarded and the old application stays active.
+*/
+uint8_t IAP_finish(void) {
+
+  // check state and completeness
+  if (m_status.state != IAP_STATE_RECEIVING)
+    return(IAP_ERR_STATE);
+  if (m_status.progress != IAP_NUM_BLOCKS(m_status.size))
+    return(IAP_ERR_BLOCK);
+
+  // verify staging area. On error discard transfer
+  if (IAP_crc(IAP_STAGE_START, m_status.size) != m_status.crc) {
+    KV_write(IAP_KEY_STATE, IAP_STATE_IDLE);
+    m_status.state = IAP_STATE_IDLE;
+    return(IAP_ERR_CRC);
+  }
+
+  // reset progress for copy, then switch to new image
+  m_status.progress = 0;
+  if (IAP_commit(1) != IAP_OK)
+    return(IAP_ERR_EEPROM);
+  if (!KV_write(IAP_KEY_STATE, IAP_STATE_VERIFIED))
+    return(IAP_ERR_EEPROM);
+  m_status.state = IAP_STATE_VERIFIED;
+
+  // copy to application area
+  return(IAP_copy());
+
+} // IAP_finish
+
+
+
+/**
+  \fn void IAP_getStatus(iap_status_t *status)
+
+  \brief get current status of update engine
+
+  \param[out] status    current status. Progress is the last committed block, i.e. where to resume
+*/
+void IAP_getStatus(iap_status_t *status) {
+
+  uint32_t  val;
+
+  *status = m_status;
+  status->progress = (KV_read(IAP_KEY_PROGRESS, &val)) ? (uint16_t) val : 0;
+
+} // IAP_getStatus
+
+
+
+/**
+  \fn uint8_t IAP_appValid(void)
+
+  \brief check if a valid application is installed
+
+  \return application valid(=1) or not(=0)
+
+  application is valid if no copy is pending and an application was installed.
+  If IAP_CHECK_APP is set in config.h, additionally check the CRC32.
+*/
+uint8_t IAP_appValid(void) {
+
+  uint32_t  size, crc;
+
+  // copy pending or no application installed
+  if (m_status.state == IAP_STATE_VERIFIED)
+    return(0);
+  if ((!KV_read(IAP_KEY_APP_SIZE, &size)) || (size == 0) || (!KV_read(IAP_KEY_APP_CRC, &crc)))
+    return(0);
+
+  // optionally check CRC
+  #if (IAP_CHECK_APP)
+    if (IAP_crc(IAP_APP_START, size) != crc)
+      return(0);
+  #endif
+
+  return(1);
+
+} // IAP_appValid
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,122 @@
+/**
+  \file iap.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of resumable in-application programming (IAP) engine
+
+  declaration of a power-fail safe firmware update engine. A new image is first
+  received block-wise into a staging area in P-flash, while the active application
+  remains untouched. Only after the CRC32 of the complete image is verified, the
+  image is copied to the application area. Progress is stored in the EEPROM
+  key/value store, i.e. a reset at any time either resumes the transfer or the copy.
+
+  Update states (stored as key IAP_KEY_STATE):
+    - IAP_STATE_IDLE:       no update in progress, application valid if IAP_KEY_APP_SIZE>0
+    - IAP_STATE_RECEIVING:  image is being received to staging area. Old application still valid
+    - IAP_STATE_VERIFIED:   staging area verified, copy to application area pending/in progress
+
+  \note
+  - the STM8 has no flash bank swap, i.e. the application is always executed from IAP_APP_START
+  - switching to the new image is done by the single EEPROM record IAP_STATE_VERIFIED
+  - progress is committed every IAP_COMMIT_BLOCKS blocks. After a reset the host resumes
+    at the last committed block, see IAP_getStatus()
+  - blocks may be sent LZSS compressed (see lzss.h). The decompressor uses the already
+    written staging area as window, so each block can be resumed individually
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _IAP_H_
+#define _IAP_H_
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "flash.h"
+
+
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+// commit progress every N blocks. Default can be overwritten in config.h
+#ifndef IAP_COMMIT_BLOCKS
+  #define IAP_COMMIT_BLOCKS   4
+#endif
+
+/// keys in EEPROM key/value store
+#define IAP_KEY_STATE         0     ///< update state, see IAP_STATE_*
+#define IAP_KEY_PROGRESS      1     ///< number of blocks received or copied
+#define IAP_KEY_SIZE          2     ///< size of new image [B]
+#define IAP_KEY_CRC           3     ///< CRC32 of new image
+#define IAP_KEY_APP_SIZE      4     ///< size of active application [B], 0=none
+#define IAP_KEY_APP_CRC       5     ///< CRC32 of active application
+
+/// update states
+#define IAP_STATE_IDLE        0     ///< no update in progress
+#define IAP_STATE_RECEIVING   1     ///< receiving image to staging area
+#define IAP_STATE_VERIFIED    2     ///< image verified, copy to application area pending
+
+/// return codes
+#define IAP_OK                0     ///< no error
+#define IAP_ERR_STATE         1     ///< command not allowed in current state
+#define IAP_ERR_SIZE          2     ///< image size 0 or exceeds slot
+#define IAP_ERR_BLOCK         3     ///< block number out of order or range
+#define IAP_ERR_FLASH         4     ///< P-flash write failed
+#define IAP_ERR_EEPROM        5     ///< EEPROM (key/value store) write failed
+#define IAP_ERR_CRC           6     ///< CRC32 of image mismatch
+#define IAP_ERR_DECODE        7     ///< corrupt compressed block
+
+/// number of P-flash blocks for image size [B]
+#define IAP_NUM_BLOCKS(size)  ((uint16_t) (((uint32_t) (size) + FLASH_BLOCK_SIZE - 1) / FLASH_BLOCK_SIZE))
+
+
+/*----------------------------------------------------------
+    GLOBAL TYPEDEFS
+----------------------------------------------------------*/
+
+/// status of update engine
+typedef struct {
+  uint8_t   state;          ///< update state, see IAP_STATE_*
+  uint16_t  progress;       ///< blocks received (IAP_STATE_RECEIVING) or copied (IAP_STATE_VERIFIED)
+  uint32_t  size;           ///< size of new image [B]
+  uint32_t  crc;            ///< CRC32 of new image
+} iap_status_t;
+
+
+/*----------------------------------------------------------
+    GLOBAL FUNCTIONS
+----------------------------------------------------------*/
+
+/// init engine and finish interrupted copy. Returns IAP_OK or error code
+uint8_t IAP_begin(void);
+
+/// start or resume transfer of new image. Returns IAP_OK or error code
+uint8_t IAP_start(uint32_t size, uint32_t crc);
+
+/// write one block to staging area. Returns IAP_OK or error code
+uint8_t IAP_writeBlock(uint16_t block, const uint8_t *data);
+
+/// decompress one block and write to staging area. Returns IAP_OK or error code
+uint8_t IAP_writeCompressed(uint16_t block, const uint8_t *data, uint8_t len);
+
+/// verify staging area and copy to application area. Returns IAP_OK or error code
+uint8_t IAP_finish(void);
+
+/// get current status of update engine
+void IAP_getStatus(iap_status_t *status);
+
+/// check if a valid application is installed. Returns 1 if valid, else 0
+uint8_t IAP_appValid(void);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _IAP_H_
@@ -0,0 +1,104 @@
+/**
+  \file lzss.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of block-wise LZSS decompressor
+
+  implementation of an LZSS decompressor for firmware images, which are compressed
+  block-wise by Utils/iap_pack.py. For the stream format see lzss.h
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "lzss.h"
+#include "memory_access.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// check configuration at compile time (negative array size on error). Position in block is uint8_t
+typedef char lzss_check_block[(FLASH_BLOCK_SIZE <= 128) ? 1 : -1];
+
+
+
+/**
+  \fn uint8_t LZSS_decodeBlock(const uint8_t *src, uint8_t len, uint8_t *dst, uint32_t addr, uint16_t history)
+
+  \brief decode one compressed block
+
+  \param[in]  src       compressed data
+  \param[in]  len       length of compressed data [B]
+  \param[out] dst       decoded block (FLASH_BLOCK_SIZE bytes)
+  \param[in]  addr      P-flash address where the block will be written
+  \param[in]  history   number of valid bytes in P-flash before addr, max. LZSS_WINDOW
+
+  \return block decoded(=1) or corrupt stream(=0)
+
+  decode compressed stream into dst. Back-references within the current block
+  are copied from dst, older ones are read from P-flash before addr. The stream
+  must end exactly at the end of the block.
+*/
+uint8_t LZSS_decodeBlock(const uint8_t *src, uint8_t len, uint8_t *dst, uint32_t addr, uint16_t history) {
+
+  const uint8_t *end = src + len;
+  uint8_t       flags = 0, bits = 0, pos = 0, num;
+  uint16_t      dist;
+
+  while (pos < FLASH_BLOCK_SIZE) {
+
+    // fetch next flag byte
+    if (bits == 0) {
+      if (src >= end)
+        return(0);
+      flags = *(src++);
+      bits  = 8;
+    }
+
+    // literal byte
+    if (flags & 0x01) {
+      if (src >= end)
+        return(0);
+      dst[pos++] = *(src++);
+    }
+
+    // match: check length and distance, then copy byte-wise (source may overlap)
+    else {
+      if (src + 2 > end)
+        return(0);
+      num  = (src[0] >> 4) + LZSS_MIN_MATCH;
+      dist = ((((uint16_t) (src[0] & 0x0F)) << 8) | src[1]) + 1;
+      src += 2;
+      if ((num > (uint8_t) (FLASH_BLOCK_SIZE - pos)) || (dist > history + pos))
+        return(0);
+      while (num--) {
+        if (dist <= pos)
+          dst[pos] = dst[pos - dist];
+        else
+          dst[pos] = read_1B(addr + pos - dist);
+        pos++;
+      }
+    }
+
+    // next item
+    flags >>= 1;
+    bits--;
+
+  } // while (pos < FLASH_BLOCK_SIZE)
+
+  // complete stream must be consumed
+  return(src == end);
+
+} // LZSS_decodeBlock
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
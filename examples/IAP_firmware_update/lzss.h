@@ -0,0 +1,65 @@
+/**
+  \file lzss.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of block-wise LZSS decompressor
+
+  declaration of an LZSS decompressor for firmware images, which are compressed
+  block-wise by Utils/iap_pack.py. Each block is decoded independently of the
+  protocol framing, but back-references may point into previously written blocks.
+  These are read directly from P-flash, i.e. the 4kB window requires no RAM.
+
+  Stream format of one block:
+    - flag byte, followed by 8 items. Bit n (LSB first) describes item n
+    - flag=1: literal byte
+    - flag=0: match (2B): bits 15..12 = length-3, bits 11..0 = distance-1
+    - stream ends when FLASH_BLOCK_SIZE bytes are decoded. Unused flag bits are 0
+
+  \note
+  - matches must not cross the end of the block
+  - with the staging area as window, the image is decoded in place without extra RAM
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LZSS_H_
+#define _LZSS_H_
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "flash.h"
+
+
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+/// min. match length [B]
+#define LZSS_MIN_MATCH      3
+
+/// max. match length [B]
+#define LZSS_MAX_MATCH      (LZSS_MIN_MATCH + 15)
+
+/// window size, i.e. max. distance of back-reference [B]
+#define LZSS_WINDOW         4096
+
+
+/*----------------------------------------------------------
+    GLOBAL FUNCTIONS
+----------------------------------------------------------*/
+
+/// decode one block. History before dst is read from P-flash at addr. Returns 1 on success, else 0
+uint8_t LZSS_decodeBlock(const uint8_t *src, uint8_t len, uint8_t *dst, uint32_t addr, uint16_t history);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LZSS_H_
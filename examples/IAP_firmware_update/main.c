@@ -0,0 +1,399 @@
+/**********************
+  Resumable in-application firmware update (IAP) via UART
+  
+  supported hardware:
+    - muBoard 128kB (http://www.cream-tea.de/presentations/160305_PiAndMore.pdf)
+  
+  Functionality:
+    - bootloader in first flash sector, application at IAP_APP_START (see config.h)
+    - receive new image via UART into staging area, old application stays intact
+    - after CRC32 check copy image to application area. A reset at any time resumes
+    - interrupts are forwarded to the vector table of the application
+    - blocks may be sent LZSS compressed to reduce transfer time (see lzss.h)
+    - for host upload tool see Utils/iap_upload.py, for an example application see App/
+
+  Frame format (host->device and device->host):
+    - 0x5A, command (1B), payload length N (2B), payload (N B), CRC16-CCITT over command..payload (2B)
+    - all values are big-endian. Reply echoes command, payload starts with status (see IAP_ERR_*)
+
+  Commands:
+    - 'I' (info):   -> state(1B), block size(2B), slot size(4B), app start(4B), progress(2B), image size(4B), image CRC32(4B), features(1B)
+    - 'S' (start):  image size(4B), image CRC32(4B)
+    - 'W' (write):  block number(2B), data (FLASH_BLOCK_SIZE B)
+    - 'C' (compressed write): block number(2B), LZSS compressed data (<FLASH_BLOCK_SIZE B)
+    - 'F' (finish): verify & copy image to application area
+    - 'R' (run):    start application
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "uart.h"
+  #include "flash.h"
+  #include "memory_access.h"
+  #include "iap.h"
+  #include "crc_ref.h"
+#undef _MAIN_
+
+
+// frame start byte
+#define FRAME_SOF         0x5A
+
+// max. payload length (write command)
+#define FRAME_MAX_LEN     (2 + FLASH_BLOCK_SIZE)
+
+// max. time between bytes of a frame [ms]
+#define FRAME_TIMEOUT     50
+
+// commands
+#define CMD_INFO          'I'
+#define CMD_START         'S'
+#define CMD_WRITE         'W'
+#define CMD_COMPRESSED    'C'
+#define CMD_FINISH        'F'
+#define CMD_RUN           'R'
+
+// protocol errors (in addition to IAP_ERR_*)
+#define ERR_COMMAND       0x80      // unknown command
+#define ERR_LENGTH        0x81      // wrong payload length
+#define ERR_NO_APP        0x82      // no valid application
+
+// supported features in info reply
+#define FEATURE_LZSS      0x01      // compressed write
+
+// approx. polling loops per ms @ 16MHz
+#define LOOPS_PER_MS      1000
+
+// interrupt forwarding and jump to application use SDCC inline assembler
+#if !defined(__SDCC)
+  #error this example is only supported for SDCC
+#endif
+
+
+// frame buffer. Write data must reside in RAM for block programming
+uint8_t   frame[FRAME_MAX_LEN];
+
+
+
+/**
+  \fn IAP_IRQ(irq)
+   
+  \brief forward interrupt to vector table of application
+
+  each entry of the STM8 vector table is 4B (INT opcode & 24-bit address). Reset is at
+  offset 0, TRAP at offset 4 and IRQ n at offset 8+4*n. Jump to respective entry of
+  application, which then executes its interrupt service routine. Naked function,
+  i.e. no context is saved and the application ISR returns via IRET.
+*/
+#define IAP_IRQ(irq)  void IAP_irq##irq(void) __interrupt(irq) __naked { __asm jpf IAP_APP_START+8+4*irq __endasm; }
+
+// TRAP
+void IAP_trap(void) __trap __naked { __asm jpf IAP_APP_START+4 __endasm; }
+
+// IRQ0..29
+IAP_IRQ(0)  IAP_IRQ(1)  IAP_IRQ(2)  IAP_IRQ(3)  IAP_IRQ(4)  IAP_IRQ(5)  IAP_IRQ(6)  IAP_IRQ(7)
+IAP_IRQ(8)  IAP_IRQ(9)  IAP_IRQ(10) IAP_IRQ(11) IAP_IRQ(12) IAP_IRQ(13) IAP_IRQ(14) IAP_IRQ(15)
+IAP_IRQ(16) IAP_IRQ(17) IAP_IRQ(18) IAP_IRQ(19) IAP_IRQ(20) IAP_IRQ(21) IAP_IRQ(22) IAP_IRQ(23)
+IAP_IRQ(24) IAP_IRQ(25) IAP_IRQ(26) IAP_IRQ(27) IAP_IRQ(28) IAP_IRQ(29)
+
+
+
+/**
+  \fn void jumpApp(void)
+   
+  \brief start application
+
+  restore reset state of used peripherals, then jump to reset vector of application
+*/
+void jumpApp(void) {
+
+  // wait until reply is sent
+  UART_flush();
+
+  // reset UART and clock
+  sfr_UART.CR2.byte   = 0x00;
+  sfr_UART.BRR2.byte  = 0x00;
+  sfr_UART.BRR1.byte  = 0x00;
+  sfr_CLK.CKDIVR.byte = 0x18;
+
+  // jump to reset vector of application
+  __asm jpf IAP_APP_START __endasm;
+
+} // jumpApp
+
+
+
+/**
+  \fn uint8_t receiveByte(uint8_t *data, uint16_t timeout)
+   
+  \brief receive 1 byte via UART with timeout
+  
+  \param[out] data      received byte
+  \param[in]  timeout   timeout [ms] (approx.)
+
+  \return byte received(=1) or timeout(=0)
+*/
+uint8_t receiveByte(uint8_t *data, uint16_t timeout) {
+
+  uint16_t  i;
+
+  do {
+    for (i=0; i<LOOPS_PER_MS; i++) {
+      if (sfr_UART.SR.RXNE) {
+        *data = UART_read();
+        return(1);
+      }
+    }
+  } while (timeout--);
+
+  return(0);
+
+} // receiveByte
+
+
+
+/**
+  \fn uint8_t receiveFrame(uint8_t *cmd, uint16_t *len, uint16_t timeout)
+   
+  \brief receive frame via UART
+  
+  \param[out] cmd       received command
+  \param[out] len       received payload length. Payload is stored in frame[]
+  \param[in]  timeout   timeout for start of frame [ms] (approx.)
+
+  \return valid frame received(=1) or timeout/error(=0)
+*/
+uint8_t receiveFrame(uint8_t *cmd, uint16_t *len, uint16_t timeout) {
+
+  uint8_t   data;
+  uint16_t  crc, i;
+
+  // wait for start of frame
+  do {
+    if (!receiveByte(&data, timeout))
+      return(0);
+  } while (data != FRAME_SOF);
+
+  // receive command and length
+  if (!receiveByte(cmd, FRAME_TIMEOUT))
+    return(0);
+  crc = crc16_ccitt_update(0xFFFF, *cmd);
+  if (!receiveByte(&data, FRAME_TIMEOUT))
+    return(0);
+  crc = crc16_ccitt_update(crc, data);
+  *len = (uint16_t) data << 8;
+  if (!receiveByte(&data, FRAME_TIMEOUT))
+    return(0);
+  crc = crc16_ccitt_update(crc, data);
+  *len |= data;
+  if (*len > FRAME_MAX_LEN)
+    return(0);
+
+  // receive payload
+  for (i=0; i<*len; i++) {
+    if (!receiveByte(&(frame[i]), FRAME_TIMEOUT))
+      return(0);
+    crc = crc16_ccitt_update(crc, frame[i]);
+  }
+
+  // receive and check CRC
+  if (!receiveByte(&data, FRAME_TIMEOUT))
+    return(0);
+  crc ^= (uint16_t) data << 8;
+  if (!receiveByte(&data, FRAME_TIMEOUT))
+    return(0);
+  crc ^= data;
+
+  return(crc == 0);
+
+} // receiveFrame
+
+
+
+/**
+  \fn void sendFrame(uint8_t cmd, uint16_t len)
+   
+  \brief send frame via UART
+  
+  \param[in]  cmd       command to send
+  \param[in]  len       payload length. Payload is taken from frame[]
+*/
+void sendFrame(uint8_t cmd, uint16_t len) {
+
+  uint16_t  crc, i;
+
+  UART_write(FRAME_SOF);
+  UART_write(cmd);
+  crc = crc16_ccitt_update(0xFFFF, cmd);
+  UART_write((uint8_t) (len >> 8));
+  crc = crc16_ccitt_update(crc, (uint8_t) (len >> 8));
+  UART_write((uint8_t) len);
+  crc = crc16_ccitt_update(crc, (uint8_t) len);
+  for (i=0; i<len; i++) {
+    UART_write(frame[i]);
+    crc = crc16_ccitt_update(crc, frame[i]);
+  }
+  UART_write((uint8_t) (crc >> 8));
+  UART_write((uint8_t) crc);
+
+} // sendFrame
+
+
+
+/**
+  \fn uint8_t putValue(uint8_t idx, uint32_t value, uint8_t num)
+   
+  \brief store value big-endian in frame[]
+  
+  \param[in]  idx       index in frame[]
+  \param[in]  value     value to store
+  \param[in]  num       number of bytes (1..4)
+
+  \return index after stored value
+*/
+uint8_t putValue(uint8_t idx, uint32_t value, uint8_t num) {
+
+  while (num--)
+    frame[idx++] = (uint8_t) (value >> (8*num));
+
+  return(idx);
+
+} // putValue
+
+
+
+/**
+  \fn uint32_t getValue(uint8_t idx, uint8_t num)
+   
+  \brief read big-endian value from frame[]
+  
+  \param[in]  idx       index in frame[]
+  \param[in]  num       number of bytes (1..4)
+
+  \return read value
+*/
+uint32_t getValue(uint8_t idx, uint8_t num) {
+
+  uint32_t  value = 0;
+
+  while (num--)
+    value = (value << 8) | frame[idx++];
+
+  return(value);
+
+} // getValue
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void) {
+
+  iap_status_t  status;
+  uint8_t       cmd, appValid, session = 0;
+  uint16_t      len;
+  
+  // disable interrupts. Bootloader uses polling, interrupts belong to application
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+    
+  // init UART
+  UART_begin(IAP_BAUDRATE);
+  
+  // read update status, finish interrupted copy and check application
+  IAP_begin();
+  appValid = IAP_appValid();
+
+  // main loop
+  while (1) {
+
+    // wait for frame. Without session start valid application after IAP_BOOT_WAIT
+    if (!receiveFrame(&cmd, &len, (session || !appValid) ? 1000 : IAP_BOOT_WAIT)) {
+      if ((!session) && (appValid))
+        jumpApp();
+      continue;
+    }
+    session = 1;
+
+    // execute command. Reply payload starts with status
+    switch (cmd) {
+
+      // get status, e.g. to resume transfer
+      case CMD_INFO:
+        IAP_getStatus(&status);
+        len = putValue(0, IAP_OK, 1);
+        len = putValue(len, status.state, 1);
+        len = putValue(len, FLASH_BLOCK_SIZE, 2);
+        len = putValue(len, IAP_SLOT_SIZE, 4);
+        len = putValue(len, IAP_APP_START, 4);
+        len = putValue(len, status.progress, 2);
+        len = putValue(len, status.size, 4);
+        len = putValue(len, status.crc, 4);
+        len = putValue(len, FEATURE_LZSS, 1);
+        break;
+
+      // start or resume transfer
+      case CMD_START:
+        if (len != 8)
+          frame[0] = ERR_LENGTH;
+        else
+          frame[0] = IAP_start(getValue(0, 4), getValue(4, 4));
+        len = 1;
+        break;
+
+      // write block to staging area
+      case CMD_WRITE:
+        if (len != 2 + FLASH_BLOCK_SIZE)
+          frame[0] = ERR_LENGTH;
+        else
+          frame[0] = IAP_writeBlock((uint16_t) getValue(0, 2), &(frame[2]));
+        len = 1;
+        break;
+
+      // decompress block and write to staging area. Data is decoded directly from frame buffer
+      case CMD_COMPRESSED:
+        if ((len <= 2) || (len >= 2 + FLASH_BLOCK_SIZE))
+          frame[0] = ERR_LENGTH;
+        else
+          frame[0] = IAP_writeCompressed((uint16_t) getValue(0, 2), &(frame[2]), (uint8_t) (len - 2));
+        len = 1;
+        break;
+
+      // verify and activate image
+      case CMD_FINISH:
+        frame[0] = IAP_finish();
+        appValid = IAP_appValid();
+        len = 1;
+        break;
+
+      // start application
+      case CMD_RUN:
+        frame[0] = (appValid) ? IAP_OK : ERR_NO_APP;
+        sendFrame(cmd, 1);
+        if (appValid)
+          jumpApp();
+        continue;
+
+      // unknown command
+      default:
+        frame[0] = ERR_COMMAND;
+        len = 1;
+
+    } // switch (cmd)
+
+    // send reply
+    sendFrame(cmd, len);
+
+  } // main loop
+  
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
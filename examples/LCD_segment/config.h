@@ -0,0 +1,58 @@
+/**
+  \file config.h
+
+  \brief set project configurations
+
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define STM8L_DISCOVERY
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"
+  #define LCD_RTC_LSE                 // clock LCD from 32.768kHz crystal
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    LCD GLASS CONFIGURATION
+----------------------------------------------------------*/
+
+#if defined(STM8L_DISCOVERY)
+
+  // 6 digits with 14 segments + DP + colon, 1/4 duty
+  #define LCD_DIGITS          6
+
+  // used SEG pins (bit n = SEGn)
+  #define LCD_SEG_MASK        0x0FFF0FFFL
+
+  // SEG lines of each digit, left to right
+  #define LCD_DIGIT_SEG       { {0,1,26,27}, {2,3,24,25}, {4,5,22,23}, {6,7,20,21}, {8,9,18,19}, {10,11,16,17} }
+
+  // position of glyph bits LCD_A..LCD_COL within digit: (SEG line index << 2) | COM. 0xFF = not connected
+  //                           A  B  C  D  E  F G1 G2  H  J  K  L  M  N DP COL
+  #define LCD_GLYPH_MAP       { 6, 2, 5, 4, 0, 7, 3, 1,15,14,10,11, 8,12,13, 9 }
+
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
@@ -0,0 +1,368 @@
+/**
+  \file lcd.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of segment LCD driver with framebuffer
+
+  implementation of framebuffer, glyph mapping and start-of-frame
+  synchronized update of LCD RAM, see lcd.h.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "lcd.h"
+
+
+/*----------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+----------------------------------------------------------*/
+
+/// drawing buffer, modified by LCD_pixel() etc.
+static uint8_t            m_draw[LCD_RAM_SIZE];
+
+/// snapshot for next frame, copied to LCD RAM in SOF ISR
+static uint8_t            m_pending[LCD_RAM_SIZE];
+
+/// SEG lines of each digit
+static const uint8_t      m_digitSeg[LCD_DIGITS][4] = LCD_DIGIT_SEG;
+
+/// position of glyph bits within digit: (SEG line index << 2) | COM
+static const uint8_t      m_glyphMap[16] = LCD_GLYPH_MAP;
+
+/// 14-segment font for characters 0x20..0x5F. Lower case is mapped to upper case
+static const uint16_t     m_font[64] = {
+  0x0000, 0x4006, 0x0220, 0x12ce, 0x12ed, 0x0c24, 0x2359, 0x0200,    //   ! " # $ % & '
+  0x2400, 0x0900, 0x3fc0, 0x12c0, 0x0800, 0x00c0, 0x4000, 0x0c00,    // ( ) * + , - . /
+  0x0c3f, 0x0406, 0x00db, 0x008f, 0x00e6, 0x00ed, 0x00fd, 0x0007,    // 0 1 2 3 4 5 6 7
+  0x00ff, 0x00ef, 0x1200, 0x0a00, 0x2400, 0x00c8, 0x0900, 0x1083,    // 8 9 : ; < = > ?
+  0x02bb, 0x00f7, 0x128f, 0x0039, 0x120f, 0x0079, 0x0071, 0x00bd,    // @ A B C D E F G
+  0x00f6, 0x1209, 0x001e, 0x2470, 0x0038, 0x0536, 0x2136, 0x003f,    // H I J K L M N O
+  0x00f3, 0x203f, 0x20f3, 0x00ed, 0x1201, 0x003e, 0x0c30, 0x2836,    // P Q R S T U V W
+  0x2d00, 0x1500, 0x0c09, 0x0039, 0x2100, 0x000f, 0x2800, 0x0008     // X Y Z [ \ ] ^ _
+};
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void LCD_begin(void)
+
+  \brief start RTC clock and LCD, clear display
+
+  enable RTC and LCD clocks, start LSE or LSI as RTCCLK and configure LCD
+  for 1/4 duty, 1/3 bias and internal voltage source. Framebuffer and
+  display are cleared.
+*/
+void LCD_begin(void) {
+
+  uint8_t   i;
+
+  // enable RTC and LCD clocks (PCKEN22, PCKEN23. Bit names differ between devices)
+  sfr_CLK.PCKENR2.byte |= 0x0C;
+
+  // start LSE or LSI and select as RTC clock with prescaler 1
+  #if defined(LCD_RTC_LSE)
+    sfr_CLK.ECKR.LSEON = 1;
+    while (!sfr_CLK.ECKR.LSERDY);
+    sfr_CLK.CRTCR.byte = 0x10;
+  #else
+    sfr_CLK.ICKCR.LSION = 1;
+    while (!sfr_CLK.ICKCR.LSIRDY);
+    sfr_CLK.CRTCR.byte = 0x04;
+  #endif
+  while (sfr_CLK.CRTCR.RTCSWBSY);
+
+  // stop LCD
+  sfr_LCD.CR3.byte = 0x00;
+
+  // clear buffers and LCD RAM
+  for (i=0; i<LCD_RAM_SIZE; i++) {
+    m_draw[i]    = 0x00;
+    m_pending[i] = 0x00;
+    (&(sfr_LCD.RAM0.byte))[i] = 0x00;
+  }
+
+  // LCD clock = RTCCLK / 2^PS / (16+DIV)
+  sfr_LCD.FRQ.byte = (uint8_t) ((LCD_PS << 4) | LCD_DIV);
+
+  // 1/4 duty, 1/3 bias, no blinking
+  sfr_LCD.CR1.byte = 0x06;
+
+  // internal voltage source, contrast, short pulse-on duration
+  sfr_LCD.CR2.byte = (uint8_t) ((1 << 5) | ((LCD_CONTRAST & 0x07) << 1));
+
+  // connect used SEG pins
+  sfr_LCD.PM0.byte = (uint8_t) (LCD_SEG_MASK);
+  sfr_LCD.PM1.byte = (uint8_t) (LCD_SEG_MASK >> 8);
+  sfr_LCD.PM2.byte = (uint8_t) (LCD_SEG_MASK >> 16);
+  sfr_LCD.PM3.byte = (uint8_t) (LCD_SEG_MASK >> 24);
+
+  // start LCD
+  sfr_LCD.CR3.LCDEN = 1;
+
+} // LCD_begin
+
+
+
+/**
+  \fn void LCD_clear(void)
+
+  \brief clear framebuffer
+
+  clear all pixels in framebuffer. Display is changed on LCD_update().
+*/
+void LCD_clear(void) {
+
+  uint8_t   i;
+
+  for (i=0; i<LCD_RAM_SIZE; i++)
+    m_draw[i] = 0x00;
+
+} // LCD_clear
+
+
+
+/**
+  \fn void LCD_pixel(uint8_t com, uint8_t seg, uint8_t on)
+
+  \brief set or clear single pixel in framebuffer
+
+  \param[in]  com   COM line (0..3)
+  \param[in]  seg   SEG line (0..27)
+  \param[in]  on    pixel state (0=off, else on)
+
+  set or clear pixel in framebuffer. Display is changed on LCD_update().
+*/
+void LCD_pixel(uint8_t com, uint8_t seg, uint8_t on) {
+
+  uint8_t   bit;
+
+  // check parameters
+  if ((com > 3) || (seg >= LCD_SEG_NUM))
+    return;
+
+  // LCD RAM is a bit array with COMn in bits n*28..n*28+27
+  bit = (uint8_t) (com * LCD_SEG_NUM + seg);
+  if (on)
+    m_draw[bit >> 3] |= (uint8_t) (1 << (bit & 0x07));
+  else
+    m_draw[bit >> 3] &= (uint8_t) ~(1 << (bit & 0x07));
+
+} // LCD_pixel
+
+
+
+/**
+  \fn void LCD_glyph(uint8_t pos, uint16_t glyph)
+
+  \brief draw segment mask at digit position
+
+  \param[in]  pos     digit position (0=left)
+  \param[in]  glyph   segment mask LCD_A..LCD_COL
+
+  set segments of digit according to glyph mask. Display is changed on LCD_update().
+*/
+void LCD_glyph(uint8_t pos, uint16_t glyph) {
+
+  uint8_t   i, map;
+
+  // check parameter
+  if (pos >= LCD_DIGITS)
+    return;
+
+  // map glyph bits to COM/SEG
+  for (i=0; i<16; i++) {
+    map = m_glyphMap[i];
+    if (map != 0xFF)
+      LCD_pixel(map & 0x03, m_digitSeg[pos][map >> 2], (uint8_t) (glyph & 0x01));
+    glyph >>= 1;
+  }
+
+} // LCD_glyph
+
+
+
+/**
+  \fn void LCD_putc(uint8_t pos, char c)
+
+  \brief draw character at digit position
+
+  \param[in]  pos   digit position (0=left)
+  \param[in]  c     character to draw
+
+  draw character from font. Unknown characters are drawn blank.
+  Display is changed on LCD_update().
+*/
+void LCD_putc(uint8_t pos, char c) {
+
+  // map lower to upper case
+  if ((c >= 'a') && (c <= 'z'))
+    c -= 'a' - 'A';
+
+  // draw character
+  if ((c >= 0x20) && (c < 0x60))
+    LCD_glyph(pos, m_font[c - 0x20]);
+  else
+    LCD_glyph(pos, 0x0000);
+
+} // LCD_putc
+
+
+
+/**
+  \fn void LCD_puts(uint8_t pos, const char *str)
+
+  \brief draw string from digit position
+
+  \param[in]  pos   first digit position (0=left)
+  \param[in]  str   string to draw
+
+  draw string until end of string or display. A '.' or ':' following a
+  character sets DP or colon of that digit. Display is changed on LCD_update().
+*/
+void LCD_puts(uint8_t pos, const char *str) {
+
+  uint16_t  glyph;
+  char      c;
+
+  while ((*str) && (pos < LCD_DIGITS)) {
+
+    // get glyph of character
+    c = *(str++);
+    if ((c >= 'a') && (c <= 'z'))
+      c -= 'a' - 'A';
+    if ((c >= 0x20) && (c < 0x60))
+      glyph = m_font[c - 0x20];
+    else
+      glyph = 0x0000;
+
+    // merge following '.' and ':'
+    while ((*str == '.') || (*str == ':')) {
+      glyph |= (*str == '.') ? LCD_DP : LCD_COL;
+      str++;
+    }
+
+    LCD_glyph(pos++, glyph);
+
+  } // loop over string
+
+} // LCD_puts
+
+
+
+/**
+  \fn void LCD_update(void)
+
+  \brief show framebuffer at next start of frame
+
+  take snapshot of framebuffer and enable SOF interrupt. The snapshot is
+  copied to LCD RAM at the start of the next frame. If the previous update
+  is still pending, it is replaced. Framebuffer can be modified immediately
+  after return.
+*/
+void LCD_update(void) {
+
+  uint8_t   i;
+
+  // no SOF copy during snapshot
+  sfr_LCD.CR3.SOFIE = 0;
+
+  // take snapshot
+  for (i=0; i<LCD_RAM_SIZE; i++)
+    m_pending[i] = m_draw[i];
+
+  // clear stale SOF flag and enable interrupt for next frame
+  sfr_LCD.CR3.SOFC  = 1;
+  sfr_LCD.CR3.SOFIE = 1;
+
+} // LCD_update
+
+
+
+/**
+  \fn uint8_t LCD_busy(void)
+
+  \brief check if update is still pending
+
+  \return 1 if last LCD_update() is not yet shown, else 0
+*/
+uint8_t LCD_busy(void) {
+
+  return(sfr_LCD.CR3.SOFIE);
+
+} // LCD_busy
+
+
+
+/**
+  \fn void LCD_blink(uint8_t mode, uint8_t freq)
+
+  \brief set hardware blinking
+
+  \param[in]  mode    blink mode LCD_BLINK_xxx
+  \param[in]  freq    blink frequency fDiv/2^(3+freq), freq=0..7
+
+  blinking is done by LCD controller without CPU interaction. With 32.768kHz
+  and default clock settings freq=5 results in ~2Hz.
+*/
+void LCD_blink(uint8_t mode, uint8_t freq) {
+
+  sfr_LCD.CR1.byte = (uint8_t) ((sfr_LCD.CR1.byte & 0x07) | ((mode & 0x03) << 6) | ((freq & 0x07) << 3));
+
+} // LCD_blink
+
+
+
+/**
+  \fn void LCD_contrast(uint8_t level)
+
+  \brief set contrast
+
+  \param[in]  level   contrast level 0..7 (max)
+
+  set maximum LCD voltage of internal voltage source.
+*/
+void LCD_contrast(uint8_t level) {
+
+  sfr_LCD.CR2.byte = (uint8_t) ((sfr_LCD.CR2.byte & ~0x0E) | ((level & 0x07) << 1));
+
+} // LCD_contrast
+
+
+
+/**
+  \fn void LCD_SOF_ISR(void)
+
+  \brief ISR for LCD start of frame
+
+  interrupt service routine for LCD start of frame. Copy pending snapshot
+  to LCD RAM, clear flag and disable interrupt until next LCD_update().
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(LCD_SOF_ISR, _LCD_SOF_VECTOR_)
+{
+  uint8_t   i;
+
+  // copy snapshot to LCD RAM
+  for (i=0; i<LCD_RAM_SIZE; i++)
+    (&(sfr_LCD.RAM0.byte))[i] = m_pending[i];
+
+  // clear flag and disable interrupt
+  sfr_LCD.CR3.SOFC  = 1;
+  sfr_LCD.CR3.SOFIE = 0;
+
+} // LCD_SOF_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
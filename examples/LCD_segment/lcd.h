@@ -0,0 +1,148 @@
+/**
+  \file lcd.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of segment LCD driver with framebuffer
+
+  declaration of driver for the STM8L/STM8AL LCD controller with 1/4 duty
+  and 1/3 bias. Features:
+    - all drawing goes to a RAM framebuffer. LCD_update() takes a snapshot,
+      which is copied to LCD RAM in the start-of-frame (SOF) interrupt, i.e.
+      the glass never shows a partially drawn frame
+    - SOF interrupt is only enabled while an update is pending, so an idle
+      display causes no CPU wake-ups
+    - glyphs are 16-bit masks of segments LCD_A..LCD_COL. The mapping to
+      COM/SEG lines is set in config.h (LCD_DIGIT_SEG, LCD_GLYPH_MAP)
+    - blinking and contrast are handled by the LCD controller
+    - LCD is clocked from RTCCLK (LSE or LSI) and keeps running in active-halt
+
+  Segment layout of a digit:
+  \verbatim
+       --A--
+      |\ | /|
+      F H J K B
+      |  \|/  |
+      -G1- -G2-
+      |  /|\  |
+      E L M N C
+      |/  |  \|
+       --D--   DP  COL
+  \endverbatim
+
+  \note
+  - only SEG0..SEG27 with 4 COM are supported (LCD RAM0..13)
+  - frame rate with 32.768kHz and defaults is ~132Hz
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LCD_H_
+#define _LCD_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// check for LCD controller
+#if !defined(sfr_LCD)
+  #error device has no LCD controller
+#endif
+
+/// size of LCD RAM used for 4 COM x 28 SEG [B]
+#define LCD_RAM_SIZE            14
+
+/// number of SEG lines per COM in LCD RAM
+#define LCD_SEG_NUM             28
+
+// LCD clock prescaler 2^PS and divider (16+DIV). Default can be overwritten in config.h
+#ifndef LCD_PS
+  #define LCD_PS                1
+#endif
+#ifndef LCD_DIV
+  #define LCD_DIV               15
+#endif
+
+// contrast after LCD_begin() (0..7). Default can be overwritten in config.h
+#ifndef LCD_CONTRAST
+  #define LCD_CONTRAST          4
+#endif
+
+// glyph bits
+#define LCD_A                   0x0001        ///< top
+#define LCD_B                   0x0002        ///< upper right
+#define LCD_C                   0x0004        ///< lower right
+#define LCD_D                   0x0008        ///< bottom
+#define LCD_E                   0x0010        ///< lower left
+#define LCD_F                   0x0020        ///< upper left
+#define LCD_G1                  0x0040        ///< middle left
+#define LCD_G2                  0x0080        ///< middle right
+#define LCD_H                   0x0100        ///< upper left diagonal
+#define LCD_J                   0x0200        ///< upper center
+#define LCD_K                   0x0400        ///< upper right diagonal
+#define LCD_L                   0x0800        ///< lower left diagonal
+#define LCD_M                   0x1000        ///< lower center
+#define LCD_N                   0x2000        ///< lower right diagonal
+#define LCD_DP                  0x4000        ///< decimal point
+#define LCD_COL                 0x8000        ///< colon
+
+// blink modes for LCD_blink()
+#define LCD_BLINK_OFF           0             ///< no blinking
+#define LCD_BLINK_SEG0_COM0     1             ///< blink pixel SEG0/COM0
+#define LCD_BLINK_SEG0_ALL      2             ///< blink SEG0 on all COM
+#define LCD_BLINK_ALL           3             ///< blink all pixels
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// start RTC clock and LCD, clear display
+void LCD_begin(void);
+
+/// clear framebuffer
+void LCD_clear(void);
+
+/// set (on!=0) or clear single pixel in framebuffer
+void LCD_pixel(uint8_t com, uint8_t seg, uint8_t on);
+
+/// draw segment mask LCD_xxx at digit position
+void LCD_glyph(uint8_t pos, uint16_t glyph);
+
+/// draw character at digit position
+void LCD_putc(uint8_t pos, char c);
+
+/// draw string from digit position. '.' and ':' are merged into preceding digit
+void LCD_puts(uint8_t pos, const char *str);
+
+/// show framebuffer at next start of frame
+void LCD_update(void);
+
+/// check if update is still pending
+uint8_t LCD_busy(void);
+
+/// set hardware blinking mode LCD_BLINK_xxx with frequency fDiv/2^(3+freq)
+void LCD_blink(uint8_t mode, uint8_t freq);
+
+/// set contrast 0..7 (max)
+void LCD_contrast(uint8_t level);
+
+/// ISR for LCD start of frame
+ISR_HANDLER(LCD_SOF_ISR, _LCD_SOF_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LCD_H_
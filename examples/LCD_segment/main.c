@@ -0,0 +1,167 @@
+/**********************
+  Segment LCD with framebuffer, updated in sync with LCD start of frame
+
+  supported hardware:
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - drive 6-digit 14-segment glass of STM8L Discovery via LCD controller
+    - show banner with hardware blinking for 2s
+    - then show meter value, updated 4x per second. Display is changed only
+      at start of LCD frame, i.e. without tearing
+    - change contrast every 5s
+    - between updates stay in active-halt. LCD and RTC wake-up timer keep
+      running from 32.768kHz crystal. CPU wakes only for RTC tick and once
+      per update for the SOF interrupt
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "lcd.h"
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// update period [ms]
+#define TICK_MS       250
+
+
+/*----------------------------------------------------------
+    GLOBAL VARIABLES
+----------------------------------------------------------*/
+
+// tick flag. Set in RTC ISR
+volatile uint8_t    g_tick = 0;
+
+
+
+/**
+  \fn void RTC_tick_begin(void)
+
+  \brief start periodic RTC wake-up
+
+  start RTC wake-up timer with period TICK_MS. RTC clock is already
+  started by LCD_begin().
+*/
+void RTC_tick_begin(void) {
+
+  // unlock RTC write protection
+  sfr_RTC.WPR.byte = 0xCA;
+  sfr_RTC.WPR.byte = 0x53;
+
+  // stop wake-up timer
+  sfr_RTC.CR2.WUTE = 0;
+  while (!sfr_RTC.ISR1.WUTWF);
+
+  // set clock RTCCLK/16 and reload value. Period is WUTR+1
+  sfr_RTC.CR1.WUCKSEL = 0;
+  sfr_RTC.WUTRH.byte  = (uint8_t) (((32768L / 16) * TICK_MS / 1000 - 1) >> 8);
+  sfr_RTC.WUTRL.byte  = (uint8_t) ((32768L / 16) * TICK_MS / 1000 - 1);
+
+  // clear flag, enable interrupt and start timer
+  sfr_RTC.ISR2.WUTF  = 0;
+  sfr_RTC.CR2.WUTIE  = 1;
+  sfr_RTC.CR2.WUTE   = 1;
+
+  // lock RTC write protection
+  sfr_RTC.WPR.byte = 0xFF;
+
+} // RTC_tick_begin
+
+
+
+/**
+  \fn void RTC_TICK_ISR(void)
+
+  \brief ISR for RTC wake-up timer
+
+  interrupt service routine for RTC wake-up timer. Clear flag (mandatory)
+  and set tick flag
+*/
+ISR_HANDLER(RTC_TICK_ISR, _RTC_WAKEUP_VECTOR_)
+{
+  sfr_RTC.ISR2.WUTF = 0;
+  g_tick = 1;
+
+} // RTC_TICK_ISR
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  char      str[10];
+  uint16_t  ticks = 0;
+  uint32_t  energy = 0;
+  uint8_t   contrast = 0;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init LCD and RTC tick
+  LCD_begin();
+  RTC_tick_begin();
+
+  // switch off main regulator and internal reference voltage during active-halt
+  sfr_CLK.ICKCR.SAHALT = 1;
+  sfr_PWR.CSR2.ULP = 1;
+  sfr_PWR.CSR2.FWU = 1;
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // show banner with hardware blinking
+  LCD_puts(0, "STM8L");
+  LCD_update();
+  LCD_blink(LCD_BLINK_ALL, 5);
+
+  // main loop
+  while(1) {
+
+    // wait for tick in active-halt (HALT re-enables interrupts). SOF ISR also wakes
+    DISABLE_INTERRUPTS();
+    while (!g_tick) {
+      ENTER_HALT();
+      DISABLE_INTERRUPTS();
+    }
+    g_tick = 0;
+    ENABLE_INTERRUPTS();
+    ticks++;
+
+    // stop banner after 2s
+    if (ticks < 2000/TICK_MS)
+      continue;
+    LCD_blink(LCD_BLINK_OFF, 0);
+
+    // change contrast every 5s
+    if ((ticks % (5000/TICK_MS)) == 0) {
+      contrast = (contrast + 1) & 0x07;
+      LCD_contrast(contrast);
+    }
+
+    // draw meter value (in 0.01kWh) and show it at next frame
+    energy += 7;
+    sprintf(str, "%4lu.%02u", (energy / 100) % 10000, (uint16_t) (energy % 100));
+    LCD_puts(0, str);
+    LCD_update();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,108 @@
+/**********************
+  Multi-channel PWM engine with synchronized, glitch-free duty cycle updates
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - TIM1: 20kHz center-aligned PWM on CH1 and CH3 with 180deg phase-shift,
+      like example PWM_2ch_phase-shift. Complementary output CH1N with 500ns
+      dead-time (pin requires remapping on some devices)
+    - TIM2: 1kHz edge-aligned PWM on CH1 and CH2 with >=1000 steps, e.g. for LEDs.
+      TIM2 is advanced by 25% relative to TIM1
+    - every 1ms duty cycles of all channels are changed within PWM_lock()/PWM_unlock(),
+      i.e. all channels of a timer change in the same PWM period
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "pwm.h"
+#undef _MAIN_
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint16_t  duty1 = 0, duty2 = 0;
+  int8_t    dir1 = 1;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // set timer pins to output
+  TIM1_PORT.DDR.byte |= TIM1_PINS;  // input(=0) or output(=1)
+  TIM1_PORT.CR1.byte |= TIM1_PINS;  // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+  TIM1_PORT.CR2.byte |= TIM1_PINS;  // input: 0=no exint, 1=exint; output: 0=2MHz slope, 1=10MHz slope
+  TIM2_PORT.DDR.byte |= TIM2_PINS;
+  TIM2_PORT.CR1.byte |= TIM2_PINS;
+
+  // init 1ms tick
+  TIM4_init();
+
+  // TIM1: 20kHz center-aligned, CH1 with complementary output, CH3 shifted by 180deg
+  PWM_begin(PWM_TIM1, 20000L, 100, PWM_CENTER);
+  PWM_deadtime(500);
+  PWM_channel(PWM_TIM1, 1, PWM_COMPLEMENTARY);
+  PWM_channel(PWM_TIM1, 3, PWM_SHIFT180);
+
+  // TIM2: 1kHz edge-aligned, CH1 and CH2 with at least 1000 steps
+  PWM_begin(PWM_TIM2, 1000L, 1000, PWM_EDGE);
+  PWM_channel(PWM_TIM2, 1, 0);
+  PWM_channel(PWM_TIM2, 2, PWM_ACTIVE_LOW);
+
+  // start both timers with TIM2 advanced by 25%
+  PWM_setPhase(PWM_TIM2, PWM_DUTY_MAX / 4);
+  PWM_start(PWM_MASK(PWM_TIM1) | PWM_MASK(PWM_TIM2));
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // every 1ms update duty cycles
+    if (flagMilli()) {
+      clearFlagMilli();
+
+      // TIM1: ramp duty up/down within 0..50%
+      duty1 += dir1 * 16;
+      if ((duty1 == 0) || (duty1 == PWM_DUTY_MAX/2))
+        dir1 = -dir1;
+
+      // TIM2: sawtooth ramp in 4s
+      duty2 += 8;
+      if (duty2 > PWM_DUTY_MAX)
+        duty2 = 0;
+
+      // update both channels of each timer in the same PWM period
+      PWM_lock(PWM_TIM1);
+      PWM_setDuty(PWM_TIM1, 1, duty1);
+      PWM_setDuty(PWM_TIM1, 3, duty1);
+      PWM_unlock(PWM_TIM1);
+
+      PWM_lock(PWM_TIM2);
+      PWM_setDuty(PWM_TIM2, 1, duty2);
+      PWM_setDuty(PWM_TIM2, 2, duty2);
+      PWM_unlock(PWM_TIM2);
+
+    } // 1ms task
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,625 @@
+/**
+  \file pwm.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of multi-channel PWM engine for TIM1, TIM2, TIM3 and TIM5
+
+  implementation of a PWM engine for the 16-bit timers. Timer registers are
+  accessed via a descriptor table with register addresses, which hides the
+  different register layouts of STM8S and STM8L timers.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include "pwm.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// register layout of general purpose timers depends on family
+#if !defined(FAMILY_STM8S) && !defined(FAMILY_STM8L)
+  #error device family not supported
+#endif
+
+// timer register bits. Are identical for all 16-bit timers
+#define CR1_CEN             0x01      ///< counter enable
+#define CR1_UDIS            0x02      ///< update event disable
+#define CR1_CMS             0x20      ///< center-aligned mode 1
+#define CR1_ARPE            0x80      ///< auto-reload preload enable
+#define EGR_UG              0x01      ///< generate update event
+#define CCMR_PWM1           0x60      ///< output compare mode PWM mode 1
+#define CCMR_OCPE           0x08      ///< output compare preload enable
+#define CCER_E              0x01      ///< output enable (per channel nibble)
+#define CCER_P              0x02      ///< output polarity low
+#define CCER_NE             0x04      ///< complementary output enable
+#define CCER_NP             0x08      ///< complementary output polarity low
+#define BKR_MOE             0x80      ///< main output enable
+
+// descriptor for advanced timer TIM1
+#define PWM_ADV_TIMER(T)    { &(sfr_##T.CR1.byte), &(sfr_##T.EGR.byte), &(sfr_##T.CCMR1.byte), \
+                              &(sfr_##T.CCER1.byte), &(sfr_##T.CNTRH.byte), &(sfr_##T.PSCRH.byte), \
+                              &(sfr_##T.ARRH.byte), &(sfr_##T.CCR1H.byte), &(sfr_##T.BKR.byte), 4, 1, 0 }
+
+// descriptor for general purpose timers TIM2/3/5. STM8L timers support center-aligned mode and have a break register
+#if defined(FAMILY_STM8S)
+  #define PWM_GP_TIMER(T,N) { &(sfr_##T.CR1.byte), &(sfr_##T.EGR.byte), &(sfr_##T.CCMR1.byte), \
+                              &(sfr_##T.CCER1.byte), &(sfr_##T.CNTRH.byte), &(sfr_##T.PSCR.byte), \
+                              &(sfr_##T.ARRH.byte), &(sfr_##T.CCR1H.byte), NULL, N, 0, 15 }
+#else
+  #define PWM_GP_TIMER(T,N) { &(sfr_##T.CR1.byte), &(sfr_##T.EGR.byte), &(sfr_##T.CCMR1.byte), \
+                              &(sfr_##T.CCER1.byte), &(sfr_##T.CNTRH.byte), &(sfr_##T.PSCR.byte), \
+                              &(sfr_##T.ARRH.byte), &(sfr_##T.CCR1H.byte), &(sfr_##T.BKR.byte), N, 1, 7 }
+#endif
+
+// descriptor for timer not available on device
+#define PWM_NO_TIMER        { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0, 0 }
+
+
+/*----------------------------------------------------------
+    TYPEDEFS
+----------------------------------------------------------*/
+
+/// timer descriptor. Consecutive registers (e.g. CCMR2, ARRL) are addressed relative to first
+typedef struct {
+  volatile uint8_t    *CR1;           ///< control register 1
+  volatile uint8_t    *EGR;           ///< event generation register
+  volatile uint8_t    *CCMR1;         ///< capture/compare mode register 1, 1 register per channel
+  volatile uint8_t    *CCER1;         ///< capture/compare enable register 1, 2 channels per register
+  volatile uint8_t    *CNTRH;         ///< counter high byte, followed by low byte
+  volatile uint8_t    *PSCR;          ///< prescaler (TIM1: PSCRH, followed by PSCRL)
+  volatile uint8_t    *ARRH;          ///< auto-reload high byte, followed by low byte
+  volatile uint8_t    *CCR1H;         ///< compare register 1 high byte, followed by CCR1L, CCR2H,...
+  volatile uint8_t    *BKR;           ///< break register with main output enable, or NULL
+  uint8_t             numCh;          ///< number of compare channels, or 0 if timer not available
+  uint8_t             center;         ///< center-aligned mode supported (=1) or not (=0)
+  uint8_t             maxShift;       ///< max. prescaler 2^maxShift, or 0 for 16-bit linear prescaler
+} pwm_timer_t;
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// timer descriptors, indexed by timer ID
+static const pwm_timer_t  m_timer[PWM_NUM_TIMERS] = {
+  #if defined(sfr_TIM1)
+    PWM_ADV_TIMER(TIM1),
+  #else
+    PWM_NO_TIMER,
+  #endif
+  #if defined(sfr_TIM2) && defined(FAMILY_STM8S)
+    PWM_GP_TIMER(TIM2, 3),
+  #elif defined(sfr_TIM2)
+    PWM_GP_TIMER(TIM2, 2),
+  #else
+    PWM_NO_TIMER,
+  #endif
+  #if defined(sfr_TIM3)
+    PWM_GP_TIMER(TIM3, 2),
+  #else
+    PWM_NO_TIMER,
+  #endif
+  #if defined(sfr_TIM5) && defined(FAMILY_STM8S)
+    PWM_GP_TIMER(TIM5, 3)
+  #elif defined(sfr_TIM5)
+    PWM_GP_TIMER(TIM5, 2)
+  #else
+    PWM_NO_TIMER
+  #endif
+};
+
+/// number of duty cycle steps per timer, i.e. compare value for 100%
+static uint16_t   m_top[PWM_NUM_TIMERS];
+
+/// alignment mode per timer
+static uint8_t    m_mode[PWM_NUM_TIMERS];
+
+/// channels with 180deg phase-shift per timer (bit ch)
+static uint8_t    m_shift[PWM_NUM_TIMERS];
+
+/// counter start value per timer for PWM_start()
+static uint16_t   m_phase[PWM_NUM_TIMERS];
+
+
+
+/**
+  \fn uint16_t PWM_setFrequency(uint8_t id, uint32_t freq, uint16_t steps)
+
+  \brief change PWM frequency
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+  \param[in]  freq    PWM frequency [Hz]
+  \param[in]  steps   min. number of duty cycle steps
+
+  \return number of duty cycle steps, or 0 if frequency or steps can't be realized
+
+  calculate smallest prescaler for requested frequency, which gives highest
+  resolution. Prescaler and reload registers are buffered, i.e. the new
+  frequency is active after the next update event. Compare values are not
+  scaled, i.e. duty cycles must be set again, e.g. within PWM_lock()/PWM_unlock().
+*/
+uint16_t PWM_setFrequency(uint8_t id, uint32_t freq, uint16_t steps) {
+
+  const pwm_timer_t  *tim = &(m_timer[id]);
+  uint32_t  counts;
+  uint16_t  psc, top, arr;
+  uint8_t   shift;
+
+  // check parameters
+  if ((id >= PWM_NUM_TIMERS) || (tim->numCh == 0) || (freq == 0))
+    return(0);
+
+  // timer ticks per period. Center-aligned counter counts up and down
+  counts = F_MASTER / freq;
+  if (m_mode[id] == PWM_CENTER)
+    counts >>= 1;
+
+  // TIM1: 16-bit linear prescaler 1..65536
+  if (tim->maxShift == 0) {
+    psc = (uint16_t) ((counts + 0xFFFE) / 0xFFFF);
+    if (psc == 0)
+      return(0);
+    top = (uint16_t) (counts / psc);
+  }
+
+  // TIM2/3/5: prescaler 2^shift
+  else {
+    shift = 0;
+    while ((counts >> shift) > 0xFFFF)
+      shift++;
+    if (shift > tim->maxShift)
+      return(0);
+    top = (uint16_t) (counts >> shift);
+  }
+
+  // check resolution
+  if ((top < 2) || (top < steps))
+    return(0);
+
+  // set prescaler (always buffered)
+  if (tim->maxShift == 0) {
+    psc--;
+    tim->PSCR[0] = (uint8_t) (psc >> 8);
+    tim->PSCR[1] = (uint8_t) psc;
+  }
+  else
+    tim->PSCR[0] = shift;
+
+  // set reload value (buffered). Edge-aligned period is ARR+1, center-aligned 2*ARR
+  arr = top;
+  if (m_mode[id] == PWM_EDGE)
+    arr--;
+  tim->ARRH[0] = (uint8_t) (arr >> 8);
+  tim->ARRH[1] = (uint8_t) arr;
+
+  // store resolution for duty cycle scaling
+  m_top[id] = top;
+
+  return(top);
+
+} // PWM_setFrequency
+
+
+
+/**
+  \fn uint16_t PWM_begin(uint8_t id, uint32_t freq, uint16_t steps, uint8_t mode)
+
+  \brief init timer for PWM
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+  \param[in]  freq    PWM frequency [Hz]
+  \param[in]  steps   min. number of duty cycle steps
+  \param[in]  mode    PWM_EDGE or PWM_CENTER
+
+  \return number of duty cycle steps, or 0 on error
+
+  reset timer, set frequency and enable buffering of all registers. All
+  channels are disabled. Timer is not started, see PWM_start().
+*/
+uint16_t PWM_begin(uint8_t id, uint32_t freq, uint16_t steps, uint8_t mode) {
+
+  const pwm_timer_t  *tim = &(m_timer[id]);
+  uint8_t   i;
+
+  // check timer and mode
+  if ((id >= PWM_NUM_TIMERS) || (tim->numCh == 0))
+    return(0);
+  if ((mode == PWM_CENTER) && (!tim->center))
+    return(0);
+
+  // for low-power device activate timer clock
+  #if defined(FAMILY_STM8L)
+    if (id == PWM_TIM1)
+      sfr_CLK.PCKENR2.PCKEN21 = 1;
+    else if (id == PWM_TIM2)
+      sfr_CLK.PCKENR1.PCKEN10 = 1;
+    else if (id == PWM_TIM3)
+      sfr_CLK.PCKENR1.PCKEN11 = 1;
+    #if defined(sfr_TIM5)
+      else
+        sfr_CLK.PCKENR3.PCKEN31 = 1;
+    #endif
+  #endif
+
+  // stop timer and disable all channels
+  tim->CR1[0] = 0x00;
+  for (i=0; i<tim->numCh; i++) {
+    tim->CCER1[i >> 1] = 0x00;
+    tim->CCMR1[i] = 0x00;
+  }
+  m_shift[id] = 0;
+  m_phase[id] = 0;
+
+  // buffered reload value, edge- or center-aligned
+  m_mode[id] = mode;
+  tim->CR1[0] = CR1_ARPE | ((mode == PWM_CENTER) ? CR1_CMS : 0x00);
+
+  // set frequency
+  if (PWM_setFrequency(id, freq, steps) == 0)
+    return(0);
+
+  // clear compare values
+  for (i=1; i<=tim->numCh; i++)
+    PWM_setCompare(id, i, 0);
+
+  // transfer buffered registers
+  tim->EGR[0] = EGR_UG;
+
+  // main output enable
+  if (tim->BKR)
+    tim->BKR[0] |= BKR_MOE;
+
+  return(m_top[id]);
+
+} // PWM_begin
+
+
+
+/**
+  \fn uint8_t PWM_channels(uint8_t id)
+
+  \brief get number of compare channels
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+
+  \return number of compare channels, or 0 if timer is not available
+*/
+uint8_t PWM_channels(uint8_t id) {
+
+  if (id >= PWM_NUM_TIMERS)
+    return(0);
+  return(m_timer[id].numCh);
+
+} // PWM_channels
+
+
+
+/**
+  \fn uint8_t PWM_channel(uint8_t id, uint8_t ch, uint8_t options)
+
+  \brief configure and enable PWM channel
+
+  \param[in]  id        timer ID, e.g. PWM_TIM1
+  \param[in]  ch        channel (1..PWM_channels())
+  \param[in]  options   PWM_ACTIVE_LOW, PWM_COMPLEMENTARY, PWM_SHIFT180 or 0
+
+  \return 1 on success, 0 on invalid channel or option
+
+  set PWM mode 1 with buffered compare register and enable output.
+  PWM_SHIFT180 inverts the output and compare value, i.e. in center-aligned
+  mode the pulse is centered on the counter maximum instead of minimum.
+  Duty cycle is set to 0.
+*/
+uint8_t PWM_channel(uint8_t id, uint8_t ch, uint8_t options) {
+
+  const pwm_timer_t  *tim = &(m_timer[id]);
+  uint8_t   ccer, pos;
+
+  // check parameters
+  if ((id >= PWM_NUM_TIMERS) || (ch == 0) || (ch > tim->numCh))
+    return(0);
+  if ((options & PWM_COMPLEMENTARY) && ((id != PWM_TIM1) || (ch > 3)))
+    return(0);
+  if ((options & PWM_SHIFT180) && (m_mode[id] != PWM_CENTER))
+    return(0);
+
+  // PWM mode 1 with buffered compare value
+  tim->CCMR1[ch-1] = CCMR_PWM1 | CCMR_OCPE;
+
+  // shifted channel has inverted output
+  if (options & PWM_SHIFT180) {
+    options ^= PWM_ACTIVE_LOW;
+    m_shift[id] |= (uint8_t) (1 << ch);
+  }
+  else
+    m_shift[id] &= (uint8_t) ~(1 << ch);
+
+  // output enable and polarity. Complementary output has same polarity
+  ccer = CCER_E;
+  if (options & PWM_ACTIVE_LOW)
+    ccer |= CCER_P;
+  if (options & PWM_COMPLEMENTARY) {
+    ccer |= CCER_NE;
+    if (options & PWM_ACTIVE_LOW)
+      ccer |= CCER_NP;
+  }
+
+  // 2 channels per CCER register
+  pos = ((ch-1) & 0x01) ? 4 : 0;
+  tim->CCER1[(ch-1) >> 1] = (tim->CCER1[(ch-1) >> 1] & (uint8_t) ~(0x0F << pos)) | (uint8_t) (ccer << pos);
+
+  // start with duty 0
+  PWM_setCompare(id, ch, 0);
+
+  return(1);
+
+} // PWM_channel
+
+
+
+/**
+  \fn uint16_t PWM_deadtime(uint16_t ns)
+
+  \brief set dead-time of complementary outputs
+
+  \param[in]  ns      dead-time [ns]
+
+  \return set dead-time [ns] after rounding down to resolution
+
+  set dead-time between edges of TIM1 CHx and CHxN. Resolution is 1 tick of
+  fMaster up to 127 ticks and coarser for longer times, max. 1008 ticks.
+*/
+uint16_t PWM_deadtime(uint16_t ns) {
+
+#if defined(sfr_TIM1)
+
+  uint32_t  ticks;
+  uint8_t   dtg;
+
+  // convert to fMaster ticks
+  ticks = ((uint32_t) ns * (F_MASTER / 1000000L)) / 1000L;
+
+  // encode DTG: 0xxxxxxx=1x, 10xxxxxx=(64+x)*2, 110xxxxx=(32+x)*8, 111xxxxx=(32+x)*16
+  if (ticks < 128) {
+    dtg = (uint8_t) ticks;
+  }
+  else if (ticks < 256) {
+    ticks >>= 1;
+    dtg = 0x80 | (uint8_t) (ticks - 64);
+    ticks <<= 1;
+  }
+  else if (ticks < 512) {
+    ticks >>= 3;
+    dtg = 0xC0 | (uint8_t) (ticks - 32);
+    ticks <<= 3;
+  }
+  else {
+    ticks >>= 4;
+    if (ticks > 63)
+      ticks = 63;
+    dtg = 0xE0 | (uint8_t) (ticks - 32);
+    ticks <<= 4;
+  }
+
+  // set dead-time generator
+  sfr_TIM1.DTR.byte = dtg;
+
+  // return set dead-time [ns]
+  return((uint16_t) ((ticks * 1000L) / (F_MASTER / 1000000L)));
+
+#else
+
+  (void) ns;
+  return(0);
+
+#endif
+
+} // PWM_deadtime
+
+
+
+/**
+  \fn void PWM_lock(uint8_t id)
+
+  \brief defer update of buffered registers
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+
+  disable update event, i.e. compare, reload and prescaler values written
+  afterwards remain in preload registers until PWM_unlock(). Timer continues
+  with old values.
+*/
+void PWM_lock(uint8_t id) {
+
+  if ((id < PWM_NUM_TIMERS) && (m_timer[id].numCh))
+    m_timer[id].CR1[0] |= CR1_UDIS;
+
+} // PWM_lock
+
+
+
+/**
+  \fn void PWM_unlock(uint8_t id)
+
+  \brief transfer buffered registers with next update event
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+
+  re-enable update event. All values written since PWM_lock() are transferred
+  at the next counter overflow/underflow, i.e. all channels change in the
+  same PWM period.
+*/
+void PWM_unlock(uint8_t id) {
+
+  if ((id < PWM_NUM_TIMERS) && (m_timer[id].numCh))
+    m_timer[id].CR1[0] &= (uint8_t) ~CR1_UDIS;
+
+} // PWM_unlock
+
+
+
+/**
+  \fn void PWM_setCompare(uint8_t id, uint8_t ch, uint16_t value)
+
+  \brief set compare value of channel
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+  \param[in]  ch      channel (1..PWM_channels())
+  \param[in]  value   compare value (0..duty steps). Larger values are clipped to 100%
+
+  set buffered compare value in timer ticks. Is active after next update event.
+*/
+void PWM_setCompare(uint8_t id, uint8_t ch, uint16_t value) {
+
+  const pwm_timer_t  *tim = &(m_timer[id]);
+  uint16_t  top;
+
+  // check parameters
+  if ((id >= PWM_NUM_TIMERS) || (ch == 0) || (ch > tim->numCh))
+    return;
+
+  // clip to 100%
+  top = m_top[id];
+  if (value > top)
+    value = top;
+
+  // 180deg shifted channel has inverted output and compare value
+  if (m_shift[id] & (uint8_t) (1 << ch))
+    value = top - value;
+
+  // center-aligned 100% requires compare > ARR
+  if ((value == top) && (m_mode[id] == PWM_CENTER))
+    value++;
+
+  // write MSB first
+  tim->CCR1H[2*(ch-1)]   = (uint8_t) (value >> 8);
+  tim->CCR1H[2*(ch-1)+1] = (uint8_t) value;
+
+} // PWM_setCompare
+
+
+
+/**
+  \fn void PWM_setDuty(uint8_t id, uint8_t ch, uint16_t duty)
+
+  \brief set duty cycle of channel
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+  \param[in]  ch      channel (1..PWM_channels())
+  \param[in]  duty    duty cycle in 1/PWM_DUTY_MAX (0..PWM_DUTY_MAX)
+
+  scale duty cycle to timer resolution and set compare value.
+*/
+void PWM_setDuty(uint8_t id, uint8_t ch, uint16_t duty) {
+
+  if (id >= PWM_NUM_TIMERS)
+    return;
+
+  // clip to 100%
+  if (duty > PWM_DUTY_MAX)
+    duty = PWM_DUTY_MAX;
+
+  // scale to timer resolution
+  PWM_setCompare(id, ch, (uint16_t) (((uint32_t) m_top[id] * duty) >> 15));
+
+} // PWM_setDuty
+
+
+
+/**
+  \fn void PWM_setPhase(uint8_t id, uint16_t phase)
+
+  \brief set phase of timer for PWM_start()
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+  \param[in]  phase   phase advance in 1/PWM_DUTY_MAX of period
+
+  set counter start value, i.e. timer is advanced by phase relative to timers
+  with phase 0 started in the same PWM_start() call. In center-aligned mode
+  the counter starts counting up, i.e. max. phase is 50%.
+*/
+void PWM_setPhase(uint8_t id, uint16_t phase) {
+
+  if (id >= PWM_NUM_TIMERS)
+    return;
+
+  // edge-aligned: counter 0..top-1
+  if (m_mode[id] == PWM_EDGE) {
+    if (phase >= PWM_DUTY_MAX)
+      phase = 0;
+    m_phase[id] = (uint16_t) (((uint32_t) m_top[id] * phase) >> 15);
+  }
+
+  // center-aligned: period is 2*top, counter counts up from start value
+  else {
+    if (phase > (PWM_DUTY_MAX / 2))
+      phase = PWM_DUTY_MAX / 2;
+    m_phase[id] = (uint16_t) (((uint32_t) m_top[id] * phase) >> 14);
+  }
+
+} // PWM_setPhase
+
+
+
+/**
+  \fn void PWM_start(uint8_t mask)
+
+  \brief start timers with their phase
+
+  \param[in]  mask    timers to start, e.g. PWM_MASK(PWM_TIM1) | PWM_MASK(PWM_TIM2)
+
+  stop timers, set counters to phase start values and start them directly
+  after each other. Timers are started a few CPU cycles apart in order of
+  their ID. For exact phase call with interrupts disabled.
+*/
+void PWM_start(uint8_t mask) {
+
+  uint8_t   id;
+
+  // stop timers and set counter start values (MSB first)
+  for (id=0; id<PWM_NUM_TIMERS; id++) {
+    if ((mask & PWM_MASK(id)) && (m_timer[id].numCh)) {
+      m_timer[id].CR1[0] &= (uint8_t) ~CR1_CEN;
+      m_timer[id].CNTRH[0] = (uint8_t) (m_phase[id] >> 8);
+      m_timer[id].CNTRH[1] = (uint8_t) m_phase[id];
+    }
+  }
+
+  // start timers
+  for (id=0; id<PWM_NUM_TIMERS; id++) {
+    if ((mask & PWM_MASK(id)) && (m_timer[id].numCh))
+      m_timer[id].CR1[0] |= CR1_CEN;
+  }
+
+} // PWM_start
+
+
+
+/**
+  \fn void PWM_stop(uint8_t id)
+
+  \brief stop timer
+
+  \param[in]  id      timer ID, e.g. PWM_TIM1
+
+  stop counter. Outputs keep their current level.
+*/
+void PWM_stop(uint8_t id) {
+
+  if ((id < PWM_NUM_TIMERS) && (m_timer[id].numCh))
+    m_timer[id].CR1[0] &= (uint8_t) ~CR1_CEN;
+
+} // PWM_stop
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,121 @@
+/**
+  \file pwm.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of multi-channel PWM engine for TIM1, TIM2, TIM3 and TIM5
+
+  declaration of a PWM engine for the 16-bit timers TIM1, TIM2, TIM3 and TIM5.
+  Timers are accessed via a descriptor table, i.e. the same functions are used
+  for all timers. Features:
+    - prescaler and reload value are calculated for a requested frequency and
+      min. number of duty cycle steps
+    - edge-aligned or center-aligned mode (TIM1 and STM8L TIM2/3/5 only)
+    - all compare and reload registers are buffered (preload). Updates of
+      several channels between PWM_lock() and PWM_unlock() are transferred
+      together with the next update event, i.e. without glitches
+    - complementary outputs with dead-time (TIM1 channels 1-3 only)
+    - 180deg phase-shift of single channels in center-aligned mode
+    - phase-shift between timers via counter start values and a common start
+
+  \note
+  - timer output pins are not configured, see device datasheet for
+    pin mapping and alternate function remapping
+  - functions are not reentrant. Don't call them from ISRs and main at the same time
+  - between PWM_lock() and PWM_unlock() update events are disabled, i.e. keep
+    this section short (< 1 PWM period) to avoid missed periods
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _PWM_H_
+#define _PWM_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// default master clock [Hz], can be overwritten in config.h
+#ifndef F_MASTER
+  #define F_MASTER          16000000L
+#endif
+
+// timer IDs. Not all timers are available on all devices
+#define PWM_TIM1            0         ///< advanced control timer (16-bit prescaler, 4 channels, dead-time)
+#define PWM_TIM2            1         ///< general purpose timer 2
+#define PWM_TIM3            2         ///< general purpose timer 3
+#define PWM_TIM5            3         ///< general purpose timer 5
+#define PWM_NUM_TIMERS      4         ///< number of timer IDs
+
+/// bitmask of timer ID for PWM_start()
+#define PWM_MASK(id)        ((uint8_t) (1 << (id)))
+
+// PWM alignment modes
+#define PWM_EDGE            0         ///< edge-aligned, counter counts up
+#define PWM_CENTER          1         ///< center-aligned, counter counts up and down
+
+// channel options for PWM_channel(). Can be combined
+#define PWM_ACTIVE_LOW      0x01      ///< output is active low
+#define PWM_COMPLEMENTARY   0x02      ///< also enable complementary output CHxN (TIM1 CH1-3 only)
+#define PWM_SHIFT180        0x04      ///< shift pulse by 180deg (center-aligned mode only)
+
+/// duty cycle for 100%. Duty cycles are passed in units of 1/PWM_DUTY_MAX
+#define PWM_DUTY_MAX        0x8000
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init timer for PWM with frequency [Hz], min. duty steps and alignment. Returns duty steps or 0 on error
+uint16_t PWM_begin(uint8_t id, uint32_t freq, uint16_t steps, uint8_t mode);
+
+/// change PWM frequency [Hz] with min. duty steps. Returns duty steps or 0 on error. Reset duty cycles afterwards
+uint16_t PWM_setFrequency(uint8_t id, uint32_t freq, uint16_t steps);
+
+/// get number of compare channels of timer, or 0 if timer is not available
+uint8_t PWM_channels(uint8_t id);
+
+/// configure and enable channel (1..4) with options PWM_ACTIVE_LOW etc. Returns 1 on success, 0 on error
+uint8_t PWM_channel(uint8_t id, uint8_t ch, uint8_t options);
+
+/// set dead-time [ns] of complementary outputs (TIM1 only). Returns set dead-time [ns]
+uint16_t PWM_deadtime(uint16_t ns);
+
+/// defer update of buffered registers until PWM_unlock()
+void PWM_lock(uint8_t id);
+
+/// transfer all buffered registers with next update event
+void PWM_unlock(uint8_t id);
+
+/// set duty cycle of channel in 1/PWM_DUTY_MAX
+void PWM_setDuty(uint8_t id, uint8_t ch, uint16_t duty);
+
+/// set compare value of channel in timer ticks (0..duty steps)
+void PWM_setCompare(uint8_t id, uint8_t ch, uint16_t value);
+
+/// set phase of timer in 1/PWM_DUTY_MAX of period for PWM_start(). Center-aligned max. 50%
+void PWM_setPhase(uint8_t id, uint16_t phase);
+
+/// start timers given as bitmask of PWM_MASK(id) with their phase
+void PWM_start(uint8_t mask);
+
+/// stop timer. Outputs keep their level
+void PWM_stop(uint8_t id);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _PWM_H_
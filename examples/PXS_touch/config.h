@@ -0,0 +1,61 @@
+/**
+  \file config.h
+
+  \brief set project configurations
+
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define STM8TL52_BOARD
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8TL52_BOARD)
+  #include "../../include/STM8TL52F4.h"
+  #define TOUCH_PCK2_PXS      0x01          // PCKENR2 bit for PXS clock (PCKEN20)
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    TOUCH CONFIGURATION
+----------------------------------------------------------*/
+
+// electrodes: X(name, bank, RX, TX mask, touch threshold, proximity threshold, sampling capacitor, EPCC)
+//  - electrodes of one bank are acquired in parallel, banks one after the other
+//  - TX mask=0: self capacitance (surface), else mutual capacitance (projected)
+//  - thresholds are count deltas. Proximity threshold = touch threshold disables proximity
+//  - sampling capacitor (RXnCSSELR) and EPCC (RXnEPCCSELR) are per RX line
+#define TOUCH_ELECTRODES(X) \
+  X(TOUCH_KEY1,   0,  0,  0x0000,   40,   40,   16,   0) \
+  X(TOUCH_KEY2,   0,  1,  0x0000,   40,   40,   16,   0) \
+  X(TOUCH_KEY3,   0,  2,  0x0000,   40,   40,   16,   0) \
+  X(TOUCH_PROX,   1,  3,  0x0000,  120,   15,   24,   0)
+
+// number of banks in TOUCH_ELECTRODES
+#define TOUCH_BANKS           2
+
+// acquisitions per scan = 2^TOUCH_SAMPLES_SHIFT (averaging)
+#define TOUCH_SAMPLES_SHIFT   2
+
+// scan period [ms]
+#define TOUCH_PERIOD          10
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
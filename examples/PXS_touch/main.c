@@ -0,0 +1,126 @@
+/**********************
+  Capacitive touch keys and proximity sensor via ProxSense (PXS)
+
+  supported hardware:
+    - STM8TL52F4 board with 3 touch keys on RX0..RX2, proximity electrode on RX3
+      and USART on PC2/PC3
+
+  Functionality:
+    - scan electrodes every TOUCH_PERIOD ms. Keys are acquired in parallel
+      (bank 0), proximity electrode separately (bank 1), 4x averaging
+    - acquisition sequence runs in PXS interrupt, CPU waits in WAIT mode
+    - track baselines, debounce and detect touch/proximity
+    - print state changes and deltas via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "touch.h"
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    GLOBAL VARIABLES
+----------------------------------------------------------*/
+
+// electrode names for output, generated from electrode list
+#define TOUCH_NAME(name, bank, rx, tx, touch, prox, cs, epcc)   #name,
+const char *names[TOUCH_NUM] = { TOUCH_ELECTRODES(TOUCH_NAME) };
+#undef TOUCH_NAME
+
+// state names for output
+const char *states[] = { "calib", "release", "proximity", "touch" };
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint8_t   last[TOUCH_NUM];
+  uint8_t   i;
+  uint32_t  lastScan = 0;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init peripherals
+  UART_begin(115200);
+  TIM4_init();
+  TOUCH_begin();
+  for (i=0; i<TOUCH_NUM; i++)
+    last[i] = TOUCH_CALIB;
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  printf("\nProxSense touch: %u electrodes in %u banks\n", (uint16_t) TOUCH_NUM, (uint16_t) TOUCH_BANKS);
+
+  // main loop
+  while(1) {
+
+    // start periodic scan
+    if ((uint32_t) (millis() - lastScan) >= TOUCH_PERIOD) {
+      lastScan = millis();
+      TOUCH_start();
+    }
+
+    // evaluate completed scan and print changes
+    if (TOUCH_ready() && TOUCH_process()) {
+      for (i=0; i<TOUCH_NUM; i++) {
+        if (TOUCH_state(i) != last[i]) {
+          last[i] = TOUCH_state(i);
+          printf("%s: %s (delta %d)\n", names[i], states[last[i]], TOUCH_delta(i));
+        }
+      }
+    }
+
+    // wait for next interrupt (PXS or 1ms tick)
+    WAIT_FOR_INTERRUPT();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,73 @@
+/**
+  \file timer4.h
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief declaration of timer TIM4 (1ms clock) functions/macros
+   
+  declaration of timer TIM4 functions as 1ms master clock (fMaster=16MHz).
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _TIMER4_H_
+#define _TIMER4_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL VARIABLES
+-----------------------------------------------------------------------------*/
+
+// declare or reference to global variables, depending on '_MAIN_'
+#if defined(_MAIN_)
+  volatile uint8_t            g_flagMilli;                 ///< flag for 1ms timer interrupt. Set in TIM4 ISR
+  volatile uint32_t           g_millis;                    ///< 1ms counter. Increased in TIM4 ISR
+#else // _MAIN_
+  extern volatile uint8_t     g_flagMilli;
+  extern volatile uint32_t    g_millis;
+#endif // _MAIN_
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+#define flagMilli()           g_flagMilli                   ///< 1ms flag. Set in 1ms ISR
+#define clearFlagMilli()      g_flagMilli=0                 ///< clear 1ms flag
+#define millis()              g_millis                      ///< get milliseconds since start of program
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init timer 4 (1ms master clock). Requires fMaster=16MHz
+void TIM4_init(void);
+
+/// ISR for timer 4 (1ms master clock)
+#if defined(_TIM4_OVR_UIF_VECTOR_)
+  ISR_HANDLER(TIM4_UPD_ISR, _TIM4_OVR_UIF_VECTOR_);
+#elif defined(_TIM4_UIF_VECTOR_)
+  ISR_HANDLER(TIM4_UPD_ISR, _TIM4_UIF_VECTOR_)
+#elif defined(_TIM4_UPDATE_VECTOR_)
+  ISR_HANDLER(TIM4_UPD_ISR, _TIM4_UPDATE_VECTOR_);
+#else
+  #error TIM4 vector undefined
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _TIMER4_H_
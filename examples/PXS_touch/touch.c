@@ -0,0 +1,455 @@
+/**
+  \file touch.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of capacitive touch engine for ProxSense (PXS)
+
+  implementation of interrupt driven PXS acquisition and of baseline
+  tracking, debouncing and proximity/touch detection, see touch.h.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "touch.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+/// number of acquisitions per scan
+#define TOUCH_SAMPLES     (1 << TOUCH_SAMPLES_SHIFT)
+
+// compile-time checks of electrode list
+#define TOUCH_CHECK(name, bank, rx, tx, touch, prox, cs, epcc) \
+  typedef char check_##name[((bank) < TOUCH_BANKS) && ((rx) < TOUCH_RX_NUM) && ((prox) <= (touch)) && ((prox) > 0) && ((cs) < 32) && ((epcc) < 256) ? 1 : -1];
+TOUCH_ELECTRODES(TOUCH_CHECK)
+#undef TOUCH_CHECK
+
+// sum of acquisitions must fit into 16 bit
+typedef char check_sum_range[((uint32_t) TOUCH_MAX_COUNT << TOUCH_SAMPLES_SHIFT) < 65536L ? 1 : -1];
+
+
+/*----------------------------------------------------------
+    MODULE TYPEDEFS
+----------------------------------------------------------*/
+
+/// electrode configuration, generated at compile time
+typedef struct {
+  uint8_t     bank;         ///< bank index
+  uint8_t     rx;           ///< receiver
+  uint16_t    tx;           ///< transmitter mask (0=self capacitance)
+  int16_t     touchIn;      ///< delta to enter touch
+  int16_t     touchOut;     ///< delta to leave touch
+  int16_t     proxIn;       ///< delta to enter proximity
+  int16_t     proxOut;      ///< delta to leave proximity
+  uint8_t     cs;           ///< sampling capacitor selection
+  uint8_t     epcc;         ///< parasitic capacitance compensation
+} touch_cfg_t;
+
+/// electrode runtime data
+typedef struct {
+  uint32_t    base;         ///< baseline [1/256 counts]
+  int16_t     delta;        ///< last delta
+  uint16_t    time;         ///< scans in current state
+  uint8_t     state;        ///< state TOUCH_xxx
+  uint8_t     debounce;     ///< consecutive scans with new target state
+} touch_elec_t;
+
+
+/*----------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+----------------------------------------------------------*/
+
+/// electrode configuration incl. hysteresis thresholds
+#define TOUCH_CFG(name, bank, rx, tx, touch, prox, cs, epcc) \
+  { bank, rx, tx, touch, ((int32_t) (touch) * TOUCH_HYSTERESIS) / 100, prox, ((int32_t) (prox) * TOUCH_HYSTERESIS) / 100, cs, epcc },
+static const touch_cfg_t  m_cfg[TOUCH_NUM] = {
+  TOUCH_ELECTRODES(TOUCH_CFG)
+};
+#undef TOUCH_CFG
+
+/// electrode runtime data
+static touch_elec_t       m_elec[TOUCH_NUM];
+
+/// receivers and transmitters per bank. Set in TOUCH_begin()
+static uint16_t           m_bankRx[TOUCH_BANKS];
+static uint16_t           m_bankTx[TOUCH_BANKS];
+
+/// sum of counts over samples per bank and receiver. Written in ISR
+static uint16_t           m_sum[TOUCH_BANKS][TOUCH_RX_NUM];
+
+/// receivers with timeout per bank. Written in ISR
+static uint16_t           m_timeout[TOUCH_BANKS];
+
+/// acquisition sequence state. Written in ISR
+static volatile uint8_t   m_bank, m_sample, m_busy, m_done;
+
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn static void selectBank(uint8_t bank)
+
+  \brief enable receivers and transmitters of bank
+
+  \param[in]  bank    bank index
+*/
+static void selectBank(uint8_t bank) {
+
+  sfr_PXS.RXENRH.byte = (uint8_t) (m_bankRx[bank] >> 8);
+  sfr_PXS.RXENRL.byte = (uint8_t) (m_bankRx[bank]);
+  sfr_PXS.TXENRH.byte = (uint8_t) (m_bankTx[bank] >> 8);
+  sfr_PXS.TXENRL.byte = (uint8_t) (m_bankTx[bank]);
+
+} // selectBank
+
+
+
+/**
+  \fn void TOUCH_begin(void)
+
+  \brief configure PXS and start calibration
+
+  enable PXS clock, set sampling capacitor and EPCC per receiver, derive
+  bank masks from electrode list and enable end-of-conversion interrupt.
+  All electrodes start in TOUCH_CALIB.
+*/
+void TOUCH_begin(void) {
+
+  uint8_t   i;
+  uint16_t  used = 0;
+
+  // enable PXS clock
+  sfr_CLK.PCKENR2.byte |= TOUCH_PCK2_PXS;
+
+  // stop PXS
+  sfr_PXS.CR1.byte = 0x00;
+  sfr_PXS.CR2.byte = 0x00;
+
+  // optional analog and timing settings, else keep reset values
+  #if defined(TOUCH_CR3)
+    sfr_PXS.CR3.byte = TOUCH_CR3;
+  #endif
+  #if defined(TOUCH_CKCR1)
+    sfr_PXS.CKCR1.byte = TOUCH_CKCR1;
+  #endif
+  #if defined(TOUCH_CKCR2)
+    sfr_PXS.CKCR2.byte = TOUCH_CKCR2;
+  #endif
+
+  // bank masks and per receiver settings
+  for (i=0; i<TOUCH_BANKS; i++) {
+    m_bankRx[i] = 0;
+    m_bankTx[i] = 0;
+  }
+  for (i=0; i<TOUCH_NUM; i++) {
+    m_bankRx[m_cfg[i].bank] |= (uint16_t) 1 << m_cfg[i].rx;
+    m_bankTx[m_cfg[i].bank] |= m_cfg[i].tx;
+    used |= (uint16_t) 1 << m_cfg[i].rx;
+    (&(sfr_PXS.RX0CSSELR.byte))[m_cfg[i].rx]   = m_cfg[i].cs;
+    (&(sfr_PXS.RX0EPCCSELR.byte))[m_cfg[i].rx] = m_cfg[i].epcc;
+  }
+
+  // inactive receivers are grounded
+  sfr_PXS.RXINSRH.byte = 0x00;
+  sfr_PXS.RXINSRL.byte = 0x00;
+
+  // timeout for all used receivers
+  sfr_PXS.MAXRH.byte   = (uint8_t) (TOUCH_MAX_COUNT >> 8);
+  sfr_PXS.MAXRL.byte   = (uint8_t) (TOUCH_MAX_COUNT);
+  sfr_PXS.MAXENRH.byte = (uint8_t) (used >> 8);
+  sfr_PXS.MAXENRL.byte = (uint8_t) (used);
+
+  // reset sequencer and electrodes
+  m_busy = 0;
+  m_done = 0;
+  TOUCH_recalibrate();
+
+  // enable end of conversion interrupt and PXS
+  sfr_PXS.CR2.EOCITEN   = 1;
+  sfr_PXS.CR1.LOW_POWER = TOUCH_LOW_POWER;
+  sfr_PXS.CR1.PXSEN     = 1;
+
+} // TOUCH_begin
+
+
+
+/**
+  \fn uint8_t TOUCH_start(void)
+
+  \brief start scan of all banks
+
+  \return 1 if scan was started, 0 if previous scan is still running
+
+  start acquisition of first bank. Further banks and samples are started
+  in the end-of-conversion ISR. A completed but unprocessed scan is discarded.
+*/
+uint8_t TOUCH_start(void) {
+
+  uint8_t   b, i;
+
+  if (m_busy)
+    return(0);
+
+  // clear sums
+  for (b=0; b<TOUCH_BANKS; b++) {
+    for (i=0; i<TOUCH_RX_NUM; i++)
+      m_sum[b][i] = 0;
+    m_timeout[b] = 0;
+  }
+
+  // start first bank
+  m_bank   = 0;
+  m_sample = 0;
+  m_done   = 0;
+  m_busy   = 1;
+  selectBank(0);
+  sfr_PXS.CR1.START = 1;
+
+  return(1);
+
+} // TOUCH_start
+
+
+
+/**
+  \fn uint8_t TOUCH_ready(void)
+
+  \brief check if scan is complete
+
+  \return 1 if scan is complete and not yet processed, else 0
+*/
+uint8_t TOUCH_ready(void) {
+
+  return(m_done);
+
+} // TOUCH_ready
+
+
+
+/**
+  \fn uint8_t TOUCH_process(void)
+
+  \brief evaluate completed scan
+
+  \return number of electrodes with state change
+
+  for each electrode: average counts, update delta, baseline and debounced
+  state. Electrodes with timeout keep their state. Call after TOUCH_ready().
+*/
+uint8_t TOUCH_process(void) {
+
+  const touch_cfg_t   *cfg;
+  touch_elec_t        *el;
+  uint32_t            meas;
+  uint8_t             i, target, changes = 0;
+
+  if (!m_done)
+    return(0);
+
+  for (i=0; i<TOUCH_NUM; i++) {
+    cfg = &(m_cfg[i]);
+    el  = &(m_elec[i]);
+
+    // skip timeout
+    if (m_timeout[cfg->bank] & ((uint16_t) 1 << cfg->rx))
+      continue;
+
+    // average count [1/256]
+    meas = ((uint32_t) m_sum[cfg->bank][cfg->rx] << 8) >> TOUCH_SAMPLES_SHIFT;
+
+    // initial baseline: first value, then fast filter
+    if (el->state == TOUCH_CALIB) {
+      if (el->time == 0)
+        el->base = meas;
+      else if (meas > el->base)
+        el->base += (meas - el->base) >> 2;
+      else
+        el->base -= (el->base - meas) >> 2;
+      el->delta = 0;
+      if (++(el->time) >= TOUCH_CALIB_SCANS) {
+        el->state    = TOUCH_RELEASE;
+        el->time     = 0;
+        el->debounce = 0;
+        changes++;
+      }
+      continue;
+    }
+
+    // delta = baseline - count, positive on touch
+    el->delta = (int16_t) (((int32_t) el->base - (int32_t) meas) >> 8);
+
+    // target state with hysteresis
+    if (el->delta >= ((el->state == TOUCH_DETECT) ? cfg->touchOut : cfg->touchIn))
+      target = TOUCH_DETECT;
+    else if ((cfg->proxIn < cfg->touchIn) && (el->delta >= ((el->state >= TOUCH_PROXIMITY) ? cfg->proxOut : cfg->proxIn)))
+      target = TOUCH_PROXIMITY;
+    else
+      target = TOUCH_RELEASE;
+
+    // debounce state change
+    if (target != el->state) {
+      if (++(el->debounce) >= ((target > el->state) ? TOUCH_DEBOUNCE_IN : TOUCH_DEBOUNCE_OUT)) {
+        el->state    = target;
+        el->time     = 0;
+        el->debounce = 0;
+        changes++;
+      }
+    }
+    else
+      el->debounce = 0;
+
+    // track baseline only without detection. Fast recovery if count increased
+    if ((el->state == TOUCH_RELEASE) && (target == TOUCH_RELEASE)) {
+      if (meas > el->base)
+        el->base += (meas - el->base) >> TOUCH_NEG_DRIFT_SHIFT;
+      else
+        el->base -= (el->base - meas) >> TOUCH_DRIFT_SHIFT;
+    }
+
+    // recalibrate if touched too long, e.g. object placed on electrode
+    if (el->time < 0xFFFF)
+      el->time++;
+    #if (TOUCH_MAX_DURATION > 0)
+      if ((el->state == TOUCH_DETECT) && (el->time >= TOUCH_MAX_DURATION)) {
+        el->state    = TOUCH_CALIB;
+        el->time     = 0;
+        el->debounce = 0;
+        changes++;
+      }
+    #endif
+
+  } // loop over electrodes
+
+  m_done = 0;
+
+  return(changes);
+
+} // TOUCH_process
+
+
+
+/**
+  \fn uint8_t TOUCH_state(touch_id_t id)
+
+  \brief get electrode state
+
+  \param[in]  id    electrode identifier from TOUCH_ELECTRODES
+
+  \return state TOUCH_xxx
+*/
+uint8_t TOUCH_state(touch_id_t id) {
+
+  return(m_elec[id].state);
+
+} // TOUCH_state
+
+
+
+/**
+  \fn int16_t TOUCH_delta(touch_id_t id)
+
+  \brief get last delta of electrode
+
+  \param[in]  id    electrode identifier from TOUCH_ELECTRODES
+
+  \return baseline - count of last scan
+*/
+int16_t TOUCH_delta(touch_id_t id) {
+
+  return(m_elec[id].delta);
+
+} // TOUCH_delta
+
+
+
+/**
+  \fn void TOUCH_recalibrate(void)
+
+  \brief restart baseline calibration
+
+  set all electrodes to TOUCH_CALIB. New baselines are acquired during
+  the next TOUCH_CALIB_SCANS scans.
+*/
+void TOUCH_recalibrate(void) {
+
+  uint8_t   i;
+
+  for (i=0; i<TOUCH_NUM; i++) {
+    m_elec[i].state    = TOUCH_CALIB;
+    m_elec[i].time     = 0;
+    m_elec[i].debounce = 0;
+    m_elec[i].delta    = 0;
+  }
+
+} // TOUCH_recalibrate
+
+
+
+/**
+  \fn void TOUCH_PXS_ISR(void)
+
+  \brief ISR for PXS end of conversion
+
+  interrupt service routine for PXS end of conversion. Add counts of the
+  current bank, then start the next bank or sample. After the last
+  acquisition the scan is marked complete and PXS stays idle.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(TOUCH_PXS_ISR, _PXS_EOC_VECTOR_)
+{
+  uint8_t   rx, *cnt;
+  uint16_t  mask, valid;
+
+  // clear flag (write 1)
+  sfr_PXS.ISR.byte = 0x80;
+
+  // add counts of enabled receivers, mark timeouts
+  mask  = m_bankRx[m_bank];
+  valid = ((uint16_t) sfr_PXS.RXSRH.byte << 8) | sfr_PXS.RXSRL.byte;
+  cnt   = &(sfr_PXS.RX0CNTRH.byte);
+  for (rx=0; rx<TOUCH_RX_NUM; rx++) {
+    if (mask & 0x01) {
+      if (valid & 0x01)
+        m_sum[m_bank][rx] += ((uint16_t) cnt[0] << 8) | cnt[1];
+      else
+        m_timeout[m_bank] |= (uint16_t) 1 << rx;
+    }
+    mask  >>= 1;
+    valid >>= 1;
+    cnt    += 2;
+  }
+
+  // next bank, then next sample
+  if (++m_bank >= TOUCH_BANKS) {
+    m_bank = 0;
+    if (++m_sample >= TOUCH_SAMPLES) {
+      m_busy = 0;
+      m_done = 1;
+      return;
+    }
+  }
+
+  // start next acquisition
+  #if (TOUCH_BANKS > 1)
+    selectBank(m_bank);
+  #endif
+  sfr_PXS.CR1.START = 1;
+
+} // TOUCH_PXS_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
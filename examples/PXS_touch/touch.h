@@ -0,0 +1,164 @@
+/**
+  \file touch.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of capacitive touch engine for ProxSense (PXS)
+
+  declaration of touch acquisition and detection for STM8TL5x devices.
+  Features:
+    - electrodes are listed in config.h (TOUCH_ELECTRODES). Identifiers,
+      per-electrode tables, hysteresis thresholds and consistency checks
+      are generated from this list at compile time
+    - electrodes are grouped into banks. All receivers of a bank are
+      acquired in parallel, banks and averaging samples are sequenced in
+      the PXS end-of-conversion interrupt without CPU polling
+    - baseline tracking with slow drift compensation, fast recovery from
+      negative deltas and recalibration after max. touch duration
+    - detection states release, proximity and touch with hysteresis and
+      debouncing in both directions
+
+  Usage:
+    - TOUCH_start() starts a scan, TOUCH_ready() reports its end
+    - TOUCH_process() evaluates the scan in main context
+    - query results via TOUCH_state() and TOUCH_delta()
+
+  \note
+  - counts decrease with increasing electrode capacitance, i.e. delta =
+    baseline - count is positive on touch
+  - electrodes sharing an RX line (in different banks) share sampling
+    capacitor and EPCC settings
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _TOUCH_H_
+#define _TOUCH_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// check for ProxSense
+#if !defined(sfr_PXS)
+  #error device has no ProxSense module
+#endif
+
+/// number of PXS receivers
+#define TOUCH_RX_NUM            10
+
+// number of acquisitions per scan = 2^TOUCH_SAMPLES_SHIFT. Default can be overwritten in config.h
+#ifndef TOUCH_SAMPLES_SHIFT
+  #define TOUCH_SAMPLES_SHIFT   2
+#endif
+
+// max. count, longer acquisitions are timeouts. Default can be overwritten in config.h
+#ifndef TOUCH_MAX_COUNT
+  #define TOUCH_MAX_COUNT       4000
+#endif
+
+// release threshold in % of detect threshold (hysteresis). Default can be overwritten in config.h
+#ifndef TOUCH_HYSTERESIS
+  #define TOUCH_HYSTERESIS      75
+#endif
+
+// consecutive scans to enter/leave a state (debouncing). Default can be overwritten in config.h
+#ifndef TOUCH_DEBOUNCE_IN
+  #define TOUCH_DEBOUNCE_IN     3
+#endif
+#ifndef TOUCH_DEBOUNCE_OUT
+  #define TOUCH_DEBOUNCE_OUT    2
+#endif
+
+// scans for initial baseline. Default can be overwritten in config.h
+#ifndef TOUCH_CALIB_SCANS
+  #define TOUCH_CALIB_SCANS     8
+#endif
+
+// baseline drift filter 2^-n per scan, for positive and negative deltas. Default can be overwritten in config.h
+#ifndef TOUCH_DRIFT_SHIFT
+  #define TOUCH_DRIFT_SHIFT     7
+#endif
+#ifndef TOUCH_NEG_DRIFT_SHIFT
+  #define TOUCH_NEG_DRIFT_SHIFT 2
+#endif
+
+// max. touch duration [scans] before recalibration, 0=unlimited. Default can be overwritten in config.h
+#ifndef TOUCH_MAX_DURATION
+  #define TOUCH_MAX_DURATION    3000
+#endif
+
+// PXS low-power mode (CR1.LOW_POWER). Default can be overwritten in config.h
+#ifndef TOUCH_LOW_POWER
+  #define TOUCH_LOW_POWER       1
+#endif
+
+// PXS clock gating bit in PCKENR2. Default can be overwritten in config.h
+#ifndef TOUCH_PCK2_PXS
+  #define TOUCH_PCK2_PXS        0x01
+#endif
+
+// electrode states
+#define TOUCH_CALIB             0             ///< baseline calibration
+#define TOUCH_RELEASE           1             ///< no detection
+#define TOUCH_PROXIMITY         2             ///< object near electrode
+#define TOUCH_DETECT            3             ///< electrode touched
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// electrode identifiers, generated from TOUCH_ELECTRODES
+#define TOUCH_ENUM(name, bank, rx, tx, touch, prox, cs, epcc)   name,
+typedef enum {
+  TOUCH_ELECTRODES(TOUCH_ENUM)
+  TOUCH_NUM                                 ///< number of electrodes
+} touch_id_t;
+#undef TOUCH_ENUM
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// configure PXS from electrode tables and start baseline calibration
+void TOUCH_begin(void);
+
+/// start scan of all banks. Returns 0 if previous scan is still running
+uint8_t TOUCH_start(void);
+
+/// check if scan is complete and not yet processed
+uint8_t TOUCH_ready(void);
+
+/// evaluate completed scan. Returns number of state changes
+uint8_t TOUCH_process(void);
+
+/// get state TOUCH_xxx of electrode
+uint8_t TOUCH_state(touch_id_t id);
+
+/// get last delta (baseline - count) of electrode
+int16_t TOUCH_delta(touch_id_t id);
+
+/// restart baseline calibration of all electrodes
+void TOUCH_recalibrate(void);
+
+/// ISR for PXS end of conversion
+ISR_HANDLER(TOUCH_PXS_ISR, _PXS_EOC_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _TOUCH_H_
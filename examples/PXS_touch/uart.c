@@ -0,0 +1,60 @@
+/**
+  \file uart.c
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief implementation of UART functions/macros
+   
+  implementation of UART functions.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "uart.h"
+
+
+
+/**
+  \fn void UART_begin(uint32_t BR)
+   
+  \brief initialize UART for blocking transmission, polling reception
+  
+  \param[in]  BR    baudrate [Baud]
+
+  initialize UART for communication with specified baudrate.
+  Use 1 start, 8 data and 1 stop bit; no parity or flow control.
+  Use blocking Tx, and polling Rx. Requires fMaster=16MHz
+*/
+void UART_begin(uint32_t BR) {
+
+  uint16_t  val16;
+
+  // for low-power device enable clock gating to USART1
+  #if defined(FAMILY_STM8L) || defined(FAMILY_STM8T)
+    sfr_CLK.PCKENR1.byte |= 0x20;     // PCKEN15 (bit name differs between devices)
+  #endif
+
+  // reset UART
+  sfr_UART.CR1.byte = 0x00;   // enable UART, 8 data bits, no parity control
+  sfr_UART.CR2.byte = 0x00;   // no interrupts, disable sender/receiver
+  sfr_UART.CR3.byte = 0x00;   // 1 stop bit, no clock output
+
+  // set baudrate (note: BRR2 must be written before BRR1!)
+  val16 = (uint16_t) (((uint32_t) 16000000L)/BR);
+  sfr_UART.BRR2.byte = (uint8_t) (((val16 & 0xF000) >> 8) | (val16 & 0x000F));
+  sfr_UART.BRR1.byte = (uint8_t) ((val16 & 0x0FF0) >> 4);
+
+  // enable transmission, no interrupts
+  sfr_UART.CR2.REN  = 1;  // enable receiver
+  sfr_UART.CR2.TEN  = 1;  // enable sender
+
+} // UART_begin
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,52 @@
+/**
+  \file config.h
+
+  \brief set project configurations
+
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define STM8L162_BOARD
+//#define STM8L_DISCOVERY
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8L162_BOARD)
+  #include "../../include/STM8L162R8.h"     // with sub-second and calibration
+#elif defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"     // no sub-second and calibration
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    RTC CONFIGURATION
+----------------------------------------------------------*/
+
+// use 32.768kHz crystal. Else LSI (~38kHz, +/-10%)
+#define RTC_LSE
+
+// calibration [0.1ppm], e.g. from measurement of 1Hz output
+#define RTC_CALIB_PPM10     0
+
+// data logger interval [ms]
+#define LOG_INTERVAL        10000L
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
@@ -0,0 +1,153 @@
+/**********************
+  RTC calendar with alarms, wake-up timer and active-halt between events
+
+  supported hardware:
+    - STM8L162R8 board with USART1 on PC2/PC3 -> with sub-second and calibration
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - start RTC from 32.768kHz crystal. Set calendar only after power-on
+    - apply smooth calibration (if supported)
+    - data logger: wake every LOG_INTERVAL via wake-up timer and print timestamp
+    - alarm every full minute, and once after 90s via relative alarm
+    - stay in active-halt between events
+    - print results via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "uart.h"
+  #include "rtc.h"
+#undef _MAIN_
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/**
+  \fn void printTime(const char *event)
+
+  \brief print event with timestamp
+
+  \param[in]  event   name of event
+*/
+void printTime(const char *event) {
+
+  rtc_time_t  t;
+
+  RTC_getTime(&t);
+  printf("20%02u-%02u-%02u %02u:%02u:%02u.%03u (%lus): %s\n",
+    (uint16_t) t.year, (uint16_t) t.month, (uint16_t) t.day,
+    (uint16_t) t.hour, (uint16_t) t.minute, (uint16_t) t.second, t.millis,
+    RTC_toSeconds(&t), event);
+
+} // printTime
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  rtc_time_t  t;
+  uint8_t     events, once = 1;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init peripherals
+  UART_begin(115200);
+
+  // start RTC. Set calendar only if not yet running
+  if (!RTC_begin()) {
+    t.year   = 26;
+    t.month  = 10;
+    t.day    = 18;
+    t.hour   = 12;
+    t.minute = 0;
+    t.second = 0;
+    RTC_setTime(&t);
+  }
+  #if (RTC_HAS_CALIB)
+    RTC_calibrate(RTC_CALIB_PPM10);
+  #endif
+
+  // periodic logger wake-up
+  RTC_setWakeup(LOG_INTERVAL);
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  printf("\nRTC %s sub-second\n", (RTC_HAS_SUBSEC) ? "with" : "without");
+  printTime("start");
+
+  // alarm once after 90s
+  RTC_alarmIn(90);
+
+  // main loop
+  while(1) {
+
+    // wait for UART, then sleep in active-halt until next RTC event
+    UART_flush();
+    events = RTC_sleep();
+
+    // wake-up timer -> log
+    if (events & RTC_EVENT_WAKEUP)
+      printTime("log");
+
+    // alarm
+    if (events & RTC_EVENT_ALARM) {
+      if (once) {
+        printTime("alarm after 90s");
+        once = 0;
+
+        // then alarm every full minute
+        t.second = 0;
+        RTC_setAlarm(&t, RTC_ALARM_ANY_DAY | RTC_ALARM_ANY_HOUR | RTC_ALARM_ANY_MINUTE);
+      }
+      else
+        printTime("alarm minute");
+    }
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
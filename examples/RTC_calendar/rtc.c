@@ -0,0 +1,592 @@
+/**
+  \file rtc.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of RTC calendar, alarm and wake-up service
+
+  implementation of calendar access, alarm, wake-up timer, calibration
+  and active-halt sleep via RTC, see rtc.h.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "rtc.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// RTC write protection
+#define RTC_UNLOCK()    { sfr_RTC.WPR.byte = 0xCA; sfr_RTC.WPR.byte = 0x53; }
+#define RTC_LOCK()      { sfr_RTC.WPR.byte = 0xFF; }
+
+// name of LSE control register differs between devices
+#if defined(sfr_CLK_ECKCR_RESET_VALUE)
+  #define CLK_ECKR      ECKCR
+#else
+  #define CLK_ECKR      ECKR
+#endif
+
+
+/*----------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+----------------------------------------------------------*/
+
+/// pending RTC_EVENT_xxx. Set in RTC ISR
+static volatile uint8_t   m_events;
+
+/// days before month in non-leap year
+static const uint16_t     m_daysBefore[12] = { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 };
+
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn static uint8_t toBcd(uint8_t val)
+
+  \brief convert binary to BCD
+
+  \param[in]  val   binary value (0..99)
+
+  \return BCD value
+*/
+static uint8_t toBcd(uint8_t val) {
+
+  return((uint8_t) (((val / 10) << 4) | (val % 10)));
+
+} // toBcd
+
+
+
+/**
+  \fn static uint8_t fromBcd(uint8_t val)
+
+  \brief convert BCD to binary
+
+  \param[in]  val   BCD value
+
+  \return binary value
+*/
+static uint8_t fromBcd(uint8_t val) {
+
+  return((uint8_t) ((val >> 4) * 10 + (val & 0x0F)));
+
+} // fromBcd
+
+
+
+/**
+  \fn uint8_t RTC_begin(void)
+
+  \brief start RTC clock and prescalers
+
+  \return 1 if calendar was already initialized, else 0
+
+  enable RTC clock from LSE (RTC_LSE defined in config.h) or LSI. If the
+  calendar is not yet initialized, set prescalers for 1Hz and 24h format.
+  Main regulator and voltage reference are switched off during active-halt.
+*/
+uint8_t RTC_begin(void) {
+
+  // enable RTC clock (PCKEN22. Bit name differs between devices)
+  sfr_CLK.PCKENR2.byte |= 0x04;
+
+  // start LSE or LSI and select as RTC clock with prescaler 1
+  #if defined(RTC_LSE)
+    sfr_CLK.CLK_ECKR.LSEON = 1;
+    while (!sfr_CLK.CLK_ECKR.LSERDY);
+    sfr_CLK.CRTCR.byte = 0x10;
+  #else
+    sfr_CLK.ICKCR.LSION = 1;
+    while (!sfr_CLK.ICKCR.LSIRDY);
+    sfr_CLK.CRTCR.byte = 0x04;
+  #endif
+  while (sfr_CLK.CRTCR.RTCSWBSY);
+
+  // switch off main regulator and internal reference voltage during active-halt
+  sfr_CLK.ICKCR.SAHALT = 1;
+  sfr_PWR.CSR2.ULP = 1;
+  sfr_PWR.CSR2.FWU = 1;
+
+  // reset events
+  m_events = 0;
+
+  // calendar already running -> keep
+  if (sfr_RTC.ISR1.INITS)
+    return(1);
+
+  // enter init mode
+  RTC_UNLOCK();
+  sfr_RTC.ISR1.INIT = 1;
+  while (!sfr_RTC.ISR1.INITF);
+
+  // set prescalers for 1Hz. APRER must be written last
+  sfr_RTC.SPRERH.byte = (uint8_t) (RTC_PREDIV_S >> 8);
+  sfr_RTC.SPRERL.byte = (uint8_t) (RTC_PREDIV_S);
+  sfr_RTC.APRER.byte  = (uint8_t) (RTC_PREDIV_A);
+
+  // 24h format
+  sfr_RTC.CR1.FMT = 0;
+
+  // exit init mode
+  sfr_RTC.ISR1.INIT = 0;
+  RTC_LOCK();
+
+  return(0);
+
+} // RTC_begin
+
+
+
+/**
+  \fn void RTC_setTime(const rtc_time_t *t)
+
+  \brief set calendar
+
+  \param[in]  t   date and time. Weekday and millis are ignored
+
+  set calendar via init mode. Weekday is calculated from date. Prescalers
+  restart, i.e. the second starts with the call.
+*/
+void RTC_setTime(const rtc_time_t *t) {
+
+  rtc_time_t  tmp;
+
+  // get weekday
+  RTC_fromSeconds(RTC_toSeconds(t), &tmp);
+
+  // enter init mode
+  RTC_UNLOCK();
+  sfr_RTC.ISR1.INIT = 1;
+  while (!sfr_RTC.ISR1.INITF);
+
+  // set time and date (BCD). DR3 must be written last
+  sfr_RTC.TR1.byte = toBcd(tmp.second);
+  sfr_RTC.TR2.byte = toBcd(tmp.minute);
+  sfr_RTC.TR3.byte = toBcd(tmp.hour);
+  sfr_RTC.DR1.byte = toBcd(tmp.day);
+  sfr_RTC.DR2.byte = (uint8_t) ((tmp.weekday << 5) | toBcd(tmp.month));
+  sfr_RTC.DR3.byte = toBcd(tmp.year);
+
+  // exit init mode
+  sfr_RTC.ISR1.INIT = 0;
+  RTC_LOCK();
+
+  // wait for shadow registers
+  while (!sfr_RTC.ISR1.RSF);
+
+} // RTC_setTime
+
+
+
+/**
+  \fn void RTC_getTime(rtc_time_t *t)
+
+  \brief read calendar
+
+  \param[out] t   date and time
+
+  read calendar shadow registers. Reading the first register locks the
+  higher registers until DR3 is read, i.e. the result is consistent.
+*/
+void RTC_getTime(rtc_time_t *t) {
+
+  uint8_t   dr2;
+  #if (RTC_HAS_SUBSEC)
+    uint16_t  ss;
+  #endif
+
+  // wait for valid shadow registers
+  while (!sfr_RTC.ISR1.RSF);
+
+  // sub-second counts down from PREDIV_S to 0
+  #if (RTC_HAS_SUBSEC)
+    ss  = sfr_RTC.SSRL.byte;
+    ss |= (uint16_t) sfr_RTC.SSRH.byte << 8;
+    if (ss > RTC_PREDIV_S)
+      ss = RTC_PREDIV_S;
+    t->millis = (uint16_t) (((uint32_t) (RTC_PREDIV_S - ss) * 1000L) / (RTC_PREDIV_S + 1));
+  #else
+    t->millis = 0;
+  #endif
+
+  // read time and date in order TR1..DR3
+  t->second  = fromBcd(sfr_RTC.TR1.byte & 0x7F);
+  t->minute  = fromBcd(sfr_RTC.TR2.byte & 0x7F);
+  t->hour    = fromBcd(sfr_RTC.TR3.byte & 0x3F);
+  t->day     = fromBcd(sfr_RTC.DR1.byte & 0x3F);
+  dr2        = sfr_RTC.DR2.byte;
+  t->year    = fromBcd(sfr_RTC.DR3.byte);
+  t->month   = fromBcd(dr2 & 0x1F);
+  t->weekday = dr2 >> 5;
+
+} // RTC_getTime
+
+
+
+/**
+  \fn uint32_t RTC_toSeconds(const rtc_time_t *t)
+
+  \brief convert calendar to seconds since 2000
+
+  \param[in]  t   date and time
+
+  \return seconds since 2000-01-01 00:00:00
+*/
+uint32_t RTC_toSeconds(const rtc_time_t *t) {
+
+  uint16_t  days;
+
+  // days since 2000-01-01. Every 4th year is leap year in 2000..2099
+  days = (uint16_t) (365 * t->year + (t->year + 3) / 4);
+  days += m_daysBefore[(t->month - 1) % 12] + t->day - 1;
+  if (((t->year & 0x03) == 0) && (t->month > 2))
+    days++;
+
+  return((uint32_t) days * 86400L + (uint32_t) t->hour * 3600L + (uint16_t) t->minute * 60 + t->second);
+
+} // RTC_toSeconds
+
+
+
+/**
+  \fn void RTC_fromSeconds(uint32_t sec, rtc_time_t *t)
+
+  \brief convert seconds since 2000 to calendar
+
+  \param[in]  sec   seconds since 2000-01-01 00:00:00
+  \param[out] t     date and time incl. weekday. Millis are set to 0
+*/
+void RTC_fromSeconds(uint32_t sec, rtc_time_t *t) {
+
+  uint16_t  days, len;
+  uint8_t   leap, month;
+
+  // time of day
+  days      = (uint16_t) (sec / 86400L);
+  sec      -= (uint32_t) days * 86400L;
+  t->hour   = (uint8_t) (sec / 3600);
+  sec      -= (uint16_t) t->hour * 3600;
+  t->minute = (uint8_t) (sec / 60);
+  t->second = (uint8_t) (sec - (uint16_t) t->minute * 60);
+  t->millis = 0;
+
+  // 2000-01-01 was a Saturday
+  t->weekday = (uint8_t) ((days + 5) % 7 + 1);
+
+  // year
+  t->year = 0;
+  while (1) {
+    len = ((t->year & 0x03) == 0) ? 366 : 365;
+    if (days < len)
+      break;
+    days -= len;
+    t->year++;
+  }
+  leap = ((t->year & 0x03) == 0);
+
+  // month and day
+  month = 12;
+  while (days < m_daysBefore[month-1] + ((leap && (month > 2)) ? 1 : 0))
+    month--;
+  days -= m_daysBefore[month-1] + ((leap && (month > 2)) ? 1 : 0);
+  t->month = month;
+  t->day   = (uint8_t) (days + 1);
+
+} // RTC_fromSeconds
+
+
+
+/**
+  \fn void RTC_setAlarm(const rtc_time_t *t, uint8_t mask)
+
+  \brief set alarm A
+
+  \param[in]  t       alarm date/weekday and time. Year, month and millis are ignored
+  \param[in]  mask    ignored fields and options RTC_ALARM_xxx
+
+  set alarm A and enable alarm interrupt. E.g. mask=RTC_ALARM_ANY_DAY|RTC_ALARM_ANY_HOUR
+  triggers every hour at t->minute:t->second.
+*/
+void RTC_setAlarm(const rtc_time_t *t, uint8_t mask) {
+
+  RTC_UNLOCK();
+
+  // disable alarm and wait for write access
+  sfr_RTC.CR2.ALRAE = 0;
+  while (!sfr_RTC.ISR1.ALRAWF);
+
+  // set alarm time with masks (MSKx = bit 7)
+  sfr_RTC.ALRMAR1.byte = (uint8_t) (toBcd(t->second) | ((mask & RTC_ALARM_ANY_SECOND) ? 0x80 : 0x00));
+  sfr_RTC.ALRMAR2.byte = (uint8_t) (toBcd(t->minute) | ((mask & RTC_ALARM_ANY_MINUTE) ? 0x80 : 0x00));
+  sfr_RTC.ALRMAR3.byte = (uint8_t) (toBcd(t->hour)   | ((mask & RTC_ALARM_ANY_HOUR)   ? 0x80 : 0x00));
+  if (mask & RTC_ALARM_WEEKDAY)
+    sfr_RTC.ALRMAR4.byte = (uint8_t) (t->weekday | 0x40 | ((mask & RTC_ALARM_ANY_DAY) ? 0x80 : 0x00));
+  else
+    sfr_RTC.ALRMAR4.byte = (uint8_t) (toBcd(t->day) | ((mask & RTC_ALARM_ANY_DAY) ? 0x80 : 0x00));
+
+  // don't compare sub-seconds
+  #if (RTC_HAS_SUBSEC)
+    sfr_RTC.ALRMASSMSKR.byte = 0x00;
+  #endif
+
+  // clear pending flag (write 1 to other flags has no effect) and enable alarm
+  sfr_RTC.ISR2.byte = (uint8_t) ~0x01;
+  sfr_RTC.CR2.ALRAIE = 1;
+  sfr_RTC.CR2.ALRAE  = 1;
+
+  RTC_LOCK();
+
+} // RTC_setAlarm
+
+
+
+/**
+  \fn void RTC_alarmIn(uint32_t sec)
+
+  \brief set alarm relative to current time
+
+  \param[in]  sec   delay [s] (1..2419200)
+
+  set alarm A to current time plus sec with date match. As the alarm
+  compares day of month, the delay must be < 28 days.
+*/
+void RTC_alarmIn(uint32_t sec) {
+
+  rtc_time_t  t;
+
+  RTC_getTime(&t);
+  RTC_fromSeconds(RTC_toSeconds(&t) + sec, &t);
+  RTC_setAlarm(&t, 0);
+
+} // RTC_alarmIn
+
+
+
+/**
+  \fn void RTC_clearAlarm(void)
+
+  \brief disable alarm A
+
+  disable alarm A and its interrupt.
+*/
+void RTC_clearAlarm(void) {
+
+  RTC_UNLOCK();
+  sfr_RTC.CR2.ALRAIE = 0;
+  sfr_RTC.CR2.ALRAE  = 0;
+  sfr_RTC.ISR2.byte  = (uint8_t) ~0x01;
+  RTC_LOCK();
+
+} // RTC_clearAlarm
+
+
+
+/**
+  \fn void RTC_setWakeup(uint32_t ms)
+
+  \brief set periodic wake-up timer
+
+  \param[in]  ms    period [ms]. 0 stops the timer
+
+  periods up to 65536 ticks of RTCCLK/16 (32s with LSE) are timed from
+  RTCCLK/16. Longer periods use the 1Hz calendar clock and are rounded
+  to full seconds, max. RTC_MAX_WAKEUP.
+*/
+void RTC_setWakeup(uint32_t ms) {
+
+  uint32_t  ticks;
+
+  RTC_UNLOCK();
+
+  // stop timer and wait for write access
+  sfr_RTC.CR2.WUTIE = 0;
+  sfr_RTC.CR2.WUTE  = 0;
+  while (!sfr_RTC.ISR1.WUTWF);
+  sfr_RTC.ISR2.byte = (uint8_t) ~0x04;
+
+  // set clock and reload value. Period is WUTR+1
+  if (ms > 0) {
+    ticks = (ms < 60000L) ? (ms * (RTC_F_CLK / 16) + 500) / 1000L : 65537L;
+    if (ticks <= 65536L) {
+      if (ticks == 0)
+        ticks = 1;
+      sfr_RTC.CR1.WUCKSEL = 0;                  // RTCCLK/16
+    }
+    else {
+      ticks = (ms + 500) / 1000L;
+      if (ticks > RTC_MAX_WAKEUP)
+        ticks = RTC_MAX_WAKEUP;
+      if (ticks <= 65536L)
+        sfr_RTC.CR1.WUCKSEL = 4;                // 1Hz
+      else {
+        sfr_RTC.CR1.WUCKSEL = 6;                // 1Hz, WUT + 2^16
+        ticks -= 65536L;
+      }
+    }
+    sfr_RTC.WUTRH.byte = (uint8_t) ((ticks - 1) >> 8);
+    sfr_RTC.WUTRL.byte = (uint8_t) (ticks - 1);
+
+    // enable interrupt and start timer
+    sfr_RTC.CR2.WUTIE = 1;
+    sfr_RTC.CR2.WUTE  = 1;
+  }
+
+  RTC_LOCK();
+
+} // RTC_setWakeup
+
+
+
+/**
+  \fn void RTC_calibrate(int16_t ppm10)
+
+  \brief set smooth calibration
+
+  \param[in]  ppm10   correction [0.1ppm] (-4870..+4880). Positive values speed up clock
+
+  RTCCLK pulses are masked (or inserted via CALP) evenly over a 32s cycle
+  in steps of 2^-20 (0.954ppm). Measure the deviation e.g. via the 1Hz
+  calibration output and pass the negative error.
+*/
+#if (RTC_HAS_CALIB)
+void RTC_calibrate(int16_t ppm10) {
+
+  int32_t   pulses;
+  uint16_t  calm;
+  uint8_t   calp;
+
+  // convert to pulses per 2^20 RTCCLK with rounding
+  pulses = (int32_t) ppm10 * 1048576L;
+  pulses = (pulses + ((pulses < 0) ? -5000000L : 5000000L)) / 10000000L;
+
+  // faster: insert 512 pulses (CALP) and mask remainder
+  if (pulses > 0) {
+    if (pulses > 512)
+      pulses = 512;
+    calp = 1;
+    calm = (uint16_t) (512 - pulses);
+  }
+
+  // slower: mask pulses
+  else {
+    if (pulses < -511)
+      pulses = -511;
+    calp = 0;
+    calm = (uint16_t) (-pulses);
+  }
+
+  // wait until previous calibration is applied, then set 32s cycle
+  RTC_UNLOCK();
+  while (sfr_RTC.ISR1.RECALPF);
+  sfr_RTC.CALRH.byte = (uint8_t) ((calp << 7) | (calm >> 8));
+  sfr_RTC.CALRL.byte = (uint8_t) calm;
+  RTC_LOCK();
+
+} // RTC_calibrate
+#endif // RTC_HAS_CALIB
+
+
+
+/**
+  \fn uint8_t RTC_events(void)
+
+  \brief get and clear RTC events
+
+  \return pending events RTC_EVENT_xxx
+*/
+uint8_t RTC_events(void) {
+
+  uint8_t   events;
+
+  DISABLE_INTERRUPTS();
+  events = m_events;
+  m_events = 0;
+  ENABLE_INTERRUPTS();
+
+  return(events);
+
+} // RTC_events
+
+
+
+/**
+  \fn uint8_t RTC_sleep(void)
+
+  \brief stay in active-halt until next RTC event
+
+  \return events RTC_EVENT_xxx which ended the sleep
+
+  enter active-halt until alarm or wake-up timer fires. Other interrupts
+  are serviced, but don't end the sleep. As calendar shadow registers are
+  not updated during halt, they are re-synchronized before return.
+  UART etc. must be idle before the call.
+*/
+uint8_t RTC_sleep(void) {
+
+  uint8_t   events;
+
+  // disable interrupts until HALT (re-enables interrupts)
+  DISABLE_INTERRUPTS();
+  while (!m_events) {
+    ENTER_HALT();
+    DISABLE_INTERRUPTS();
+  }
+  events = m_events;
+  m_events = 0;
+  ENABLE_INTERRUPTS();
+
+  // re-synchronize calendar shadow registers
+  RTC_UNLOCK();
+  sfr_RTC.ISR1.RSF = 0;
+  RTC_LOCK();
+  while (!sfr_RTC.ISR1.RSF);
+
+  return(events);
+
+} // RTC_sleep
+
+
+
+/**
+  \fn void RTC_ISR(void)
+
+  \brief ISR for RTC alarm and wake-up timer
+
+  interrupt service routine for RTC alarm A and wake-up timer (shared
+  vector). Clear flags (mandatory) and store events.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(RTC_ISR, _RTC_WAKEUP_VECTOR_)
+{
+  uint8_t   flags = sfr_RTC.ISR2.byte;
+
+  // alarm A
+  if (flags & 0x01) {
+    sfr_RTC.ISR2.byte = (uint8_t) ~0x01;
+    m_events |= RTC_EVENT_ALARM;
+  }
+
+  // wake-up timer
+  if (flags & 0x04) {
+    sfr_RTC.ISR2.byte = (uint8_t) ~0x04;
+    m_events |= RTC_EVENT_WAKEUP;
+  }
+
+} // RTC_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,157 @@
+/**
+  \file rtc.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of RTC calendar, alarm and wake-up service
+
+  declaration of functions for the STM8L/STM8AL real-time clock. Features:
+    - calendar 2000..2099 in 24h format, conversion to/from seconds since 2000
+    - alarm A on date/weekday and time with masks, or relative to now
+    - periodic wake-up timer from 0.5ms (RTCCLK/16) up to 36h (1Hz clock)
+    - sub-second timestamps with resolution 1/(RTC_PREDIV_S+1) s (if supported)
+    - smooth digital calibration in steps of 0.95ppm (if supported)
+    - RTC_sleep() stays in active-halt until next alarm or wake-up event
+
+  \note
+  - sub-second and calibration registers only exist on high density and
+    low-/medium+ density devices, see RTC_HAS_SUBSEC and RTC_HAS_CALIB
+  - alarm and wake-up timer share one interrupt vector (RTC_ISR)
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _RTC_H_
+#define _RTC_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// check for RTC
+#if !defined(sfr_RTC)
+  #error device has no RTC
+#endif
+
+// optional RTC features, depending on device
+#if defined(sfr_RTC_SSRL_RESET_VALUE)
+  #define RTC_HAS_SUBSEC        1
+#else
+  #define RTC_HAS_SUBSEC        0
+#endif
+#if defined(sfr_RTC_CALRL_RESET_VALUE)
+  #define RTC_HAS_CALIB         1
+#else
+  #define RTC_HAS_CALIB         0
+#endif
+
+// RTC clock frequency [Hz]
+#if defined(RTC_LSE)
+  #define RTC_F_CLK             32768L
+#else
+  #define RTC_F_CLK             38000L
+#endif
+
+// asynchronous prescaler (1..128). Max. value for lowest consumption. Default can be overwritten in config.h
+#ifndef RTC_PREDIV_A
+  #define RTC_PREDIV_A          127
+#endif
+
+// synchronous prescaler for 1Hz calendar clock. Default can be overwritten in config.h
+#ifndef RTC_PREDIV_S
+  #define RTC_PREDIV_S          ((uint16_t) (RTC_F_CLK / (RTC_PREDIV_A + 1) - 1))
+#endif
+
+// alarm masks for RTC_setAlarm(). Masked fields are ignored for match
+#define RTC_ALARM_ANY_SECOND    0x01          ///< ignore seconds
+#define RTC_ALARM_ANY_MINUTE    0x02          ///< ignore minutes
+#define RTC_ALARM_ANY_HOUR      0x04          ///< ignore hours
+#define RTC_ALARM_ANY_DAY       0x08          ///< ignore date/weekday
+#define RTC_ALARM_WEEKDAY       0x10          ///< match weekday instead of date
+
+// events returned by RTC_events() and RTC_sleep()
+#define RTC_EVENT_ALARM         0x01          ///< alarm A matched
+#define RTC_EVENT_WAKEUP        0x02          ///< wake-up timer elapsed
+
+/// max. wake-up period [s]
+#define RTC_MAX_WAKEUP          131072L
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// calendar date and time
+typedef struct {
+  uint8_t     year;         ///< year since 2000 (0..99)
+  uint8_t     month;        ///< month (1..12)
+  uint8_t     day;          ///< day of month (1..31)
+  uint8_t     weekday;      ///< day of week (1=Monday..7=Sunday)
+  uint8_t     hour;         ///< hour (0..23)
+  uint8_t     minute;       ///< minute (0..59)
+  uint8_t     second;       ///< second (0..59)
+  uint16_t    millis;       ///< sub-second [ms]. Always 0 if !RTC_HAS_SUBSEC
+} rtc_time_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// start RTC clock and prescalers. Returns 1 if calendar was already set
+uint8_t RTC_begin(void);
+
+/// set calendar. Weekday is calculated from date
+void RTC_setTime(const rtc_time_t *t);
+
+/// read calendar
+void RTC_getTime(rtc_time_t *t);
+
+/// convert calendar to seconds since 2000-01-01 00:00:00
+uint32_t RTC_toSeconds(const rtc_time_t *t);
+
+/// convert seconds since 2000-01-01 00:00:00 to calendar
+void RTC_fromSeconds(uint32_t sec, rtc_time_t *t);
+
+/// set alarm A with masks RTC_ALARM_xxx and enable interrupt
+void RTC_setAlarm(const rtc_time_t *t, uint8_t mask);
+
+/// set alarm A to current time plus sec (1..~2419200, i.e. 28 days)
+void RTC_alarmIn(uint32_t sec);
+
+/// disable alarm A
+void RTC_clearAlarm(void);
+
+/// set periodic wake-up timer [ms] and enable interrupt. 0 stops timer
+void RTC_setWakeup(uint32_t ms);
+
+/// set smooth calibration [0.1ppm]. Positive values speed up clock
+#if (RTC_HAS_CALIB)
+  void RTC_calibrate(int16_t ppm10);
+#endif
+
+/// get and clear RTC_EVENT_xxx flags
+uint8_t RTC_events(void);
+
+/// stay in active-halt until next RTC event. Returns RTC_EVENT_xxx
+uint8_t RTC_sleep(void);
+
+/// ISR for RTC alarm and wake-up timer
+ISR_HANDLER(RTC_ISR, _RTC_WAKEUP_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _RTC_H_
@@ -0,0 +1,64 @@
+/**
+  \file uart.h
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief declaration of UART functions/macros
+   
+  declaration of UART functions for blocking transmission and polling reception.
+  Uses USART1 (STM8L) or UART1 (STM8S)
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_H_
+#define _UART_H_
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+// select UART instance. STM8L: USART1, STM8S: UART1
+#if defined(sfr_USART1)
+  #define sfr_UART           sfr_USART1
+#elif defined(sfr_UART1)
+  #define sfr_UART           sfr_UART1
+#else
+  #error UART not defined
+#endif
+
+/// check if byte received
+#define UART_available()   ( sfr_UART.SR.RXNE )
+
+/// read received byte
+#define UART_read()        ( sfr_UART.DR.byte )
+
+/// send byte
+#define UART_write(x)      { while (!(sfr_UART.SR.TXE)); sfr_UART.DR.byte = x; }
+
+/// flush UART Tx
+#define UART_flush()       { while (!(sfr_UART.SR.TC)); }
+
+
+/*----------------------------------------------------------
+    GLOBAL FUNCTIONS
+----------------------------------------------------------*/
+
+/// initialize UART for blocking transmission, polling reception
+void UART_begin(uint32_t BR);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_H_
@@ -0,0 +1,422 @@
+#!/usr/bin/env python3
+
+"""
+Compile a declarative SMED state machine description into register init tables
+
+Reads a JSON description of one or more SMEDs (State Machine Event Driven PWM
+generators of STLUX devices) with states, timers, input events, transitions and
+coupling, checks it and writes a C header for the SMED driver. Register offsets
+are taken from the XML device description, i.e. the image matches the device header.
+
+Description format (all keys except "id" and "states" are optional):
+  {
+    "smeds": [
+      {
+        "name":         "BUCK",                     C identifier, default SMEDn
+        "id":           0,                          SMED 0..5
+        "clock":        {"source": 0, "div": 0, "freq": 96000000},
+                                                    CLK_SMEDx.CK_SW, .SMED_x_DIV and resulting
+                                                    counter clock [Hz] for times with unit
+        "mode":         0,                          MSC_SMDCFGxy.SMEDx_GLBCONF
+        "couple":       1,                          coupled SMED of same pair (0+1, 2+3, 4+5)
+        "sync_update":  true,                       MSC_SMULOCK.USE_UNLOCK_xy for coupled pair
+        "timers":       {"T0": "4us", "T1": 200},   TMR_Tx as ticks or time with unit ns, us, ms
+        "timer_num":    0,                          CFG.TIM_NUM
+        "timer_update": 0,                          CFG.TIM_UPD
+        "dither":       0,                          CTR_DTHR
+        "inputs":       [{"enable": true, "rising": true, "edge": true, "source": 0}, ...],
+                                                    InSig0..2: ISEL.INPUTx_EN, CTR_INP.RS_INSIGx,
+                                                    CTR_INP.EL_INSIGx, MSC_CBOXSn.CONB_Sn_x
+        "input_ctrl":   {"rais_en": false, "el_en": false, "latch": false},
+                                                    CTR_INP.RAIS_EN, CTR_INP.EL_EN, ISEL.INPUT_LAT
+        "states": {
+          "S0": {                                   IDLE, S0..S3: PRM_IDx / PRM_Syx
+            "timeout":     {"output": 1, "reset": true, "hold_exit": false},
+                                                    PULS_CMP, CNT_RSTC, HOLD_EXIT
+            "event":       {"next": "S1", "edge": 0, "cedge": 0, "output": 0, "reset": true,
+                            "hold": false, "and": false},
+                                                    NX_STAT, EDGE, CEDGE, PULS_EDG, CNT_RSTE,
+                                                    HOLD_JMP, AND_OR
+            "latch_reset": false                    LATCH_RS
+          }
+        },
+        "interrupts":   ["OVF", "EXT0", "S0"],      IMR: OVF, EXT0..2, S0..S3
+        "dump":         {"EX0": false, "EX1": false, "EX2": false, "every": false, "cpl_it": false}
+                                                    DMP: DMPE_EXx, DMP_EVER, CPL_IT_GE
+      }
+    ]
+  }
+For meaning of the register fields see the STLUX reference manual (RM0380).
+
+The header defines:
+  - SMED_CFG_NUM          number of configured SMEDs
+  - SMED_<name>           SMED ID
+  - SMED_<name>_Tx        timer Tx [ticks], e.g. for retuning
+  - SMED_CFG_UNLOCK       MSC_SMULOCK value with USE_UNLOCK bits of coupled pairs
+  - SMED_CFG_TABLE        initializer of smed_config_t table
+
+usage: smed_compile.py [-o smed_config.h] [-x ../../XML/STLUX385A.xml] description.json
+"""
+
+import os
+import re
+import sys
+import json
+import argparse
+import xml.etree.ElementTree as ET
+
+
+# first and last register of contiguous register image
+IMAGE_FIRST = 'CTR_INP'
+IMAGE_LAST  = 'CFG'
+
+# states and their parameter register prefixes
+STATES = ('IDLE', 'S0', 'S1', 'S2', 'S3')
+STATE_PRM = {'IDLE': 'PRM_ID', 'S0': 'PRM_S0', 'S1': 'PRM_S1', 'S2': 'PRM_S2', 'S3': 'PRM_S3'}
+
+# interrupt mask bits (IMR)
+INTERRUPTS = {'OVF': 0, 'EXT0': 1, 'EXT1': 2, 'EXT2': 3, 'S0': 4, 'S1': 5, 'S2': 6, 'S3': 7}
+
+# dump enable bits (DMP)
+DUMPS = {'EX0': 0, 'EX1': 1, 'EX2': 2, 'every': 3, 'cpl_it': 4}
+
+# allowed keys per description level. Unknown keys are rejected to catch typos
+KEYS_SMED    = ('name', 'id', 'clock', 'mode', 'couple', 'sync_update', 'timers', 'timer_num',
+                'timer_update', 'dither', 'inputs', 'input_ctrl', 'states', 'interrupts', 'dump')
+KEYS_CLOCK   = ('source', 'div', 'freq')
+KEYS_INPUT   = ('enable', 'rising', 'edge', 'source')
+KEYS_INCTRL  = ('rais_en', 'el_en', 'latch')
+KEYS_STATE   = ('timeout', 'event', 'latch_reset')
+KEYS_TIMEOUT = ('output', 'reset', 'hold_exit')
+KEYS_EVENT   = ('next', 'edge', 'cedge', 'output', 'reset', 'hold', 'and')
+
+# time units
+UNITS = {'ns': 1e-9, 'us': 1e-6, 'ms': 1e-3}
+
+
+class DescriptionError(Exception):
+  """ error in SMED description """
+  pass
+
+
+def check_keys(obj, allowed, where):
+  """ check that obj is a dict with known keys only """
+  if not isinstance(obj, dict):
+    raise DescriptionError('%s: expected object' % where)
+  for k in obj:
+    if k not in allowed:
+      raise DescriptionError('%s: unknown key "%s", allowed are %s' % (where, k, ', '.join(allowed)))
+
+
+def get_int(obj, key, lo, hi, default, where):
+  """ get integer in range lo..hi """
+  val = obj.get(key, default)
+  if isinstance(val, bool) or not isinstance(val, int) or not (lo <= val <= hi):
+    raise DescriptionError('%s: "%s" must be integer %d..%d' % (where, key, lo, hi))
+  return val
+
+
+def get_bool(obj, key, where):
+  """ get flag, default false """
+  val = obj.get(key, False)
+  if not isinstance(val, bool):
+    raise DescriptionError('%s: "%s" must be true or false' % (where, key))
+  return 1 if val else 0
+
+
+def read_layout(filename):
+  """ return ordered list of (register name, offset) of SMED0 and list of SMED modules from XML """
+  root = ET.parse(filename).getroot()
+  modules = [m.get('name') for m in root.iter('module') if re.match(r'^SMED\d$', m.get('name') or '')]
+  smed0 = [m for m in root.iter('module') if m.get('name') == 'SMED0']
+  if not smed0:
+    raise SystemExit("error: no SMED in '%s'" % filename)
+  base = None
+  regs = []
+  for sfr in smed0[0].iter('SFR'):
+    addr = int(sfr.get('address'), 16)
+    if base is None:
+      base = addr
+    for r in sfr.iter('register'):
+      regs.append((r.get('name'), addr - base))
+  return regs, modules
+
+
+def parse_ticks(val, freq, where):
+  """ convert timer value (ticks or time string) to ticks 1..65535 """
+  if isinstance(val, bool):
+    raise DescriptionError('%s: invalid timer value' % where)
+  if isinstance(val, int):
+    ticks = val
+  else:
+    m = re.match(r'^\s*([0-9.]+)\s*(ns|us|ms)\s*$', str(val))
+    if not m:
+      raise DescriptionError('%s: invalid timer value "%s", use ticks or e.g. "2.5us"' % (where, val))
+    if not freq:
+      raise DescriptionError('%s: time with unit requires "clock": {"freq": ...}' % where)
+    ticks = int(round(float(m.group(1)) * UNITS[m.group(2)] * freq))
+  if not (1 <= ticks <= 0xFFFF):
+    raise DescriptionError('%s: %s ticks out of range 1..65535' % (where, ticks))
+  return ticks
+
+
+def compile_smed(desc, index):
+  """ compile one SMED description into dict of register values. Returns (smed, regs) """
+
+  where = 'smeds[%d]' % index
+  check_keys(desc, KEYS_SMED, where)
+  sid = get_int(desc, 'id', 0, 5, None, where)
+  name = desc.get('name', 'SMED%d' % sid)
+  where = '%s (SMED%d)' % (name, sid)
+  if not re.match(r'^[A-Za-z_][A-Za-z0-9_]*$', name):
+    raise DescriptionError('%s: name must be a C identifier' % where)
+
+  regs = {}
+  smed = {'id': sid, 'name': name.upper(), 'timers': {}}
+
+  # clock source, divider and counter frequency
+  clock = desc.get('clock', {})
+  check_keys(clock, KEYS_CLOCK, where + '.clock')
+  src = get_int(clock, 'source', 0, 3, 0, where + '.clock')
+  div = get_int(clock, 'div', 0, 7, 0, where + '.clock')
+  freq = clock.get('freq')
+  smed['clk'] = src | (div << 4)
+
+  # global configuration and coupling
+  smed['mode'] = get_int(desc, 'mode', 0, 15, 0, where)
+  smed['couple'] = desc.get('couple')
+  if smed['couple'] is not None:
+    get_int(desc, 'couple', 0, 5, None, where)
+    if smed['couple'] != (sid ^ 1):
+      raise DescriptionError('%s: can only be coupled with SMED%d of same pair' % (where, sid ^ 1))
+  smed['sync'] = get_bool(desc, 'sync_update', where)
+  if smed['sync'] and (smed['couple'] is None):
+    raise DescriptionError('%s: "sync_update" requires "couple"' % where)
+
+  # timers T0..T3
+  timers = desc.get('timers', {})
+  check_keys(timers, ('T0', 'T1', 'T2', 'T3'), where + '.timers')
+  for t in sorted(timers):
+    ticks = parse_ticks(timers[t], freq, '%s.timers.%s' % (where, t))
+    regs['TMR_%sL' % t] = ticks & 0xFF
+    regs['TMR_%sH' % t] = ticks >> 8
+    smed['timers'][t] = ticks
+  regs['CFG'] = (get_int(desc, 'timer_num', 0, 3, 0, where) << 1) | \
+                (get_int(desc, 'timer_update', 0, 3, 0, where) << 3)
+  regs['CTR_DTHR'] = get_int(desc, 'dither', 0, 255, 0, where)
+
+  # input signals InSig0..2 and connection box
+  inputs = desc.get('inputs', [])
+  if not isinstance(inputs, list) or len(inputs) > 3:
+    raise DescriptionError('%s: "inputs" must be list of max. 3 inputs' % where)
+  ctr_inp, isel, cbox = 0, 0, 0
+  for i, inp in enumerate(inputs):
+    w = '%s.inputs[%d]' % (where, i)
+    check_keys(inp, KEYS_INPUT, w)
+    isel    |= get_bool(inp, 'enable', w) << i
+    ctr_inp |= get_bool(inp, 'rising', w) << i
+    ctr_inp |= get_bool(inp, 'edge', w) << (4 + i)
+    cbox    |= get_int(inp, 'source', 0, 3, 0, w) << (2 * i)
+  ctrl = desc.get('input_ctrl', {})
+  check_keys(ctrl, KEYS_INCTRL, where + '.input_ctrl')
+  ctr_inp |= (get_bool(ctrl, 'rais_en', where) << 3) | (get_bool(ctrl, 'el_en', where) << 7)
+  isel    |= get_bool(ctrl, 'latch', where) << 3
+  regs['CTR_INP'] = ctr_inp
+  smed['isel'] = isel
+  smed['cbox'] = cbox
+
+  # states and transitions
+  states = desc.get('states')
+  check_keys(states, STATES, where + '.states')
+  targets = set()
+  for s in STATES:
+    prm = STATE_PRM[s]
+    regs[prm + '0'], regs[prm + '1'], regs[prm + '2'] = 0, 0, 0
+    if s not in states:
+      continue
+    w = '%s.states.%s' % (where, s)
+    state = states[s]
+    check_keys(state, KEYS_STATE, w)
+
+    # transition on timer compare
+    if 'timeout' in state:
+      to = state['timeout']
+      check_keys(to, KEYS_TIMEOUT, w + '.timeout')
+      if s == 'IDLE':
+        raise DescriptionError('%s: IDLE has no timer' % w)
+      if ('T' + s[1]) not in smed['timers']:
+        raise DescriptionError('%s: timeout requires timer T%s' % (w, s[1]))
+      regs[prm + '1'] |= (get_int(to, 'output', 0, 1, 0, w + '.timeout') << 5) | \
+                         (get_bool(to, 'reset', w + '.timeout') << 4) | \
+                         (get_bool(to, 'hold_exit', w + '.timeout') << 6)
+
+    # transition on input event
+    if 'event' in state:
+      ev = state['event']
+      we = w + '.event'
+      check_keys(ev, KEYS_EVENT, we)
+      nxt = ev.get('next')
+      if nxt not in STATES[1:]:
+        raise DescriptionError('%s: "next" must be one of S0..S3' % we)
+      targets.add(nxt)
+      regs[prm + '0'] |= int(nxt[1]) | (get_int(ev, 'edge', 0, 3, 0, we) << 2) | \
+                         (get_bool(ev, 'reset', we) << 4) | (get_int(ev, 'output', 0, 1, 0, we) << 5) | \
+                         (get_bool(ev, 'hold', we) << 6) | (get_bool(ev, 'and', we) << 7)
+      regs[prm + '1'] |= get_int(ev, 'cedge', 0, 3, 0, we) << 2
+
+    regs[prm + '2'] = get_bool(state, 'latch_reset', w)
+
+  # event transitions must end in configured states
+  for t in sorted(targets):
+    if t not in states:
+      raise DescriptionError('%s: state %s is target of a transition, but not configured' % (where, t))
+  if 'IDLE' not in states:
+    print('warning: %s: IDLE not configured, FSM stays in IDLE after start' % where, file=sys.stderr)
+
+  # interrupts
+  imr = 0
+  ints = desc.get('interrupts', [])
+  if not isinstance(ints, list):
+    raise DescriptionError('%s: "interrupts" must be a list' % where)
+  for i in ints:
+    if i not in INTERRUPTS:
+      raise DescriptionError('%s: unknown interrupt "%s", allowed are %s' % (where, i, ', '.join(INTERRUPTS)))
+    imr |= 1 << INTERRUPTS[i]
+  smed['imr'] = imr
+
+  # dump configuration
+  dump = desc.get('dump', {})
+  check_keys(dump, tuple(DUMPS), where + '.dump')
+  smed['dmp'] = sum(get_bool(dump, k, where + '.dump') << b for k, b in DUMPS.items())
+
+  return smed, regs
+
+
+def check_coupling(smeds):
+  """ coupled SMEDs must reference each other and use the same update mode """
+  by_id = dict((s['id'], s) for s in smeds)
+  for s in smeds:
+    if s['couple'] is None:
+      continue
+    p = by_id.get(s['couple'])
+    if (p is None) or (p['couple'] != s['id']):
+      raise DescriptionError('%s: coupled SMED%d must be configured and coupled with SMED%d' % (s['name'], s['couple'], s['id']))
+    if p['sync'] != s['sync']:
+      raise DescriptionError('%s: "sync_update" differs from coupled %s' % (s['name'], p['name']))
+
+
+def register_image(layout, regs):
+  """ return register values from IMAGE_FIRST to IMAGE_LAST in address order """
+  names = [n for n, _ in layout]
+  offs = dict(layout)
+  first, last = names.index(IMAGE_FIRST), names.index(IMAGE_LAST)
+  image = []
+  for i, n in enumerate(names[first:last+1]):
+    if offs[n] != offs[IMAGE_FIRST] + i:
+      raise SystemExit('error: SMED registers %s..%s are not contiguous in XML' % (IMAGE_FIRST, IMAGE_LAST))
+    image.append((n, regs.get(n, 0)))
+  unknown = set(regs) - set(names)
+  if unknown:
+    raise SystemExit('error: registers %s not found in XML' % ', '.join(sorted(unknown)))
+  return image
+
+
+def write_header(out, source, layout, smeds):
+  """ write C header with register init tables """
+
+  out.write('''/**
+  \\file smed_config.h
+
+  \\brief SMED register init tables
+
+  register init tables for the SMED driver, compiled from '%s'.
+
+  \\note
+  - this file is generated by Utils/smed_compile.py. Do not edit, but re-compile
+    after changes of the state machine description
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _SMED_CONFIG_H_
+#define _SMED_CONFIG_H_
+
+''' % os.path.basename(source))
+
+  unlock = 0
+  for s in smeds:
+    if s['sync']:
+      unlock |= 1 << (s['id'] >> 1)
+  out.write('#define %-24s %d\n' % ('SMED_CFG_NUM', len(smeds)))
+  out.write('#define %-24s 0x%02x\n' % ('SMED_CFG_UNLOCK', unlock))
+  out.write('#define %-24s %d\n' % ('SMED_CFG_IMAGE_LEN', len(register_image(layout, {}))))
+  out.write('\n')
+  for s in smeds:
+    out.write('#define %-24s %d\n' % ('SMED_' + s['name'], s['id']))
+    for t in sorted(s['timers']):
+      out.write('#define %-24s %d\n' % ('SMED_%s_%s' % (s['name'], t), s['timers'][t]))
+  out.write('\n')
+
+  # init table: id, clock, mode, connection box, interrupt mask, input selection, dump, register image
+  out.write('#define SMED_CFG_TABLE \\\n')
+  for i, s in enumerate(smeds):
+    image = register_image(layout, s['regs'])
+    out.write('  /* %s: SMED%d */ \\\n' % (s['name'], s['id']))
+    out.write('  { %d, 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x, 0x%02x, { \\\n' %
+              (s['id'], s['clk'], s['mode'], s['cbox'], s['imr'], s['isel'], s['dmp']))
+    for j in range(0, len(image), 8):
+      line = ', '.join('0x%02x' % v for _, v in image[j:j+8])
+      out.write('    %s%s \\\n' % (line, ',' if j + 8 < len(image) else ''))
+    out.write('  } }%s\n' % (', \\' if i + 1 < len(smeds) else ''))
+
+  out.write('''
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _SMED_CONFIG_H_
+''')
+
+
+if __name__ == "__main__":
+
+  parser = argparse.ArgumentParser(description='compile SMED state machine description into register init tables')
+  parser.add_argument('-o', '--output', default='smed_config.h', help='output header')
+  parser.add_argument('-x', '--xml', default=os.path.join(os.path.dirname(__file__), '../../../XML/STLUX385A.xml'),
+                      help='XML device description (default: STLUX385A)')
+  parser.add_argument('description', help='SMED description (JSON)')
+  args = parser.parse_args()
+
+  # register layout and available SMEDs from XML
+  layout, modules = read_layout(args.xml)
+
+  # read and compile description
+  with open(args.description) as f:
+    try:
+      desc = json.load(f)
+    except ValueError as e:
+      raise SystemExit("error: %s: %s" % (args.description, e))
+  try:
+    check_keys(desc, ('smeds',), 'description')
+    if not isinstance(desc.get('smeds'), list) or len(desc['smeds']) == 0:
+      raise DescriptionError('description: "smeds" must be a non-empty list')
+    smeds = []
+    for i, d in enumerate(desc['smeds']):
+      s, regs = compile_smed(d, i)
+      if 'SMED%d' % s['id'] not in modules:
+        raise DescriptionError('%s: SMED%d not available on device' % (s['name'], s['id']))
+      if any(x['id'] == s['id'] for x in smeds):
+        raise DescriptionError('%s: SMED%d configured twice' % (s['name'], s['id']))
+      if any(x['name'] == s['name'] for x in smeds):
+        raise DescriptionError('%s: name used twice' % s['name'])
+      s['regs'] = regs
+      register_image(layout, regs)
+      smeds.append(s)
+    check_coupling(smeds)
+  except DescriptionError as e:
+    raise SystemExit('error: %s' % e)
+
+  with open(args.output, 'w') as out:
+    write_header(out, args.description, layout, smeds)
+
+  print("compiled %d SMEDs to '%s'" % (len(smeds), args.output))
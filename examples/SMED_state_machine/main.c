@@ -0,0 +1,82 @@
+/**********************
+  SMED state machines compiled from a declarative description, with glitch-free retuning
+
+  supported hardware:
+    - STLUX385A (other STLUX devices after re-compiling with their XML file)
+
+  Functionality:
+    - state machines of SMED0 (BUCK) and SMED1 (AUX) are described in
+      smed_buck.json and compiled by Utils/smed_compile.py into smed_config.h
+    - BUCK: 100kHz PWM with max. on-time T0, early switch-off by input event
+      InSig0 (e.g. peak current comparator). AUX: complementary PWM
+    - SMED0+1 are a coupled pair with synchronized update
+    - on-time is slowly ramped up and down. Timers of both SMEDs are updated
+      together without glitches
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "smed.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// PWM period [ticks] and on-time range [ticks]
+#define PERIOD        (SMED_BUCK_T0 + SMED_BUCK_T1)
+#define ON_MIN        (PERIOD / 10)
+#define ON_MAX        SMED_BUCK_T0
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void) {
+
+  uint16_t  buck[4], aux[4];
+  uint16_t  on = ON_MAX;
+  int8_t    step = -1;
+  uint32_t  i;
+
+  // init SMEDs from compiled table
+  SMED_begin();
+
+  // start coupled pair together
+  SMED_start(SMED_MASK(SMED_BUCK) | SMED_MASK(SMED_AUX));
+
+  // main loop
+  while(1) {
+
+    // ramp on-time between limits
+    on += step;
+    if ((on <= ON_MIN) || (on >= ON_MAX))
+      step = -step;
+
+    // BUCK: on-time T0, off-time T1. AUX: complementary
+    buck[0] = on;
+    buck[1] = PERIOD - on;
+    aux[0]  = buck[1];
+    aux[1]  = buck[0];
+
+    // update both SMEDs and transfer together. Skip if previous update is pending
+    if (SMED_setTimes(SMED_BUCK, SMED_T0 | SMED_T1, buck)) {
+      while (!SMED_setTimes(SMED_AUX, SMED_T0 | SMED_T1, aux));
+      SMED_unlock(SMED_BUCK);
+    }
+
+    // simple wait ~10ms @ 16MHz
+    for (i=0; i<6000L; i++)
+      NOP();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
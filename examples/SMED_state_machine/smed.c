@@ -0,0 +1,345 @@
+/**
+  \file smed.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of SMED driver with compiled register tables
+
+  implementation of functions to initialize the SMEDs from the table compiled
+  by Utils/smed_compile.py and retune them at runtime. All SMEDs have the
+  same register layout, i.e. they are accessed via a table of base addresses.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include "smed.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// SMED only exists on STLUX devices
+#if !defined(sfr_SMED0)
+  #error device has no SMED
+#endif
+
+// SMDx_CTR bits
+#define CTR_START_CNT       0x01      ///< start counter
+#define CTR_FSM_ENA         0x02      ///< enable state machine
+
+// check that compiled register image matches device header (negative array size on error)
+typedef char smed_check_image[(SMED_CFG_IMAGE_LEN == (offsetof(SMED0_t, CFG) - offsetof(SMED0_t, CTR_INP) + 1)) ? 1 : -1];
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// SMED register blocks, indexed by SMED ID. Layout is identical for all SMEDs
+static SMED0_t * const    m_smed[SMED_NUM] = {
+  &sfr_SMED0,
+  (SMED0_t*) &sfr_SMED1,
+  (SMED0_t*) &sfr_SMED2,
+  (SMED0_t*) &sfr_SMED3,
+  (SMED0_t*) &sfr_SMED4,
+  (SMED0_t*) &sfr_SMED5
+};
+
+/// compiled configurations
+static const smed_config_t  m_config[SMED_CFG_NUM] = { SMED_CFG_TABLE };
+
+
+
+/**
+  \fn uint8_t SMED_init(const smed_config_t *cfg)
+
+  \brief initialize single SMED
+
+  \param[in]  cfg   configuration, e.g. from compiled table
+
+  \return 1 on success, 0 on invalid SMED ID
+
+  stop SMED, set clock, coupling and connection box, and write the register
+  image. Timers and dithering are validated, i.e. become active immediately.
+*/
+uint8_t SMED_init(const smed_config_t *cfg) {
+
+  SMED0_t   *smed;
+  uint8_t   i, shift;
+
+  // check ID
+  if (cfg->id >= SMED_NUM)
+    return(0);
+  smed = m_smed[cfg->id];
+
+  // stop state machine and counter
+  smed->CTR.byte = 0x00;
+
+  // clock source and divider. CLK_SMED0..5 are consecutive
+  (&(sfr_CLK.SMED0.byte))[cfg->id] = cfg->clk;
+
+  // global configuration (nibble in MSC_SMDCFG01/23/45) and connection box
+  shift = (cfg->id & 0x01) ? 4 : 0;
+  (&(sfr_MSC.MSC_SMDCFG01.byte))[cfg->id >> 1] &= (uint8_t) ~(0x0F << shift);
+  (&(sfr_MSC.MSC_SMDCFG01.byte))[cfg->id >> 1] |= (uint8_t) ((cfg->mode & 0x0F) << shift);
+  (&(sfr_MSC.MSC_CBOXS0.byte))[cfg->id] = cfg->cbox;
+
+  // registers CTR_INP..CFG
+  for (i=0; i<SMED_CFG_IMAGE_LEN; i++)
+    (&(smed->CTR_INP.byte))[i] = cfg->image[i];
+
+  // input selection, dump and interrupts
+  smed->ISEL.byte = cfg->isel;
+  smed->DMP.byte  = cfg->dmp;
+  smed->IMR.byte  = cfg->imr;
+
+  // validate timers and dithering
+  smed->CTR_TMR.byte = SMED_T0 | SMED_T1 | SMED_T2 | SMED_T3 | SMED_DITHER;
+
+  return(1);
+
+} // SMED_init
+
+
+
+/**
+  \fn void SMED_begin(void)
+
+  \brief initialize all SMEDs from compiled table
+
+  initialize all SMEDs configured in smed_config.h and enable synchronized
+  update for coupled pairs. SMEDs are not started, see SMED_start().
+*/
+void SMED_begin(void) {
+
+  uint8_t   i;
+
+  for (i=0; i<SMED_CFG_NUM; i++)
+    SMED_init(&(m_config[i]));
+
+  // synchronized update of coupled pairs
+  sfr_MSC.MSC_SMULOCK.byte = SMED_CFG_UNLOCK;
+
+} // SMED_begin
+
+
+
+/**
+  \fn void SMED_start(uint8_t mask)
+
+  \brief start SMEDs
+
+  \param[in]  mask    SMEDs to start, e.g. SMED_MASK(0) | SMED_MASK(1)
+
+  enable state machines first, then start counters in a tight loop to
+  minimize the skew between SMEDs.
+*/
+void SMED_start(uint8_t mask) {
+
+  uint8_t   i;
+
+  for (i=0; i<SMED_NUM; i++) {
+    if (mask & SMED_MASK(i))
+      m_smed[i]->CTR.byte = CTR_FSM_ENA;
+  }
+  for (i=0; i<SMED_NUM; i++) {
+    if (mask & SMED_MASK(i))
+      m_smed[i]->CTR.byte = CTR_FSM_ENA | CTR_START_CNT;
+  }
+
+} // SMED_start
+
+
+
+/**
+  \fn void SMED_stop(uint8_t mask)
+
+  \brief stop SMEDs
+
+  \param[in]  mask    SMEDs to stop, e.g. SMED_MASK(0)
+*/
+void SMED_stop(uint8_t mask) {
+
+  uint8_t   i;
+
+  for (i=0; i<SMED_NUM; i++) {
+    if (mask & SMED_MASK(i))
+      m_smed[i]->CTR.byte = 0x00;
+  }
+
+} // SMED_stop
+
+
+
+/**
+  \fn uint8_t SMED_setTimes(uint8_t id, uint8_t mask, const uint16_t *ticks)
+
+  \brief glitch-free update of timers
+
+  \param[in]  id      SMED ID 0..5
+  \param[in]  mask    timers to update, e.g. SMED_T0 | SMED_T1
+  \param[in]  ticks   new timer values T0..T3 [ticks]. Only entries in mask are used
+
+  \return 1 on success, 0 if previous update of a timer in mask is still pending
+
+  write new timer values and validate them together. The SMED transfers
+  validated values to the active timers depending on SMDx_CFG.TIM_UPD, i.e.
+  a running PWM period is not corrupted. For coupled pairs with synchronized
+  update, call SMED_unlock() after updating both SMEDs.
+*/
+uint8_t SMED_setTimes(uint8_t id, uint8_t mask, const uint16_t *ticks) {
+
+  SMED0_t   *smed;
+  uint8_t   i;
+
+  // check ID
+  if (id >= SMED_NUM)
+    return(0);
+  smed = m_smed[id];
+
+  // previous values not yet transferred
+  mask &= (SMED_T0 | SMED_T1 | SMED_T2 | SMED_T3);
+  if (smed->CTR_TMR.byte & mask)
+    return(0);
+
+  // write timers T0..T3 (LSB, MSB are consecutive)
+  for (i=0; i<4; i++) {
+    if (mask & (1 << i)) {
+      (&(smed->TMR_T0L.byte))[2*i]   = (uint8_t) ticks[i];
+      (&(smed->TMR_T0L.byte))[2*i+1] = (uint8_t) (ticks[i] >> 8);
+    }
+  }
+
+  // validate all together
+  smed->CTR_TMR.byte |= mask;
+
+  return(1);
+
+} // SMED_setTimes
+
+
+
+/**
+  \fn uint8_t SMED_setTime(uint8_t id, uint8_t timer, uint16_t ticks)
+
+  \brief glitch-free update of single timer
+
+  \param[in]  id      SMED ID 0..5
+  \param[in]  timer   timer 0..3
+  \param[in]  ticks   new timer value [ticks]
+
+  \return 1 on success, 0 if previous update is pending
+*/
+uint8_t SMED_setTime(uint8_t id, uint8_t timer, uint16_t ticks) {
+
+  uint16_t  values[4];
+
+  if (timer > 3)
+    return(0);
+  values[timer] = ticks;
+
+  return(SMED_setTimes(id, (uint8_t) (1 << timer), values));
+
+} // SMED_setTime
+
+
+
+/**
+  \fn uint8_t SMED_setDither(uint8_t id, uint8_t dither)
+
+  \brief glitch-free update of dithering
+
+  \param[in]  id      SMED ID 0..5
+  \param[in]  dither  new dithering pattern SMDx_CTR_DTHR
+
+  \return 1 on success, 0 if previous update is pending
+*/
+uint8_t SMED_setDither(uint8_t id, uint8_t dither) {
+
+  SMED0_t   *smed;
+
+  // check ID
+  if (id >= SMED_NUM)
+    return(0);
+  smed = m_smed[id];
+
+  // previous value not yet transferred
+  if (smed->CTR_TMR.DITHER_VAL)
+    return(0);
+
+  // write and validate
+  smed->CTR_DTHR.byte = dither;
+  smed->CTR_TMR.DITHER_VAL = 1;
+
+  return(1);
+
+} // SMED_setDither
+
+
+
+/**
+  \fn void SMED_unlock(uint8_t id)
+
+  \brief synchronized transfer for coupled pair
+
+  \param[in]  id      ID of either SMED of the pair
+
+  for coupled pairs with synchronized update (MSC_SMULOCK.USE_UNLOCK_xy)
+  validated values are transferred to both SMEDs only after UNLOCK_xy is set.
+*/
+void SMED_unlock(uint8_t id) {
+
+  uint8_t   bit;
+
+  // UNLOCK_01/23/45 are bits 3..5
+  bit = (uint8_t) (0x08 << (id >> 1));
+  sfr_MSC.MSC_SMULOCK.byte |= bit;
+  sfr_MSC.MSC_SMULOCK.byte &= (uint8_t) ~bit;
+
+} // SMED_unlock
+
+
+
+/**
+  \fn void SMED_swEvent(uint8_t mask)
+
+  \brief trigger software events
+
+  \param[in]  mask    SMEDs to receive event, e.g. SMED_MASK(0)
+*/
+void SMED_swEvent(uint8_t mask) {
+
+  sfr_MSC.MSC_SMSWEV.byte = mask;
+
+} // SMED_swEvent
+
+
+
+/**
+  \fn uint8_t SMED_state(uint8_t id)
+
+  \brief get FSM state
+
+  \param[in]  id      SMED ID 0..5
+
+  \return state SMDx_FSM_STS.FSM, see reference manual
+*/
+uint8_t SMED_state(uint8_t id) {
+
+  if (id >= SMED_NUM)
+    return(0);
+
+  return(m_smed[id]->FSM_STS.byte & 0x07);
+
+} // SMED_state
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
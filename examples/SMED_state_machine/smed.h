@@ -0,0 +1,113 @@
+/**
+  \file smed.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of SMED driver with compiled register tables
+
+  declaration of a driver for the SMED (State Machine Event Driven) PWM
+  generators of STLUX devices. Features:
+    - state machines are described declaratively (JSON) and compiled by
+      Utils/smed_compile.py into validated register init tables, see smed_config.h
+    - all configured SMEDs are initialized from the table and started together
+    - glitch-free retuning of timers and dithering at runtime. New values
+      are only transferred after validation via SMDx_CTR_TMR
+    - synchronized update of coupled SMED pairs via MSC_SMULOCK
+
+  \note
+  - SMED clock source and divider are set from the table. Times with unit in
+    the description assume the given counter clock
+  - PWM output multiplexing (MSC_IOMXP1) is not changed
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _SMED_H_
+#define _SMED_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "smed_config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+/// number of SMEDs
+#define SMED_NUM            6
+
+/// bitmask of SMED ID for SMED_start() and SMED_stop()
+#define SMED_MASK(id)       ((uint8_t) (1 << (id)))
+
+// timer and dithering masks for SMED_setTimes(). Identical to SMDx_CTR_TMR bits
+#define SMED_T0             0x01      ///< timer T0
+#define SMED_T1             0x02      ///< timer T1
+#define SMED_T2             0x04      ///< timer T2
+#define SMED_T3             0x08      ///< timer T3
+#define SMED_DITHER         0x10      ///< dithering register
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// SMED configuration, generated by Utils/smed_compile.py
+typedef struct {
+  uint8_t     id;                           ///< SMED 0..5
+  uint8_t     clk;                          ///< clock configuration CLK_SMEDx
+  uint8_t     mode;                         ///< global configuration MSC_SMDCFGxy.SMEDx_GLBCONF
+  uint8_t     cbox;                         ///< connection box MSC_CBOXSx
+  uint8_t     imr;                          ///< interrupt mask SMDx_IMR
+  uint8_t     isel;                         ///< input selection SMDx_ISEL
+  uint8_t     dmp;                          ///< dump configuration SMDx_DMP
+  uint8_t     image[SMED_CFG_IMAGE_LEN];    ///< registers SMDx_CTR_INP to SMDx_CFG
+} smed_config_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// initialize all SMEDs from compiled table. SMEDs are stopped
+void SMED_begin(void);
+
+/// initialize single SMED from configuration. Returns 0 on error
+uint8_t SMED_init(const smed_config_t *cfg);
+
+/// start SMEDs (bitmask, see SMED_MASK())
+void SMED_start(uint8_t mask);
+
+/// stop SMEDs (bitmask, see SMED_MASK())
+void SMED_stop(uint8_t mask);
+
+/// glitch-free update of timers T0..T3 [ticks] (bitmask SMED_Tx). Returns 0 if previous update is pending
+uint8_t SMED_setTimes(uint8_t id, uint8_t mask, const uint16_t *ticks);
+
+/// glitch-free update of single timer 0..3 [ticks]. Returns 0 if previous update is pending
+uint8_t SMED_setTime(uint8_t id, uint8_t timer, uint16_t ticks);
+
+/// glitch-free update of dithering. Returns 0 if previous update is pending
+uint8_t SMED_setDither(uint8_t id, uint8_t dither);
+
+/// transfer validated values of both SMEDs of a coupled pair with synchronized update
+void SMED_unlock(uint8_t id);
+
+/// trigger software events (bitmask, see SMED_MASK())
+void SMED_swEvent(uint8_t mask);
+
+/// get current FSM state SMDx_FSM_STS.FSM
+uint8_t SMED_state(uint8_t id);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _SMED_H_
@@ -0,0 +1,49 @@
+/**
+  \file smed_config.h
+
+  \brief SMED register init tables
+
+  register init tables for the SMED driver, compiled from 'smed_buck.json'.
+
+  \note
+  - this file is generated by Utils/smed_compile.py. Do not edit, but re-compile
+    after changes of the state machine description
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _SMED_CONFIG_H_
+#define _SMED_CONFIG_H_
+
+#define SMED_CFG_NUM             2
+#define SMED_CFG_UNLOCK          0x01
+#define SMED_CFG_IMAGE_LEN       26
+
+#define SMED_BUCK                0
+#define SMED_BUCK_T0             64
+#define SMED_BUCK_T1             96
+#define SMED_AUX                 1
+#define SMED_AUX_T0              96
+#define SMED_AUX_T1              64
+
+#define SMED_CFG_TABLE \
+  /* BUCK: SMED0 */ \
+  { 0, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, { \
+    0x11, 0x00, 0x40, 0x00, 0x60, 0x00, 0x00, 0x00, \
+    0x00, 0x00, 0x30, 0x00, 0x00, 0x11, 0x10, 0x00, \
+    0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+    0x00, 0x00 \
+  } }, \
+  /* AUX: SMED1 */ \
+  { 1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, { \
+    0x00, 0x00, 0x60, 0x00, 0x40, 0x00, 0x00, 0x00, \
+    0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x30, 0x00, \
+    0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+    0x00, 0x00 \
+  } }
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _SMED_CONFIG_H_
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+
+"""
+Generate UART instance table for the generic UART driver from XML device descriptions
+
+Scans the XML device descriptions for UART, USART and LINUART modules and their
+transmit/receive interrupts, and writes a C header with one block per group of
+devices with identical UART configuration. The block is selected via the
+DEVICE_xxx macro defined in the device header.
+
+For each instance ID (e.g. UART1, USART2, LINUART) the following is defined:
+  - <ID>_AVAILABLE      instance exists on device
+  - <ID>_SFR            register struct, e.g. sfr_UART1
+  - <ID>_TX_IRQ         IRQ of TXE/TC interrupt
+  - <ID>_RX_IRQ         IRQ of RXNE/IDLE/error interrupt
+  - <ID>_CLK_ENABLE()   enable peripheral clock (empty if clock active after reset)
+
+usage: uart_gen.py [-o uart_instances.h] [XML files or folder]
+"""
+
+import os
+import re
+import glob
+import argparse
+import xml.etree.ElementTree as ET
+
+
+# peripheral clock gating (family, module) -> (register, mask). Only required where clock is off after reset
+CLOCK_GATES = {
+  ('STM8L',    'USART1'):  ('PCKENR1', 0x20),
+  ('STM8L',    'USART2'):  ('PCKENR3', 0x08),
+  ('STM8L',    'USART3'):  ('PCKENR3', 0x10),
+  ('STM8L101', 'USART'):   ('PCKENR',  0x20),
+  ('STM8T',    'USART'):   ('PCKENR1', 0x20),
+}
+
+# supported UART type modules
+UART_NAME = re.compile(r'^(UART|USART|LINUART)\d?$')
+
+
+def device_macro(chipname):
+  """ name of DEVICE_xxx macro in device header """
+  return 'DEVICE_' + re.sub(r'[^A-Za-z0-9]', '_', chipname)
+
+
+def device_family(family):
+  """ map XML family description to FAMILY_xxx name """
+  if family.startswith('STM8L101'):
+    return 'STM8L101'
+  if family.startswith('STM8L'):
+    return 'STM8L'
+  if family.startswith('STM8S'):
+    return 'STM8S'
+  return family.split(',')[0]
+
+
+def parse_device(filename):
+  """ return (device macro, tuple of UART instances) for one XML file """
+
+  root = ET.parse(filename).getroot()
+  chip = root.get('chipname')
+  family = device_family(root.findtext('family', ''))
+
+  # collect UART type modules by address. Aliases share the same address
+  modules = {}
+  for m in root.iter('module'):
+    name = m.get('name')
+    if not UART_NAME.match(name):
+      continue
+    sfr = m.find('SFR')
+    addr = int(sfr.get('address'), 16)
+    modules.setdefault(addr, []).append(name)
+
+  # get IRQ for interrupt, identified by register.bit of enable
+  irqs = {}
+  for i in root.iter('interrupt'):
+    if i.get('irq'):
+      irqs[(i.get('enable'), i.get('pending', '').split('.')[-1])] = int(i.get('irq'))
+
+  instances = []
+  for addr in sorted(modules):
+
+    # prefer numbered name over alias, e.g. USART1 over USART
+    names = modules[addr]
+    name = sorted(names, key=lambda n: (not n[-1].isdigit(), n))[0]
+
+    # find Tx and Rx IRQ via enable bits of any alias
+    tx = rx = None
+    for n in names:
+      tx = tx if tx is not None else irqs.get((n + '_CR2.TIEN', 'TXE'))
+      rx = rx if rx is not None else irqs.get((n + '_CR2.RIEN', 'RXNE'))
+    if (tx is None) or (rx is None):
+      print('warning: %s: no interrupts found for %s, skipped' % (chip, name))
+      continue
+
+    # clock gating if required by family
+    gate = CLOCK_GATES.get((family, name))
+    instances.append((name, addr, tx, rx, gate))
+
+  return device_macro(chip), tuple(instances)
+
+
+def write_header(out, groups):
+  """ write C header with one block per group of devices """
+
+  out.write('''/**
+  \\file uart_instances.h
+
+  \\brief UART instances of all supported devices
+
+  UART, USART and LINUART instances of all devices with respective register
+  struct, transmit and receive IRQs, and peripheral clock enable.
+
+  \\note
+  - this file is generated by Utils/uart_gen.py from the XML device descriptions.
+    Do not edit, but re-generate after changes to the XML files
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_INSTANCES_H_
+#define _UART_INSTANCES_H_
+
+''')
+
+  first = True
+  for instances, devices in groups:
+    cond = ' || \\\n    '.join('defined(%s)' % d for d in sorted(devices))
+    out.write('%s %s\n' % ('#if' if first else '#elif', cond))
+    first = False
+    if len(instances) == 0:
+      out.write('  // no UART available\n')
+    for (name, addr, tx, rx, gate) in instances:
+      out.write('  // %s at 0x%04x\n' % (name, addr))
+      out.write('  #define %s\n' % (name + '_AVAILABLE'))
+      out.write('  #define %-28s sfr_%s\n' % (name + '_SFR', name))
+      out.write('  #define %-28s %d\n' % (name + '_TX_IRQ', tx))
+      out.write('  #define %-28s %d\n' % (name + '_RX_IRQ', rx))
+      if gate:
+        out.write('  #define %-28s (sfr_CLK.%s.byte |= 0x%02x)\n' % (name + '_CLK_ENABLE()', gate[0], gate[1]))
+      else:
+        out.write('  #define %s\n' % (name + '_CLK_ENABLE()'))
+    out.write('\n')
+  out.write('''#else
+  #error device not supported, re-generate with Utils/uart_gen.py
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_INSTANCES_H_
+''')
+
+
+if __name__ == "__main__":
+
+  parser = argparse.ArgumentParser(description='generate UART instance table from XML device descriptions')
+  parser.add_argument('-o', '--output', default='uart_instances.h', help='output header')
+  parser.add_argument('xml', nargs='*', default=[os.path.join(os.path.dirname(__file__), '../../../XML')],
+                      help='XML files or folder (default: repository XML folder)')
+  args = parser.parse_args()
+
+  # collect XML files
+  files = []
+  for x in args.xml:
+    files += sorted(glob.glob(os.path.join(x, '*.xml'))) if os.path.isdir(x) else [x]
+
+  # group devices with identical UART configuration
+  groups = {}
+  for f in files:
+    dev, instances = parse_device(f)
+    groups.setdefault(instances, []).append(dev)
+
+  # sort groups by first device for stable output
+  groups = sorted(groups.items(), key=lambda g: sorted(g[1])[0])
+  with open(args.output, 'w') as out:
+    write_header(out, groups)
+
+  print("wrote %d devices in %d groups to '%s'" % (len(files), len(groups), args.output))
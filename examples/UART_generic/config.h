@@ -0,0 +1,85 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device, board and UART instances.
+
+  \note
+  per enabled UART instance <ID> define:
+    - USE_<ID>        enable instance
+    - <ID>_BAUD       baudrate [Baud]
+    - <ID>_RX_SIZE    receive FIFO size [B], power of 2 and <=128
+    - <ID>_TX_SIZE    transmit FIFO size [B], power of 2 and <=128
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define MUBOARD
+//#define STM8L_DISCOVERY
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES AND UART CONFIGURATION
+----------------------------------------------------------*/
+
+// muBoard (http://www.cream-tea.de/presentations/160305_PiAndMore.pdf)
+#if defined(MUBOARD)
+  #include "../../include/STM8S207MB.h"
+
+  #define F_HSI           16000000L   // HSI clock [Hz]
+  #define HSI_PRESCALER   0           // fMaster = fHSI/2^HSI_PRESCALER
+  #define F_MASTER        (F_HSI >> HSI_PRESCALER)
+
+  // UART1: console via USB bridge
+  #define USE_UART1
+  #define UART1_BAUD      115200
+  #define UART1_RX_SIZE   64
+  #define UART1_TX_SIZE   128
+
+  // UART3: frame based protocol, e.g. Modbus RTU
+  #define USE_UART3
+  #define UART3_BAUD      19200
+  #define UART3_RX_SIZE   128
+  #define UART3_TX_SIZE   32
+
+  // aliases used by main.c
+  #define CONSOLE(fn)     UART1_##fn
+  #define BUS(fn)         UART3_##fn
+
+
+// STM8L discovery board (STM8L152C6)
+#elif defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"
+
+  #define F_HSI           16000000L   // HSI clock [Hz]
+  #define HSI_PRESCALER   UART_HSIDIV_BEST(F_HSI, USART1_BAUD)  // slowest clock supporting baudrate
+  #define F_MASTER        (F_HSI >> HSI_PRESCALER)
+
+  // USART1: console via ST-Link virtual COM port (PC3/PC2)
+  #define USE_USART1
+  #define USART1_BAUD     9600
+  #define USART1_RX_SIZE  32
+  #define USART1_TX_SIZE  64
+
+  // aliases used by main.c
+  #define CONSOLE(fn)     USART1_##fn
+  #define BUS(fn)         USART1_##fn
+
+#else
+  #error no board selected
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
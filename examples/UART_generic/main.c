@@ -0,0 +1,117 @@
+/**********************
+  Generic interrupt driven UART driver for all UART, USART and LINUART instances
+
+  supported hardware:
+    - muBoard (http://www.cream-tea.de/presentations/160305_PiAndMore.pdf)
+    - STM8L discovery board (STM8L152C6)
+
+  Functionality:
+    - enable UART instances and set baudrate & FIFO sizes in config.h
+    - available instances per device are generated from XML by Utils/uart_gen.py
+    - bus: echo complete frames (terminated by idle line) with length prefix
+    - console: on 's' print error and frame counters
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "uart.h"
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/// print string via console
+void print_str(const char *str) {
+  while (*str)
+    CONSOLE(write)((uint8_t) (*str++));
+}
+
+/// print 16-bit unsigned number via console
+void print_num(uint16_t num) {
+  char      buf[6];
+  uint8_t   i = 5;
+  buf[5] = '\0';
+  do {
+    buf[--i] = '0' + (num % 10);
+    num /= 10;
+  } while (num);
+  print_str(&(buf[i]));
+}
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void) {
+
+  uart_stats_t  stats;
+  uint8_t       len, data;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // set HSI prescaler from config.h (default is HSI/8=2MHz)
+  sfr_CLK.CKDIVR.byte = UART_CKDIVR(HSI_PRESCALER);
+
+  // init UARTs with parameters from config.h
+  CONSOLE(begin)();
+  #if !defined(STM8L_DISCOVERY)
+    BUS(begin)();
+  #endif
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  print_str("\nUART_generic demo\n");
+
+  // print baudrate error of bus UART. Is calculated at compile time
+  print_str("bus baudrate error ");
+  #if defined(STM8L_DISCOVERY)
+    print_num(UART_BAUD_ERROR(F_MASTER, USART1_BAUD));
+  #else
+    print_num(UART_BAUD_ERROR(F_MASTER, UART3_BAUD));
+  #endif
+  print_str(" permille\n");
+
+  // main loop
+  while(1) {
+
+    // echo each complete bus frame with length prefix
+    #if !defined(STM8L_DISCOVERY)
+      if ((len = BUS(frameAvailable)()) != 0) {
+        BUS(write)(len);
+        while (len--)
+          BUS(write)(BUS(read)());
+      }
+    #endif
+
+    // handle console commands
+    if (CONSOLE(available)()) {
+      data = CONSOLE(read)();
+
+      // print and reset counters of bus
+      if (data == 's') {
+        BUS(getStats)(&stats, 1);
+        print_str("frames ");   print_num(stats.frames);
+        print_str(", parity "); print_num(stats.parity);
+        print_str(", framing ");print_num(stats.framing);
+        print_str(", noise ");  print_num(stats.noise);
+        print_str(", overrun ");print_num(stats.overrun);
+        print_str(", overflow ");print_num(stats.overflow);
+        print_str("\n");
+      }
+
+    } // console
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
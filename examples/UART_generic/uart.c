@@ -0,0 +1,81 @@
+/**
+  \file uart.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of generic UART functions/macros using FIFO and interrupts
+
+  implementation of interrupt driven UART functions for all enabled UART, USART
+  and LINUART instances. The code of each instance is generated from the common
+  implementation in uart_template.h
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "uart.h"
+
+
+/*----------------------------------------------------------
+    IMPLEMENTATION OF ENABLED INSTANCES
+----------------------------------------------------------*/
+
+#if defined(USE_UART)
+  #define UART_ID   UART
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_UART1)
+  #define UART_ID   UART1
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_UART2)
+  #define UART_ID   UART2
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_UART3)
+  #define UART_ID   UART3
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_USART)
+  #define UART_ID   USART
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_USART1)
+  #define UART_ID   USART1
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_USART2)
+  #define UART_ID   USART2
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_USART3)
+  #define UART_ID   USART3
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+#if defined(USE_LINUART)
+  #define UART_ID   LINUART
+  #include "uart_template.h"
+  #undef UART_ID
+#endif
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
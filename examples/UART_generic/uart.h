@@ -0,0 +1,169 @@
+/**
+  \file uart.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of generic UART functions/macros using FIFO and interrupts
+
+  declaration of interrupt driven UART functions for all UART, USART and LINUART
+  instances. Functions are prefixed with the instance name, e.g. UART1_begin() or
+  USART2_read(). Instances are enabled in config.h via USE_<ID>, baudrate and
+  FIFO sizes via <ID>_BAUD, <ID>_RX_SIZE and <ID>_TX_SIZE.
+
+  \note
+  - available instances per device are listed in uart_instances.h, which is
+    generated from the XML device descriptions by Utils/uart_gen.py
+  - FIFO sizes must be a power of 2 and <=128
+  - a received frame is terminated by an idle line (>=1 frame w/o data)
+  - baudrate registers are calculated at compile time, see uart_baud.h.
+    Infeasible combinations of F_MASTER and <ID>_BAUD stop compilation
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_H_
+#define _UART_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "uart_instances.h"
+#include "uart_baud.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// default master clock [Hz], can be overwritten in config.h
+#ifndef F_MASTER
+  #define F_MASTER          16000000L
+#endif
+
+// helper macros for instance specific names, e.g. UART_CAT(UART1, begin) -> UART1_begin
+#define UART_CAT_(a,b)    a##_##b
+#define UART_CAT(a,b)     UART_CAT_(a,b)
+
+// UART status register bits. Bit names differ between variants, e.g. OR vs. OR_LHE
+#define UART_SR_PE        0x01      ///< parity error
+#define UART_SR_FE        0x02      ///< framing error
+#define UART_SR_NF        0x04      ///< noise flag
+#define UART_SR_OR        0x08      ///< overrun error
+#define UART_SR_IDLE      0x10      ///< idle line detected
+#define UART_SR_RXNE      0x20      ///< receive register not empty
+#define UART_SR_TC        0x40      ///< transmission complete
+#define UART_SR_TXE       0x80      ///< transmit register empty
+
+/// forced register read, e.g. to clear status flags. Register structs are not declared volatile
+#define UART_READ(reg)    (*((volatile uint8_t*) &(reg)))
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// UART error and event counters
+typedef struct {
+  uint16_t    parity;         ///< parity errors
+  uint16_t    framing;        ///< framing errors (missing stop bit)
+  uint16_t    noise;          ///< bytes with noise detected
+  uint16_t    overrun;        ///< bytes lost in hardware (ISR too slow)
+  uint16_t    overflow;       ///< bytes lost due to full Rx FIFO
+  uint16_t    frames;         ///< received frames (terminated by idle line)
+} uart_stats_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// declare functions and ISRs of one UART instance
+#define UART_DECLARE(ID) \
+  void      ID##_begin(void); \
+  void      ID##_write(uint8_t data); \
+  void      ID##_writeBuf(const uint8_t *buf, uint8_t num); \
+  void      ID##_flush(void); \
+  uint8_t   ID##_available(void); \
+  uint8_t   ID##_read(void); \
+  uint8_t   ID##_peek(void); \
+  uint8_t   ID##_frameAvailable(void); \
+  void      ID##_getStats(uart_stats_t *stats, uint8_t clear); \
+  ISR_HANDLER(ID##_TXE_ISR, ID##_TX_IRQ); \
+  ISR_HANDLER(ID##_RXNE_ISR, ID##_RX_IRQ);
+
+
+// declare enabled instances. Check availability on device
+#if defined(USE_UART)
+  #if !defined(UART_AVAILABLE)
+    #error UART not available on device
+  #endif
+  UART_DECLARE(UART)
+#endif
+
+#if defined(USE_UART1)
+  #if !defined(UART1_AVAILABLE)
+    #error UART1 not available on device
+  #endif
+  UART_DECLARE(UART1)
+#endif
+
+#if defined(USE_UART2)
+  #if !defined(UART2_AVAILABLE)
+    #error UART2 not available on device
+  #endif
+  UART_DECLARE(UART2)
+#endif
+
+#if defined(USE_UART3)
+  #if !defined(UART3_AVAILABLE)
+    #error UART3 not available on device
+  #endif
+  UART_DECLARE(UART3)
+#endif
+
+#if defined(USE_USART)
+  #if !defined(USART_AVAILABLE)
+    #error USART not available on device
+  #endif
+  UART_DECLARE(USART)
+#endif
+
+#if defined(USE_USART1)
+  #if !defined(USART1_AVAILABLE)
+    #error USART1 not available on device
+  #endif
+  UART_DECLARE(USART1)
+#endif
+
+#if defined(USE_USART2)
+  #if !defined(USART2_AVAILABLE)
+    #error USART2 not available on device
+  #endif
+  UART_DECLARE(USART2)
+#endif
+
+#if defined(USE_USART3)
+  #if !defined(USART3_AVAILABLE)
+    #error USART3 not available on device
+  #endif
+  UART_DECLARE(USART3)
+#endif
+
+#if defined(USE_LINUART)
+  #if !defined(LINUART_AVAILABLE)
+    #error LINUART not available on device
+  #endif
+  UART_DECLARE(LINUART)
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_H_
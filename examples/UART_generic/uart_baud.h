@@ -0,0 +1,84 @@
+/**
+  \file uart_baud.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief compile-time calculation of UART baudrate registers
+
+  macros for calculating the UART baudrate registers BRR1/BRR2 and the resulting
+  baudrate error from master clock and baudrate. For constant arguments all
+  macros are evaluated by the compiler, i.e. no 32-bit division at runtime.
+  Additionally the largest HSI prescaler which still meets the baudrate
+  tolerance can be determined, e.g. to save power.
+
+  \note
+  - UART divider must be within [16; 0xFFFF] (see reference manual)
+  - baudrate tolerance can be set via UART_BAUD_TOLERANCE [permille] (default 20)
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_BAUD_H_
+#define _UART_BAUD_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// default max. baudrate error [permille], can be overwritten before inclusion
+#ifndef UART_BAUD_TOLERANCE
+  #define UART_BAUD_TOLERANCE   20
+#endif
+
+/// UART divider for master clock and baudrate (rounded)
+#define UART_BAUD_DIV(fclk, baud)       ((((uint32_t) (fclk)) + ((uint32_t) (baud))/2) / ((uint32_t) (baud)))
+
+/// actual baudrate [Baud] for master clock and nominal baudrate
+#define UART_BAUD_ACTUAL(fclk, baud)    (((uint32_t) (fclk)) / UART_BAUD_DIV(fclk, baud))
+
+/// absolute baudrate error [permille] for master clock and nominal baudrate
+#define UART_BAUD_ERROR(fclk, baud)     ((((UART_BAUD_ACTUAL(fclk, baud) > ((uint32_t) (baud))) ? \
+                                          (UART_BAUD_ACTUAL(fclk, baud) - ((uint32_t) (baud))) : \
+                                          (((uint32_t) (baud)) - UART_BAUD_ACTUAL(fclk, baud))) * 1000L) / ((uint32_t) (baud)))
+
+/// check if baudrate is feasible: divider in valid range and error within tolerance (1=ok, 0=not possible)
+#define UART_BAUD_VALID(fclk, baud)     ((UART_BAUD_DIV(fclk, baud) >= 16) && \
+                                         (UART_BAUD_DIV(fclk, baud) <= 0xFFFF) && \
+                                         (UART_BAUD_ERROR(fclk, baud) <= UART_BAUD_TOLERANCE))
+
+/// value of register BRR1 for master clock and baudrate: DIV[11:4]
+#define UART_BRR1(fclk, baud)           ((uint8_t) ((UART_BAUD_DIV(fclk, baud) >> 4) & 0xFF))
+
+/// value of register BRR2 for master clock and baudrate: DIV[15:12] and DIV[3:0]
+#define UART_BRR2(fclk, baud)           ((uint8_t) (((UART_BAUD_DIV(fclk, baud) >> 8) & 0xF0) | (UART_BAUD_DIV(fclk, baud) & 0x0F)))
+
+/// compile-time check of baudrate. Compilation fails with "negative array size" if not feasible
+#define UART_BAUD_ASSERT(name, fclk, baud)  typedef char name[UART_BAUD_VALID(fclk, baud) ? 1 : -1]
+
+/// largest HSI prescaler exponent k in [0;3] (fMaster=fHSI/2^k) which supports baudrate, or 0 if none
+#define UART_HSIDIV_BEST(fhsi, baud)    (UART_BAUD_VALID((fhsi)/8, baud) ? 3 : \
+                                         UART_BAUD_VALID((fhsi)/4, baud) ? 2 : \
+                                         UART_BAUD_VALID((fhsi)/2, baud) ? 1 : 0)
+
+/// value of register CLK_CKDIVR for HSI prescaler exponent k (CPU prescaler = 1)
+#if defined(FAMILY_STM8L) || defined(FAMILY_STM8L101)
+  #define UART_CKDIVR(k)                ((uint8_t) (k))
+#else
+  #define UART_CKDIVR(k)                ((uint8_t) ((k) << 3))
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_BAUD_H_
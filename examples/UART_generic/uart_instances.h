@@ -0,0 +1,307 @@
+/**
+  \file uart_instances.h
+
+  \brief UART instances of all supported devices
+
+  UART, USART and LINUART instances of all devices with respective register
+  struct, transmit and receive IRQs, and peripheral clock enable.
+
+  \note
+  - this file is generated by Utils/uart_gen.py from the XML device descriptions.
+    Do not edit, but re-generate after changes to the XML files
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_INSTANCES_H_
+#define _UART_INSTANCES_H_
+
+#if defined(DEVICE_STLUX285A) || \
+    defined(DEVICE_STLUX325A) || \
+    defined(DEVICE_STLUX383A) || \
+    defined(DEVICE_STLUX385) || \
+    defined(DEVICE_STLUX385A) || \
+    defined(DEVICE_STNRG288A) || \
+    defined(DEVICE_STNRG328A) || \
+    defined(DEVICE_STNRG388A) || \
+    defined(DEVICE_STWBC) || \
+    defined(DEVICE_STWBC_EP) || \
+    defined(DEVICE_STWBC_MC) || \
+    defined(DEVICE_STWBC_WA)
+  // UART at 0x5230
+  #define UART_AVAILABLE
+  #define UART_SFR                     sfr_UART
+  #define UART_TX_IRQ                  17
+  #define UART_RX_IRQ                  18
+  #define UART_CLK_ENABLE()
+
+#elif defined(DEVICE_STM8AF5168) || \
+    defined(DEVICE_STM8AF5169) || \
+    defined(DEVICE_STM8AF5178) || \
+    defined(DEVICE_STM8AF5179) || \
+    defined(DEVICE_STM8AF5188) || \
+    defined(DEVICE_STM8AF5189) || \
+    defined(DEVICE_STM8AF518A) || \
+    defined(DEVICE_STM8AF5198) || \
+    defined(DEVICE_STM8AF5199) || \
+    defined(DEVICE_STM8AF519A) || \
+    defined(DEVICE_STM8AF51A8) || \
+    defined(DEVICE_STM8AF51A9) || \
+    defined(DEVICE_STM8AF51AA) || \
+    defined(DEVICE_STM8AF5268) || \
+    defined(DEVICE_STM8AF5269) || \
+    defined(DEVICE_STM8AF5286) || \
+    defined(DEVICE_STM8AF5288) || \
+    defined(DEVICE_STM8AF5289) || \
+    defined(DEVICE_STM8AF528A) || \
+    defined(DEVICE_STM8AF52A6) || \
+    defined(DEVICE_STM8AF52A8) || \
+    defined(DEVICE_STM8AF52A9) || \
+    defined(DEVICE_STM8AF52AA) || \
+    defined(DEVICE_STM8AF6169) || \
+    defined(DEVICE_STM8AF6178) || \
+    defined(DEVICE_STM8AF6179) || \
+    defined(DEVICE_STM8AF6188) || \
+    defined(DEVICE_STM8AF6189) || \
+    defined(DEVICE_STM8AF618A) || \
+    defined(DEVICE_STM8AF6198) || \
+    defined(DEVICE_STM8AF6199) || \
+    defined(DEVICE_STM8AF619A) || \
+    defined(DEVICE_STM8AF61A8) || \
+    defined(DEVICE_STM8AF61A9) || \
+    defined(DEVICE_STM8AF61AA) || \
+    defined(DEVICE_STM8AF6269) || \
+    defined(DEVICE_STM8AF6288) || \
+    defined(DEVICE_STM8AF6289) || \
+    defined(DEVICE_STM8AF628A) || \
+    defined(DEVICE_STM8AF62A8) || \
+    defined(DEVICE_STM8AF62A9) || \
+    defined(DEVICE_STM8AF62AA)
+  // USART at 0x5230
+  #define USART_AVAILABLE
+  #define USART_SFR                    sfr_USART
+  #define USART_TX_IRQ                 17
+  #define USART_RX_IRQ                 18
+  #define USART_CLK_ENABLE()
+  // LINUART at 0x5240
+  #define LINUART_AVAILABLE
+  #define LINUART_SFR                  sfr_LINUART
+  #define LINUART_TX_IRQ               20
+  #define LINUART_RX_IRQ               21
+  #define LINUART_CLK_ENABLE()
+
+#elif defined(DEVICE_STM8AF6126) || \
+    defined(DEVICE_STM8AF6146) || \
+    defined(DEVICE_STM8AF6148) || \
+    defined(DEVICE_STM8AF6166) || \
+    defined(DEVICE_STM8AF6168) || \
+    defined(DEVICE_STM8AF6176) || \
+    defined(DEVICE_STM8AF6186) || \
+    defined(DEVICE_STM8AF6246) || \
+    defined(DEVICE_STM8AF6248) || \
+    defined(DEVICE_STM8AF6266) || \
+    defined(DEVICE_STM8AF6268) || \
+    defined(DEVICE_STM8AF6286) || \
+    defined(DEVICE_STM8AF62A6)
+  // LINUART at 0x5240
+  #define LINUART_AVAILABLE
+  #define LINUART_SFR                  sfr_LINUART
+  #define LINUART_TX_IRQ               20
+  #define LINUART_RX_IRQ               21
+  #define LINUART_CLK_ENABLE()
+
+#elif defined(DEVICE_STM8AF6213) || \
+    defined(DEVICE_STM8AF6223) || \
+    defined(DEVICE_STM8AF6223A) || \
+    defined(DEVICE_STM8AF6226)
+  // LINUART at 0x5230
+  #define LINUART_AVAILABLE
+  #define LINUART_SFR                  sfr_LINUART
+  #define LINUART_TX_IRQ               17
+  #define LINUART_RX_IRQ               18
+  #define LINUART_CLK_ENABLE()
+
+#elif defined(DEVICE_STM8AL3136) || \
+    defined(DEVICE_STM8AL3138) || \
+    defined(DEVICE_STM8AL3146) || \
+    defined(DEVICE_STM8AL3148) || \
+    defined(DEVICE_STM8AL3166) || \
+    defined(DEVICE_STM8AL3168) || \
+    defined(DEVICE_STM8AL3L46) || \
+    defined(DEVICE_STM8AL3L48) || \
+    defined(DEVICE_STM8AL3L66) || \
+    defined(DEVICE_STM8AL3L68) || \
+    defined(DEVICE_STM8L050J3) || \
+    defined(DEVICE_STM8L051F3) || \
+    defined(DEVICE_STM8L052C6) || \
+    defined(DEVICE_STM8L151C2) || \
+    defined(DEVICE_STM8L151C3) || \
+    defined(DEVICE_STM8L151C4) || \
+    defined(DEVICE_STM8L151C6) || \
+    defined(DEVICE_STM8L151F2) || \
+    defined(DEVICE_STM8L151F3) || \
+    defined(DEVICE_STM8L151G2) || \
+    defined(DEVICE_STM8L151G3) || \
+    defined(DEVICE_STM8L151G4) || \
+    defined(DEVICE_STM8L151G6) || \
+    defined(DEVICE_STM8L151K2) || \
+    defined(DEVICE_STM8L151K3) || \
+    defined(DEVICE_STM8L151K4) || \
+    defined(DEVICE_STM8L151K6) || \
+    defined(DEVICE_STM8L152C4) || \
+    defined(DEVICE_STM8L152C6) || \
+    defined(DEVICE_STM8L152K4) || \
+    defined(DEVICE_STM8L152K6)
+  // USART1 at 0x5230
+  #define USART1_AVAILABLE
+  #define USART1_SFR                   sfr_USART1
+  #define USART1_TX_IRQ                27
+  #define USART1_RX_IRQ                28
+  #define USART1_CLK_ENABLE()          (sfr_CLK.PCKENR1.byte |= 0x20)
+
+#elif defined(DEVICE_STM8AL3188) || \
+    defined(DEVICE_STM8AL3189) || \
+    defined(DEVICE_STM8AL318A) || \
+    defined(DEVICE_STM8AL31E88) || \
+    defined(DEVICE_STM8AL31E89) || \
+    defined(DEVICE_STM8AL31E8A) || \
+    defined(DEVICE_STM8AL3L88) || \
+    defined(DEVICE_STM8AL3L89) || \
+    defined(DEVICE_STM8AL3L8A) || \
+    defined(DEVICE_STM8AL3LE88) || \
+    defined(DEVICE_STM8AL3LE89) || \
+    defined(DEVICE_STM8AL3LE8A) || \
+    defined(DEVICE_STM8L052R8) || \
+    defined(DEVICE_STM8L151C8) || \
+    defined(DEVICE_STM8L151M8) || \
+    defined(DEVICE_STM8L151R6) || \
+    defined(DEVICE_STM8L151R8) || \
+    defined(DEVICE_STM8L152C8) || \
+    defined(DEVICE_STM8L152M8) || \
+    defined(DEVICE_STM8L152R6) || \
+    defined(DEVICE_STM8L152R8) || \
+    defined(DEVICE_STM8L162M8) || \
+    defined(DEVICE_STM8L162R8)
+  // USART1 at 0x5230
+  #define USART1_AVAILABLE
+  #define USART1_SFR                   sfr_USART1
+  #define USART1_TX_IRQ                27
+  #define USART1_RX_IRQ                28
+  #define USART1_CLK_ENABLE()          (sfr_CLK.PCKENR1.byte |= 0x20)
+  // USART2 at 0x53e0
+  #define USART2_AVAILABLE
+  #define USART2_SFR                   sfr_USART2
+  #define USART2_TX_IRQ                19
+  #define USART2_RX_IRQ                20
+  #define USART2_CLK_ENABLE()          (sfr_CLK.PCKENR3.byte |= 0x08)
+  // USART3 at 0x53f0
+  #define USART3_AVAILABLE
+  #define USART3_SFR                   sfr_USART3
+  #define USART3_TX_IRQ                21
+  #define USART3_RX_IRQ                22
+  #define USART3_CLK_ENABLE()          (sfr_CLK.PCKENR3.byte |= 0x10)
+
+#elif defined(DEVICE_STM8L001J3) || \
+    defined(DEVICE_STM8L101F1) || \
+    defined(DEVICE_STM8L101F2) || \
+    defined(DEVICE_STM8L101F3) || \
+    defined(DEVICE_STM8L101G2) || \
+    defined(DEVICE_STM8L101G3) || \
+    defined(DEVICE_STM8L101K3)
+  // USART at 0x5230
+  #define USART_AVAILABLE
+  #define USART_SFR                    sfr_USART
+  #define USART_TX_IRQ                 27
+  #define USART_RX_IRQ                 28
+  #define USART_CLK_ENABLE()           (sfr_CLK.PCKENR.byte |= 0x20)
+
+#elif defined(DEVICE_STM8S001J3) || \
+    defined(DEVICE_STM8S003F3) || \
+    defined(DEVICE_STM8S003K3) || \
+    defined(DEVICE_STM8S103F2) || \
+    defined(DEVICE_STM8S103F3) || \
+    defined(DEVICE_STM8S103K3) || \
+    defined(DEVICE_STM8S903F3) || \
+    defined(DEVICE_STM8S903K3)
+  // UART1 at 0x5230
+  #define UART1_AVAILABLE
+  #define UART1_SFR                    sfr_UART1
+  #define UART1_TX_IRQ                 17
+  #define UART1_RX_IRQ                 18
+  #define UART1_CLK_ENABLE()
+
+#elif defined(DEVICE_STM8S005C6) || \
+    defined(DEVICE_STM8S005K6) || \
+    defined(DEVICE_STM8S105C4) || \
+    defined(DEVICE_STM8S105C6) || \
+    defined(DEVICE_STM8S105K4) || \
+    defined(DEVICE_STM8S105K6) || \
+    defined(DEVICE_STM8S105S4) || \
+    defined(DEVICE_STM8S105S6)
+  // UART2 at 0x5240
+  #define UART2_AVAILABLE
+  #define UART2_SFR                    sfr_UART2
+  #define UART2_TX_IRQ                 20
+  #define UART2_RX_IRQ                 21
+  #define UART2_CLK_ENABLE()
+
+#elif defined(DEVICE_STM8S007C8) || \
+    defined(DEVICE_STM8S207C6) || \
+    defined(DEVICE_STM8S207C8) || \
+    defined(DEVICE_STM8S207CB) || \
+    defined(DEVICE_STM8S207K6) || \
+    defined(DEVICE_STM8S207K8) || \
+    defined(DEVICE_STM8S207M8) || \
+    defined(DEVICE_STM8S207MB) || \
+    defined(DEVICE_STM8S207R6) || \
+    defined(DEVICE_STM8S207R8) || \
+    defined(DEVICE_STM8S207RB) || \
+    defined(DEVICE_STM8S207S6) || \
+    defined(DEVICE_STM8S207S8) || \
+    defined(DEVICE_STM8S207SB) || \
+    defined(DEVICE_STM8S208C6) || \
+    defined(DEVICE_STM8S208C8) || \
+    defined(DEVICE_STM8S208CB) || \
+    defined(DEVICE_STM8S208M8) || \
+    defined(DEVICE_STM8S208MB) || \
+    defined(DEVICE_STM8S208R6) || \
+    defined(DEVICE_STM8S208R8) || \
+    defined(DEVICE_STM8S208RB) || \
+    defined(DEVICE_STM8S208S6) || \
+    defined(DEVICE_STM8S208S8) || \
+    defined(DEVICE_STM8S208SB)
+  // UART1 at 0x5230
+  #define UART1_AVAILABLE
+  #define UART1_SFR                    sfr_UART1
+  #define UART1_TX_IRQ                 17
+  #define UART1_RX_IRQ                 18
+  #define UART1_CLK_ENABLE()
+  // UART3 at 0x5240
+  #define UART3_AVAILABLE
+  #define UART3_SFR                    sfr_UART3
+  #define UART3_TX_IRQ                 20
+  #define UART3_RX_IRQ                 21
+  #define UART3_CLK_ENABLE()
+
+#elif defined(DEVICE_STM8TL52F4) || \
+    defined(DEVICE_STM8TL52G4) || \
+    defined(DEVICE_STM8TL53C4) || \
+    defined(DEVICE_STM8TL53F4) || \
+    defined(DEVICE_STM8TL53G4)
+  // USART at 0x5230
+  #define USART_AVAILABLE
+  #define USART_SFR                    sfr_USART
+  #define USART_TX_IRQ                 27
+  #define USART_RX_IRQ                 28
+  #define USART_CLK_ENABLE()           (sfr_CLK.PCKENR1.byte |= 0x20)
+
+#else
+  #error device not supported, re-generate with Utils/uart_gen.py
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_INSTANCES_H_
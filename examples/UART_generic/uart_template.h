@@ -0,0 +1,417 @@
+/**
+  \file uart_template.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of one UART instance using FIFO and interrupts
+
+  implementation of UART functions and ISRs for one UART instance. This file is
+  included by uart.c once per enabled instance with UART_ID set to the instance
+  name, e.g. UART1. All function and variable names are derived from UART_ID.
+
+  \note
+  - Rx and Tx FIFOs are single producer/single consumer with free running 8-bit
+    indices, i.e. no interrupt locking is required
+  - no multiple inclusion guard on purpose
+*/
+
+/*----------------------------------------------------------
+    LOCAL NAMES OF UART INSTANCE
+----------------------------------------------------------*/
+
+#if !defined(UART_ID)
+  #error UART_ID must be defined before including uart_template.h
+#endif
+
+// function names, e.g. UART_FN(begin) -> UART1_begin
+#define UART_FN(x)        UART_CAT(UART_ID, x)
+
+// module variable names, e.g. UART_VAR(rxBuf) -> m_UART1_rxBuf
+#define UART_VAR(x)       UART_CAT(UART_CAT(m, UART_ID), x)
+
+// instance parameters from uart_instances.h and config.h. Prefix THIS_ avoids conflicts with instance "UART"
+#define THIS_SFR          UART_FN(SFR)
+#define THIS_BAUD         UART_FN(BAUD)
+#define THIS_RX_SIZE      UART_FN(RX_SIZE)
+#define THIS_TX_SIZE      UART_FN(TX_SIZE)
+
+// check FIFO sizes (power of 2 and <=128) at compile time
+typedef char UART_VAR(checkRxSize)[(((THIS_RX_SIZE & (THIS_RX_SIZE-1)) == 0) && (THIS_RX_SIZE <= 128)) ? 1 : -1];
+typedef char UART_VAR(checkTxSize)[(((THIS_TX_SIZE & (THIS_TX_SIZE-1)) == 0) && (THIS_TX_SIZE <= 128)) ? 1 : -1];
+
+// check baudrate divider range and error at compile time
+UART_BAUD_ASSERT(UART_VAR(checkBaud), F_MASTER, THIS_BAUD);
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// receive FIFO buffer. Written by ISR, read by application
+static uint8_t            UART_VAR(rxBuf)[THIS_RX_SIZE];
+
+/// receive FIFO write index (free running). Only modified by ISR
+static volatile uint8_t   UART_VAR(rxHead);
+
+/// receive FIFO read index (free running). Only modified by application
+static volatile uint8_t   UART_VAR(rxTail);
+
+/// receive FIFO write index at last idle line, i.e. end of last complete frame
+static volatile uint8_t   UART_VAR(rxFrame);
+
+/// transmit FIFO buffer. Written by application, read by ISR
+static uint8_t            UART_VAR(txBuf)[THIS_TX_SIZE];
+
+/// transmit FIFO write index (free running). Only modified by application
+static volatile uint8_t   UART_VAR(txHead);
+
+/// transmit FIFO read index (free running). Only modified by ISR
+static volatile uint8_t   UART_VAR(txTail);
+
+/// error and event counters
+static volatile uart_stats_t  UART_VAR(stats);
+
+
+/**
+  \fn void <ID>_begin(void)
+
+  \brief initialize UART for interrupt based communication
+
+  initialize UART for interrupt based communication with baudrate <ID>_BAUD.
+  Use 1 start, 8 data and 1 stop bit; no parity or flow control.
+
+  \note
+  baudrate divider is calculated at compile time from F_MASTER and <ID>_BAUD
+*/
+void UART_FN(begin)(void) {
+
+  // enable peripheral clock (if required)
+  UART_FN(CLK_ENABLE)();
+
+  // reset UART
+  THIS_SFR.CR2.byte = 0x00;     // disable interrupts, sender and receiver
+  THIS_SFR.CR1.byte = 0x00;     // enable UART, 8 data bits, no parity control
+  THIS_SFR.CR3.byte = 0x00;     // 1 stop bit, no clock output
+
+  // init FIFOs and counters
+  UART_VAR(rxHead)  = 0;
+  UART_VAR(rxTail)  = 0;
+  UART_VAR(rxFrame) = 0;
+  UART_VAR(txHead)  = 0;
+  UART_VAR(txTail)  = 0;
+  UART_VAR(stats).parity   = 0;
+  UART_VAR(stats).framing  = 0;
+  UART_VAR(stats).noise    = 0;
+  UART_VAR(stats).overrun  = 0;
+  UART_VAR(stats).overflow = 0;
+  UART_VAR(stats).frames   = 0;
+
+  // set baudrate (note: BRR2 must be written before BRR1!)
+  THIS_SFR.BRR2.byte = UART_BRR2(F_MASTER, THIS_BAUD);
+  THIS_SFR.BRR1.byte = UART_BRR1(F_MASTER, THIS_BAUD);
+
+  // clear pending flags by reading SR then DR
+  UART_READ(THIS_SFR.SR.byte);
+  UART_READ(THIS_SFR.DR.byte);
+
+  // enable sender, receiver and receive interrupts. Tx interrupt is enabled on demand
+  THIS_SFR.CR2.REN   = 1;       // enable receiver
+  THIS_SFR.CR2.TEN   = 1;       // enable sender
+  THIS_SFR.CR2.RIEN  = 1;       // enable receive & error interrupt
+  THIS_SFR.CR2.ILIEN = 1;       // enable idle line interrupt for framing
+
+} // <ID>_begin
+
+
+
+/**
+  \fn void <ID>_write(uint8_t data)
+
+  \brief send byte via UART
+
+  \param[in]  data  byte to send
+
+  add byte to transmit FIFO and enable Tx interrupt. If FIFO is full, wait.
+*/
+void UART_FN(write)(uint8_t data) {
+
+  // wait until space in FIFO
+  while ((uint8_t) (UART_VAR(txHead) - UART_VAR(txTail)) >= THIS_TX_SIZE);
+
+  // store data and publish it via index
+  UART_VAR(txBuf)[UART_VAR(txHead) & (THIS_TX_SIZE-1)] = data;
+  UART_VAR(txHead)++;
+
+  // enable Tx interrupt, which sends FIFO content (bset is atomic)
+  THIS_SFR.CR2.TIEN = 1;
+
+} // <ID>_write
+
+
+
+/**
+  \fn void <ID>_writeBuf(const uint8_t *buf, uint8_t num)
+
+  \brief send array of bytes via UART
+
+  \param[in]  buf   array to send
+  \param[in]  num   number of bytes to send
+
+  add array to transmit FIFO. If FIFO is full, wait.
+*/
+void UART_FN(writeBuf)(const uint8_t *buf, uint8_t num) {
+
+  while (num--)
+    UART_FN(write)(*buf++);
+
+} // <ID>_writeBuf
+
+
+
+/**
+  \fn void <ID>_flush(void)
+
+  \brief wait until all data is sent
+
+  wait until transmit FIFO is empty and the last byte was sent, e.g. before
+  entering low power mode.
+*/
+void UART_FN(flush)(void) {
+
+  // wait until FIFO is empty
+  while (UART_VAR(txHead) != UART_VAR(txTail));
+
+  // wait until last byte is sent
+  while (!(THIS_SFR.SR.byte & UART_SR_TC));
+
+} // <ID>_flush
+
+
+
+/**
+  \fn uint8_t <ID>_available(void)
+
+  \brief number of received bytes
+
+  \return number of bytes in receive FIFO
+*/
+uint8_t UART_FN(available)(void) {
+
+  return((uint8_t) (UART_VAR(rxHead) - UART_VAR(rxTail)));
+
+} // <ID>_available
+
+
+
+/**
+  \fn uint8_t <ID>_read(void)
+
+  \brief read oldest byte from receive FIFO
+
+  \return oldest received byte or 0 if FIFO is empty
+*/
+uint8_t UART_FN(read)(void) {
+
+  uint8_t   data;
+
+  // FIFO empty
+  if (UART_VAR(rxHead) == UART_VAR(rxTail))
+    return(0);
+
+  // read data, then release slot
+  data = UART_VAR(rxBuf)[UART_VAR(rxTail) & (THIS_RX_SIZE-1)];
+  UART_VAR(rxTail)++;
+
+  return(data);
+
+} // <ID>_read
+
+
+
+/**
+  \fn uint8_t <ID>_peek(void)
+
+  \brief get oldest byte from receive FIFO without removing it
+
+  \return oldest received byte or 0 if FIFO is empty
+*/
+uint8_t UART_FN(peek)(void) {
+
+  // FIFO empty
+  if (UART_VAR(rxHead) == UART_VAR(rxTail))
+    return(0);
+
+  return(UART_VAR(rxBuf)[UART_VAR(rxTail) & (THIS_RX_SIZE-1)]);
+
+} // <ID>_peek
+
+
+
+/**
+  \fn uint8_t <ID>_frameAvailable(void)
+
+  \brief number of received bytes belonging to complete frames
+
+  \return number of bytes in receive FIFO up to the last idle line
+
+  A frame is terminated by an idle line on Rx. Use e.g. for Modbus RTU or
+  other protocols which separate frames by a pause.
+*/
+uint8_t UART_FN(frameAvailable)(void) {
+
+  uint8_t   numAll, numFrame;
+
+  // read frame end before head. Both only advance, so frame end <= head
+  numFrame = (uint8_t) (UART_VAR(rxFrame) - UART_VAR(rxTail));
+  numAll   = (uint8_t) (UART_VAR(rxHead)  - UART_VAR(rxTail));
+
+  // frame end was already read by application (e.g. via <ID>_read())
+  if (numFrame > numAll)
+    return(0);
+
+  return(numFrame);
+
+} // <ID>_frameAvailable
+
+
+
+/**
+  \fn void <ID>_getStats(uart_stats_t *stats, uint8_t clear)
+
+  \brief get error and event counters
+
+  \param[out] stats   copy of counters
+  \param[in]  clear   reset counters after copy (0=keep, 1=reset)
+*/
+void UART_FN(getStats)(uart_stats_t *stats, uint8_t clear) {
+
+  // disable receive interrupts for consistent copy
+  THIS_SFR.CR2.RIEN  = 0;
+  THIS_SFR.CR2.ILIEN = 0;
+
+  // copy counters
+  stats->parity   = UART_VAR(stats).parity;
+  stats->framing  = UART_VAR(stats).framing;
+  stats->noise    = UART_VAR(stats).noise;
+  stats->overrun  = UART_VAR(stats).overrun;
+  stats->overflow = UART_VAR(stats).overflow;
+  stats->frames   = UART_VAR(stats).frames;
+
+  // optionally reset counters
+  if (clear) {
+    UART_VAR(stats).parity   = 0;
+    UART_VAR(stats).framing  = 0;
+    UART_VAR(stats).noise    = 0;
+    UART_VAR(stats).overrun  = 0;
+    UART_VAR(stats).overflow = 0;
+    UART_VAR(stats).frames   = 0;
+  }
+
+  // re-enable receive interrupts
+  THIS_SFR.CR2.RIEN  = 1;
+  THIS_SFR.CR2.ILIEN = 1;
+
+} // <ID>_getStats
+
+
+
+/**
+  \fn void <ID>_RXNE_ISR(void)
+
+  \brief ISR for UART receive, errors and idle line
+
+  interrupt service routine for UART receive
+
+  Actions:
+    - count parity, framing, noise and overrun errors
+    - copy received byte to FIFO. If FIFO is full, count overflow
+    - on idle line mark end of frame
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+    Cosmic: interrupt service table is defined in file "stm8_interrupt_vector.c"
+*/
+ISR_HANDLER(UART_FN(RXNE_ISR), UART_FN(RX_IRQ)) {
+
+  uint8_t   status, data;
+
+  // read status once. Flags are cleared by following DR read
+  status = UART_READ(THIS_SFR.SR.byte);
+
+  // count errors
+  if (status & UART_SR_PE)
+    UART_VAR(stats).parity++;
+  if (status & UART_SR_FE)
+    UART_VAR(stats).framing++;
+  if (status & UART_SR_NF)
+    UART_VAR(stats).noise++;
+  if (status & UART_SR_OR)
+    UART_VAR(stats).overrun++;
+
+  // read DR to clear flags. Store byte if received
+  data = UART_READ(THIS_SFR.DR.byte);
+  if (status & UART_SR_RXNE) {
+    if ((uint8_t) (UART_VAR(rxHead) - UART_VAR(rxTail)) >= THIS_RX_SIZE)
+      UART_VAR(stats).overflow++;
+    else {
+      UART_VAR(rxBuf)[UART_VAR(rxHead) & (THIS_RX_SIZE-1)] = data;
+      UART_VAR(rxHead)++;
+    }
+  }
+
+  // idle line terminates frame
+  if ((status & UART_SR_IDLE) && (UART_VAR(rxFrame) != UART_VAR(rxHead))) {
+    UART_VAR(rxFrame) = UART_VAR(rxHead);
+    UART_VAR(stats).frames++;
+  }
+
+} // <ID>_RXNE_ISR
+
+
+
+/**
+  \fn void <ID>_TXE_ISR(void)
+
+  \brief ISR for UART transmit
+
+  interrupt service routine for UART transmit
+
+  Actions:
+    - called if Tx HW buffer is empty
+    - move oldest byte from FIFO to Tx buffer
+    - if FIFO is empty, disable this interrupt
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+    Cosmic: interrupt service table is defined in file "stm8_interrupt_vector.c"
+*/
+ISR_HANDLER(UART_FN(TXE_ISR), UART_FN(TX_IRQ)) {
+
+  // send next byte
+  if (UART_VAR(txHead) != UART_VAR(txTail)) {
+    THIS_SFR.DR.byte = UART_VAR(txBuf)[UART_VAR(txTail) & (THIS_TX_SIZE-1)];
+    UART_VAR(txTail)++;
+  }
+
+  // FIFO empty -> disable Tx interrupt
+  if (UART_VAR(txHead) == UART_VAR(txTail))
+    THIS_SFR.CR2.TIEN = 0;
+
+} // <ID>_TXE_ISR
+
+
+/*----------------------------------------------------------
+    UNDEFINE LOCAL NAMES OF UART INSTANCE
+----------------------------------------------------------*/
+#undef UART_FN
+#undef UART_VAR
+#undef THIS_SFR
+#undef THIS_BAUD
+#undef THIS_RX_SIZE
+#undef THIS_TX_SIZE
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
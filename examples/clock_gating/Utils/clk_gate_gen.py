@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+
+"""
+Generate peripheral clock gate table for the clock gating driver from XML device descriptions
+
+Scans the XML device descriptions for peripheral modules and CLK_PCKENRx registers,
+and writes a C header with one block per group of devices with identical clock
+gates. The block is selected via the DEVICE_xxx macro defined in the device header.
+
+For each device group the following is defined:
+  - CLK_GATE_NUM_REG      number of CLK_PCKENRx registers
+  - CLK_GATE_REG<n>       register n (0-based), e.g. sfr_CLK.PCKENR1.byte
+  - CLK_GATE_MASK<n>      mask of all known gates in register n
+  - CLK_GATE_<module>     gate ID = 8*register + bit, e.g. CLK_GATE_TIM4
+
+Modules sharing one gate (e.g. TIM2 and TIM5) get the same ID. Families without
+known gate layout are skipped.
+
+usage: clk_gate_gen.py [-o clk_gates.h] [XML files or folder]
+"""
+
+import os
+import re
+import glob
+import argparse
+import xml.etree.ElementTree as ET
+
+
+# peripheral clock gates per family: module -> (register, bit). See reference manuals
+CLOCK_GATES = {
+  'STM8S': {
+    'I2C':     ('PCKENR1', 0),
+    'SPI':     ('PCKENR1', 1),
+    'UART2':   ('PCKENR1', 3),
+    'UART3':   ('PCKENR1', 3),
+    'TIM4':    ('PCKENR1', 4),
+    'TIM6':    ('PCKENR1', 4),
+    'TIM2':    ('PCKENR1', 5),
+    'TIM5':    ('PCKENR1', 5),
+    'TIM3':    ('PCKENR1', 6),
+    'TIM1':    ('PCKENR1', 7),
+    'AWU':     ('PCKENR2', 2),
+    'ADC':     ('PCKENR2', 3),
+    'ADC1':    ('PCKENR2', 3),
+    'ADC2':    ('PCKENR2', 3),
+    'CAN':     ('PCKENR2', 7),
+  },
+  'STM8L': {
+    'TIM2':    ('PCKENR1', 0),
+    'TIM3':    ('PCKENR1', 1),
+    'TIM4':    ('PCKENR1', 2),
+    'I2C1':    ('PCKENR1', 3),
+    'SPI1':    ('PCKENR1', 4),
+    'USART1':  ('PCKENR1', 5),
+    'BEEP':    ('PCKENR1', 6),
+    'DAC':     ('PCKENR1', 7),
+    'ADC1':    ('PCKENR2', 0),
+    'TIM1':    ('PCKENR2', 1),
+    'RTC':     ('PCKENR2', 2),
+    'LCD':     ('PCKENR2', 3),
+    'DMA1':    ('PCKENR2', 4),
+    'COMP':    ('PCKENR2', 5),
+    'COMP1_2': ('PCKENR2', 5),
+    'BOOTROM': ('PCKENR2', 7),
+    'AES':     ('PCKENR3', 0),
+    'TIM5':    ('PCKENR3', 1),
+    'SPI2':    ('PCKENR3', 2),
+    'USART2':  ('PCKENR3', 3),
+    'USART3':  ('PCKENR3', 4),
+  },
+  'STM8L101': {
+    'TIM2':    ('PCKENR',  0),
+    'TIM3':    ('PCKENR',  1),
+    'TIM4':    ('PCKENR',  2),
+    'I2C':     ('PCKENR',  3),
+    'SPI':     ('PCKENR',  4),
+    'USART':   ('PCKENR',  5),
+    'AWU':     ('PCKENR',  6),
+    'BEEP':    ('PCKENR',  6),
+  },
+  'STM8T': {
+    'TIM2':    ('PCKENR1', 0),
+    'TIM3':    ('PCKENR1', 1),
+    'TIM4':    ('PCKENR1', 2),
+    'I2C':     ('PCKENR1', 3),
+    'SPI':     ('PCKENR1', 4),
+    'USART':   ('PCKENR1', 5),
+    'AWU':     ('PCKENR1', 6),
+    'BEEP':    ('PCKENR1', 6),
+  },
+}
+
+# gates without own module in XML, added if register bit exists
+PSEUDO_MODULES = ('BOOTROM',)
+
+# UART type modules. On STM8S the gate depends on device, see gate_stm8s_uart()
+UART_NAME = re.compile(r'^(UART|USART|LINUART)\d?$')
+
+
+def device_macro(chipname):
+  """ name of DEVICE_xxx macro in device header """
+  return 'DEVICE_' + re.sub(r'[^A-Za-z0-9]', '_', chipname)
+
+
+def device_family(family):
+  """ map XML family description to FAMILY_xxx name """
+  if family.startswith('STM8L101'):
+    return 'STM8L101'
+  if family.startswith('STM8L'):
+    return 'STM8L'
+  if family.startswith('STM8S'):
+    return 'STM8S'
+  return family.split(',')[0]
+
+
+def gate_stm8s_uart(addr, uart_addrs):
+  """ STM8S: UART at 0x5230 uses bit 2 if a 2nd UART exists at 0x5240, else bit 3 """
+  if (addr == 0x5230) and (0x5240 in uart_addrs):
+    return ('PCKENR1', 2)
+  return ('PCKENR1', 3)
+
+
+def register_bits(clk):
+  """ return {register: mask of existing bits} for all CLK_PCKENRx registers """
+  regs = {}
+  for r in clk.iter('register'):
+    name = r.get('name')
+    if not name.startswith('PCKENR'):
+      continue
+    mask = 0
+    for b in r.iter('bitfield'):
+      bits = [int(x) for x in b.get('bits').split('-')]
+      for i in range(bits[0], bits[-1] + 1):
+        mask |= (1 << i)
+    regs[name] = mask
+  return regs
+
+
+def parse_device(filename):
+  """ return (device macro, gate configuration) for one XML file, or None if not supported """
+
+  root = ET.parse(filename).getroot()
+  chip = root.get('chipname')
+  family = device_family(root.findtext('family', ''))
+  table = CLOCK_GATES.get(family)
+  if table is None:
+    return device_macro(chip), None
+
+  # CLK gating registers and existing bits
+  clk = [m for m in root.iter('module') if m.get('name') == 'CLK']
+  regs = register_bits(clk[0]) if clk else {}
+  if len(regs) == 0:
+    return device_macro(chip), None
+  names = sorted(regs)
+
+  # collect modules and UART addresses
+  modules = {}
+  for m in root.iter('module'):
+    sfr = m.find('SFR')
+    modules[m.get('name')] = int(sfr.get('address'), 16) if sfr is not None else None
+  uart_addrs = set(a for n, a in modules.items() if UART_NAME.match(n))
+  for p in PSEUDO_MODULES:
+    modules.setdefault(p, None)
+
+  # assign gates. Skip gates whose register or bit does not exist
+  gates = []
+  for name in sorted(modules):
+    if (family == 'STM8S') and UART_NAME.match(name):
+      gate = gate_stm8s_uart(modules[name], uart_addrs)
+    else:
+      gate = table.get(name)
+    if (gate is None) or (gate[0] not in regs) or (not (regs[gate[0]] & (1 << gate[1]))):
+      continue
+    gates.append((name, names.index(gate[0]) * 8 + gate[1], gate[0], gate[1]))
+
+  return device_macro(chip), (tuple(names), tuple(gates))
+
+
+def write_header(out, groups):
+  """ write C header with one block per group of devices """
+
+  out.write('''/**
+  \\file clk_gates.h
+
+  \\brief peripheral clock gates of all supported devices
+
+  CLK_PCKENRx registers and peripheral clock gate IDs of all devices with known
+  gate layout. Gate ID is 8*register + bit.
+
+  \\note
+  - this file is generated by Utils/clk_gate_gen.py from the XML device descriptions.
+    Do not edit, but re-generate after changes to the XML files
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CLK_GATES_H_
+#define _CLK_GATES_H_
+
+''')
+
+  first = True
+  for (regs, gates), devices in groups:
+    cond = ' || \\\n    '.join('defined(%s)' % d for d in sorted(devices))
+    out.write('%s %s\n' % ('#if' if first else '#elif', cond))
+    first = False
+    out.write('  #define %-28s %d\n' % ('CLK_GATE_NUM_REG', len(regs)))
+    for i, r in enumerate(regs):
+      mask = 0
+      for g in gates:
+        if g[2] == r:
+          mask |= (1 << g[3])
+      out.write('  #define %-28s sfr_CLK.%s.byte\n' % ('CLK_GATE_REG%d' % i, r))
+      out.write('  #define %-28s 0x%02x\n' % ('CLK_GATE_MASK%d' % i, mask))
+    for (name, gid, reg, bit) in gates:
+      out.write('  #define %-28s %-4d // %s bit %d\n' % ('CLK_GATE_' + name, gid, reg, bit))
+    out.write('\n')
+  out.write('''#else
+  #error device not supported, re-generate with Utils/clk_gate_gen.py
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CLK_GATES_H_
+''')
+
+
+if __name__ == "__main__":
+
+  parser = argparse.ArgumentParser(description='generate peripheral clock gate table from XML device descriptions')
+  parser.add_argument('-o', '--output', default='clk_gates.h', help='output header')
+  parser.add_argument('xml', nargs='*', default=[os.path.join(os.path.dirname(__file__), '../../../XML')],
+                      help='XML files or folder (default: repository XML folder)')
+  args = parser.parse_args()
+
+  # collect XML files
+  files = []
+  for x in args.xml:
+    files += sorted(glob.glob(os.path.join(x, '*.xml'))) if os.path.isdir(x) else [x]
+
+  # group devices with identical gate configuration. Skip unsupported devices
+  groups = {}
+  skipped = 0
+  for f in files:
+    dev, config = parse_device(f)
+    if config is None:
+      skipped += 1
+      continue
+    groups.setdefault(config, []).append(dev)
+
+  # sort groups by first device for stable output
+  groups = sorted(groups.items(), key=lambda g: sorted(g[1])[0])
+  with open(args.output, 'w') as out:
+    write_header(out, groups)
+
+  print("wrote %d devices in %d groups to '%s', skipped %d" % (len(files) - skipped, len(groups), args.output, skipped))
@@ -0,0 +1,161 @@
+/**
+  \file clk_gate.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of peripheral clock gating via reference counts
+
+  implementation of a peripheral clock gating framework. Each CLK_PCKENRx bit
+  has a reference count, the bit is set while the count is >0.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "clk_gate.h"
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// reference count per gate ID
+static uint8_t    m_users[CLK_GATE_NUM];
+
+
+
+/**
+  \fn void CLK_setGate(uint8_t gate, uint8_t enable)
+
+  \brief enable or disable peripheral clock
+
+  \param[in]  gate      gate ID, see clk_gates.h
+  \param[in]  enable    enable(=1) or disable(=0) clock
+*/
+static void CLK_setGate(uint8_t gate, uint8_t enable) {
+
+  uint8_t   mask = (uint8_t) (1 << (gate & 0x07));
+
+  switch (gate >> 3) {
+    case 0:
+      if (enable) CLK_GATE_REG0 |= mask; else CLK_GATE_REG0 &= (uint8_t) ~mask;
+      break;
+    #if (CLK_GATE_NUM_REG > 1)
+    case 1:
+      if (enable) CLK_GATE_REG1 |= mask; else CLK_GATE_REG1 &= (uint8_t) ~mask;
+      break;
+    #endif
+    #if (CLK_GATE_NUM_REG > 2)
+    case 2:
+      if (enable) CLK_GATE_REG2 |= mask; else CLK_GATE_REG2 &= (uint8_t) ~mask;
+      break;
+    #endif
+    default:
+      break;
+  }
+
+} // CLK_setGate
+
+
+
+/**
+  \fn void CLK_gateBegin(void)
+
+  \brief reset reference counts and gate all known peripheral clocks
+
+  disable all peripheral clocks listed in clk_gates.h. Unknown or reserved
+  bits are not changed. Call before initializing drivers.
+*/
+void CLK_gateBegin(void) {
+
+  uint8_t   i;
+
+  // reset reference counts
+  for (i=0; i<CLK_GATE_NUM; i++)
+    m_users[i] = 0;
+
+  // disable all known clocks
+  CLK_GATE_REG0 &= (uint8_t) ~CLK_GATE_MASK0;
+  #if (CLK_GATE_NUM_REG > 1)
+    CLK_GATE_REG1 &= (uint8_t) ~CLK_GATE_MASK1;
+  #endif
+  #if (CLK_GATE_NUM_REG > 2)
+    CLK_GATE_REG2 &= (uint8_t) ~CLK_GATE_MASK2;
+  #endif
+
+} // CLK_gateBegin
+
+
+
+/**
+  \fn void CLK_acquire(uint8_t gate)
+
+  \brief acquire peripheral clock
+
+  \param[in]  gate      gate ID, see clk_gates.h
+
+  increase reference count. First call enables the clock. Call before accessing
+  the peripheral registers, e.g. in driver init. Not reentrant, see clk_gate.h
+*/
+void CLK_acquire(uint8_t gate) {
+
+  // invalid gate
+  if (gate >= CLK_GATE_NUM)
+    return;
+
+  // first user -> enable clock
+  if (m_users[gate]++ == 0)
+    CLK_setGate(gate, 1);
+
+} // CLK_acquire
+
+
+
+/**
+  \fn void CLK_release(uint8_t gate)
+
+  \brief release peripheral clock
+
+  \param[in]  gate      gate ID, see clk_gates.h
+
+  decrease reference count. Last call disables the clock. Peripheral must be
+  idle, e.g. UART transmission finished. Not reentrant, see clk_gate.h
+*/
+void CLK_release(uint8_t gate) {
+
+  // invalid or unused gate
+  if ((gate >= CLK_GATE_NUM) || (m_users[gate] == 0))
+    return;
+
+  // last user -> disable clock
+  if (--m_users[gate] == 0)
+    CLK_setGate(gate, 0);
+
+} // CLK_release
+
+
+
+/**
+  \fn uint8_t CLK_users(uint8_t gate)
+
+  \brief get number of users of peripheral clock
+
+  \param[in]  gate      gate ID, see clk_gates.h
+
+  \return reference count of gate
+*/
+uint8_t CLK_users(uint8_t gate) {
+
+  if (gate >= CLK_GATE_NUM)
+    return(0);
+  return(m_users[gate]);
+
+} // CLK_users
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,67 @@
+/**
+  \file clk_gate.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of peripheral clock gating via reference counts
+
+  declaration of a peripheral clock gating framework. Drivers acquire their
+  peripheral clock on open, e.g. CLK_acquire(CLK_GATE_TIM4), and release it on
+  close. The CLK_PCKENRx bit is set by the first acquire and cleared by the last
+  release, i.e. peripherals sharing one gate (e.g. TIM2/TIM5 on STM8S) or used
+  by several drivers are handled correctly. CLK_gateBegin() gates all known
+  peripheral clocks, which are enabled after reset on most devices.
+
+  \note
+  - gate IDs CLK_GATE_<module> are listed in clk_gates.h, which is generated
+    from the XML device descriptions by Utils/clk_gate_gen.py
+  - acquire/release are not reentrant. If a gate is also used from an ISR, call
+    them with interrupts disabled
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CLK_GATE_H_
+#define _CLK_GATE_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "clk_gates.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+/// number of gate IDs
+#define CLK_GATE_NUM        (CLK_GATE_NUM_REG * 8)
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// reset reference counts and gate all known peripheral clocks
+void CLK_gateBegin(void);
+
+/// acquire peripheral clock. First call enables clock
+void CLK_acquire(uint8_t gate);
+
+/// release peripheral clock. Last call disables clock
+void CLK_release(uint8_t gate);
+
+/// get number of users of peripheral clock
+uint8_t CLK_users(uint8_t gate);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CLK_GATE_H_
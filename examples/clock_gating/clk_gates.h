@@ -0,0 +1,546 @@
+/**
+  \file clk_gates.h
+
+  \brief peripheral clock gates of all supported devices
+
+  CLK_PCKENRx registers and peripheral clock gate IDs of all devices with known
+  gate layout. Gate ID is 8*register + bit.
+
+  \note
+  - this file is generated by Utils/clk_gate_gen.py from the XML device descriptions.
+    Do not edit, but re-generate after changes to the XML files
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CLK_GATES_H_
+#define _CLK_GATES_H_
+
+#if defined(DEVICE_STM8AF5168) || \
+    defined(DEVICE_STM8AF5169) || \
+    defined(DEVICE_STM8AF5178) || \
+    defined(DEVICE_STM8AF5179) || \
+    defined(DEVICE_STM8AF5188) || \
+    defined(DEVICE_STM8AF5189) || \
+    defined(DEVICE_STM8AF518A) || \
+    defined(DEVICE_STM8AF5198) || \
+    defined(DEVICE_STM8AF5199) || \
+    defined(DEVICE_STM8AF519A) || \
+    defined(DEVICE_STM8AF51A8) || \
+    defined(DEVICE_STM8AF51A9) || \
+    defined(DEVICE_STM8AF51AA) || \
+    defined(DEVICE_STM8AF5268) || \
+    defined(DEVICE_STM8AF5269) || \
+    defined(DEVICE_STM8AF5286) || \
+    defined(DEVICE_STM8AF5288) || \
+    defined(DEVICE_STM8AF5289) || \
+    defined(DEVICE_STM8AF528A) || \
+    defined(DEVICE_STM8AF52A6) || \
+    defined(DEVICE_STM8AF52A8) || \
+    defined(DEVICE_STM8AF52A9) || \
+    defined(DEVICE_STM8AF52AA)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x8c
+  #define CLK_GATE_ADC                 11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_CAN                 15   // PCKENR2 bit 7
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_LINUART             3    // PCKENR1 bit 3
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM2                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM3                6    // PCKENR1 bit 6
+  #define CLK_GATE_TIM4                4    // PCKENR1 bit 4
+  #define CLK_GATE_USART               2    // PCKENR1 bit 2
+
+#elif defined(DEVICE_STM8AF6126) || \
+    defined(DEVICE_STM8AF6146) || \
+    defined(DEVICE_STM8AF6148) || \
+    defined(DEVICE_STM8AF6166) || \
+    defined(DEVICE_STM8AF6168) || \
+    defined(DEVICE_STM8AF6176) || \
+    defined(DEVICE_STM8AF6186) || \
+    defined(DEVICE_STM8AF6246) || \
+    defined(DEVICE_STM8AF6248) || \
+    defined(DEVICE_STM8AF6266) || \
+    defined(DEVICE_STM8AF6268) || \
+    defined(DEVICE_STM8AF6286) || \
+    defined(DEVICE_STM8AF62A6)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xfb
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x0c
+  #define CLK_GATE_ADC                 11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_LINUART             3    // PCKENR1 bit 3
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM2                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM3                6    // PCKENR1 bit 6
+  #define CLK_GATE_TIM4                4    // PCKENR1 bit 4
+
+#elif defined(DEVICE_STM8AF6169) || \
+    defined(DEVICE_STM8AF6178) || \
+    defined(DEVICE_STM8AF6179) || \
+    defined(DEVICE_STM8AF6188) || \
+    defined(DEVICE_STM8AF6189) || \
+    defined(DEVICE_STM8AF618A) || \
+    defined(DEVICE_STM8AF6198) || \
+    defined(DEVICE_STM8AF6199) || \
+    defined(DEVICE_STM8AF619A) || \
+    defined(DEVICE_STM8AF61A8) || \
+    defined(DEVICE_STM8AF61A9) || \
+    defined(DEVICE_STM8AF61AA) || \
+    defined(DEVICE_STM8AF6269) || \
+    defined(DEVICE_STM8AF6288) || \
+    defined(DEVICE_STM8AF6289) || \
+    defined(DEVICE_STM8AF628A) || \
+    defined(DEVICE_STM8AF62A8) || \
+    defined(DEVICE_STM8AF62A9) || \
+    defined(DEVICE_STM8AF62AA)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x0c
+  #define CLK_GATE_ADC                 11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_LINUART             3    // PCKENR1 bit 3
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM2                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM3                6    // PCKENR1 bit 6
+  #define CLK_GATE_TIM4                4    // PCKENR1 bit 4
+  #define CLK_GATE_USART               2    // PCKENR1 bit 2
+
+#elif defined(DEVICE_STM8AF6213) || \
+    defined(DEVICE_STM8AF6223) || \
+    defined(DEVICE_STM8AF6223A) || \
+    defined(DEVICE_STM8AF6226)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xbb
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x0c
+  #define CLK_GATE_ADC                 11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_LINUART             3    // PCKENR1 bit 3
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM5                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM6                4    // PCKENR1 bit 4
+
+#elif defined(DEVICE_STM8AL3136) || \
+    defined(DEVICE_STM8AL3138) || \
+    defined(DEVICE_STM8AL3146) || \
+    defined(DEVICE_STM8AL3148) || \
+    defined(DEVICE_STM8AL3166) || \
+    defined(DEVICE_STM8AL3168) || \
+    defined(DEVICE_STM8L151C4) || \
+    defined(DEVICE_STM8L151C6) || \
+    defined(DEVICE_STM8L151G4) || \
+    defined(DEVICE_STM8L151G6) || \
+    defined(DEVICE_STM8L151K4) || \
+    defined(DEVICE_STM8L151K6)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0xb7
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_COMP                13   // PCKENR2 bit 5
+  #define CLK_GATE_DAC                 7    // PCKENR1 bit 7
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_TIM1                9    // PCKENR2 bit 1
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+
+#elif defined(DEVICE_STM8AL3188) || \
+    defined(DEVICE_STM8AL3189) || \
+    defined(DEVICE_STM8AL318A) || \
+    defined(DEVICE_STM8L151C8) || \
+    defined(DEVICE_STM8L151M8) || \
+    defined(DEVICE_STM8L151R6) || \
+    defined(DEVICE_STM8L151R8)
+  #define CLK_GATE_NUM_REG             3
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0xb7
+  #define CLK_GATE_REG2                sfr_CLK.PCKENR3.byte
+  #define CLK_GATE_MASK2               0x1e
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_COMP1_2             13   // PCKENR2 bit 5
+  #define CLK_GATE_DAC                 7    // PCKENR1 bit 7
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_SPI2                18   // PCKENR3 bit 2
+  #define CLK_GATE_TIM1                9    // PCKENR2 bit 1
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_TIM5                17   // PCKENR3 bit 1
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+  #define CLK_GATE_USART2              19   // PCKENR3 bit 3
+  #define CLK_GATE_USART3              20   // PCKENR3 bit 4
+
+#elif defined(DEVICE_STM8AL31E88) || \
+    defined(DEVICE_STM8AL31E89) || \
+    defined(DEVICE_STM8AL31E8A)
+  #define CLK_GATE_NUM_REG             3
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0xb7
+  #define CLK_GATE_REG2                sfr_CLK.PCKENR3.byte
+  #define CLK_GATE_MASK2               0x1f
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_AES                 16   // PCKENR3 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_COMP1_2             13   // PCKENR2 bit 5
+  #define CLK_GATE_DAC                 7    // PCKENR1 bit 7
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_SPI2                18   // PCKENR3 bit 2
+  #define CLK_GATE_TIM1                9    // PCKENR2 bit 1
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_TIM5                17   // PCKENR3 bit 1
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+  #define CLK_GATE_USART2              19   // PCKENR3 bit 3
+  #define CLK_GATE_USART3              20   // PCKENR3 bit 4
+
+#elif defined(DEVICE_STM8AL3L46) || \
+    defined(DEVICE_STM8AL3L48) || \
+    defined(DEVICE_STM8AL3L66) || \
+    defined(DEVICE_STM8AL3L68) || \
+    defined(DEVICE_STM8L052C6) || \
+    defined(DEVICE_STM8L152C4) || \
+    defined(DEVICE_STM8L152C6) || \
+    defined(DEVICE_STM8L152K4) || \
+    defined(DEVICE_STM8L152K6)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0xbf
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_COMP                13   // PCKENR2 bit 5
+  #define CLK_GATE_DAC                 7    // PCKENR1 bit 7
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_LCD                 11   // PCKENR2 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_TIM1                9    // PCKENR2 bit 1
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+
+#elif defined(DEVICE_STM8AL3L88) || \
+    defined(DEVICE_STM8AL3L89) || \
+    defined(DEVICE_STM8AL3L8A) || \
+    defined(DEVICE_STM8L052R8) || \
+    defined(DEVICE_STM8L152C8) || \
+    defined(DEVICE_STM8L152M8) || \
+    defined(DEVICE_STM8L152R6) || \
+    defined(DEVICE_STM8L152R8)
+  #define CLK_GATE_NUM_REG             3
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0xbf
+  #define CLK_GATE_REG2                sfr_CLK.PCKENR3.byte
+  #define CLK_GATE_MASK2               0x1e
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_COMP1_2             13   // PCKENR2 bit 5
+  #define CLK_GATE_DAC                 7    // PCKENR1 bit 7
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_LCD                 11   // PCKENR2 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_SPI2                18   // PCKENR3 bit 2
+  #define CLK_GATE_TIM1                9    // PCKENR2 bit 1
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_TIM5                17   // PCKENR3 bit 1
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+  #define CLK_GATE_USART2              19   // PCKENR3 bit 3
+  #define CLK_GATE_USART3              20   // PCKENR3 bit 4
+
+#elif defined(DEVICE_STM8AL3LE88) || \
+    defined(DEVICE_STM8AL3LE89) || \
+    defined(DEVICE_STM8AL3LE8A) || \
+    defined(DEVICE_STM8L162M8) || \
+    defined(DEVICE_STM8L162R8)
+  #define CLK_GATE_NUM_REG             3
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0xbf
+  #define CLK_GATE_REG2                sfr_CLK.PCKENR3.byte
+  #define CLK_GATE_MASK2               0x1f
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_AES                 16   // PCKENR3 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_COMP1_2             13   // PCKENR2 bit 5
+  #define CLK_GATE_DAC                 7    // PCKENR1 bit 7
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_LCD                 11   // PCKENR2 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_SPI2                18   // PCKENR3 bit 2
+  #define CLK_GATE_TIM1                9    // PCKENR2 bit 1
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_TIM5                17   // PCKENR3 bit 1
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+  #define CLK_GATE_USART2              19   // PCKENR3 bit 3
+  #define CLK_GATE_USART3              20   // PCKENR3 bit 4
+
+#elif defined(DEVICE_STM8L001J3) || \
+    defined(DEVICE_STM8L101F1) || \
+    defined(DEVICE_STM8L101F2) || \
+    defined(DEVICE_STM8L101F3) || \
+    defined(DEVICE_STM8L101G2) || \
+    defined(DEVICE_STM8L101G3) || \
+    defined(DEVICE_STM8L101K3)
+  #define CLK_GATE_NUM_REG             1
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR.byte
+  #define CLK_GATE_MASK0               0x7f
+  #define CLK_GATE_AWU                 6    // PCKENR bit 6
+  #define CLK_GATE_BEEP                6    // PCKENR bit 6
+  #define CLK_GATE_I2C                 3    // PCKENR bit 3
+  #define CLK_GATE_SPI                 4    // PCKENR bit 4
+  #define CLK_GATE_TIM2                0    // PCKENR bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR bit 2
+  #define CLK_GATE_USART               5    // PCKENR bit 5
+
+#elif defined(DEVICE_STM8L050J3) || \
+    defined(DEVICE_STM8L151C2) || \
+    defined(DEVICE_STM8L151C3) || \
+    defined(DEVICE_STM8L151F2) || \
+    defined(DEVICE_STM8L151F3) || \
+    defined(DEVICE_STM8L151G2) || \
+    defined(DEVICE_STM8L151G3) || \
+    defined(DEVICE_STM8L151K2) || \
+    defined(DEVICE_STM8L151K3)
+  #define CLK_GATE_NUM_REG             3
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0x7f
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0xb5
+  #define CLK_GATE_REG2                sfr_CLK.PCKENR3.byte
+  #define CLK_GATE_MASK2               0x00
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_COMP                13   // PCKENR2 bit 5
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+
+#elif defined(DEVICE_STM8L051F3)
+  #define CLK_GATE_NUM_REG             3
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0x7f
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x95
+  #define CLK_GATE_REG2                sfr_CLK.PCKENR3.byte
+  #define CLK_GATE_MASK2               0x00
+  #define CLK_GATE_ADC1                8    // PCKENR2 bit 0
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_BOOTROM             15   // PCKENR2 bit 7
+  #define CLK_GATE_DMA1                12   // PCKENR2 bit 4
+  #define CLK_GATE_I2C1                3    // PCKENR1 bit 3
+  #define CLK_GATE_RTC                 10   // PCKENR2 bit 2
+  #define CLK_GATE_SPI1                4    // PCKENR1 bit 4
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_USART1              5    // PCKENR1 bit 5
+
+#elif defined(DEVICE_STM8S001J3) || \
+    defined(DEVICE_STM8S003F3) || \
+    defined(DEVICE_STM8S003K3) || \
+    defined(DEVICE_STM8S103F2) || \
+    defined(DEVICE_STM8S103F3) || \
+    defined(DEVICE_STM8S103K3)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xbb
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x0c
+  #define CLK_GATE_ADC1                11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM2                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM4                4    // PCKENR1 bit 4
+  #define CLK_GATE_UART1               3    // PCKENR1 bit 3
+
+#elif defined(DEVICE_STM8S005C6) || \
+    defined(DEVICE_STM8S005K6) || \
+    defined(DEVICE_STM8S105C4) || \
+    defined(DEVICE_STM8S105C6) || \
+    defined(DEVICE_STM8S105K4) || \
+    defined(DEVICE_STM8S105K6) || \
+    defined(DEVICE_STM8S105S4) || \
+    defined(DEVICE_STM8S105S6)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xfb
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x0c
+  #define CLK_GATE_ADC1                11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM2                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM3                6    // PCKENR1 bit 6
+  #define CLK_GATE_TIM4                4    // PCKENR1 bit 4
+  #define CLK_GATE_UART2               3    // PCKENR1 bit 3
+
+#elif defined(DEVICE_STM8S007C8) || \
+    defined(DEVICE_STM8S207C6) || \
+    defined(DEVICE_STM8S207C8) || \
+    defined(DEVICE_STM8S207CB) || \
+    defined(DEVICE_STM8S207K6) || \
+    defined(DEVICE_STM8S207K8) || \
+    defined(DEVICE_STM8S207M8) || \
+    defined(DEVICE_STM8S207MB) || \
+    defined(DEVICE_STM8S207R6) || \
+    defined(DEVICE_STM8S207R8) || \
+    defined(DEVICE_STM8S207RB) || \
+    defined(DEVICE_STM8S207S6) || \
+    defined(DEVICE_STM8S207S8) || \
+    defined(DEVICE_STM8S207SB)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x0c
+  #define CLK_GATE_ADC2                11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM2                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM3                6    // PCKENR1 bit 6
+  #define CLK_GATE_TIM4                4    // PCKENR1 bit 4
+  #define CLK_GATE_UART1               2    // PCKENR1 bit 2
+  #define CLK_GATE_UART3               3    // PCKENR1 bit 3
+
+#elif defined(DEVICE_STM8S208C6) || \
+    defined(DEVICE_STM8S208C8) || \
+    defined(DEVICE_STM8S208CB) || \
+    defined(DEVICE_STM8S208M8) || \
+    defined(DEVICE_STM8S208MB) || \
+    defined(DEVICE_STM8S208R6) || \
+    defined(DEVICE_STM8S208R8) || \
+    defined(DEVICE_STM8S208RB) || \
+    defined(DEVICE_STM8S208S6) || \
+    defined(DEVICE_STM8S208S8) || \
+    defined(DEVICE_STM8S208SB)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xff
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x8c
+  #define CLK_GATE_ADC2                11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_CAN                 15   // PCKENR2 bit 7
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM2                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM3                6    // PCKENR1 bit 6
+  #define CLK_GATE_TIM4                4    // PCKENR1 bit 4
+  #define CLK_GATE_UART1               2    // PCKENR1 bit 2
+  #define CLK_GATE_UART3               3    // PCKENR1 bit 3
+
+#elif defined(DEVICE_STM8S903F3) || \
+    defined(DEVICE_STM8S903K3)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0xbb
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x0c
+  #define CLK_GATE_ADC                 11   // PCKENR2 bit 3
+  #define CLK_GATE_AWU                 10   // PCKENR2 bit 2
+  #define CLK_GATE_I2C                 0    // PCKENR1 bit 0
+  #define CLK_GATE_SPI                 1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM1                7    // PCKENR1 bit 7
+  #define CLK_GATE_TIM5                5    // PCKENR1 bit 5
+  #define CLK_GATE_TIM6                4    // PCKENR1 bit 4
+  #define CLK_GATE_UART1               3    // PCKENR1 bit 3
+
+#elif defined(DEVICE_STM8TL52F4) || \
+    defined(DEVICE_STM8TL52G4) || \
+    defined(DEVICE_STM8TL53C4) || \
+    defined(DEVICE_STM8TL53F4) || \
+    defined(DEVICE_STM8TL53G4)
+  #define CLK_GATE_NUM_REG             2
+  #define CLK_GATE_REG0                sfr_CLK.PCKENR1.byte
+  #define CLK_GATE_MASK0               0x7f
+  #define CLK_GATE_REG1                sfr_CLK.PCKENR2.byte
+  #define CLK_GATE_MASK1               0x00
+  #define CLK_GATE_AWU                 6    // PCKENR1 bit 6
+  #define CLK_GATE_BEEP                6    // PCKENR1 bit 6
+  #define CLK_GATE_I2C                 3    // PCKENR1 bit 3
+  #define CLK_GATE_SPI                 4    // PCKENR1 bit 4
+  #define CLK_GATE_TIM2                0    // PCKENR1 bit 0
+  #define CLK_GATE_TIM3                1    // PCKENR1 bit 1
+  #define CLK_GATE_TIM4                2    // PCKENR1 bit 2
+  #define CLK_GATE_USART               5    // PCKENR1 bit 5
+
+#else
+  #error device not supported, re-generate with Utils/clk_gate_gen.py
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CLK_GATES_H_
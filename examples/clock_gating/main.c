@@ -0,0 +1,111 @@
+/**********************
+  Peripheral clock gating via driver reference counts
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - gate all known peripheral clocks after reset
+    - TIM4 (1ms) acquires its clock permanently
+    - every 1s open UART, print CLK_PCKENRx and reference counts, close UART.
+      In between the UART clock is off
+    - gate table clk_gates.h is generated by Utils/clk_gate_gen.py from XML
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "clk_gate.h"
+  #include "timer4.h"
+  #include "uart.h"
+#undef _MAIN_
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint32_t  nextPrint = 0;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch fMaster prescaler to 1 (default is 8)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // gate all known peripheral clocks
+  CLK_gateBegin();
+
+  // configure LED pin as output
+  LED_PORT.DDR.byte |= LED_PIN;     // input(=0) or output(=1)
+  LED_PORT.CR1.byte |= LED_PIN;     // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+
+  // init 1ms clock. Acquires TIM4 clock
+  TIM4_init();
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // every 1s print clock gating status
+    if (millis() >= nextPrint) {
+      nextPrint += 1000;
+
+      // open UART (acquire clock), print status, close UART (release clock)
+      UART_begin(19200);
+      printf("%lums: PCKENR1 0x%02x, PCKENR2 0x%02x, users TIM4 %d, UART %d\n", (unsigned long) millis(),
+        (int) sfr_CLK.PCKENR1.byte, (int) sfr_CLK.PCKENR2.byte, (int) CLK_users(CLK_GATE_TIM4), (int) CLK_users(UART_GATE));
+      UART_end();
+
+      // toggle LED
+      LED_PORT.ODR.byte ^= LED_PIN;
+
+    } // 1s task
+
+    // wait for next interrupt
+    WAIT_FOR_INTERRUPT();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,99 @@
+/**
+  \file uart.c
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief implementation of UART functions/macros with clock gating
+   
+  implementation of blocking UART transmission. UART clock is acquired in
+  UART_begin() and released in UART_end().
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "uart.h"
+#include "clk_gate.h"
+
+
+
+/**
+  \fn void UART_begin(uint32_t BR)
+   
+  \brief acquire UART clock and initialize for transmission
+  
+  \param[in]  BR    baudrate [Baud]
+
+  acquire UART clock and initialize for transmission with specified baudrate.
+  Use 1 start, 8 data and 1 stop bit; no parity or flow control.
+*/
+void UART_begin(uint32_t BR) {
+
+  uint16_t  val16;
+
+  // acquire UART clock
+  CLK_acquire(UART_GATE);
+
+  // set UART behaviour
+  sfr_UART.CR1.byte = 0x00;   // enable UART, 8 data bits, no parity control
+  sfr_UART.CR2.byte = 0x00;   // no interrupts, disable sender/receiver
+  sfr_UART.CR3.byte = 0x00;   // 1 stop bit, no clock output
+
+  // set baudrate for fMaster=16MHz (note: BRR2 must be written before BRR1!)
+  val16 = (uint16_t) ((16000000L + BR/2) / BR);
+  sfr_UART.BRR2.byte = (uint8_t) (((val16 & 0xF000) >> 8) | (val16 & 0x000F));
+  sfr_UART.BRR1.byte = (uint8_t) ((val16 & 0x0FF0) >> 4);
+
+  // enable sender
+  sfr_UART.CR2.TEN = 1;
+
+} // UART_begin
+
+
+
+/**
+  \fn void UART_end(void)
+   
+  \brief disable UART and release clock
+  
+  wait until last byte is sent, then disable sender and release UART clock
+*/
+void UART_end(void) {
+
+  // wait until last byte is sent
+  while (!(sfr_UART.SR.TC));
+
+  // disable sender and release clock
+  sfr_UART.CR2.TEN = 0;
+  CLK_release(UART_GATE);
+
+} // UART_end
+
+
+
+/**
+  \fn void UART_write(uint8_t data)
+   
+  \brief send byte
+  
+  \param[in]  data    byte to send
+
+  send byte via UART. Wait until transmit register is empty
+*/
+void UART_write(uint8_t data) {
+
+  // wait until transmit register is empty
+  while (!(sfr_UART.SR.TXE));
+
+  // send byte
+  sfr_UART.DR.byte = data;
+
+} // UART_write
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,63 @@
+/**
+  \file uart.h
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief declaration of UART functions/macros with clock gating
+   
+  declaration of blocking UART transmission. UART clock is acquired in
+  UART_begin() and released in UART_end().
+
+  \note requires fMaster=16MHz
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_H_
+#define _UART_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// select UART instance and clock gate. STM8L: USART1, STM8S: UART2
+#if defined(sfr_USART1)
+  #define sfr_UART          sfr_USART1
+  #define UART_GATE         CLK_GATE_USART1
+#elif defined(sfr_UART2)
+  #define sfr_UART          sfr_UART2
+  #define UART_GATE         CLK_GATE_UART2
+#else
+  #error UART not defined
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// acquire UART clock and initialize for transmission
+void UART_begin(uint32_t BR);
+
+/// wait until transmission finished, disable UART and release clock
+void UART_end(void);
+
+/// send byte (blocking)
+void UART_write(uint8_t data);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_H_
@@ -0,0 +1,323 @@
+/**
+  \file clock_mgr.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of clock tree manager
+
+  implementation of a clock manager which switches clock source and prescaler
+  via the CLK_SWITCH interrupt, and notifies registered drivers of the change.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "clock_mgr.h"
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// registered driver callbacks
+static clock_notifier_t   m_notifier[CLOCK_MAX_NOTIFIERS];
+
+/// number of registered callbacks
+static uint8_t            m_numNotifiers;
+
+/// prescaler exponent to set after pending switch
+static volatile uint8_t   m_pendingDiv;
+
+/// clock switch pending
+static volatile uint8_t   m_busy;
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void clock_notify(uint8_t event, uint32_t fMaster)
+
+  \brief call all registered notifiers
+
+  \param[in] event      CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+  \param[in] fMaster    master clock [Hz] before (pre) or after (post) change
+*/
+static void clock_notify(uint8_t event, uint32_t fMaster)
+{
+  uint8_t   i;
+
+  for (i=0; i<m_numNotifiers; i++)
+    m_notifier[i](event, fMaster);
+
+} // clock_notify
+
+
+
+/**
+  \fn void clock_update(void)
+
+  \brief calculate master and CPU clock from current clock registers
+*/
+static void clock_update(void)
+{
+  uint32_t  f;
+
+  // frequency of active clock source
+  switch (clock_get())
+  {
+    case CLK_HSE: f = F_HSE; break;
+    case CLK_LSI: f = F_LSI; break;
+    #if defined(FAMILY_STM8L)
+      case CLK_LSE: f = F_LSE; break;
+    #endif
+    default:      f = F_HSI; break;
+  }
+
+  // STM8S: HSI prescaler only applies to HSI, CPU prescaler to fCPU
+  #if defined(FAMILY_STM8S)
+    if (clock_get() == CLK_HSI)
+      f >>= sfr_CLK.CKDIVR.HSIDIV;
+    g_fMaster = f;
+    g_fCPU    = f >> sfr_CLK.CKDIVR.CPUDIV;
+
+  // STM8L: system clock prescaler applies to all sources, fCPU = fMaster
+  #else
+    f >>= (sfr_CLK.CKDIVR.byte & 0x07);
+    g_fMaster = f;
+    g_fCPU    = f;
+  #endif
+
+} // clock_update
+
+
+
+/**
+  \fn void clock_setDiv(uint8_t div)
+
+  \brief set master clock prescaler
+
+  \param[in] div        prescaler exponent, i.e. fMaster = fSource / 2^div
+*/
+static void clock_setDiv(uint8_t div)
+{
+  #if defined(FAMILY_STM8S)
+    if (clock_get() == CLK_HSI)
+      sfr_CLK.CKDIVR.HSIDIV = div;
+  #else
+    sfr_CLK.CKDIVR.byte = div;
+  #endif
+
+} // clock_setDiv
+
+
+
+/**
+  \fn void clock_begin(void)
+
+  \brief init clock manager from current clock setting
+
+  clear notifier list and calculate g_fMaster and g_fCPU from current registers.
+  Call after initial clock setup and before clock_attach()
+*/
+void clock_begin(void)
+{
+  m_numNotifiers = 0;
+  m_busy = 0;
+  clock_update();
+
+} // clock_begin
+
+
+
+/**
+  \fn uint8_t clock_attach(clock_notifier_t notifier)
+
+  \brief register driver callback for clock changes
+
+  \param[in] notifier   callback, called before and after each clock change
+
+  \return success(=1) or list full(=0)
+
+  register a driver callback. The callback is immediately called with
+  CLOCK_POST_CHANGE, so the driver adapts to the current clock.
+  Call during initialization with interrupts disabled.
+*/
+uint8_t clock_attach(clock_notifier_t notifier)
+{
+  if (m_numNotifiers >= CLOCK_MAX_NOTIFIERS)
+    return 0;
+
+  m_notifier[m_numNotifiers++] = notifier;
+  notifier(CLOCK_POST_CHANGE, g_fMaster);
+
+  return 1;
+
+} // clock_attach
+
+
+
+/**
+  \fn uint8_t clock_request(uint8_t source, uint8_t div)
+
+  \brief request switch to clock source and prescaler (non-blocking)
+
+  \param[in] source     new clock source, e.g. CLK_HSE
+  \param[in] div        prescaler exponent, i.e. fMaster = fSource / 2^div (STM8S: HSI only)
+
+  \return request accepted(=1) or other switch pending / invalid prescaler(=0)
+
+  Request a clock change. If the source is already active, only the prescaler is changed
+  immediately. Else the new oscillator is started and the switch is completed in CLK_ISR()
+  once it is stable. Use clock_busy() to check for completion.
+  Must not be called from an ISR.
+*/
+uint8_t clock_request(uint8_t source, uint8_t div)
+{
+  // check prescaler and pending switch
+  if ((div > CLOCK_MAX_DIV) || (m_busy))
+    return 0;
+
+  // same source -> only change prescaler
+  if (source == clock_get())
+  {
+    DISABLE_INTERRUPTS();
+    clock_notify(CLOCK_PRE_CHANGE, g_fMaster);
+    clock_setDiv(div);
+    clock_update();
+    clock_notify(CLOCK_POST_CHANGE, g_fMaster);
+    ENABLE_INTERRUPTS();
+    return 1;
+  }
+
+  // start target oscillator. Switch is executed in ISR once it is stable
+  m_pendingDiv = div;
+  m_busy = 1;
+  sfr_CLK.SWCR.SWIF  = 0;
+  sfr_CLK.SWCR.SWEN  = 0;
+  sfr_CLK.SWCR.SWIEN = 1;
+  sfr_CLK.SWR.SWI    = source;
+
+  return 1;
+
+} // clock_request
+
+
+
+/**
+  \fn uint8_t clock_busy(void)
+
+  \brief check if a clock switch is pending
+
+  \return switch pending(=1) or idle(=0)
+*/
+uint8_t clock_busy(void)
+{
+  return m_busy;
+
+} // clock_busy
+
+
+
+/**
+  \fn void clock_cancel(void)
+
+  \brief cancel pending clock switch
+
+  cancel pending clock switch, e.g. if the target oscillator does not start.
+  The active clock is not changed.
+*/
+void clock_cancel(void)
+{
+  DISABLE_INTERRUPTS();
+  sfr_CLK.SWCR.SWIEN = 0;
+  sfr_CLK.SWCR.SWIF  = 0;
+  sfr_CLK.SWCR.SWBSY = 0;       // reset switch process
+  m_busy = 0;
+  ENABLE_INTERRUPTS();
+
+} // clock_cancel
+
+
+
+/**
+  \fn void clock_init_css(void)
+
+  \brief enable clock security system (supervise HSE)
+
+  Enable clock security system for HSE. In case of HSE fails, the CSS
+  falls back to HSI and triggers an interrupt.
+  Once CSS triggers, HSE remains disabled until reset (see AN3265)
+*/
+void clock_init_css(void)
+{
+  // for low-power device enable smooth fall-back to HSI
+  #if defined(FAMILY_STM8L)
+    sfr_CLK.CSSR.CSSDGON = 1;
+  #endif
+
+  // enable CSS interrupt
+  sfr_CLK.CSSR.CSSDIE = 1;
+
+  // clear CSS interrupt flag
+  sfr_CLK.CSSR.CSSD = 0;
+
+  // activate CSS
+  sfr_CLK.CSSR.CSSEN = 1;
+
+} // clock_init_css
+
+
+
+/**
+  \fn void CLK_ISR(void)
+
+  \brief ISR for clock switch and clock security system
+
+  interrupt service routine for clock switch (target oscillator stable) and
+  clock security system (HSE failed). Execute pending switch and notify drivers.
+  CLK_SWITCH and CLK_CSS share the same interrupt vector.
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(CLK_ISR, _CLK_SWITCH_VECTOR_)
+{
+  // target oscillator stable -> execute switch
+  if ((sfr_CLK.SWCR.SWIEN) && (sfr_CLK.SWCR.SWIF))
+  {
+    clock_notify(CLOCK_PRE_CHANGE, g_fMaster);
+
+    // switch clock. Takes only few cycles
+    sfr_CLK.SWCR.SWIF  = 0;
+    sfr_CLK.SWCR.SWIEN = 0;
+    sfr_CLK.SWCR.SWEN  = 1;
+    while (sfr_CLK.SWCR.SWBSY);
+
+    // set new prescaler and notify drivers
+    clock_setDiv(m_pendingDiv);
+    clock_update();
+    m_busy = 0;
+    clock_notify(CLOCK_POST_CHANGE, g_fMaster);
+  }
+
+  // HSE failed -> hardware already switched to HSI. Cancel pending switch and notify drivers
+  if (sfr_CLK.CSSR.CSSD)
+  {
+    sfr_CLK.CSSR.CSSD  = 0;
+    sfr_CLK.SWCR.SWIEN = 0;
+    m_busy = 0;
+    clock_update();
+    clock_notify(CLOCK_POST_CHANGE, g_fMaster);
+  }
+
+  return;
+
+} // CLK_ISR
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
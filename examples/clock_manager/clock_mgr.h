@@ -0,0 +1,144 @@
+/**
+  \file clock_mgr.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of clock tree manager
+
+  declaration of a clock manager which switches clock source and prescaler
+  without busy-waiting, and notifies registered drivers (e.g. UART, timer, I2C, ADC)
+  to adapt their timing to the new master clock.
+
+  Switching sequence:
+    - clock_request() selects the target source. The oscillator starts in the background
+    - once it is stable, the CLK_SWITCH interrupt calls all notifiers with CLOCK_PRE_CHANGE,
+      executes the switch, sets the new prescaler and calls the notifiers with CLOCK_POST_CHANGE
+    - a pure prescaler change (same source) is executed immediately in the same way
+
+  \note
+  - notifiers are called with interrupts disabled, i.e. driver ISRs never see inconsistent timing
+  - notifiers must be short. CLOCK_PRE_CHANGE may e.g. wait for an ongoing UART transmission
+  - CLK_SWITCH and CLK_CSS share one interrupt vector. A CSS event (HSE failure) is also notified
+  - if the target oscillator does not start, the request stays pending. Use clock_cancel() with a timeout
+  - STM8S: fMaster >16MHz requires a flash wait state (option byte), see datasheet
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CLOCK_MGR_H_
+#define _CLOCK_MGR_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+// frequency of external oscillator [Hz]. Default can be overwritten in config.h
+#ifndef F_HSE
+  #define F_HSE                 16000000L
+#endif
+
+// max. number of notifiers. Default can be overwritten in config.h
+#ifndef CLOCK_MAX_NOTIFIERS
+  #define CLOCK_MAX_NOTIFIERS   4
+#endif
+
+// STM8S / STM8AF family
+#if defined(FAMILY_STM8S)
+  #define CLK_HSI               0xE1                        ///< clock source: internal high-speed clock (16MHz)
+  #define CLK_LSI               0xD2                        ///< clock source: internal low-speed clock (128kHz)
+  #define CLK_HSE               0xB4                        ///< clock source: external high-speed clock
+
+  #define F_HSI                 16000000L                   ///< frequency of HSI [Hz]
+  #define F_LSI                 128000L                     ///< frequency of LSI [Hz]
+  #define CLOCK_MAX_DIV         3                           ///< max. prescaler exponent (HSIDIV, HSI only)
+
+  #define clock_get()           ( sfr_CLK.CMSR.byte )       ///< active clock source
+
+// STM8L / STM8AL family
+#elif defined(FAMILY_STM8L)
+  #define CLK_HSI               0x01                        ///< clock source: internal high-speed clock (16MHz)
+  #define CLK_LSI               0x02                        ///< clock source: internal low-speed clock (38kHz)
+  #define CLK_HSE               0x04                        ///< clock source: external high-speed clock
+  #define CLK_LSE               0x08                        ///< clock source: external low-speed clock (32.768kHz)
+
+  #define F_HSI                 16000000L                   ///< frequency of HSI [Hz]
+  #define F_LSI                 38000L                      ///< frequency of LSI [Hz]
+  #define F_LSE                 32768L                      ///< frequency of LSE [Hz]
+  #define CLOCK_MAX_DIV         7                           ///< max. prescaler exponent (SYSCLK divider)
+
+  #define clock_get()           ( sfr_CLK.SCSR.byte )       ///< active clock source
+
+// family not yet supported
+#else
+  #error unsupported STM8 family
+#endif
+
+/// notifier events
+#define CLOCK_PRE_CHANGE        0                           ///< clock is about to change. Argument is old fMaster
+#define CLOCK_POST_CHANGE       1                           ///< clock has changed. Argument is new fMaster
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// driver callback for clock changes. Called with interrupts disabled
+typedef void (*clock_notifier_t)(uint8_t event, uint32_t fMaster);
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL VARIABLES
+-----------------------------------------------------------------------------*/
+
+// declare or reference to global variables, depending on '_MAIN_'
+#if defined(_MAIN_)
+  volatile uint32_t           g_fMaster;                  ///< current master clock [Hz]. Updated in clock ISR
+  volatile uint32_t           g_fCPU;                     ///< current CPU clock [Hz]. Updated in clock ISR
+#else // _MAIN_
+  extern volatile uint32_t    g_fMaster;
+  extern volatile uint32_t    g_fCPU;
+#endif // _MAIN_
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init clock manager from current clock setting
+void clock_begin(void);
+
+/// register driver callback for clock changes. Returns 1 on success, else 0
+uint8_t clock_attach(clock_notifier_t notifier);
+
+/// request switch to clock source and prescaler 2^div (non-blocking). Returns 1 if accepted, else 0
+uint8_t clock_request(uint8_t source, uint8_t div);
+
+/// check if a clock switch is pending
+uint8_t clock_busy(void);
+
+/// cancel pending clock switch, e.g. after timeout
+void clock_cancel(void);
+
+/// enable clock security system (supervise HSE)
+void clock_init_css(void);
+
+/// ISR for clock switch and clock security interrupt
+ISR_HANDLER(CLK_ISR, _CLK_SWITCH_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CLOCK_MGR_H_
@@ -0,0 +1,147 @@
+/**********************
+  Clock tree manager with non-blocking clock switch and driver notification
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - every 2s cycle through clock settings: HSE 16MHz -> HSI 2MHz -> HSI 16MHz
+    - clock source switch is executed in CLK_SWITCH interrupt, i.e. no busy-waiting
+    - UART, TIM4 (1ms), I2C and ADC timing is adapted via notifiers, i.e. 1ms timebase
+      and UART communication continue independent of clock
+    - print current clock via UART
+    notes:
+      - STM8L Discovery has no external resonator -> HSE request times out after 100ms
+      - if HSE failed (supervised by CSS), drivers are notified of fall-back to HSI
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "clock_mgr.h"
+  #include "timer4.h"
+  #include "uart.h"
+  #include "periph_clock.h"
+#undef _MAIN_
+
+
+// clock settings to cycle through: source and prescaler exponent
+#define NUM_SETTINGS  3
+const uint8_t   source[NUM_SETTINGS]    = { CLK_HSE, CLK_HSI, CLK_HSI };
+const uint8_t   prescaler[NUM_SETTINGS] = { 0,       3,       0       };
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint32_t  nextSwitch = 0;
+  uint32_t  timeout = 0;
+  uint8_t   idx = 0;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch fMaster prescaler to 1 (default is 8)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init clock manager for current clock
+  clock_begin();
+
+  // configure LED pin as output
+  LED_PORT.DDR.byte |= LED_PIN;     // input(=0) or output(=1)
+  LED_PORT.CR1.byte |= LED_PIN;     // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+  LED_PORT.CR2.byte |= LED_PIN;     // input: 0=no exint, 1=exint; output: 0=2MHz slope, 1=10MHz slope
+
+  // init drivers for current clock
+  UART_begin(19200);
+  TIM4_init();
+
+  // register drivers for clock changes
+  clock_attach(UART_clockNotifier);
+  clock_attach(TIM4_clockNotifier);
+  clock_attach(I2C_clockNotifier);
+  #if defined(FAMILY_STM8S)
+    clock_attach(ADC_clockNotifier);
+  #endif
+
+  // enable HSE supervision (CSS)
+  clock_init_css();
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // print message
+  printf("reset\n");
+
+  // main loop
+  while(1) {
+
+    // cancel switch if oscillator does not start within 100ms
+    if ((clock_busy()) && (millis() >= timeout)) {
+      clock_cancel();
+      printf("  switch timeout\n");
+    }
+
+    // every 2s request next clock setting. Is executed in background
+    if ((!clock_busy()) && (millis() >= nextSwitch)) {
+      nextSwitch += 2000;
+
+      // print active clock
+      printf("fMaster %ldHz, fCPU %ldHz, source 0x%02x\n", (long) g_fMaster, (long) g_fCPU, (int) clock_get());
+
+      // request next setting
+      idx = (idx + 1) % NUM_SETTINGS;
+      clock_request(source[idx], prescaler[idx]);
+      timeout = millis() + 100;
+
+      // toggle LED
+      LED_PORT.ODR.byte ^= LED_PIN;
+
+    } // 2s task
+
+    // wait for next interrupt
+    WAIT_FOR_INTERRUPT();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,130 @@
+/**
+  \file periph_clock.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of clock notifiers for I2C and ADC
+
+  implementation of clock notifiers, which adapt the timing of I2C and ADC to
+  master clock changes.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "periph_clock.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// I2C register name differs between STM8S and STM8L
+#if defined(sfr_I2C)
+  #define sfr_I2C_        sfr_I2C
+#elif defined(sfr_I2C1)
+  #define sfr_I2C_        sfr_I2C1
+#endif
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void I2C_clockNotifier(uint8_t event, uint32_t fMaster)
+
+  \brief adapt I2C timing to clock change
+
+  \param[in]  event     CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+  \param[in]  fMaster   master clock [Hz] before (pre) or after (post) change
+
+  I2C timing registers may only be changed while the peripheral is disabled.
+  Before the change disable I2C, afterwards set input clock (FREQR in MHz,
+  min. 1MHz), SCL clock (CCR) and rise time (TRISER), then re-enable I2C.
+  An ongoing transfer must be finished before requesting a clock change.
+*/
+#if defined(sfr_I2C_)
+void I2C_clockNotifier(uint8_t event, uint32_t fMaster)
+{
+  static uint8_t  s_enabled = 0;
+  uint8_t         freq;
+  uint16_t        ccr;
+
+  // remember state and disable I2C
+  if (event == CLOCK_PRE_CHANGE)
+  {
+    s_enabled = sfr_I2C_.CR1.PE;
+    sfr_I2C_.CR1.PE = 0;
+    return;
+  }
+
+  // input clock in MHz (1..24)
+  freq = (uint8_t) (fMaster / 1000000L);
+  if (freq < 1)
+    freq = 1;
+  sfr_I2C_.FREQR.byte = freq;
+
+  // standard mode: tHigh = tLow = CCR * tMaster (min. 4)
+  ccr = (uint16_t) (fMaster / (2 * I2C_SPEED));
+  if (ccr < 4)
+    ccr = 4;
+  sfr_I2C_.CCRL.byte = (uint8_t) ccr;
+  sfr_I2C_.CCRH.byte = (uint8_t) ((ccr >> 8) & 0x0F);
+
+  // max. rise time 1000ns in standard mode
+  sfr_I2C_.TRISER.byte = freq + 1;
+
+  // restore state. On first call (from clock_attach) keep I2C as initialized
+  if (s_enabled)
+    sfr_I2C_.CR1.PE = 1;
+
+} // I2C_clockNotifier
+#endif // sfr_I2C_
+
+
+
+/**
+  \fn void ADC_clockNotifier(uint8_t event, uint32_t fMaster)
+
+  \brief adapt ADC prescaler to clock change (STM8S only)
+
+  \param[in]  event     CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+  \param[in]  fMaster   master clock [Hz] before (pre) or after (post) change
+
+  select the smallest ADC prescaler (SPSEL) for which fADC <= ADC_FMAX, i.e.
+  the fastest conversion possible at the new master clock.
+  An ongoing conversion must be finished before requesting a clock change.
+*/
+#if defined(FAMILY_STM8S)
+void ADC_clockNotifier(uint8_t event, uint32_t fMaster)
+{
+  // available prescalers for SPSEL=0..7
+  static const uint8_t  s_div[8] = {2, 3, 4, 6, 8, 10, 12, 18};
+  uint8_t               spsel;
+
+  if (event != CLOCK_POST_CHANGE)
+    return;
+
+  // find smallest prescaler
+  for (spsel=0; spsel<7; spsel++)
+  {
+    if (fMaster / s_div[spsel] <= ADC_FMAX)
+      break;
+  }
+
+  // set prescaler
+  #if defined(sfr_ADC1)
+    sfr_ADC1.CR1.SPSEL = spsel;
+  #elif defined(sfr_ADC2)
+    sfr_ADC2.CR1.SPSEL = spsel;
+  #endif
+
+} // ADC_clockNotifier
+#endif // FAMILY_STM8S
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
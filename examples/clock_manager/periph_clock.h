@@ -0,0 +1,61 @@
+/**
+  \file periph_clock.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of clock notifiers for I2C and ADC
+
+  declaration of clock notifiers, which adapt the timing of I2C and ADC to
+  master clock changes. Register via clock_attach() after the peripheral is initialized.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _PERIPH_CLOCK_H_
+#define _PERIPH_CLOCK_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+#include "config.h"
+#include "clock_mgr.h"
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+// I2C SCL frequency [Hz] (standard mode). Default can be overwritten in config.h
+#ifndef I2C_SPEED
+  #define I2C_SPEED           100000L
+#endif
+
+// max. ADC clock [Hz]. Default can be overwritten in config.h
+#ifndef ADC_FMAX
+  #define ADC_FMAX            4000000L
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// adapt I2C input clock and SCL timing (FREQR, CCR, TRISER) to clock change
+void I2C_clockNotifier(uint8_t event, uint32_t fMaster);
+
+/// adapt ADC prescaler (SPSEL) to clock change. STM8S only
+#if defined(FAMILY_STM8S)
+  void ADC_clockNotifier(uint8_t event, uint32_t fMaster);
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _PERIPH_CLOCK_H_
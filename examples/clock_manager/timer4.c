@@ -0,0 +1,156 @@
+/**
+  \file timer4.c
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief implementation of timer TIM4 (1ms clock) functions/macros
+   
+  implementation of timer TIM4 functions as 1ms master clock. Prescaler and
+  reload value follow clock changes via TIM4_clockNotifier()
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "timer4.h"
+
+
+/*----------------------------------------------------------
+    FUNCTIONS
+----------------------------------------------------------*/
+
+/**
+  \fn void TIM4_setPeriod(uint32_t fMaster)
+   
+  \brief set prescaler and reload value for 1ms period
+   
+  \param[in]  fMaster   master clock [Hz]
+
+  use the smallest prescaler 2^PSC for which the 1ms reload value fits into
+  8 bit. If fMaster/1000 is not divisible by 2^PSC the period is rounded down,
+  e.g. 24MHz -> 187 ticks of 5.33us = 0.997ms. New values become active with
+  the next update event.
+*/
+static void TIM4_setPeriod(uint32_t fMaster) {
+
+  uint8_t   psc = 0;
+  uint32_t  ticks = fMaster / 1000L;
+
+  // find smallest prescaler
+  while ((ticks > 256) && (psc < 7)) {
+    psc++;
+    ticks >>= 1;
+  }
+  if (ticks == 0)
+    ticks = 1;
+  
+  // set prescaler and reload value. Period is ARR+1
+  sfr_TIM4.PSCR.PSC = psc;
+  sfr_TIM4.ARR.byte = (uint8_t) (ticks - 1);
+
+} // TIM4_setPeriod
+
+
+
+/**
+  \fn void TIM4_init(void)
+   
+  \brief init timer 4 for 1ms master clock with interrupt
+   
+  init 8-bit timer TIM4 with 1ms tick for current master clock.
+  Is used for SW master clock via below interrupt.
+*/
+void TIM4_init(void) {
+
+  // for low-power device activate TIM4 clock
+  #if defined(FAMILY_STM8L)
+    sfr_CLK.PCKENR1.PCKEN12 = 1;
+  #endif
+   
+  // stop the timer
+  sfr_TIM4.CR1.CEN = 0;
+  
+  // initialize global clock variables
+  g_flagMilli = 0;
+  g_millis    = 0;
+  
+  // clear counter
+  sfr_TIM4.CNTR.byte = 0x00;
+
+  // auto-reload value buffered
+  sfr_TIM4.CR1.ARPE = 1;
+
+  // clear pending events
+  sfr_TIM4.EGR.byte  = 0x00;
+
+  // set prescaler and reload value for 1ms
+  TIM4_setPeriod(g_fMaster);
+
+  // enable timer 4 interrupt
+  sfr_TIM4.IER.UIE = 1;
+  
+  // start the timer
+  sfr_TIM4.CR1.CEN = 1;
+  
+} // TIM4_init
+
+
+
+/**
+  \fn void TIM4_clockNotifier(uint8_t event, uint32_t fMaster)
+   
+  \brief adapt prescaler and reload value to clock change
+  
+  \param[in]  event     CLOCK_PRE_CHANGE or CLOCK_POST_CHANGE
+  \param[in]  fMaster   master clock [Hz] before (pre) or after (post) change
+
+  recalculate 1ms period after clock change. Register via clock_attach() after TIM4_init()
+*/
+void TIM4_clockNotifier(uint8_t event, uint32_t fMaster) {
+
+  if (event == CLOCK_POST_CHANGE)
+    TIM4_setPeriod(fMaster);
+
+} // TIM4_clockNotifier
+
+
+
+/**
+  \fn void TIM4_UPD_ISR(void)
+   
+  \brief ISR for timer 4 (1ms master clock)
+   
+  interrupt service routine for timer TIM4.
+  Used for 1ms system clock.
+
+  Note: 
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+#if defined(_TIM4_OVR_UIF_VECTOR_)
+  ISR_HANDLER(TIM4_UPD_ISR, _TIM4_OVR_UIF_VECTOR_)
+#elif defined(_TIM4_UIF_VECTOR_)
+  ISR_HANDLER(TIM4_UPD_ISR, _TIM4_UIF_VECTOR_)
+#else
+  #error TIM4 vector undefined
+#endif
+{
+  // clear timer 4 interrupt flag
+  #if defined(FAMILY_STM8S)
+    sfr_TIM4.SR.UIF = 0;
+  #else
+    sfr_TIM4.SR1.UIF = 0;
+  #endif
+
+  // set/increase global variables
+  g_millis++;
+  g_flagMilli = 1;
+    
+  return;
+
+} // TIM4_UPD_ISR
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,462 @@
+/**
+  \file capture.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of input capture engine for frequency and duty measurement
+
+  implementation of a measurement engine based on input capture of a
+  free-running 16-bit timer. The capture ISR only accumulates tick differences.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "capture.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// check configuration at compile time (negative array size on error)
+typedef char cap_check_psc[(CAP_PSC <= 7) ? 1 : -1];
+typedef char cap_check_filter[(CAP_FILTER <= 15) ? 1 : -1];
+
+/// access consecutive timer registers, e.g. CAP_REG(sfr_CAP.CCMR1, 2) is CCMR3
+#define CAP_REG(first, idx) (((volatile uint8_t*) &((first).byte))[idx])
+
+// channel modes
+#define CAP_MODE_OFF        0         ///< channel disabled
+#define CAP_MODE_PERIOD     1         ///< period measurement
+#define CAP_MODE_DUTY       2         ///< first channel of duty pair (rising edge, statistics)
+#define CAP_MODE_HIGH       3         ///< second channel of duty pair (falling edge, interrupt)
+
+// register bits
+#define CCMR_TI_OWN         0x01      ///< CCxS: ICx is mapped on TIx
+#define CCMR_TI_PAIR        0x02      ///< CCxS: ICx is mapped on TI of other channel in pair
+#define CCER_E              0x01      ///< capture enable (per channel nibble)
+#define CCER_P              0x02      ///< capture on falling edge (per channel nibble)
+
+/// interrupt enable, status and overcapture bit of channel index 0..3
+#define CAP_BIT(idx)        ((uint8_t) (0x02 << (idx)))
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// channel mode
+static uint8_t            m_mode[CAP_NUM_CH];
+
+/// periods per capture, i.e. capture prescaler
+static uint8_t            m_div[CAP_NUM_CH];
+
+/// last capture value (duty mode: last rising edge)
+static uint16_t           m_last[CAP_NUM_CH];
+
+/// channels without previous capture (bit CAP_BIT(idx))
+static volatile uint8_t   m_first;
+
+/// accumulated statistics, cleared by CAP_read()
+static volatile uint32_t  m_sumPeriod[CAP_NUM_CH];
+static volatile uint32_t  m_sumHigh[CAP_NUM_CH];
+static volatile uint16_t  m_num[CAP_NUM_CH];
+
+
+
+/**
+  \fn uint16_t CAP_readCCR(uint8_t idx)
+
+  \brief read capture register of channel
+
+  \param[in]  idx     channel index (0..CAP_NUM_CH-1)
+
+  \return 16-bit capture value
+
+  read capture register (MSB first). Clears capture flag CCxIF.
+*/
+static uint16_t CAP_readCCR(uint8_t idx) {
+
+  uint16_t  value;
+
+  value  = (uint16_t) CAP_REG(sfr_CAP.CCR1H, 2*idx) << 8;
+  value |= CAP_REG(sfr_CAP.CCR1H, 2*idx+1);
+
+  return(value);
+
+} // CAP_readCCR
+
+
+
+/**
+  \fn void CAP_config(uint8_t idx, uint8_t ccmr, uint8_t ccer)
+
+  \brief configure capture channel
+
+  \param[in]  idx     channel index (0..CAP_NUM_CH-1)
+  \param[in]  ccmr    value for CCMRx (input mapping, prescaler, filter)
+  \param[in]  ccer    CCER nibble (enable, polarity)
+
+  input mapping in CCMRx can only be changed while the channel is disabled.
+*/
+static void CAP_config(uint8_t idx, uint8_t ccmr, uint8_t ccer) {
+
+  uint8_t   pos = (idx & 0x01) ? 4 : 0;
+
+  // disable channel, set mode, then enable with polarity
+  CAP_REG(sfr_CAP.CCER1, idx >> 1) &= (uint8_t) ~(0x0F << pos);
+  CAP_REG(sfr_CAP.CCMR1, idx) = ccmr;
+  CAP_REG(sfr_CAP.CCER1, idx >> 1) |= (uint8_t) (ccer << pos);
+
+} // CAP_config
+
+
+
+/**
+  \fn void CAP_clear(uint8_t idx)
+
+  \brief clear statistics of channel
+
+  \param[in]  idx     channel index (0..CAP_NUM_CH-1)
+
+  channel interrupt must be disabled.
+*/
+static void CAP_clear(uint8_t idx) {
+
+  m_sumPeriod[idx] = 0;
+  m_sumHigh[idx]   = 0;
+  m_num[idx]       = 0;
+  m_first |= CAP_BIT(idx);
+
+} // CAP_clear
+
+
+
+/**
+  \fn void CAP_begin(void)
+
+  \brief init timer as free-running counter
+
+  init timer with prescaler 2^CAP_PSC and period 2^16. All channels are
+  disabled. Interrupts must be enabled for measurements.
+*/
+void CAP_begin(void) {
+
+  uint8_t   i;
+
+  // for low-power device activate timer clock
+  #if defined(FAMILY_STM8L)
+    #if (CAP_TIMER == 1)
+      sfr_CLK.PCKENR2.PCKEN21 = 1;
+    #elif (CAP_TIMER == 2)
+      sfr_CLK.PCKENR1.PCKEN10 = 1;
+    #else
+      sfr_CLK.PCKENR1.PCKEN11 = 1;
+    #endif
+  #endif
+
+  // stop timer and disable all channels
+  sfr_CAP.CR1.byte = 0x00;
+  sfr_CAP.IER.byte = 0x00;
+  for (i=0; i<CAP_NUM_CH; i++) {
+    CAP_REG(sfr_CAP.CCER1, i >> 1) = 0x00;
+    CAP_REG(sfr_CAP.CCMR1, i) = 0x00;
+    m_mode[i] = CAP_MODE_OFF;
+  }
+
+  // set prescaler. TIM1 has linear 16-bit prescaler, TIM2/3 2^PSC
+  #if (CAP_TIMER == 1)
+    sfr_CAP.PSCRH.byte = 0x00;
+    sfr_CAP.PSCRL.byte = (uint8_t) ((1 << CAP_PSC) - 1);
+  #else
+    sfr_CAP.PSCR.PSC = CAP_PSC;
+  #endif
+
+  // free-running with max. period 2^16
+  sfr_CAP.ARRH.byte = 0xFF;
+  sfr_CAP.ARRL.byte = 0xFF;
+
+  // load prescaler and clear flags
+  sfr_CAP.EGR.UG = 1;
+  sfr_CAP.SR1.byte = 0x00;
+  sfr_CAP.SR2.byte = 0x00;
+
+  // start timer
+  sfr_CAP.CR1.CEN = 1;
+
+} // CAP_begin
+
+
+
+/**
+  \fn uint8_t CAP_period(uint8_t ch, uint8_t edge, uint8_t div)
+
+  \brief start period measurement on channel
+
+  \param[in]  ch      channel (1..CAP_NUM_CH)
+  \param[in]  edge    CAP_RISING or CAP_FALLING
+  \param[in]  div     capture prescaler CAP_DIV1..CAP_DIV8
+
+  \return 1 on success, 0 on invalid channel
+
+  capture every 2^div-th edge on input TIx. Each capture adds the ticks of
+  2^div periods, i.e. the capture prescaler averages in hardware and
+  reduces the interrupt rate. Channel must not be part of an active duty pair.
+*/
+uint8_t CAP_period(uint8_t ch, uint8_t edge, uint8_t div) {
+
+  uint8_t   idx = ch - 1;
+
+  // check parameters
+  if ((ch == 0) || (ch > CAP_NUM_CH) || (div > CAP_DIV8))
+    return(0);
+
+  // stop channel interrupt and clear statistics
+  sfr_CAP.IER.byte &= (uint8_t) ~CAP_BIT(idx);
+  CAP_clear(idx);
+  m_mode[idx] = CAP_MODE_PERIOD;
+  m_div[idx]  = (uint8_t) (1 << div);
+
+  // capture on own input with prescaler and filter
+  CAP_config(idx, CCMR_TI_OWN | (div << 2) | (CAP_FILTER << 4), CCER_E | ((edge == CAP_FALLING) ? CCER_P : 0));
+
+  // clear pending flags and enable interrupt
+  sfr_CAP.SR1.byte = (uint8_t) ~CAP_BIT(idx);
+  sfr_CAP.SR2.byte = (uint8_t) ~CAP_BIT(idx);
+  sfr_CAP.IER.byte |= CAP_BIT(idx);
+
+  return(1);
+
+} // CAP_period
+
+
+
+/**
+  \fn uint8_t CAP_duty(uint8_t ch)
+
+  \brief start period and duty measurement on channel pair
+
+  \param[in]  ch      first channel of pair (1 or 3)
+
+  \return 1 on success, 0 on invalid channel
+
+  channel ch captures rising edges and channel ch+1 falling edges of input
+  TIch. Only the falling edge triggers an interrupt, which evaluates both
+  captures. Statistics are stored under channel ch.
+*/
+uint8_t CAP_duty(uint8_t ch) {
+
+  uint8_t   idx = ch - 1;
+
+  // check parameters
+  if (((ch != 1) && (ch != 3)) || (ch >= CAP_NUM_CH))
+    return(0);
+
+  // stop channel interrupts and clear statistics
+  sfr_CAP.IER.byte &= (uint8_t) ~(CAP_BIT(idx) | CAP_BIT(idx+1));
+  CAP_clear(idx);
+  m_mode[idx]   = CAP_MODE_DUTY;
+  m_mode[idx+1] = CAP_MODE_HIGH;
+  m_div[idx]    = 1;
+
+  // first channel: rising edge on own input. Second channel: falling edge on same input
+  CAP_config(idx,   CCMR_TI_OWN  | (CAP_FILTER << 4), CCER_E);
+  CAP_config(idx+1, CCMR_TI_PAIR | (CAP_FILTER << 4), CCER_E | CCER_P);
+
+  // clear pending flags and enable interrupt on falling edge
+  sfr_CAP.SR1.byte = (uint8_t) ~(CAP_BIT(idx) | CAP_BIT(idx+1));
+  sfr_CAP.SR2.byte = (uint8_t) ~(CAP_BIT(idx) | CAP_BIT(idx+1));
+  sfr_CAP.IER.byte |= CAP_BIT(idx+1);
+
+  return(1);
+
+} // CAP_duty
+
+
+
+/**
+  \fn void CAP_disable(uint8_t ch)
+
+  \brief disable channel
+
+  \param[in]  ch      channel (1..CAP_NUM_CH). For duty pair first channel
+
+  disable capture and interrupt of channel. In duty mode both channels of
+  the pair are disabled.
+*/
+void CAP_disable(uint8_t ch) {
+
+  uint8_t   idx = ch - 1;
+  uint8_t   num = 1;
+
+  // check parameter
+  if ((ch == 0) || (ch > CAP_NUM_CH))
+    return;
+
+  // duty pair -> disable both channels
+  if (m_mode[idx] == CAP_MODE_DUTY)
+    num = 2;
+
+  // disable interrupt and capture
+  while (num--) {
+    sfr_CAP.IER.byte &= (uint8_t) ~CAP_BIT(idx);
+    CAP_config(idx, 0x00, 0x00);
+    m_mode[idx] = CAP_MODE_OFF;
+    idx++;
+  }
+
+} // CAP_disable
+
+
+
+/**
+  \fn void CAP_read(uint8_t ch, cap_stat_t *stat)
+
+  \brief copy and clear statistics of channel
+
+  \param[in]  ch      channel (1..CAP_NUM_CH). For duty pair first channel
+  \param[out] stat    accumulated statistics since last call
+
+  copy accumulated statistics with channel interrupt disabled and restart
+  accumulation. Overcapture flags are evaluated and cleared.
+*/
+void CAP_read(uint8_t ch, cap_stat_t *stat) {
+
+  uint8_t   idx = ch - 1;
+  uint8_t   mask;
+
+  // check parameter
+  if ((ch == 0) || (ch > CAP_NUM_CH))
+    return;
+
+  // interrupt and overcapture flags of channel or channel pair
+  mask = CAP_BIT(idx);
+  if (m_mode[idx] == CAP_MODE_DUTY)
+    mask |= CAP_BIT(idx+1);
+
+  // copy and clear statistics without channel interrupt
+  sfr_CAP.IER.byte &= (uint8_t) ~mask;
+  stat->sumPeriod   = m_sumPeriod[idx];
+  stat->sumHigh     = m_sumHigh[idx];
+  stat->num         = m_num[idx];
+  m_sumPeriod[idx]  = 0;
+  m_sumHigh[idx]    = 0;
+  m_num[idx]        = 0;
+  if (m_mode[idx] == CAP_MODE_DUTY)
+    sfr_CAP.IER.byte |= CAP_BIT(idx+1);
+  else if (m_mode[idx] == CAP_MODE_PERIOD)
+    sfr_CAP.IER.byte |= CAP_BIT(idx);
+
+  // check and clear overcapture flags
+  stat->overcapture = (sfr_CAP.SR2.byte & mask) ? 1 : 0;
+  sfr_CAP.SR2.byte = (uint8_t) ~mask;
+
+} // CAP_read
+
+
+
+/**
+  \fn float CAP_frequency(const cap_stat_t *stat)
+
+  \brief get average frequency
+
+  \param[in]  stat    statistics from CAP_read()
+
+  \return average frequency [Hz] or 0 if no period was measured
+*/
+float CAP_frequency(const cap_stat_t *stat) {
+
+  if (stat->sumPeriod == 0)
+    return(0.0);
+
+  return((float) F_CAP * (float) stat->num / (float) stat->sumPeriod);
+
+} // CAP_frequency
+
+
+
+/**
+  \fn float CAP_dutyCycle(const cap_stat_t *stat)
+
+  \brief get average duty cycle
+
+  \param[in]  stat    statistics from CAP_read() in duty mode
+
+  \return average duty cycle [%] or 0 if no period was measured
+*/
+float CAP_dutyCycle(const cap_stat_t *stat) {
+
+  if (stat->sumPeriod == 0)
+    return(0.0);
+
+  return(100.0 * (float) stat->sumHigh / (float) stat->sumPeriod);
+
+} // CAP_dutyCycle
+
+
+
+/**
+  \fn void CAP_CC_ISR(void)
+
+  \brief ISR for capture events
+
+  interrupt service routine for capture events of all channels. Only tick
+  differences are accumulated, evaluation is done in main via CAP_read().
+  Accumulation stops before the period counter overflows.
+*/
+ISR_HANDLER(CAP_CC_ISR, CAP_CC_VECTOR) {
+
+  uint8_t   flags, idx;
+  uint16_t  capture, rise, period, high;
+
+  // pending channels with enabled interrupt
+  flags = sfr_CAP.SR1.byte & sfr_CAP.IER.byte;
+
+  for (idx=0; idx<CAP_NUM_CH; idx++) {
+
+    if (!(flags & CAP_BIT(idx)))
+      continue;
+
+    // read capture value, clears flag
+    capture = CAP_readCCR(idx);
+
+    // period mode: difference to last capture covers m_div periods
+    if (m_mode[idx] == CAP_MODE_PERIOD) {
+      if (m_first & CAP_BIT(idx))
+        m_first &= (uint8_t) ~CAP_BIT(idx);
+      else if (m_num[idx] < (uint16_t) (0xFFFF - 8)) {
+        m_sumPeriod[idx] += (uint16_t) (capture - m_last[idx]);
+        m_num[idx]       += m_div[idx];
+      }
+      m_last[idx] = capture;
+    }
+
+    // duty mode: falling edge on 2nd channel, last rising edge in 1st channel
+    else {
+      rise   = CAP_readCCR(idx-1);
+      period = rise - m_last[idx-1];
+      high   = capture - rise;
+      m_last[idx-1] = rise;
+
+      // skip first period and periods with missed edges (high > period)
+      if (m_first & CAP_BIT(idx-1))
+        m_first &= (uint8_t) ~CAP_BIT(idx-1);
+      else if ((high <= period) && (m_num[idx-1] < 0xFFFF)) {
+        m_sumPeriod[idx-1] += period;
+        m_sumHigh[idx-1]   += high;
+        m_num[idx-1]++;
+      }
+    }
+
+  } // loop channels
+
+} // CAP_CC_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
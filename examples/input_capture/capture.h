@@ -0,0 +1,148 @@
+/**
+  \file capture.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of input capture engine for frequency and duty measurement
+
+  declaration of a measurement engine based on input capture of a free-running
+  16-bit timer (TIM1, TIM2 or TIM3). Each channel is used in one of two modes:
+    - period: capture every 1st, 2nd, 4th or 8th edge on TIx. The capture
+      prescaler averages in hardware and reduces the interrupt load accordingly
+    - duty: channel pair 1+2 or 3+4 captures rising and falling edges on the
+      same input TI1 or TI3, respectively (like PWM-input mode, but the counter
+      keeps running). One interrupt per period yields period and high time
+  The capture ISR only accumulates the measured ticks per channel. Statistics are
+  read and cleared from main via CAP_read() and evaluated via CAP_frequency()
+  and CAP_duty().
+
+  \note
+  - timer tick is 2^CAP_PSC/fMaster. Max. measured time per capture is 2^16
+    ticks (4ms at CAP_PSC=0, 65ms at CAP_PSC=4). Longer periods are measured
+    modulo 2^16
+  - in duty mode the ISR must be served before the next rising edge, i.e.
+    high and low time must be longer than the ISR latency
+  - measurement accuracy is limited by the accuracy of fMaster (HSI: +/-1%)
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CAPTURE_H_
+#define _CAPTURE_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// default master clock [Hz], can be overwritten in config.h
+#ifndef F_MASTER
+  #define F_MASTER          16000000L
+#endif
+
+// used timer (1, 2 or 3). Default can be overwritten in config.h
+#ifndef CAP_TIMER
+  #define CAP_TIMER         1
+#endif
+
+// timer prescaler exponent [0..7] (tick=2^CAP_PSC/fMaster). Default can be overwritten in config.h
+#ifndef CAP_PSC
+  #define CAP_PSC           4
+#endif
+
+// input filter [0..15], see CCMRx.ICxF in reference manual. Default can be overwritten in config.h
+#ifndef CAP_FILTER
+  #define CAP_FILTER        3
+#endif
+
+/// timer tick frequency [Hz]
+#define F_CAP               (F_MASTER >> CAP_PSC)
+
+// select timer registers, vector and number of channels
+#if (CAP_TIMER == 1)
+  #define sfr_CAP           sfr_TIM1
+  #define CAP_CC_VECTOR     _TIM1_CAPCOM_CC1IF_VECTOR_
+  #define CAP_NUM_CH        4
+#elif (CAP_TIMER == 2)
+  #define sfr_CAP           sfr_TIM2
+  #define CAP_CC_VECTOR     _TIM2_CAPCOM_CC1IF_VECTOR_
+  #if defined(FAMILY_STM8S)
+    #define CAP_NUM_CH      3
+  #else
+    #define CAP_NUM_CH      2
+  #endif
+#elif (CAP_TIMER == 3)
+  #define sfr_CAP           sfr_TIM3
+  #define CAP_CC_VECTOR     _TIM3_CAPCOM_CC1IF_VECTOR_
+  #define CAP_NUM_CH        2
+#else
+  #error CAP_TIMER must be 1, 2 or 3
+#endif
+
+// capture edge
+#define CAP_RISING          0         ///< capture rising edges
+#define CAP_FALLING         1         ///< capture falling edges
+
+// capture prescaler, i.e. periods per capture
+#define CAP_DIV1            0         ///< capture every edge
+#define CAP_DIV2            1         ///< capture every 2nd edge
+#define CAP_DIV4            2         ///< capture every 4th edge
+#define CAP_DIV8            3         ///< capture every 8th edge
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// accumulated measurement of one channel since last CAP_read()
+typedef struct {
+  uint32_t    sumPeriod;      ///< sum of measured periods [ticks]
+  uint32_t    sumHigh;        ///< sum of high times [ticks]. Duty mode only
+  uint16_t    num;            ///< number of periods in sums
+  uint8_t     overcapture;    ///< capture lost since last read (=1), e.g. due to ISR latency
+} cap_stat_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init timer as free-running counter. All channels are disabled
+void CAP_begin(void);
+
+/// measure period on channel (1..CAP_NUM_CH) with edge and capture prescaler. Returns 1 on success
+uint8_t CAP_period(uint8_t ch, uint8_t edge, uint8_t div);
+
+/// measure period and duty on input TI1 or TI3 via channel pair ch/ch+1 (ch=1 or 3). Returns 1 on success
+uint8_t CAP_duty(uint8_t ch);
+
+/// disable channel (or channel pair in duty mode)
+void CAP_disable(uint8_t ch);
+
+/// copy and clear statistics of channel
+void CAP_read(uint8_t ch, cap_stat_t *stat);
+
+/// get average frequency [Hz] from statistics, or 0 if no period measured
+float CAP_frequency(const cap_stat_t *stat);
+
+/// get average duty cycle [%] from statistics (duty mode only)
+float CAP_dutyCycle(const cap_stat_t *stat);
+
+/// ISR for capture events
+ISR_HANDLER(CAP_CC_ISR, CAP_CC_VECTOR);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CAPTURE_H_
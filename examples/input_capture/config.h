@@ -0,0 +1,42 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+//#define STM8L_DISCOVERY
+#define SDUINO
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"
+  #define CAP_PORT   sfr_PORTD          // TIM1_CH1=PD2, TIM1_CH3=PD5
+  #define CAP_PINS   (PIN2 | PIN5)
+#elif defined(SDUINO)
+  #include "../../include/STM8S105K6.h"
+  #define CAP_PORT   sfr_PORTC          // TIM1_CH1=PC1, TIM1_CH3=PC3
+  #define CAP_PINS   (PIN1 | PIN3)
+#else
+  #error undefined board
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
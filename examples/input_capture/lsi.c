@@ -0,0 +1,240 @@
+/**
+  \file lsi.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of LSI frequency measurement and calibration
+
+  implementation of functions to measure the LSI clock via input capture
+  with capture prescaler 8 and correct LSI based timings.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "lsi.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// timer connected to LSI
+#if defined(FAMILY_STM8S) && defined(LSI_MEASURE_TIM1_IC1)
+  #define sfr_LSI_TIM       sfr_TIM1
+#elif defined(FAMILY_STM8S) && defined(LSI_MEASURE_TIM3_IC1)
+  #define sfr_LSI_TIM       sfr_TIM3
+#elif defined(FAMILY_STM8L)
+  #define sfr_LSI_TIM       sfr_TIM2
+#else
+  #error LSI measurement not supported for device
+#endif
+
+/// LSI periods per capture (capture prescaler)
+#define LSI_DIV             8
+
+/// timeout for single capture [polling loops]
+#define LSI_TIMEOUT         0xFFFF
+
+// check range of F_MASTER*LSI_DIV*LSI_NUM_CAPTURES (negative array size on error)
+typedef char lsi_check_range[(F_MASTER <= (0xFFFFFFFFUL / (LSI_DIV * LSI_NUM_CAPTURES))) ? 1 : -1];
+
+
+
+/**
+  \fn uint8_t LSI_capture(uint16_t *value)
+
+  \brief wait for next capture of LSI timer
+
+  \param[out] value   capture value
+
+  \return 1 on success, 0 on timeout
+*/
+static uint8_t LSI_capture(uint16_t *value) {
+
+  uint16_t  timeout = LSI_TIMEOUT;
+
+  // wait for capture with timeout
+  while (!sfr_LSI_TIM.SR1.CC1IF) {
+    if (!(timeout--))
+      return(0);
+  }
+
+  // read capture (MSB first), clears flag
+  *value  = (uint16_t) sfr_LSI_TIM.CCR1H.byte << 8;
+  *value |= sfr_LSI_TIM.CCR1L.byte;
+
+  return(1);
+
+} // LSI_capture
+
+
+
+/**
+  \fn uint32_t LSI_measure(void)
+
+  \brief measure LSI frequency
+
+  \return measured LSI frequency [Hz], or 0 on timeout
+
+  start LSI, connect it to input capture 1 of the measurement timer and
+  average LSI_NUM_CAPTURES captures of 8 LSI periods each at fMaster
+  resolution. Measurement is polled and takes ~1ms (STM8S) or ~3.5ms (STM8L).
+  Afterwards the timer channel is disabled again.
+*/
+uint32_t LSI_measure(void) {
+
+  uint16_t  last, capture;
+  uint32_t  sum = 0;
+  uint8_t   i;
+  #if !defined(FAMILY_STM8S)
+    uint8_t   cbeepr;
+  #endif
+
+  // start LSI
+  #if defined(FAMILY_STM8S)
+    sfr_CLK.ICKR.LSIEN = 1;
+    while (!sfr_CLK.ICKR.LSIRDY);
+  #else
+    sfr_CLK.ICKCR.LSION = 1;
+    while (!sfr_CLK.ICKCR.LSIRDY);
+  #endif
+
+  // connect LSI to timer input capture 1
+  #if defined(FAMILY_STM8S)
+    sfr_AWU.CSR1.MSR = 1;
+  #else
+    sfr_CLK.PCKENR1.PCKEN10 = 1;            // TIM2 clock
+    sfr_CLK.PCKENR1.PCKEN16 = 1;            // BEEP clock
+    cbeepr = sfr_CLK.CBEEPR.byte;           // select LSI as BEEP clock (CLKBEEPSEL=01)
+    sfr_CLK.CBEEPR.byte = 0x02;
+    while (sfr_CLK.CBEEPR.BEEPSWBSY);
+    sfr_BEEP.CSR1.MSR = 1;
+  #endif
+
+  // free-running timer at fMaster, capture every 8th rising edge on TI1
+  sfr_LSI_TIM.CR1.byte  = 0x00;
+  sfr_LSI_TIM.CCER1.byte = 0x00;
+  #if defined(FAMILY_STM8S) && defined(LSI_MEASURE_TIM1_IC1)
+    sfr_LSI_TIM.PSCRH.byte = 0x00;          // TIM1: 16-bit linear prescaler
+    sfr_LSI_TIM.PSCRL.byte = 0x00;
+  #else
+    sfr_LSI_TIM.PSCR.byte  = 0x00;          // TIM2/3: prescaler 2^PSC
+  #endif
+  sfr_LSI_TIM.ARRH.byte = 0xFF;
+  sfr_LSI_TIM.ARRL.byte = 0xFF;
+  sfr_LSI_TIM.CCMR1.byte = 0x01 | (3 << 2); // IC1 on TI1, prescaler 8, no filter
+  sfr_LSI_TIM.CCER1.byte = 0x01;            // capture enable, rising edge
+  sfr_LSI_TIM.EGR.UG    = 1;                // load prescaler
+  sfr_LSI_TIM.SR1.byte  = 0x00;
+  sfr_LSI_TIM.CR1.CEN   = 1;
+
+  // sum up periods
+  if (LSI_capture(&last)) {
+    for (i=0; i<LSI_NUM_CAPTURES; i++) {
+      if (!LSI_capture(&capture)) {
+        sum = 0;
+        break;
+      }
+      sum += (uint16_t) (capture - last);
+      last = capture;
+    }
+  }
+
+  // stop timer and disconnect LSI
+  sfr_LSI_TIM.CR1.CEN    = 0;
+  sfr_LSI_TIM.CCER1.byte = 0x00;
+  sfr_LSI_TIM.CCMR1.byte = 0x00;
+  #if defined(FAMILY_STM8S)
+    sfr_AWU.CSR1.MSR = 0;
+  #else
+    sfr_BEEP.CSR1.MSR = 0;
+    sfr_CLK.CBEEPR.byte = cbeepr & 0x06;    // restore BEEP clock selection
+    while (sfr_CLK.CBEEPR.BEEPSWBSY);
+  #endif
+
+  // timeout
+  if (sum == 0)
+    return(0);
+
+  // calculate frequency
+  return(((uint32_t) F_MASTER * (LSI_DIV * LSI_NUM_CAPTURES) + (sum >> 1)) / sum);
+
+} // LSI_measure
+
+
+
+/**
+  \fn uint8_t LSI_beepDiv(uint32_t fLSI, uint16_t freq)
+
+  \brief get beeper divider for frequency
+
+  \param[in]  fLSI    measured LSI frequency [Hz]
+  \param[in]  freq    beeper frequency [Hz] for BEEPSEL=0 (nominal 1kHz)
+
+  \return value for BEEP_CSR.BEEPDIV (STM8S) or BEEP_CSR2.BEEPDIV (STM8L)
+
+  beeper frequency is fLSI/(8*(BEEPDIV+2)). Result is rounded and clipped to
+  valid range 0..30. For BEEPSEL=1 and 2 beeper frequency is 2x and 4x.
+*/
+uint8_t LSI_beepDiv(uint32_t fLSI, uint16_t freq) {
+
+  uint32_t  div;
+
+  // avoid division by 0
+  if (freq == 0)
+    return(30);
+
+  // rounded divider
+  div = (fLSI + 4L * freq) / (8L * freq);
+
+  // clip to valid range
+  if (div < 2)
+    return(0);
+  if (div > 32)
+    return(30);
+  return((uint8_t) (div - 2));
+
+} // LSI_beepDiv
+
+
+
+/**
+  \fn uint16_t LSI_correctTime(uint32_t fLSI, uint16_t ms)
+
+  \brief convert time for LSI based timer
+
+  \param[in]  fLSI    measured LSI frequency [Hz]
+  \param[in]  ms      requested time [ms]
+
+  \return time [ms] to pass to functions assuming nominal LSI frequency
+
+  AWU and RTC times are calculated for F_LSI_NOMINAL, i.e. a passed time x
+  actually lasts x*F_LSI_NOMINAL/fLSI. For a real duration ms the time to
+  pass is ms*fLSI/F_LSI_NOMINAL, clipped to 65535ms.
+*/
+uint16_t LSI_correctTime(uint32_t fLSI, uint16_t ms) {
+
+  uint32_t  time;
+
+  // no measurement -> keep time
+  if (fLSI < 100)
+    return(ms);
+
+  // scale with 1/100 to avoid overflow
+  time = ((uint32_t) ms * (fLSI / 100) + (F_LSI_NOMINAL / 200)) / (F_LSI_NOMINAL / 100);
+
+  // clip to 16 bit
+  if (time > 0xFFFF)
+    return(0xFFFF);
+  return((uint16_t) time);
+
+} // LSI_correctTime
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,78 @@
+/**
+  \file lsi.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of LSI frequency measurement and calibration
+
+  declaration of functions to measure the low speed internal clock (LSI) via
+  input capture 1 of the timer it is internally connected to:
+    - STM8S: TIM1 or TIM3 (see LSI_MEASURE_TIMx_IC1 in device header), via AWU_CSR1.MSR
+    - STM8L: TIM2, via BEEP_CSR1.MSR
+  The measured frequency is used to correct beeper frequency and wake-up times
+  of AWU or RTC, which are otherwise based on the nominal LSI frequency.
+
+  \note
+  - LSI deviates by up to +/-12% (STM8S) or 26-56kHz (STM8L) from the nominal
+    frequency, see datasheet. Accuracy of the measurement is that of fMaster,
+    i.e. use HSE for best results
+  - LSI_measure() reconfigures the measurement timer. Call it before the
+    timer is initialized for other purposes
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _LSI_H_
+#define _LSI_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// default master clock [Hz], can be overwritten in config.h
+#ifndef F_MASTER
+  #define F_MASTER          16000000L
+#endif
+
+/// nominal LSI frequency [Hz]
+#if defined(FAMILY_STM8S)
+  #define F_LSI_NOMINAL     128000L
+#else
+  #define F_LSI_NOMINAL     38000L
+#endif
+
+// number of averaged captures (8 LSI periods each). Default can be overwritten in config.h
+#ifndef LSI_NUM_CAPTURES
+  #define LSI_NUM_CAPTURES  16
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// measure LSI frequency [Hz] by polling. Returns 0 on timeout
+uint32_t LSI_measure(void);
+
+/// get beeper divider BEEPDIV for frequency [Hz] with BEEPSEL=0, based on measured LSI [Hz]
+uint8_t LSI_beepDiv(uint32_t fLSI, uint16_t freq);
+
+/// convert real time [ms] to time for nominal LSI (ms*fLSI/F_LSI_NOMINAL), e.g. for AWU_setTime(). Corrects LSI deviation
+uint16_t LSI_correctTime(uint32_t fLSI, uint16_t ms);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _LSI_H_
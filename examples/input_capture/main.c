@@ -0,0 +1,136 @@
+/**********************
+  Input capture measurement of frequency and duty cycle, and LSI calibration
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - at start measure LSI frequency via input capture and print it together
+      with corrected beeper divider and AWU time via UART
+    - TIM1 counts with 1MHz. Frequency on TIM1_CH1 (Sduino: PC1, Discovery: PD2)
+      is measured with capture prescaler 8, e.g. for flow-meter pulses
+    - frequency and duty cycle on TIM1_CH3 (Sduino: PC3, Discovery: PD5) are
+      measured via channel pair 3+4
+    - every 1s print averaged frequencies and duty cycle via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "capture.h"
+  #include "lsi.h"
+#undef _MAIN_
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint32_t    fLSI, nextPrint = 1000;
+  uint32_t    freq;
+  uint16_t    duty;
+  cap_stat_t  stat;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init UART for 19.2kBaud
+  UART_begin(19200);
+
+  // init 1ms tick
+  TIM4_init();
+
+  // measure LSI before timer is used for capture
+  fLSI = LSI_measure();
+
+  // set calibrated 1kHz beeper divider. Beeper is not enabled
+  #if defined(FAMILY_STM8S)
+    sfr_BEEP.CSR.BEEPDIV = LSI_beepDiv(fLSI, 1000);
+  #else
+    sfr_BEEP.CSR2.BEEPDIV = LSI_beepDiv(fLSI, 1000);
+  #endif
+
+  // capture inputs with pull-up
+  CAP_PORT.CR1.byte |= CAP_PINS;    // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+
+  // init capture timer. CH1: frequency with hardware averaging, CH3+4: frequency and duty
+  CAP_begin();
+  CAP_period(1, CAP_RISING, CAP_DIV8);
+  CAP_duty(3);
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // print LSI calibration
+  printf("LSI %luHz, BEEPDIV %u, AWU 1000ms -> AWU_setTime(%u)\n", (unsigned long) fLSI,
+    (unsigned int) LSI_beepDiv(fLSI, 1000), (unsigned int) LSI_correctTime(fLSI, 1000));
+
+  // main loop
+  while(1) {
+
+    // every 1s print measurements
+    if ((int32_t) (millis() - nextPrint) >= 0) {
+      nextPrint += 1000;
+
+      // CH1: averaged frequency [0.01Hz]
+      CAP_read(1, &stat);
+      freq = (uint32_t) (CAP_frequency(&stat) * 100.0);
+      printf("CH1 %lu.%02uHz (%u periods%s), ", (unsigned long) (freq / 100), (unsigned int) (freq % 100),
+        (unsigned int) stat.num, stat.overcapture ? ", lost" : "");
+
+      // CH3: averaged frequency [0.01Hz] and duty cycle [0.1%]
+      CAP_read(3, &stat);
+      freq = (uint32_t) (CAP_frequency(&stat) * 100.0);
+      duty = (uint16_t) (CAP_dutyCycle(&stat) * 10.0);
+      printf("CH3 %lu.%02uHz, %u.%u%%\n", (unsigned long) (freq / 100), (unsigned int) (freq % 100),
+        (unsigned int) (duty / 10), (unsigned int) (duty % 10));
+
+    } // 1s task
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,62 @@
+/**
+  \file config.h
+
+  \brief set project configurations
+
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+#define STM8L_DISCOVERY
+//#define MUBOARD
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"
+  #define LED_PORT      sfr_PORTE
+  #define LED_PIN       PIN7
+  #define BUTTON_PORT   sfr_PORTC     // user button PC1 (high active)
+  #define BUTTON_PIN    PIN1
+  #define PCK1_TIM4     0x04          // PCKENR1 bit for TIM4
+  #define PCK1_UART     0x20          // PCKENR1 bit for USART1
+  #define PM_RTC_LSE                  // use 32.768kHz crystal for RTC wake-up timer
+#elif defined(MUBOARD)
+  #include "../../include/STM8S207MB.h"
+  #define LED_PORT      sfr_PORTH     // green LED PH2 (low active)
+  #define LED_PIN       PIN2
+  #define BUTTON_PORT   sfr_PORTE     // button PE5 (low active)
+  #define BUTTON_PIN    PIN5
+  #define PCK1_TIM4     0x10          // PCKENR1 bit for TIM4
+  #define PCK1_UART     0x04          // PCKENR1 bit for UART1
+#else
+  #error undefined board
+#endif
+
+
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+// min. sleep time [ms] for (active) halt. Shorter sleeps use WAIT
+#define PM_MIN_HALT         10
+
+// max. number of power mode notifiers
+#define PM_MAX_NOTIFIERS    4
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
@@ -0,0 +1,174 @@
+/**********************
+  Power manager selecting WAIT, active-halt or halt based on driver constraints
+  and pending deadlines
+
+  supported hardware:
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+    - muBoard (http://www.cream-tea.de/presentations/160305_PiAndMore.pdf)
+
+  Functionality:
+    - flash LED for 5ms every 2s. LED on time is spent in WAIT (<PM_MIN_HALT),
+      LED off time in active-halt with wake via AWU (STM8S) or RTC (STM8L)
+    - button is registered as wake source and wakes from (active-)halt
+    - on button press print uptime and number of entered modes via UART. During
+      transmission the UART limits the power manager to WAIT
+    - during WAIT only TIM4 (1ms) and UART clocks are active
+    notes:
+      - 1ms clock is advanced by slept time on timer wake, but not on button wake
+      - for measuring current remove LED and debugger
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "power_mgr.h"
+#undef _MAIN_
+
+
+// LED period and on-time [ms]
+#define LED_PERIOD    2000
+#define LED_ON_TIME   5
+
+// button pressed. Set in button ISR
+volatile uint8_t  g_button = 0;
+
+
+
+/**
+  \fn void BUTTON_ISR(void)
+   
+  \brief ISR for button
+   
+  interrupt service routine for button. Set flag for main loop and
+  skip next sleep
+
+  Note: 
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+#if defined(FAMILY_STM8L)
+  ISR_HANDLER(BUTTON_ISR, _EXTI1_VECTOR_)
+#else
+  ISR_HANDLER(BUTTON_ISR, _EXTI4_VECTOR_)
+#endif
+{
+  // clear pending flag (STM8L only)
+  #if defined(FAMILY_STM8L)
+    sfr_ITC_EXTI.SR1.byte = BUTTON_PIN;
+  #endif
+
+  // set flag for main loop
+  g_button = 1;
+  PM_wake();
+  
+} // BUTTON_ISR
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint32_t  nextLed = 0;
+  uint8_t   ledOn = 0;
+  uint16_t  count[PM_HALT+1] = { 0, 0, 0, 0 };
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // configure LED pin as output
+  LED_PORT.DDR.byte |= LED_PIN;     // input(=0) or output(=1)
+  LED_PORT.CR1.byte |= LED_PIN;     // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+
+  // configure button pin as input with interrupt. Discovery: high active, muBoard: low active with pull-up
+  BUTTON_PORT.DDR.byte &= ~BUTTON_PIN;
+  BUTTON_PORT.CR2.byte |= BUTTON_PIN;
+  #if defined(FAMILY_STM8L)
+    sfr_ITC_EXTI.CR1.P1IS = 1;      // rising edge
+  #else
+    BUTTON_PORT.CR1.byte |= BUTTON_PIN;
+    sfr_ITC.CR2.PEIS = 2;           // falling edge
+  #endif
+
+  // init 1ms clock and power manager
+  TIM4_init();
+  PM_begin();
+
+  // keep 1ms clock in WAIT. Register button as wake source
+  PM_keepClocks(PCK1_TIM4, 0x00);
+  PM_wakeSource(1);
+
+  // init UART. Limits power manager to WAIT during transmission
+  UART_begin(19200);
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // print message
+  printf("reset\n");
+
+  // main loop
+  while(1) {
+
+    // flash LED
+    if ((int32_t) (millis() - nextLed) >= 0) {
+      ledOn ^= 1;
+      LED_PORT.ODR.byte ^= LED_PIN;
+      nextLed += (ledOn ? LED_ON_TIME : (LED_PERIOD - LED_ON_TIME));
+    }
+    PM_deadline(nextLed);
+
+    // on button press print status
+    if (g_button) {
+      g_button = 0;
+      printf("%lums: run %u, wait %u, active-halt %u, halt %u\n", (unsigned long) millis(),
+        count[PM_RUN], count[PM_WAIT], count[PM_ACTIVE_HALT], count[PM_HALT]);
+    }
+
+    // enter deepest allowed low-power mode
+    count[PM_idle()]++;
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,520 @@
+/**
+  \file power_mgr.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of power manager selecting WAIT, active-halt or halt
+
+  implementation of a power manager which enters the deepest low-power mode
+  allowed by driver constraints and the next pending deadline. Wake from
+  active-halt is via AWU (STM8S) or RTC wake-up timer (STM8L).
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "power_mgr.h"
+#include "timer4.h"
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// number of active constraints per mode (PM_RUN..PM_ACTIVE_HALT)
+static uint8_t            m_lock[PM_HALT];
+
+/// number of registered external wake sources
+static uint8_t            m_wakeSources;
+
+/// peripheral clocks kept in WAIT mode (masks for CLK_PCKENR1/2)
+static uint8_t            m_keep1, m_keep2;
+
+/// earliest deadline reported since last PM_idle() [ms]
+static uint32_t           m_deadline;
+
+/// skip next sleep. Set via PM_wake()
+static volatile uint8_t   m_pending;
+
+/// wake via wake-up timer. Set in PM_TIMER_ISR
+static volatile uint8_t   m_timerWake;
+
+/// registered notifiers
+static pm_notifier_t      m_notifier[PM_MAX_NOTIFIERS];
+
+/// number of registered notifiers
+static uint8_t            m_numNotifiers;
+
+
+
+/**
+  \fn void PM_startTimer(uint16_t ms)
+
+  \brief start wake-up timer for active-halt
+
+  \param[in]  ms    sleep duration [ms] within [1;PM_MAX_SLEEP]
+*/
+static void PM_startTimer(uint16_t ms) {
+
+  // STM8S: AWU with LSI (see AWU_setTime() in example low-power_auto-wake)
+  #if defined(FAMILY_STM8S)
+
+    #define AWU_NUM  9
+    const uint16_t  timeMax[AWU_NUM]  = {    32,   64,  128,  256,  512, 1024, 2048, 5120, 30720 };  // max. wake period [ms]
+    const uint16_t  scalFreq[AWU_NUM] = { 16384, 8192, 4096, 2048, 1024,  512,  256,  102,    17 };  // AWU frequency [Hz*8.192]
+    uint8_t         TBR, APR;
+
+    // find smallest TBR for best accuracy
+    for (TBR = 0; TBR < AWU_NUM-1; TBR++)
+      if (ms <= timeMax[TBR])
+        break;
+
+    // find corresponding APR counter value. Use scaled frequency and bit shift operation
+    APR = (uint8_t) ((((uint32_t) ms * (uint32_t) scalFreq[TBR]) >> 13)) - 2;
+
+    // clip APR to valid range
+    if (APR > 0x3E) APR = 0x3E;
+
+    // add TBR offset (above windows ignore lowest 6 TBR settings with dt<1ms)
+    TBR += 7;
+
+    // set AWU timebase and prescaler, enable wake and AWU interrupt
+    sfr_AWU.TBR.AWUTB  = TBR;
+    sfr_AWU.APR.APR    = APR;
+    sfr_AWU.CSR1.AWUEN = 1;
+
+  // STM8L: RTC wake-up timer with RTCCLK/16
+  #else
+
+    uint16_t  ticks;
+
+    // number of timer ticks
+    ticks = (uint16_t) (((uint32_t) ms * (F_RTC / 16)) / 1000L);
+    if (ticks == 0)
+      ticks = 1;
+
+    // unlock RTC write protection
+    sfr_RTC.WPR.byte = 0xCA;
+    sfr_RTC.WPR.byte = 0x53;
+
+    // stop timer and wait until reload value can be changed
+    sfr_RTC.CR2.WUTE = 0;
+    while (!sfr_RTC.ISR1.WUTWF);
+
+    // set clock RTCCLK/16 and reload value. Period is WUTR+1
+    sfr_RTC.CR1.WUCKSEL = 0;
+    sfr_RTC.WUTRH.byte  = (uint8_t) ((ticks - 1) >> 8);
+    sfr_RTC.WUTRL.byte  = (uint8_t) (ticks - 1);
+
+    // clear pending flag, enable interrupt and start timer
+    sfr_RTC.ISR2.WUTF  = 0;
+    sfr_RTC.CR2.WUTIE  = 1;
+    sfr_RTC.CR2.WUTE   = 1;
+
+    // lock RTC write protection
+    sfr_RTC.WPR.byte = 0xFF;
+
+  #endif
+
+} // PM_startTimer
+
+
+
+/**
+  \fn void PM_stopTimer(void)
+
+  \brief stop wake-up timer after active-halt
+
+  stop timer to avoid wake from a following halt
+*/
+static void PM_stopTimer(void) {
+
+  // STM8S: disable AWU and its counter
+  #if defined(FAMILY_STM8S)
+    sfr_AWU.CSR1.AWUEN = 0;
+    sfr_AWU.TBR.AWUTB  = 0;
+
+  // STM8L: stop RTC wake-up timer
+  #else
+    sfr_RTC.WPR.byte = 0xCA;
+    sfr_RTC.WPR.byte = 0x53;
+    sfr_RTC.CR2.WUTIE = 0;
+    sfr_RTC.CR2.WUTE  = 0;
+    sfr_RTC.WPR.byte = 0xFF;
+  #endif
+
+} // PM_stopTimer
+
+
+
+/**
+  \fn uint8_t PM_select(uint32_t sleep)
+
+  \brief select deepest allowed low-power mode
+
+  \param[in]  sleep   time until next deadline [ms] or PM_NO_DEADLINE
+
+  \return selected power mode
+*/
+static uint8_t PM_select(uint32_t sleep) {
+
+  uint8_t   mode;
+
+  // deadline due or main loop pass requested
+  if ((m_pending) || (sleep == 0))
+    return(PM_RUN);
+
+  // shallowest mode limited by a driver. If none, allow halt
+  for (mode=PM_RUN; mode<PM_HALT; mode++) {
+    if (m_lock[mode])
+      break;
+  }
+
+  // for short sleeps halt wake-up latency and lost 1ms ticks dominate -> use WAIT
+  if ((mode >= PM_ACTIVE_HALT) && (sleep < PM_MIN_HALT))
+    mode = PM_WAIT;
+
+  // deadline pending or no external wake source -> use wake-up timer
+  if ((mode == PM_HALT) && ((sleep != PM_NO_DEADLINE) || (m_wakeSources == 0)))
+    mode = PM_ACTIVE_HALT;
+
+  return(mode);
+
+} // PM_select
+
+
+
+/**
+  \fn void PM_begin(void)
+
+  \brief init power manager and wake-up timer
+
+  reset all constraints, wake sources and notifiers, and configure halt mode
+  for lowest consumption. On STM8L the RTC clock is started (LSE or LSI).
+*/
+void PM_begin(void) {
+
+  uint8_t   i;
+
+  // reset module variables
+  for (i=0; i<PM_HALT; i++)
+    m_lock[i] = 0;
+  m_wakeSources  = 0;
+  m_keep1        = 0;
+  m_keep2        = 0;
+  m_deadline     = PM_NO_DEADLINE;
+  m_pending      = 0;
+  m_timerWake    = 0;
+  m_numNotifiers = 0;
+
+  // STM8S
+  #if defined(FAMILY_STM8S)
+
+    // switch off main regulator during halt mode
+    sfr_CLK.ICKR.REGAH = 1;
+
+    // power down flash during halt mode
+    sfr_FLASH.CR1.AHALT = 1;
+
+    // stop AWU
+    PM_stopTimer();
+
+  // STM8L
+  #else
+
+    // enable RTC clock
+    sfr_CLK.PCKENR2.PCKEN22 = 1;
+
+    // start LSE or LSI and select as RTC clock with prescaler 1
+    #if defined(PM_RTC_LSE)
+      sfr_CLK.ECKR.LSEON = 1;
+      while (!sfr_CLK.ECKR.LSERDY);
+      sfr_CLK.CRTCR.byte = 0x10;
+    #else
+      sfr_CLK.ICKCR.LSION = 1;
+      while (!sfr_CLK.ICKCR.LSIRDY);
+      sfr_CLK.CRTCR.byte = 0x04;
+    #endif
+    while (sfr_CLK.CRTCR.RTCSWBSY);
+
+    // switch off main regulator during (active-)halt mode
+    sfr_CLK.ICKCR.SAHALT = 1;
+
+    // switch off internal reference voltage during halt, and don't wait for it on wake
+    sfr_PWR.CSR2.ULP = 1;
+    sfr_PWR.CSR2.FWU = 1;
+
+    // stop RTC wake-up timer
+    PM_stopTimer();
+
+  #endif
+
+} // PM_begin
+
+
+
+/**
+  \fn uint8_t PM_attach(pm_notifier_t fn)
+
+  \brief register notifier for sleep and wake
+
+  \param[in]  fn    notifier, called with PM_SUSPEND before and PM_RESUME after sleep
+
+  \return notifier registered(=1) or table full(=0)
+
+  notifiers are called from PM_idle() with interrupts disabled, e.g. to
+  power down an ADC or save registers. Call with interrupts disabled.
+*/
+uint8_t PM_attach(pm_notifier_t fn) {
+
+  // table full
+  if (m_numNotifiers >= PM_MAX_NOTIFIERS)
+    return(0);
+
+  // add notifier
+  m_notifier[m_numNotifiers++] = fn;
+  return(1);
+
+} // PM_attach
+
+
+
+/**
+  \fn void PM_constrain(uint8_t mode)
+
+  \brief limit deepest low-power mode
+
+  \param[in]  mode    deepest allowed mode (PM_RUN..PM_ACTIVE_HALT)
+
+  limit deepest mode while a driver is active, e.g. PM_WAIT while UART is sending.
+  Calls are counted and must be matched by PM_release(). Call with interrupts
+  disabled or from ISR.
+*/
+void PM_constrain(uint8_t mode) {
+
+  if (mode < PM_HALT)
+    m_lock[mode]++;
+
+} // PM_constrain
+
+
+
+/**
+  \fn void PM_release(uint8_t mode)
+
+  \brief release limit of deepest low-power mode
+
+  \param[in]  mode    mode passed to PM_constrain()
+
+  Call with interrupts disabled or from ISR.
+*/
+void PM_release(uint8_t mode) {
+
+  if ((mode < PM_HALT) && (m_lock[mode]))
+    m_lock[mode]--;
+
+} // PM_release
+
+
+
+/**
+  \fn void PM_wakeSource(uint8_t enable)
+
+  \brief register or unregister an external wake source
+
+  \param[in]  enable  register(=1) or unregister(=0) source
+
+  halt without wake-up timer is only entered if at least one wake source, e.g.
+  an EXTI pin, is registered. Call with interrupts disabled or from ISR.
+*/
+void PM_wakeSource(uint8_t enable) {
+
+  if (enable)
+    m_wakeSources++;
+  else if (m_wakeSources)
+    m_wakeSources--;
+
+} // PM_wakeSource
+
+
+
+/**
+  \fn void PM_keepClocks(uint8_t pckenr1, uint8_t pckenr2)
+
+  \brief keep peripheral clocks in WAIT mode
+
+  \param[in]  pckenr1   mask for CLK_PCKENR1
+  \param[in]  pckenr2   mask for CLK_PCKENR2
+
+  in WAIT mode all peripheral clocks not registered here are gated, and
+  restored after wake. Masks of all calls are accumulated.
+*/
+void PM_keepClocks(uint8_t pckenr1, uint8_t pckenr2) {
+
+  m_keep1 |= pckenr1;
+  m_keep2 |= pckenr2;
+
+} // PM_keepClocks
+
+
+
+/**
+  \fn void PM_deadline(uint32_t time)
+
+  \brief report next deadline
+
+  \param[in]  time    deadline [ms] in millis() time
+
+  report time at which the main loop must run again. The earliest deadline
+  reported since the last PM_idle() is used.
+*/
+void PM_deadline(uint32_t time) {
+
+  // keep earliest deadline (overflow-safe)
+  if ((m_deadline == PM_NO_DEADLINE) || ((int32_t) (time - m_deadline) < 0))
+    m_deadline = time;
+
+} // PM_deadline
+
+
+
+/**
+  \fn void PM_wake(void)
+
+  \brief skip next sleep
+
+  call from ISR after setting a flag for the main loop. This avoids entering
+  halt in case the interrupt occurs after the main loop checked its flags.
+*/
+void PM_wake(void) {
+
+  m_pending = 1;
+
+} // PM_wake
+
+
+
+/**
+  \fn uint8_t PM_idle(void)
+
+  \brief enter deepest allowed low-power mode
+
+  \return entered mode
+
+  select mode from constraints, wake sources and next deadline, notify drivers
+  and enter mode. After wake restore peripheral clocks, advance g_millis by the
+  slept time on timer wake, and notify drivers again. Call from main loop after
+  all deadlines are reported via PM_deadline().
+*/
+uint8_t PM_idle(void) {
+
+  uint32_t  sleep;
+  uint8_t   mode, pck1, pck2, i;
+
+  // disable interrupts until WFI/HALT (both re-enable interrupts)
+  DISABLE_INTERRUPTS();
+
+  // time until next deadline
+  sleep = PM_NO_DEADLINE;
+  if (m_deadline != PM_NO_DEADLINE) {
+    if ((int32_t) (m_deadline - g_millis) > 0)
+      sleep = m_deadline - g_millis;
+    else
+      sleep = 0;
+  }
+  m_deadline = PM_NO_DEADLINE;
+
+  // select mode
+  mode = PM_select(sleep);
+  m_pending = 0;
+  if (mode == PM_RUN) {
+    ENABLE_INTERRUPTS();
+    return(PM_RUN);
+  }
+
+  // notify drivers before sleep
+  for (i=0; i<m_numNotifiers; i++)
+    m_notifier[i](PM_SUSPEND, mode);
+
+  // WAIT: gate unused peripheral clocks. Wake via any interrupt, e.g. 1ms tick
+  if (mode == PM_WAIT) {
+    pck1 = sfr_CLK.PCKENR1.byte;
+    pck2 = sfr_CLK.PCKENR2.byte;
+    sfr_CLK.PCKENR1.byte = pck1 & m_keep1;
+    sfr_CLK.PCKENR2.byte = pck2 & m_keep2;
+
+    WAIT_FOR_INTERRUPT();
+    DISABLE_INTERRUPTS();
+
+    sfr_CLK.PCKENR1.byte = pck1;
+    sfr_CLK.PCKENR2.byte = pck2;
+  }
+
+  // (active-)halt: all clocks stopped incl. 1ms tick
+  else {
+    if (mode == PM_ACTIVE_HALT) {
+      if (sleep > PM_MAX_SLEEP)
+        sleep = PM_MAX_SLEEP;
+      PM_startTimer((uint16_t) sleep);
+    }
+    m_timerWake = 0;
+
+    ENTER_HALT();
+    DISABLE_INTERRUPTS();
+
+    // stop wake-up timer and advance 1ms clock by slept time
+    if (mode == PM_ACTIVE_HALT) {
+      PM_stopTimer();
+      if (m_timerWake)
+        g_millis += sleep;
+    }
+  }
+
+  // notify drivers after wake
+  for (i=0; i<m_numNotifiers; i++)
+    m_notifier[i](PM_RESUME, mode);
+
+  ENABLE_INTERRUPTS();
+
+  return(mode);
+
+} // PM_idle
+
+
+
+/**
+  \fn void PM_TIMER_ISR(void)
+
+  \brief ISR for wake-up timer
+
+  interrupt service routine for AWU (STM8S) or RTC wake-up timer (STM8L).
+  Clear flag (mandatory) and mark wake via timer
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+#if defined(FAMILY_STM8S)
+  ISR_HANDLER(PM_TIMER_ISR, _AWU_VECTOR_)
+#else
+  ISR_HANDLER(PM_TIMER_ISR, _RTC_WAKEUP_VECTOR_)
+#endif
+{
+  // reset wakeup flag
+  #if defined(FAMILY_STM8S)
+    sfr_AWU.CSR1.AWUF = 0;
+  #else
+    sfr_RTC.ISR2.WUTF = 0;
+  #endif
+
+  // mark wake via timer
+  m_timerWake = 1;
+
+} // PM_TIMER_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
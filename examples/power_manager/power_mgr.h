@@ -0,0 +1,141 @@
+/**
+  \file power_mgr.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of power manager selecting WAIT, active-halt or halt
+
+  declaration of a power manager which enters the deepest low-power mode allowed
+  by the drivers and by the next pending deadline. Drivers register
+    - constraints via PM_constrain()/PM_release(), e.g. UART limits to WAIT while sending
+    - external wake sources via PM_wakeSource(), e.g. a button EXTI
+    - peripheral clocks required in WAIT via PM_keepClocks(). Other clocks are gated
+    - notifiers via PM_attach(), which are called before sleep and after wake
+  and the application reports the next deadline via PM_deadline() before calling
+  PM_idle() from the main loop.
+
+  Mode selection in PM_idle():
+    - deadline due or PM_wake() called since last PM_idle() -> no sleep
+    - deadline within PM_MIN_HALT or halt blocked by driver -> WAIT, 1ms tick continues
+    - deadline pending or no wake source -> active-halt with AWU (STM8S) or
+      RTC wake-up timer (STM8L). g_millis is advanced by sleep time on timer wake
+    - else -> halt, wake only via external interrupt
+
+  \note
+  - constraint, wake source and notifier functions are not reentrant. Call them
+    with interrupts disabled or from an ISR
+  - on early wake via EXTI from active-halt the slept time is unknown and g_millis
+    is not corrected, i.e. it lags by up to the programmed sleep time
+  - wake timer is based on LSI (STM8S) or LSI/LSE (STM8L). LSI is inaccurate
+    by up to +/-12%, see datasheet
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _POWER_MGR_H_
+#define _POWER_MGR_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// power modes, sorted by increasing depth
+#define PM_RUN              0         ///< no sleep
+#define PM_WAIT             1         ///< CPU stopped, peripherals clocked, wake via any interrupt
+#define PM_ACTIVE_HALT      2         ///< only LSI/LSE active, wake via wake-up timer or EXTI
+#define PM_HALT             3         ///< all clocks off, wake only via EXTI
+
+// notifier events
+#define PM_SUSPEND          0         ///< called before entering low-power mode
+#define PM_RESUME           1         ///< called after wake
+
+/// no deadline pending
+#define PM_NO_DEADLINE      0xFFFFFFFF
+
+// min. sleep time [ms] for (active) halt, shorter sleeps use WAIT. Default can be overwritten in config.h
+#ifndef PM_MIN_HALT
+  #define PM_MIN_HALT       10
+#endif
+
+// max. number of notifiers. Default can be overwritten in config.h
+#ifndef PM_MAX_NOTIFIERS
+  #define PM_MAX_NOTIFIERS  4
+#endif
+
+// max. sleep time [ms] in active-halt, limited by wake-up timer. Longer sleeps are split
+#if defined(FAMILY_STM8S)
+  #define PM_MAX_SLEEP      30000
+#else
+  #define PM_MAX_SLEEP      27000
+#endif
+
+// RTC clock [Hz] for wake-up timer (STM8L only)
+#if defined(PM_RTC_LSE)
+  #define F_RTC             32768L
+#else
+  #define F_RTC             38000L
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// notifier for power mode changes. Is called with event and mode from PM_idle()
+typedef void (*pm_notifier_t)(uint8_t event, uint8_t mode);
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init power manager and wake-up timer. Call after TIM4_init()
+void PM_begin(void);
+
+/// register notifier for sleep and wake. Returns 1 on success, 0 if table is full
+uint8_t PM_attach(pm_notifier_t fn);
+
+/// limit deepest low-power mode to 'mode'. Calls are counted
+void PM_constrain(uint8_t mode);
+
+/// release limit set via PM_constrain()
+void PM_release(uint8_t mode);
+
+/// register (enable=1) or unregister (enable=0) an external wake source for halt
+void PM_wakeSource(uint8_t enable);
+
+/// keep peripheral clocks in WAIT mode. Masks for CLK_PCKENR1/2 are accumulated
+void PM_keepClocks(uint8_t pckenr1, uint8_t pckenr2);
+
+/// report next deadline [ms] in millis() time. Earliest deadline until PM_idle() is used
+void PM_deadline(uint32_t time);
+
+/// skip next sleep, e.g. after ISR has set flag for main loop
+void PM_wake(void);
+
+/// enter deepest allowed low-power mode. Returns entered mode
+uint8_t PM_idle(void);
+
+/// ISR for wake-up timer
+#if defined(FAMILY_STM8S)
+  ISR_HANDLER(PM_TIMER_ISR, _AWU_VECTOR_);
+#else
+  ISR_HANDLER(PM_TIMER_ISR, _RTC_WAKEUP_VECTOR_);
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _POWER_MGR_H_
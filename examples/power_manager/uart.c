@@ -0,0 +1,191 @@
+/**
+  \file uart.c
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief implementation of interrupt driven UART transmission with power manager
+   
+  implementation of interrupt driven UART transmission via FIFO. The first byte
+  limits the power manager to WAIT mode, the transmission complete interrupt
+  of the last byte releases it.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "uart.h"
+#include "power_mgr.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+/// index mask for FIFO
+#define UART_TX_MASK        (UART_TX_SIZE - 1)
+
+// check FIFO size at compile time (negative array size on error)
+typedef char uart_check_size[(((UART_TX_SIZE & UART_TX_MASK) == 0) && (UART_TX_SIZE <= 128)) ? 1 : -1];
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// Tx FIFO
+static uint8_t            m_txBuf[UART_TX_SIZE];
+
+/// FIFO write and read index
+static volatile uint8_t   m_txHead, m_txTail;
+
+/// transmission ongoing, power manager is limited to WAIT
+static volatile uint8_t   m_busy;
+
+
+
+/**
+  \fn void UART_begin(uint32_t BR)
+   
+  \brief initialize UART for interrupt driven transmission
+  
+  \param[in]  BR    baudrate [Baud]
+
+  initialize UART for communication with specified baudrate.
+  Use 1 start, 8 data and 1 stop bit; no parity or flow control.
+  UART clock is kept in WAIT mode.
+*/
+void UART_begin(uint32_t BR) {
+
+  uint16_t  val16;
+
+  // reset FIFO
+  m_txHead = 0;
+  m_txTail = 0;
+  m_busy   = 0;
+
+  // for low-power device enable clock gating to USART1
+  #if defined(FAMILY_STM8L)
+    sfr_CLK.PCKENR1.PCKEN15 = 1;
+  #endif
+
+  // keep UART clock in WAIT mode
+  PM_keepClocks(PCK1_UART, 0x00);
+
+  // set UART behaviour
+  sfr_UART.CR1.byte = 0x00;   // enable UART, 8 data bits, no parity control
+  sfr_UART.CR2.byte = 0x00;   // no interrupts, disable sender/receiver
+  sfr_UART.CR3.byte = 0x00;   // 1 stop bit, no clock output
+
+  // set baudrate for fMaster=16MHz (note: BRR2 must be written before BRR1!)
+  val16 = (uint16_t) ((16000000L + BR/2) / BR);
+  sfr_UART.BRR2.byte = (uint8_t) (((val16 & 0xF000) >> 8) | (val16 & 0x000F));
+  sfr_UART.BRR1.byte = (uint8_t) ((val16 & 0x0FF0) >> 4);
+
+  // enable sender
+  sfr_UART.CR2.TEN = 1;
+
+} // UART_begin
+
+
+
+/**
+  \fn void UART_write(uint8_t data)
+   
+  \brief send byte via FIFO
+  
+  \param[in]  data    byte to send
+
+  store byte in FIFO and enable TXE interrupt. Blocks while FIFO is full.
+  Call with interrupts enabled.
+*/
+void UART_write(uint8_t data) {
+
+  uint8_t   next = (m_txHead + 1) & UART_TX_MASK;
+
+  // wait while FIFO is full
+  while (next == m_txTail);
+
+  // store byte
+  m_txBuf[m_txHead] = data;
+
+  DISABLE_INTERRUPTS();
+
+  // start transmission: limit power manager to WAIT
+  m_txHead = next;
+  if (!m_busy) {
+    m_busy = 1;
+    PM_constrain(PM_WAIT);
+  }
+
+  // enable TXE interrupt
+  sfr_UART.CR2.TCIEN = 0;
+  sfr_UART.CR2.TIEN  = 1;
+
+  ENABLE_INTERRUPTS();
+
+} // UART_write
+
+
+
+/**
+  \fn uint8_t UART_busy(void)
+   
+  \brief check if transmission is ongoing
+  
+  \return transmission ongoing(=1) or finished(=0)
+*/
+uint8_t UART_busy(void) {
+
+  return(m_busy);
+
+} // UART_busy
+
+
+
+/**
+  \fn void UART_TX_ISR(void)
+   
+  \brief ISR for UART transmit
+   
+  interrupt service routine for UART transmit register empty (TXE) and
+  transmission complete (TC). Send next byte from FIFO. If FIFO is empty,
+  wait for TC and release power manager
+
+  Note: 
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(UART_TX_ISR, UART_TX_VECTOR) {
+
+  // transmit register empty
+  if ((sfr_UART.CR2.TIEN) && (sfr_UART.SR.TXE)) {
+
+    // send next byte
+    if (m_txHead != m_txTail) {
+      sfr_UART.DR.byte = m_txBuf[m_txTail];
+      m_txTail = (m_txTail + 1) & UART_TX_MASK;
+    }
+
+    // FIFO empty -> wait for last byte sent
+    else {
+      sfr_UART.CR2.TIEN  = 0;
+      sfr_UART.CR2.TCIEN = 1;
+    }
+
+  } // TXE
+
+  // last byte sent -> allow halt again
+  else if ((sfr_UART.CR2.TCIEN) && (sfr_UART.SR.TC)) {
+    sfr_UART.CR2.TCIEN = 0;
+    m_busy = 0;
+    PM_release(PM_WAIT);
+  }
+
+} // UART_TX_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,73 @@
+/**
+  \file uart.h
+   
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+   
+  \brief declaration of interrupt driven UART transmission with power manager
+   
+  declaration of interrupt driven UART transmission via FIFO. While data is
+  sent, the power manager is limited to WAIT mode.
+
+  \note
+  - requires fMaster=16MHz
+  - FIFO size must be a power of 2 and <=128
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _UART_H_
+#define _UART_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// size of Tx FIFO [B]. Default can be overwritten in config.h
+#ifndef UART_TX_SIZE
+  #define UART_TX_SIZE      32
+#endif
+
+// select UART instance. STM8L: USART1, STM8S: UART1
+#if defined(sfr_USART1)
+  #define sfr_UART          sfr_USART1
+  #define UART_TX_VECTOR    _USART_T_TXE_VECTOR_
+#elif defined(sfr_UART1)
+  #define sfr_UART          sfr_UART1
+  #define UART_TX_VECTOR    _UART1_T_TXE_VECTOR_
+#else
+  #error UART not defined
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// initialize UART for interrupt driven transmission
+void UART_begin(uint32_t BR);
+
+/// send byte via FIFO. Blocks while FIFO is full. Call with interrupts enabled
+void UART_write(uint8_t data);
+
+/// check if transmission is ongoing
+uint8_t UART_busy(void);
+
+/// ISR for UART transmit (TXE and TC)
+ISR_HANDLER(UART_TX_ISR, UART_TX_VECTOR);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _UART_H_
@@ -10,6 +10,12 @@
   declaration of P-FLASH functions.
   Access to >16b address range (= P-flash above 32kB due to flash starts @ 0x8000)
   requires far pointers (Cosmic & IAR) or helper routines (SDCC) 
+
+  \note
+  - block erase and block programming stall the CPU while P-flash is busy, therefore
+    the actual write routine is executed from RAM (IAR: __ramfunc; SDCC & Cosmic:
+    copied to RAM at first use)
+  - data for block programming must reside in RAM
 */
 
 /*-----------------------------------------------------------------------------
@@ -24,6 +30,22 @@
 #include <stdint.h>
 
 
+/*----------------------------------------------------------
+    GLOBAL MACROS
+----------------------------------------------------------*/
+
+/// P-flash block size [B]. Low density devices (<=8kB) use 64B, others 128B
+#if (FLASH_SIZE <= 8192)
+  #define FLASH_BLOCK_SIZE    64
+#else
+  #define FLASH_BLOCK_SIZE    128
+#endif
+
+/// block programming modes for FLASH_writeBlock()
+#define FLASH_BLOCK_STANDARD  0     ///< erase & write block (~6ms)
+#define FLASH_BLOCK_FAST      1     ///< write previously erased block (~3ms)
+
+
 /*----------------------------------------------------------
     GLOBAL FUNCTIONS
 ----------------------------------------------------------*/
@@ -34,6 +56,12 @@ uint8_t FLASH_writeByte(uint32_t addr, uint8_t data);
 /// write 4B to P-flash (big-endian)
 uint8_t FLASH_writeDWord(uint32_t addr, uint32_t data);
 
+/// erase 1 block in P-flash
+uint8_t FLASH_eraseBlock(uint32_t addr);
+
+/// write 1 block to P-flash. Data must be in RAM
+uint8_t FLASH_writeBlock(uint32_t addr, const uint8_t *buf, uint8_t mode);
+
 
 
 /*-----------------------------------------------------------------------------
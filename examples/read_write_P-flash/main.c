@@ -8,6 +8,7 @@
   Functionality:
     - save data to EEPROM
     - read from EEPROM and print to terminal 
+    - erase and write a complete P-flash block from RAM routine
 **********************/
 
 /*----------------------------------------------------------
@@ -27,6 +28,12 @@
 #define NUM_DATA     20
 #define START_ADDR   (FLASH_ADDR_END - NUM_DATA + 1)
 
+// start address for block write (second last block)
+#define BLOCK_ADDR   (FLASH_ADDR_END + 1 - 2*FLASH_BLOCK_SIZE)
+
+// buffer for block write. Must reside in RAM
+uint8_t   block[FLASH_BLOCK_SIZE];
+
 
 
 /**
@@ -91,6 +98,20 @@ void main (void) {
     printf("  0x%lx  %d\n", (START_ADDR+i), (int) (read_1B(START_ADDR+i)));
   printf("done\n");
   
+  // erase block, then write block in fast mode
+  printf("\nwrite block of %dB to P-flash ... ", (int) FLASH_BLOCK_SIZE);
+  for (i=0; i<FLASH_BLOCK_SIZE; i++)
+    block[i] = (uint8_t) (FLASH_BLOCK_SIZE - i);
+  count = FLASH_eraseBlock(BLOCK_ADDR);
+  count &= FLASH_writeBlock(BLOCK_ADDR, block, FLASH_BLOCK_FAST);
+  printf("%s\n", (count ? "ok" : "failed"));
+
+  // verify block
+  count = 0;
+  for (i=0; i<FLASH_BLOCK_SIZE; i++)
+    count += (read_1B(BLOCK_ADDR+i) != block[i]);
+  printf("verify block: %d errors\n", count);
+  
   // dummy main loop
   while(1);
   
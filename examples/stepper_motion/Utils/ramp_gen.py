@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+
+"""
+Generate acceleration tables for the stepper motion engine
+
+Calculates the TIM1 reload values for a trapezoidal (constant acceleration) and an
+S-curve (sinusoidal velocity, limited jerk) ramp from start to max. speed, and writes
+them to a C header. Each table entry is valid for one batch of STEP_BATCH steps, i.e.
+the speed is sampled in the middle of each batch. Both ramps have the same average
+acceleration, the S-curve has a peak acceleration of pi/2 times the average.
+
+The header defines:
+  - STEP_PSC              TIM1 prescaler register value, timer tick is (STEP_PSC+1)/fMaster
+  - STEP_BATCH            steps per batch, i.e. per update interrupt (TIM1_RCR+1)
+  - STEP_PULSE            step pulse width [ticks]
+  - STEP_TRAPEZ_LEN       number of entries of trapezoidal ramp
+  - STEP_SCURVE_LEN       number of entries of S-curve ramp
+  - STEP_TRAPEZ_TABLE     initializer of trapezoidal ramp (ARR values)
+  - STEP_SCURVE_TABLE     initializer of S-curve ramp (ARR values)
+
+usage: ramp_gen.py [-o step_ramp.h] [--fmaster 16000000] [--psc 16] [--start 200]
+                   [--max 20000] [--accel 100000] [--batch 16] [--pulse 3]
+"""
+
+import math
+import argparse
+
+
+def s_curve_position(t, v0, dv, T):
+  """ distance after time t of sinusoidal velocity ramp v0 -> v0+dv in time T """
+  return v0 * t + 0.5 * dv * (t - T / math.pi * math.sin(math.pi * t / T))
+
+
+def s_curve_speed(t, v0, dv, T):
+  """ speed at time t of sinusoidal velocity ramp v0 -> v0+dv in time T """
+  return v0 + 0.5 * dv * (1.0 - math.cos(math.pi * t / T))
+
+
+def trapez_ramp(v0, vmax, accel, batch):
+  """ speeds in the middle of each batch for constant acceleration """
+  speeds = []
+  k = 0
+  while True:
+    v = math.sqrt(v0 * v0 + 2.0 * accel * (k * batch + 0.5 * batch))
+    if v >= vmax:
+      break
+    speeds.append(v)
+    k += 1
+  speeds.append(vmax)
+  return speeds
+
+
+def s_curve_ramp(v0, vmax, accel, batch):
+  """ speeds in the middle of each batch for sinusoidal velocity ramp """
+  dv = vmax - v0
+  T = dv / accel
+  s_end = s_curve_position(T, v0, dv, T)
+  speeds = []
+  k = 0
+  while True:
+    s = k * batch + 0.5 * batch
+    if s >= s_end:
+      break
+
+    # find time for distance via bisection (distance is monotonic in time)
+    lo, hi = 0.0, T
+    for _ in range(60):
+      mid = 0.5 * (lo + hi)
+      if s_curve_position(mid, v0, dv, T) < s:
+        lo = mid
+      else:
+        hi = mid
+    speeds.append(s_curve_speed(lo, v0, dv, T))
+    k += 1
+  speeds.append(vmax)
+  return speeds
+
+
+def reload_values(speeds, f_tim, pulse):
+  """ convert speeds [steps/s] to TIM1 reload values. Period is ARR+1 """
+  values = []
+  for v in speeds:
+    arr = int(round(f_tim / v)) - 1
+    if arr > 0xFFFF:
+      raise SystemExit('error: speed %.1f steps/s too low for prescaler, increase --psc' % v)
+    if arr <= pulse:
+      raise SystemExit('error: speed %.1f steps/s too high for pulse width, decrease --pulse or --psc' % v)
+    values.append(arr)
+  return values
+
+
+def write_table(out, name, values):
+  """ write table initializer macro with 8 values per line """
+  out.write('#define %s \\\n' % name)
+  for i in range(0, len(values), 8):
+    line = ', '.join('%5d' % v for v in values[i:i+8])
+    last = (i + 8 >= len(values))
+    out.write('  %s%s\n' % (line, '' if last else ', \\'))
+  out.write('\n')
+
+
+def write_header(out, args, trapez, scurve):
+  """ write C header with ramp tables """
+
+  f_tim = args.fmaster / args.psc
+  out.write('''/**
+  \\file step_ramp.h
+
+  \\brief acceleration tables for stepper motion engine
+
+  TIM1 reload values per batch of steps for trapezoidal and S-curve ramps.
+  Parameters: fMaster=%dHz, prescaler=%d, start=%dsteps/s, max=%dsteps/s,
+  acceleration=%dsteps/s^2, batch=%dsteps, pulse=%dticks
+
+  \\note
+  - this file is generated by Utils/ramp_gen.py. Do not edit, but re-generate
+    after changes of the ramp parameters
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _STEP_RAMP_H_
+#define _STEP_RAMP_H_
+
+''' % (args.fmaster, args.psc, args.start, args.max, args.accel, args.batch, args.pulse))
+
+  out.write('#define %-24s %-8d // timer tick %gus\n' % ('STEP_PSC', args.psc - 1, 1e6 / f_tim))
+  out.write('#define %-24s %d\n' % ('STEP_BATCH', args.batch))
+  out.write('#define %-24s %d\n' % ('STEP_PULSE', args.pulse))
+  out.write('#define %-24s %d\n' % ('STEP_TRAPEZ_LEN', len(trapez)))
+  out.write('#define %-24s %d\n' % ('STEP_SCURVE_LEN', len(scurve)))
+  out.write('\n')
+  write_table(out, 'STEP_TRAPEZ_TABLE', trapez)
+  write_table(out, 'STEP_SCURVE_TABLE', scurve)
+
+  out.write('''
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _STEP_RAMP_H_
+''')
+
+
+if __name__ == "__main__":
+
+  parser = argparse.ArgumentParser(description='generate acceleration tables for stepper motion engine')
+  parser.add_argument('-o', '--output', default='step_ramp.h', help='output header')
+  parser.add_argument('--fmaster', type=int, default=16000000, help='master clock [Hz]')
+  parser.add_argument('--psc', type=int, default=16, help='TIM1 prescaler 1..65536')
+  parser.add_argument('--start', type=int, default=200, help='start/stop speed [steps/s]')
+  parser.add_argument('--max', type=int, default=20000, help='max. speed [steps/s]')
+  parser.add_argument('--accel', type=int, default=100000, help='average acceleration [steps/s^2]')
+  parser.add_argument('--batch', type=int, default=16, help='steps per batch 1..256 (TIM1 repetition counter)')
+  parser.add_argument('--pulse', type=int, default=3, help='step pulse width [timer ticks]')
+  args = parser.parse_args()
+
+  # check parameters
+  if not (1 <= args.batch <= 256):
+    raise SystemExit('error: batch must be 1..256')
+  if not (1 <= args.psc <= 65536):
+    raise SystemExit('error: prescaler must be 1..65536')
+  if not (0 < args.start < args.max):
+    raise SystemExit('error: require 0 < start < max speed')
+
+  # calculate ramps
+  f_tim = args.fmaster / args.psc
+  trapez = reload_values(trapez_ramp(args.start, args.max, args.accel, args.batch), f_tim, args.pulse)
+  scurve = reload_values(s_curve_ramp(args.start, args.max, args.accel, args.batch), f_tim, args.pulse)
+  if max(len(trapez), len(scurve)) > 255:
+    raise SystemExit('error: ramp too long (>255 batches), increase --batch or --accel')
+
+  with open(args.output, 'w') as out:
+    write_header(out, args, trapez, scurve)
+
+  print("wrote ramps with %d (trapezoidal) and %d (S-curve) batches to '%s'" % (len(trapez), len(scurve), args.output))
@@ -0,0 +1,46 @@
+/**
+  \file config.h
+   
+  \brief set project configurations
+   
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    SELECT BOARD
+----------------------------------------------------------*/
+//#define STM8L_DISCOVERY
+#define SDUINO
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#if defined(STM8L_DISCOVERY)
+  #include "../../include/STM8L152C6.h"
+  #define STEP_PORT  sfr_PORTD          // STEP=TIM1_CH1=PD2
+  #define STEP_PIN   PIN2
+  #define DIR_PORT   sfr_PORTD          // DIR=PD3
+  #define DIR_PIN    PIN3
+#elif defined(SDUINO)
+  #include "../../include/STM8S105K6.h"
+  #define STEP_PORT  sfr_PORTC          // STEP=TIM1_CH1=PC1
+  #define STEP_PIN   PIN1
+  #define DIR_PORT   sfr_PORTC          // DIR=PC2
+  #define DIR_PIN    PIN2
+#else
+  #error undefined board
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
@@ -0,0 +1,126 @@
+/**********************
+  Stepper motion profiles with acceleration tables and TIM1 repetition counter
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - step pulses on TIM1_CH1 (Sduino: PC1, Discovery: PD2), direction on
+      DIR pin (Sduino: PC2, Discovery: PD3) for a step/direction driver
+    - queue a sequence of moves with trapezoidal and S-curve ramps, reduced
+      speed and a short (triangular) move. Moves are executed without gaps
+    - TIM1 interrupt only once per batch of 16 steps
+    - every 200ms print position via UART
+    - after sequence is finished wait 1s and repeat
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "stepper.h"
+#undef _MAIN_
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint32_t  nextPrint = 200, nextStart = 0;
+  uint8_t   idle = 0;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // STEP and DIR pins to push-pull outputs
+  STEP_PORT.DDR.byte |= STEP_PIN;   // input(=0) or output(=1)
+  STEP_PORT.CR1.byte |= STEP_PIN;   // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+  STEP_PORT.CR2.byte |= STEP_PIN;   // input: 0=no exint, 1=exint; output: 0=2MHz slope, 1=10MHz slope
+  DIR_PORT.DDR.byte  |= DIR_PIN;
+  DIR_PORT.CR1.byte  |= DIR_PIN;
+
+  // init UART for 19.2kBaud
+  UART_begin(19200);
+
+  // init 1ms tick
+  TIM4_init();
+
+  // init stepper engine
+  STEP_begin();
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // when sequence is finished, wait 1s and queue it again
+    if (!STEP_busy()) {
+      if (!idle) {
+        idle = 1;
+        nextStart = millis() + 1000;
+        printf("done at %ld\n", (long) STEP_position());
+      }
+      else if ((int32_t) (millis() - nextStart) >= 0) {
+        idle = 0;
+        STEP_move(10000, 0, STEP_TRAPEZ);     // full speed, trapezoidal
+        STEP_move(-10000, 0, STEP_SCURVE);    // full speed, S-curve
+        STEP_move(4000, 40, STEP_SCURVE);     // reduced speed
+        STEP_move(-500, 0, STEP_TRAPEZ);      // short move, triangular profile
+        STEP_move(-3500, 0, STEP_TRAPEZ);     // back to start
+      }
+    }
+
+    // every 200ms print position
+    if ((int32_t) (millis() - nextPrint) >= 0) {
+      nextPrint += 200;
+      if (STEP_busy())
+        printf("pos %ld\n", (long) STEP_position());
+    }
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,67 @@
+/**
+  \file step_ramp.h
+
+  \brief acceleration tables for stepper motion engine
+
+  TIM1 reload values per batch of steps for trapezoidal and S-curve ramps.
+  Parameters: fMaster=16000000Hz, prescaler=16, start=200steps/s, max=20000steps/s,
+  acceleration=100000steps/s^2, batch=16steps, pulse=3ticks
+
+  \note
+  - this file is generated by Utils/ramp_gen.py. Do not edit, but re-generate
+    after changes of the ramp parameters
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _STEP_RAMP_H_
+#define _STEP_RAMP_H_
+
+#define STEP_PSC                 15       // timer tick 1us
+#define STEP_BATCH               16
+#define STEP_PULSE               3
+#define STEP_TRAPEZ_LEN          126
+#define STEP_SCURVE_LEN          126
+
+#define STEP_TRAPEZ_TABLE \
+    780,   454,   352,   297,   262,   237,   218,   203, \
+    191,   180,   171,   164,   157,   151,   146,   141, \
+    137,   133,   129,   126,   122,   120,   117,   114, \
+    112,   110,   108,   106,   104,   102,   100,    99, \
+     97,    96,    94,    93,    92,    90,    89,    88, \
+     87,    86,    85,    84,    83,    82,    81,    80, \
+     79,    78,    78,    77,    76,    75,    75,    74, \
+     73,    73,    72,    71,    71,    70,    70,    69, \
+     69,    68,    68,    67,    67,    66,    66,    65, \
+     65,    64,    64,    63,    63,    62,    62,    62, \
+     61,    61,    61,    60,    60,    59,    59,    59, \
+     58,    58,    58,    57,    57,    57,    57,    56, \
+     56,    56,    55,    55,    55,    54,    54,    54, \
+     54,    53,    53,    53,    53,    52,    52,    52, \
+     52,    51,    51,    51,    51,    51,    50,    50, \
+     50,    50,    50,    49,    49,    49
+
+#define STEP_SCURVE_TABLE \
+   1345,   601,   419,   332,   280,   245,   219,   200, \
+    184,   171,   161,   152,   144,   137,   131,   126, \
+    121,   117,   113,   109,   106,   103,   101,    98, \
+     96,    93,    91,    89,    88,    86,    84,    83, \
+     81,    80,    79,    78,    77,    75,    74,    73, \
+     72,    72,    71,    70,    69,    68,    68,    67, \
+     66,    65,    65,    64,    64,    63,    63,    62, \
+     62,    61,    61,    60,    60,    59,    59,    58, \
+     58,    58,    57,    57,    57,    56,    56,    56, \
+     55,    55,    55,    55,    54,    54,    54,    54, \
+     53,    53,    53,    53,    53,    52,    52,    52, \
+     52,    52,    52,    51,    51,    51,    51,    51, \
+     51,    51,    50,    50,    50,    50,    50,    50, \
+     50,    50,    50,    50,    50,    49,    49,    49, \
+     49,    49,    49,    49,    49,    49,    49,    49, \
+     49,    49,    49,    49,    49,    49
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _STEP_RAMP_H_
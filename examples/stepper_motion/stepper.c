@@ -0,0 +1,466 @@
+/**
+  \file stepper.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of stepper motion engine with TIM1 repetition counter
+
+  implementation of a motion engine for step/direction drivers. Each move is
+  split into batches of STEP_BATCH steps. Batch j of N gets speed level
+  min(j, N-1-j, limit-1) from the acceleration table, i.e. acceleration and
+  deceleration are symmetric. The last batch takes the remaining steps.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "stepper.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// pins for step and direction
+#if !defined(DIR_PORT) || !defined(DIR_PIN)
+  #error DIR_PORT and DIR_PIN must be defined in config.h
+#endif
+
+// timer register bits
+#define CR1_ARPE            0x80      ///< auto-reload preload enable
+#define CR1_URS             0x04      ///< only counter overflow generates update interrupt
+#define CCMR_PWM2           0x70      ///< output compare mode PWM mode 2 (active after compare match)
+#define CCMR_OCPE           0x08      ///< output compare preload enable
+
+// check ramp parameters (negative array size on error)
+typedef char step_check_batch[((STEP_BATCH >= 1) && (STEP_BATCH <= 256)) ? 1 : -1];
+typedef char step_check_queue[((STEP_QUEUE & (STEP_QUEUE - 1)) == 0) ? 1 : -1];
+
+
+/*----------------------------------------------------------
+    TYPEDEFS
+----------------------------------------------------------*/
+
+/// queued move
+typedef struct {
+  uint32_t    steps;          ///< number of steps
+  uint8_t     dir;            ///< direction (1=positive)
+  uint8_t     limit;          ///< number of used ramp levels, i.e. max. speed
+  uint8_t     profile;        ///< ramp profile, e.g. STEP_TRAPEZ
+} step_move_t;
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// trapezoidal ramp, TIM1 reload values per speed level
+static const uint16_t   m_trapez[STEP_TRAPEZ_LEN] = { STEP_TRAPEZ_TABLE };
+
+/// S-curve ramp, TIM1 reload values per speed level
+static const uint16_t   m_scurve[STEP_SCURVE_LEN] = { STEP_SCURVE_TABLE };
+
+/// move queue (ring buffer). Written by main, read by ISR
+static step_move_t      m_queue[STEP_QUEUE];
+static volatile uint8_t m_head, m_tail;
+
+/// current move: ramp, ramp levels, batch index, number of batches, steps in last batch, direction
+static const uint16_t   *m_table;
+static uint8_t          m_limit;
+static uint32_t         m_batch, m_numBatch;
+static uint16_t         m_lastSteps;
+static uint8_t          m_dir;
+
+/// batch running in TIM1 (steps, direction), and batch preloaded for next update (steps, direction, level)
+static uint16_t         m_curSteps, m_preSteps;
+static uint8_t          m_curDir, m_preDir, m_preLevel;
+
+/// step generation active
+static volatile uint8_t m_running;
+
+/// position after last completed batch [steps]
+static volatile int32_t m_position;
+
+
+
+/**
+  \fn void STEP_setDir(uint8_t dir)
+
+  \brief set direction pin
+
+  \param[in]  dir   direction (1=positive)
+*/
+static void STEP_setDir(uint8_t dir) {
+
+  if (dir)
+    DIR_PORT.ODR.byte |= DIR_PIN;
+  else
+    DIR_PORT.ODR.byte &= (uint8_t) ~DIR_PIN;
+
+} // STEP_setDir
+
+
+
+/**
+  \fn uint8_t STEP_next(void)
+
+  \brief preload next batch
+
+  \return 1 if a batch was preloaded, 0 if current move is finished and queue is empty
+
+  fetch next move from queue if required, and write reload, compare and
+  repetition values of the next batch to the TIM1 preload registers. These
+  are transferred with the next update event, i.e. at the end of the
+  running batch. Step pulse is the last STEP_PULSE ticks of each period.
+*/
+static uint8_t STEP_next(void) {
+
+  uint32_t  level;
+  uint16_t  arr, ccr, steps;
+  uint8_t   idx;
+
+  // current move finished -> get next move from queue
+  if (m_batch >= m_numBatch) {
+    if (m_head == m_tail) {
+      m_preSteps = 0;
+      return(0);
+    }
+    idx = m_tail;
+    m_numBatch  = (m_queue[idx].steps + (STEP_BATCH - 1)) / STEP_BATCH;
+    m_lastSteps = (uint16_t) (m_queue[idx].steps - (m_numBatch - 1) * STEP_BATCH);
+    m_dir       = m_queue[idx].dir;
+    m_limit     = m_queue[idx].limit;
+    m_table     = (m_queue[idx].profile == STEP_SCURVE) ? m_scurve : m_trapez;
+    m_batch     = 0;
+    m_tail = (idx + 1) & (STEP_QUEUE - 1);
+  }
+
+  // speed level = min(batches done, batches remaining, limit)
+  level = m_batch;
+  if (level > m_numBatch - 1 - m_batch)
+    level = m_numBatch - 1 - m_batch;
+  if (level > (uint32_t) (m_limit - 1))
+    level = m_limit - 1;
+  arr = m_table[(uint8_t) level];
+  ccr = arr + 1 - STEP_PULSE;
+
+  // steps in this batch
+  steps = (m_batch == m_numBatch - 1) ? m_lastSteps : STEP_BATCH;
+
+  // preload timer registers (MSB first)
+  sfr_TIM1.ARRH.byte  = (uint8_t) (arr >> 8);
+  sfr_TIM1.ARRL.byte  = (uint8_t) arr;
+  sfr_TIM1.CCR1H.byte = (uint8_t) (ccr >> 8);
+  sfr_TIM1.CCR1L.byte = (uint8_t) ccr;
+  sfr_TIM1.RCR.byte   = (uint8_t) (steps - 1);
+
+  // remember for update ISR
+  m_preSteps = steps;
+  m_preDir   = m_dir;
+  m_preLevel = (uint8_t) level;
+  m_batch++;
+
+  return(1);
+
+} // STEP_next
+
+
+
+/**
+  \fn void STEP_start(void)
+
+  \brief start step generation from standstill
+
+  load first batch into timer via update event and preload the second batch.
+  Must be called with TIM1 update interrupt disabled, or from the ISR.
+*/
+static void STEP_start(void) {
+
+  // nothing to do
+  if (!STEP_next())
+    return;
+
+  // first batch becomes active
+  m_curSteps = m_preSteps;
+  m_curDir   = m_preDir;
+  STEP_setDir(m_curDir);
+
+  // load registers and reset counters. Due to URS no interrupt is triggered
+  sfr_TIM1.CR1.OPM = 0;
+  sfr_TIM1.EGR.UG  = 1;
+
+  // preload second batch, else stop after first batch
+  if (!STEP_next())
+    sfr_TIM1.CR1.OPM = 1;
+
+  // start timer
+  m_running = 1;
+  sfr_TIM1.CR1.CEN = 1;
+
+} // STEP_start
+
+
+
+/**
+  \fn void STEP_begin(void)
+
+  \brief init TIM1 for step generation
+
+  TIM1 runs with tick (STEP_PSC+1)/fMaster. Channel 1 is in PWM mode 2 with
+  preloaded compare value. Update interrupt is only triggered at the end of
+  each batch, i.e. when the repetition counter is zero.
+*/
+void STEP_begin(void) {
+
+  // enable TIM1 clock (STM8L only)
+  #if defined(FAMILY_STM8L)
+    sfr_CLK.PCKENR2.PCKEN21 = 1;
+  #endif
+
+  // stop timer, buffered reload, interrupt only on overflow
+  sfr_TIM1.CR1.byte = CR1_ARPE | CR1_URS;
+
+  // set prescaler
+  sfr_TIM1.PSCRH.byte = (uint8_t) (STEP_PSC >> 8);
+  sfr_TIM1.PSCRL.byte = (uint8_t) STEP_PSC;
+
+  // CH1: PWM mode 2 with buffered compare, output low while idle
+  sfr_TIM1.CCMR1.byte = CCMR_PWM2 | CCMR_OCPE;
+  sfr_TIM1.CCR1H.byte = 0xFF;
+  sfr_TIM1.CCR1L.byte = 0xFF;
+  sfr_TIM1.EGR.UG     = 1;
+  sfr_TIM1.CCER1.CC1E = 1;
+  sfr_TIM1.BKR.MOE    = 1;
+
+  // reset state
+  m_head = m_tail = 0;
+  m_batch = m_numBatch = 0;
+  m_curSteps = m_preSteps = 0;
+  m_running = 0;
+  m_position = 0;
+
+  // enable update interrupt
+  sfr_TIM1.SR1.UIF = 0;
+  sfr_TIM1.IER.UIE = 1;
+
+} // STEP_begin
+
+
+
+/**
+  \fn uint8_t STEP_move(int32_t steps, uint8_t speed, uint8_t profile)
+
+  \brief queue relative move
+
+  \param[in]  steps     number of steps. Sign gives direction
+  \param[in]  speed     max. speed level 1..table length, or 0 for full speed
+  \param[in]  profile   ramp profile STEP_TRAPEZ or STEP_SCURVE
+
+  \return 1 on success, 0 if queue is full
+
+  append move to queue. If the engine is idle, the move is started immediately.
+  Speed level n corresponds to the speed reached after n batches of acceleration.
+*/
+uint8_t STEP_move(int32_t steps, uint8_t speed, uint8_t profile) {
+
+  uint8_t   head, len;
+
+  // nothing to do
+  if (steps == 0)
+    return(1);
+
+  // queue is full
+  head = m_head;
+  if (((head + 1) & (STEP_QUEUE - 1)) == m_tail)
+    return(0);
+
+  // store move
+  if (steps > 0) {
+    m_queue[head].steps = (uint32_t) steps;
+    m_queue[head].dir   = 1;
+  }
+  else {
+    m_queue[head].steps = (uint32_t) (-steps);
+    m_queue[head].dir   = 0;
+  }
+  len = (profile == STEP_SCURVE) ? STEP_SCURVE_LEN : STEP_TRAPEZ_LEN;
+  m_queue[head].limit   = ((speed == 0) || (speed > len)) ? len : speed;
+  m_queue[head].profile = profile;
+
+  // append to queue and start if idle. Mask update interrupt for consistency
+  sfr_TIM1.IER.UIE = 0;
+  m_head = (head + 1) & (STEP_QUEUE - 1);
+  if (!m_running)
+    STEP_start();
+  sfr_TIM1.IER.UIE = 1;
+
+  return(1);
+
+} // STEP_move
+
+
+
+/**
+  \fn void STEP_stop(void)
+
+  \brief decelerate and discard queued moves
+
+  shorten current move such that it decelerates from the current speed with
+  the ramp of the move. Position remains valid.
+*/
+void STEP_stop(void) {
+
+  uint32_t  num;
+
+  sfr_TIM1.IER.UIE = 0;
+
+  // discard queue
+  m_tail = m_head;
+
+  // remaining batches for deceleration from level of preloaded batch
+  if (m_running && (m_preSteps != 0)) {
+    num = m_batch + m_preLevel;
+    if (num < m_numBatch) {
+      m_numBatch  = num;
+      m_lastSteps = STEP_BATCH;
+    }
+  }
+
+  sfr_TIM1.IER.UIE = 1;
+
+} // STEP_stop
+
+
+
+/**
+  \fn void STEP_abort(void)
+
+  \brief stop immediately
+
+  stop timer and discard current and queued moves, e.g. on limit switch.
+  Steps of the running batch are not counted, i.e. position is lost.
+*/
+void STEP_abort(void) {
+
+  sfr_TIM1.IER.UIE = 0;
+
+  // stop timer and reset counter, i.e. step output is inactive
+  sfr_TIM1.CR1.CEN = 0;
+  sfr_TIM1.CNTRH.byte = 0x00;
+  sfr_TIM1.CNTRL.byte = 0x00;
+  sfr_TIM1.SR1.UIF = 0;
+
+  // reset state
+  m_tail = m_head;
+  m_batch = m_numBatch = 0;
+  m_curSteps = m_preSteps = 0;
+  m_running = 0;
+
+  sfr_TIM1.IER.UIE = 1;
+
+} // STEP_abort
+
+
+
+/**
+  \fn uint8_t STEP_busy(void)
+
+  \brief check if engine is active
+
+  \return 1 if moving or moves are queued, else 0
+*/
+uint8_t STEP_busy(void) {
+
+  return(m_running || (m_head != m_tail));
+
+} // STEP_busy
+
+
+
+/**
+  \fn int32_t STEP_position(void)
+
+  \brief get position
+
+  \return position after last completed batch [steps]
+*/
+int32_t STEP_position(void) {
+
+  int32_t   pos;
+
+  // read atomically
+  sfr_TIM1.IER.UIE = 0;
+  pos = m_position;
+  sfr_TIM1.IER.UIE = 1;
+
+  return(pos);
+
+} // STEP_position
+
+
+
+/**
+  \fn void STEP_setPosition(int32_t pos)
+
+  \brief set position
+
+  \param[in]  pos   new position [steps]
+
+  set position, e.g. after homing. Call only while engine is idle.
+*/
+void STEP_setPosition(int32_t pos) {
+
+  sfr_TIM1.IER.UIE = 0;
+  m_position = pos;
+  sfr_TIM1.IER.UIE = 1;
+
+} // STEP_setPosition
+
+
+
+/**
+  \fn void STEP_UPD_ISR(void)
+
+  \brief ISR for TIM1 update event
+
+  interrupt service routine at the end of each batch. Count steps of the
+  completed batch, set direction of the new batch and preload the next one.
+  If no batch is left, one-pulse mode stops the timer after the running batch.
+*/
+ISR_HANDLER(STEP_UPD_ISR, _TIM1_OVR_UIF_VECTOR_) {
+
+  // clear interrupt flag
+  sfr_TIM1.SR1.UIF = 0;
+
+  // count steps of completed batch
+  if (m_curDir)
+    m_position += m_curSteps;
+  else
+    m_position -= m_curSteps;
+
+  // timer stopped after last batch -> idle or restart with move queued meanwhile
+  if (!sfr_TIM1.CR1.CEN) {
+    m_curSteps = 0;
+    m_running  = 0;
+    STEP_start();
+    return;
+  }
+
+  // preloaded batch is now active
+  m_curSteps = m_preSteps;
+  m_curDir   = m_preDir;
+  STEP_setDir(m_curDir);
+
+  // preload next batch, else stop after this batch
+  if (!STEP_next())
+    sfr_TIM1.CR1.OPM = 1;
+
+} // STEP_UPD_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
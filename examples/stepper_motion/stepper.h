@@ -0,0 +1,95 @@
+/**
+  \file stepper.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of stepper motion engine with TIM1 repetition counter
+
+  declaration of a motion engine for step/direction drivers of steppers or
+  servos. Step pulses are generated by TIM1 channel 1 in PWM mode 2, i.e.
+  without CPU load. Features:
+    - moves are split into batches of STEP_BATCH steps with the same speed.
+      The repetition counter TIM1_RCR repeats the period for each step of a
+      batch, i.e. there is only one update interrupt per batch
+    - trapezoidal (constant acceleration) or S-curve (limited jerk) ramps.
+      Acceleration tables are calculated at compile time by Utils/ramp_gen.py,
+      see step_ramp.h
+    - moves are queued and executed back-to-back. Reload, compare and
+      repetition registers are preloaded one batch in advance, i.e. there
+      is no gap between batches or moves
+    - short moves automatically result in a triangular profile
+
+  \note
+  - the STEP pin (TIM1_CH1) and DIR pin must be configured as outputs
+  - every move starts and ends at start speed. Blending of moves at speed is
+    not supported
+  - position is updated at the end of each batch, i.e. STEP_position() lags
+    by up to STEP_BATCH steps while moving
+  - if a move is queued after the last batch has started, it is executed
+    after a short gap
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _STEPPER_H_
+#define _STEPPER_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "step_ramp.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// size of move queue (power of 2). Default can be overwritten in config.h
+#ifndef STEP_QUEUE
+  #define STEP_QUEUE        8
+#endif
+
+// ramp profiles for STEP_move()
+#define STEP_TRAPEZ         0         ///< trapezoidal profile (constant acceleration)
+#define STEP_SCURVE         1         ///< S-curve profile (sinusoidal velocity ramp)
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init TIM1 for step generation
+void STEP_begin(void);
+
+/// queue move by relative steps with max. speed level (0=full) and ramp profile. Returns 0 if queue is full
+uint8_t STEP_move(int32_t steps, uint8_t speed, uint8_t profile);
+
+/// decelerate current move and discard queued moves
+void STEP_stop(void);
+
+/// immediately stop step generation and discard queued moves. Position may be lost
+void STEP_abort(void);
+
+/// check if moves are active or queued
+uint8_t STEP_busy(void);
+
+/// get current position [steps]
+int32_t STEP_position(void);
+
+/// set current position [steps], e.g. after homing
+void STEP_setPosition(int32_t pos);
+
+/// ISR for TIM1 update event (once per batch)
+ISR_HANDLER(STEP_UPD_ISR, _TIM1_OVR_UIF_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _STEPPER_H_
@@ -0,0 +1,229 @@
+/**********************
+  Software timer service with many one-shot and periodic timers on a hierarchical timing wheel
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - TIM4 generates 1ms tick, timer wheel is advanced from main loop
+    - NUM_TIMERS periodic timers with periods 1..NUM_TIMERS ms count their expiries
+    - LED blinks via periodic 500ms timer
+    - one-shot timer is re-started from its callback with increasing delay
+    - every 1s print number of callbacks and max. duration of SWT_process() via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "uart.h"
+  #include "sw_timer.h"
+#undef _MAIN_
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+/// number of periodic load timers
+#define NUM_TIMERS      64
+
+
+/*----------------------------------------------------------
+    GLOBAL VARIABLES
+----------------------------------------------------------*/
+
+// load timers and their expiry counters
+swt_t             g_load[NUM_TIMERS];
+uint16_t          g_count[NUM_TIMERS];
+
+// LED, status and one-shot timers
+swt_t             g_blink, g_status, g_oneShot;
+
+// callbacks since last status and max. duration of SWT_process() [ms]
+uint32_t          g_calls = 0;
+uint8_t           g_maxDuration = 0;
+
+
+
+/**
+  \fn void load_callback(swt_t *timer)
+
+  \brief callback for periodic load timers
+
+  \param[in]  timer   expired timer
+
+  count expiries via counter passed as user argument
+*/
+void load_callback(swt_t *timer) {
+
+  (*((uint16_t*) timer->arg))++;
+
+} // load_callback
+
+
+
+/**
+  \fn void blink_callback(swt_t *timer)
+
+  \brief toggle LED
+
+  \param[in]  timer   expired timer
+*/
+void blink_callback(swt_t *timer) {
+
+  (void) timer;
+  LED_PORT.ODR.byte ^= LED_PIN;
+
+} // blink_callback
+
+
+
+/**
+  \fn void oneShot_callback(swt_t *timer)
+
+  \brief one-shot timer, re-started from callback with increasing delay
+
+  \param[in]  timer   expired timer
+*/
+void oneShot_callback(swt_t *timer) {
+
+  static uint32_t delay = 100;
+
+  printf("one-shot at %lums\n", (unsigned long) millis());
+
+  // re-start with longer delay, up to ~1min
+  delay <<= 1;
+  if (delay > 60000L)
+    delay = 100;
+  SWT_start(timer, delay, 0);
+
+} // oneShot_callback
+
+
+
+/**
+  \fn void status_callback(swt_t *timer)
+
+  \brief print statistics
+
+  \param[in]  timer   expired timer
+*/
+void status_callback(swt_t *timer) {
+
+  uint32_t  sum = 0;
+  uint8_t   i;
+
+  (void) timer;
+
+  // sum up expiries of load timers
+  for (i=0; i<NUM_TIMERS; i++) {
+    sum += g_count[i];
+    g_count[i] = 0;
+  }
+
+  printf("time %lums: %lu expiries, %lu callbacks, max %ums\n", (unsigned long) millis(),
+    (unsigned long) sum, (unsigned long) g_calls, (unsigned int) g_maxDuration);
+  g_calls = 0;
+  g_maxDuration = 0;
+
+} // status_callback
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint8_t   i;
+  uint32_t  start, duration;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // configure LED pin as output
+  LED_PORT.DDR.byte |= LED_PIN;     // input(=0) or output(=1)
+  LED_PORT.CR1.byte |= LED_PIN;     // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+
+  // init UART for 19.2kBaud
+  UART_begin(19200);
+
+  // init 1ms tick and timer wheel
+  TIM4_init();
+  SWT_begin();
+
+  // start load timers with periods 1..NUM_TIMERS ms
+  for (i=0; i<NUM_TIMERS; i++) {
+    g_count[i] = 0;
+    SWT_init(&(g_load[i]), load_callback, &(g_count[i]));
+    SWT_start(&(g_load[i]), i+1, i+1);
+  }
+
+  // start LED, status and one-shot timers
+  SWT_init(&g_blink, blink_callback, NULL);
+  SWT_start(&g_blink, 500, 500);
+  SWT_init(&g_status, status_callback, NULL);
+  SWT_start(&g_status, 1000, 1000);
+  SWT_init(&g_oneShot, oneShot_callback, NULL);
+  SWT_start(&g_oneShot, 100, 0);
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // advance timer wheel and call expired timers
+    start = millis();
+    g_calls += SWT_process();
+    duration = millis() - start;
+    if (duration > g_maxDuration)
+      g_maxDuration = (uint8_t) duration;
+
+    // wait for next 1ms tick or other interrupt
+    WAIT_FOR_INTERRUPT();
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,341 @@
+/**
+  \file sw_timer.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of software timers on a hierarchical timing wheel
+
+  implementation of a software timer service on a 3-level hierarchical timing
+  wheel with O(1) start/stop and deferred callbacks.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "sw_timer.h"
+#include "timer4.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+/// mask for slot index
+#define SWT_MASK            (SWT_SLOTS - 1)
+
+/// slot index of tick in level 0..2
+#define SWT_INDEX(t, lvl)   ((uint8_t) (((t) >> ((lvl) * SWT_BITS)) & SWT_MASK))
+
+// check configuration at compile time (negative array size on error)
+typedef char swt_check_bits[((SWT_BITS >= 2) && (SWT_BITS <= 8)) ? 1 : -1];
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// timing wheel: list head per level and slot
+static swt_t      *m_wheel[3][SWT_SLOTS];
+
+/// current wheel tick. All timers up to this tick are processed
+static uint32_t   m_now;
+
+/// temporary list of timers during cascade or expiry
+static swt_t      *m_list;
+
+
+
+/**
+  \fn void SWT_link(swt_t **head, swt_t *timer)
+
+  \brief insert timer at head of list
+
+  \param[in]  head      list head
+  \param[in]  timer     timer to insert
+*/
+static void SWT_link(swt_t **head, swt_t *timer) {
+
+  timer->next = *head;
+  if (timer->next)
+    timer->next->pprev = &(timer->next);
+  timer->pprev = head;
+  *head = timer;
+
+} // SWT_link
+
+
+
+/**
+  \fn void SWT_unlink(swt_t *timer)
+
+  \brief remove timer from its list
+
+  \param[in]  timer     timer to remove. Must be linked
+*/
+static void SWT_unlink(swt_t *timer) {
+
+  *(timer->pprev) = timer->next;
+  if (timer->next)
+    timer->next->pprev = timer->pprev;
+  timer->pprev = NULL;
+
+} // SWT_unlink
+
+
+
+/**
+  \fn void SWT_insert(swt_t *timer)
+
+  \brief insert timer into wheel slot for its expiry
+
+  \param[in]  timer     timer to insert. Expiry must be after m_now
+
+  select level by remaining delay. Delays beyond the wheel range are parked
+  in the last level 2 slot before wrap-around and re-cascaded from there.
+*/
+static void SWT_insert(swt_t *timer) {
+
+  uint32_t  delta = timer->expire - m_now;
+  uint32_t  slot  = timer->expire;
+
+  // level 0: delay < SWT_SLOTS
+  if (delta < SWT_SLOTS)
+    SWT_link(&(m_wheel[0][SWT_INDEX(slot, 0)]), timer);
+
+  // level 1: delay < SWT_SLOTS^2
+  else if (delta < (1L << (2 * SWT_BITS)))
+    SWT_link(&(m_wheel[1][SWT_INDEX(slot, 1)]), timer);
+
+  // level 2: park delays beyond wheel range in last slot
+  else {
+    if (delta > SWT_MAX_DELAY)
+      slot = m_now + SWT_MAX_DELAY;
+    SWT_link(&(m_wheel[2][SWT_INDEX(slot, 2)]), timer);
+  }
+
+} // SWT_insert
+
+
+
+/**
+  \fn void SWT_cascade(uint8_t level, uint8_t index)
+
+  \brief move all timers of a slot to lower levels
+
+  \param[in]  level     wheel level (1 or 2)
+  \param[in]  index     slot index
+*/
+static void SWT_cascade(uint8_t level, uint8_t index) {
+
+  swt_t     *timer;
+
+  // move slot list to temporary list
+  m_list = m_wheel[level][index];
+  m_wheel[level][index] = NULL;
+  if (m_list)
+    m_list->pprev = &m_list;
+
+  // re-insert timers relative to current tick
+  while ((timer = m_list) != NULL) {
+    SWT_unlink(timer);
+    SWT_insert(timer);
+  }
+
+} // SWT_cascade
+
+
+
+/**
+  \fn void SWT_begin(void)
+
+  \brief init timer wheel
+
+  clear all slots and synchronize wheel to current tick. Call after TIM4_init()
+*/
+void SWT_begin(void) {
+
+  uint8_t   lvl, i;
+
+  // clear wheel
+  for (lvl=0; lvl<3; lvl++) {
+    for (i=0; i<SWT_SLOTS; i++)
+      m_wheel[lvl][i] = NULL;
+  }
+  m_list = NULL;
+
+  // synchronize to 1ms tick
+  DISABLE_INTERRUPTS();
+  m_now = g_millis;
+  ENABLE_INTERRUPTS();
+
+} // SWT_begin
+
+
+
+/**
+  \fn void SWT_init(swt_t *timer, swt_callback_t callback, void *arg)
+
+  \brief set callback and user argument of timer
+
+  \param[in]  timer     timer to initialize
+  \param[in]  callback  function called on expiry
+  \param[in]  arg       user argument, e.g. driver context. Read via timer->arg in callback
+
+  initialize timer struct before first start. Timer is stopped.
+*/
+void SWT_init(swt_t *timer, swt_callback_t callback, void *arg) {
+
+  timer->next     = NULL;
+  timer->pprev    = NULL;
+  timer->expire   = 0;
+  timer->period   = 0;
+  timer->callback = callback;
+  timer->arg      = arg;
+
+} // SWT_init
+
+
+
+/**
+  \fn void SWT_start(swt_t *timer, uint32_t delay, uint16_t period)
+
+  \brief (re-)start timer
+
+  \param[in]  timer     timer to start
+  \param[in]  delay     delay [ticks] until first expiry. 0 is handled like 1
+  \param[in]  period    period [ticks] of following expiries, or 0 for one-shot timer
+
+  a running timer is restarted. Delay is relative to the wheel tick, which
+  equals millis() after SWT_process().
+*/
+void SWT_start(swt_t *timer, uint32_t delay, uint16_t period) {
+
+  // stop if running
+  if (timer->pprev)
+    SWT_unlink(timer);
+
+  // set expiry and insert into wheel
+  if (delay == 0)
+    delay = 1;
+  timer->expire = m_now + delay;
+  timer->period = period;
+  SWT_insert(timer);
+
+} // SWT_start
+
+
+
+/**
+  \fn void SWT_stop(swt_t *timer)
+
+  \brief stop timer
+
+  \param[in]  timer     timer to stop
+
+  timer is removed from wheel, i.e. callback is not called. Stopping a stopped
+  timer has no effect.
+*/
+void SWT_stop(swt_t *timer) {
+
+  if (timer->pprev)
+    SWT_unlink(timer);
+
+} // SWT_stop
+
+
+
+/**
+  \fn uint8_t SWT_active(swt_t *timer)
+
+  \brief check if timer is running
+
+  \param[in]  timer     timer to check
+
+  \return timer running(=1) or stopped(=0)
+*/
+uint8_t SWT_active(swt_t *timer) {
+
+  return(timer->pprev != NULL);
+
+} // SWT_active
+
+
+
+/**
+  \fn uint16_t SWT_process(void)
+
+  \brief advance wheel and call callbacks of expired timers
+
+  \return number of called callbacks
+
+  advance wheel tick by tick up to g_millis. For each tick cascade higher
+  levels if required, then expire timers of the current level 0 slot.
+  Periodic timers are re-inserted before their callback is called, i.e. the
+  callback may stop or restart them. Call periodically from main loop.
+*/
+uint16_t SWT_process(void) {
+
+  uint32_t  target;
+  uint16_t  num = 0;
+  swt_t     *timer;
+  uint8_t   idx;
+
+  // get current tick (atomic copy)
+  DISABLE_INTERRUPTS();
+  target = g_millis;
+  ENABLE_INTERRUPTS();
+
+  // process all ticks since last call
+  while (m_now != target) {
+    m_now++;
+
+    // on wrap-around of lower level cascade next slot of higher level
+    idx = SWT_INDEX(m_now, 0);
+    if (idx == 0) {
+      idx = SWT_INDEX(m_now, 1);
+      SWT_cascade(1, idx);
+      if (idx == 0)
+        SWT_cascade(2, SWT_INDEX(m_now, 2));
+      idx = 0;
+    }
+
+    // move current slot to temporary list. Callbacks may stop timers in this list
+    m_list = m_wheel[0][idx];
+    m_wheel[0][idx] = NULL;
+    if (m_list)
+      m_list->pprev = &m_list;
+
+    // expire timers
+    while ((timer = m_list) != NULL) {
+      SWT_unlink(timer);
+
+      // not yet due (safety, e.g. after wheel wrap) -> re-insert
+      if (timer->expire != m_now) {
+        SWT_insert(timer);
+        continue;
+      }
+
+      // periodic timer -> re-insert for next period
+      if (timer->period) {
+        timer->expire += timer->period;
+        SWT_insert(timer);
+      }
+
+      // call callback
+      timer->callback(timer);
+      num++;
+    }
+
+  } // loop ticks
+
+  return(num);
+
+} // SWT_process
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
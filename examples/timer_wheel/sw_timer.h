@@ -0,0 +1,111 @@
+/**
+  \file sw_timer.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of software timers on a hierarchical timing wheel
+
+  declaration of a software timer service for a large number of one-shot and
+  periodic timers. Timers are sorted into a 3-level hierarchical timing wheel
+  with SWT_SLOTS slots per level:
+    - level 0: 1 tick per slot, delays < SWT_SLOTS ticks
+    - level 1: SWT_SLOTS ticks per slot, delays < SWT_SLOTS^2 ticks
+    - level 2: SWT_SLOTS^2 ticks per slot, longer delays
+  Start and stop are O(1) (insert into / unlink from slot list). On each tick
+  only the current level 0 slot is checked. Every SWT_SLOTS ticks one level 1
+  slot is cascaded into level 0, and every SWT_SLOTS^2 ticks one level 2 slot
+  into level 1. Delays beyond the wheel range are parked in level 2 and
+  re-cascaded until due.
+
+  Timers are driven by the 1ms TIM4 tick (g_millis). Callbacks are deferred,
+  i.e. run from SWT_process() in the main loop, not in the tick ISR.
+
+  \note
+  - timer structs are provided by the caller, e.g. as static variables. Memory
+    per timer is sizeof(swt_t), no heap is used
+  - wheel uses 3*SWT_SLOTS pointers of RAM
+  - all functions must be called from main context (incl. callbacks), not from ISRs
+  - periodic timers keep their phase, i.e. don't drift with callback duration
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _SW_TIMER_H_
+#define _SW_TIMER_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// number of slots per wheel level = 2^SWT_BITS. Default can be overwritten in config.h
+#ifndef SWT_BITS
+  #define SWT_BITS          6
+#endif
+
+/// number of slots per wheel level
+#define SWT_SLOTS           (1 << SWT_BITS)
+
+/// max. delay [ticks] which fits into the wheel. Longer delays are re-cascaded
+#define SWT_MAX_DELAY       ((1L << (3 * SWT_BITS)) - 1)
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// software timer
+typedef struct swt_s swt_t;
+
+/// timer callback. Is called from SWT_process() with expired timer
+typedef void (*swt_callback_t)(swt_t *timer);
+
+/// software timer. Members are module internal, use below functions
+struct swt_s {
+  swt_t             *next;          ///< next timer in slot list
+  swt_t             **pprev;        ///< link pointing to this timer. NULL if timer is stopped
+  uint32_t          expire;         ///< tick of expiry
+  uint16_t          period;         ///< period [ticks] or 0 for one-shot timer
+  swt_callback_t    callback;       ///< callback on expiry
+  void              *arg;           ///< user argument for callback
+};
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init timer wheel. Call after TIM4_init()
+void SWT_begin(void);
+
+/// set callback and user argument of timer. Timer is stopped
+void SWT_init(swt_t *timer, swt_callback_t callback, void *arg);
+
+/// (re-)start timer with delay and period [ticks] (period=0: one-shot)
+void SWT_start(swt_t *timer, uint32_t delay, uint16_t period);
+
+/// stop timer
+void SWT_stop(swt_t *timer);
+
+/// check if timer is running
+uint8_t SWT_active(swt_t *timer);
+
+/// advance wheel to current tick and call callbacks of expired timers. Returns number of callbacks
+uint16_t SWT_process(void);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _SW_TIMER_H_
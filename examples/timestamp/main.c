@@ -0,0 +1,146 @@
+/**********************
+  High-resolution 32-bit timestamps via free-running timer with software extension
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+    - STM8L Discovery board (https://www.st.com/en/evaluation-tools/stm8l-discovery.html)
+
+  Functionality:
+    - TIM2 counts with 16MHz (62.5ns), overflows are counted in software
+    - rising edges on TIM2_CH1 (Sduino: PD4, Discovery: PB0) are captured in
+      hardware and extended to 32-bit timestamps in the capture ISR
+    - every 1s print time [us], duration of TS_ticks() call and last edge period via UART
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timestamp.h"
+  #include "uart.h"
+#undef _MAIN_
+
+
+// timestamp of last edge and edge period [ticks]. Set in capture ISR
+volatile uint32_t   g_edge   = 0;
+volatile uint32_t   g_period = 0;
+
+
+
+/**
+  \fn void TS_CC_ISR(void)
+
+  \brief ISR for timer capture channel 1
+
+  interrupt service routine for capture of rising edge on channel 1.
+  Extend 16-bit capture value to 32-bit timestamp and calculate period
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(TS_CC_ISR, TS_CC_VECTOR) {
+
+  uint16_t  capture;
+  uint32_t  edge;
+
+  // read capture value (MSB first). Clears CC1IF
+  capture  = (uint16_t) sfr_TS.CCR1H.byte << 8;
+  capture |= sfr_TS.CCR1L.byte;
+
+  // extend to 32-bit timestamp and calculate period
+  edge     = TS_extend(capture);
+  g_period = edge - g_edge;
+  g_edge   = edge;
+
+} // TS_CC_ISR
+
+
+
+/**
+  \fn int putchar(int byte)
+
+  \brief output routine for printf()
+
+  \param[in]  data   byte to send
+
+  \return  sent byte
+
+  implementation of putchar() for printf(), using selected output channel.
+  Return type depends on used compiler (see respective stdio.h)
+*/
+#if defined(__CSMC__)
+  char putchar(char data)
+#else // Standard C
+  int putchar(int data)
+#endif
+{
+  // send byte
+  UART_write(data);
+
+  // return sent byte
+  return(data);
+
+} // putchar
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void)
+{
+  uint32_t  nextPrint = 0;
+  uint32_t  t1, t2, period;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init UART for 19.2kBaud
+  UART_begin(19200);
+
+  // init timestamp timer
+  TS_begin();
+
+  // capture rising edges on channel 1 with interrupt
+  sfr_TS.CCMR1.CC1S  = 1;     // IC1 is mapped on TI1
+  sfr_TS.CCER1.CC1P  = 0;     // rising edge
+  sfr_TS.CCER1.CC1E  = 1;     // enable capture
+  sfr_TS.IER.CC1IE   = 1;     // enable capture interrupt
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // main loop
+  while(1) {
+
+    // every 1s print status
+    if ((int32_t) (TS_micros() - nextPrint) >= 0) {
+      nextPrint += 1000000L;
+
+      // measure duration of timestamp call
+      t1 = TS_ticks();
+      t2 = TS_ticks();
+
+      // get edge period (atomic copy)
+      DISABLE_INTERRUPTS();
+      period = g_period;
+      ENABLE_INTERRUPTS();
+
+      printf("time %luus, TS_ticks() %luns, period %luus\n", (unsigned long) TS_micros(),
+        (unsigned long) ((t2 - t1) * 125L / 2), (unsigned long) (period >> TS_US_SHIFT));
+
+    } // 1s task
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,206 @@
+/**
+  \file timestamp.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of high-resolution timestamp service
+
+  implementation of a monotonic timestamp service based on a free-running 16-bit
+  timer with 32-bit software extension.
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "timestamp.h"
+
+
+/*----------------------------------------------------------
+    MACROS
+----------------------------------------------------------*/
+
+// check configuration at compile time (negative array size on error)
+typedef char ts_check_psc[((TS_PSC >= 0) && (TS_PSC <= 4)) ? 1 : -1];
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// number of timer overflows (software extension)
+static volatile uint32_t  m_high;
+
+
+
+/**
+  \fn void TS_read(uint32_t *high, uint16_t *cnt)
+
+  \brief read consistent snapshot of extension and counter
+
+  \param[out] high      software extension incl. pending overflow
+  \param[out] cnt       timer counter
+
+  read extension, counter and overflow flag without stopping the timer. If the
+  overflow ISR ran in between (main context), read again. If an overflow is
+  pending but not yet counted (ISR context, interrupts disabled), and the
+  counter was read after it, add it here.
+*/
+static void TS_read(uint32_t *high, uint16_t *cnt) {
+
+  uint32_t  hi;
+  uint8_t   cntH, cntL, uif;
+
+  do {
+    hi   = m_high;
+    cntH = sfr_TS.CNTRH.byte;     // reading MSB latches LSB
+    cntL = sfr_TS.CNTRL.byte;
+    uif  = sfr_TS.SR1.UIF;
+  } while (hi != m_high);
+
+  // overflow pending -> add only if counter is in lower half, i.e. read after overflow
+  if ((uif) && (!(cntH & 0x80)))
+    hi++;
+
+  *high = hi;
+  *cnt  = ((uint16_t) cntH << 8) | cntL;
+
+} // TS_read
+
+
+
+/**
+  \fn void TS_begin(void)
+
+  \brief init timer as free-running 16-bit counter
+
+  init timer with prescaler 2^TS_PSC, period 2^16 and overflow interrupt.
+  Interrupts must be enabled for the software extension.
+*/
+void TS_begin(void) {
+
+  // for low-power device activate timer clock
+  #if defined(FAMILY_STM8L)
+    #if (TS_TIMER == 2)
+      sfr_CLK.PCKENR1.PCKEN10 = 1;
+    #else
+      sfr_CLK.PCKENR1.PCKEN11 = 1;
+    #endif
+  #endif
+
+  // stop the timer and reset extension
+  sfr_TS.CR1.CEN = 0;
+  m_high = 0;
+
+  // set prescaler and max. period. Load prescaler via update event, then clear its flag
+  sfr_TS.PSCR.PSC    = TS_PSC;
+  sfr_TS.ARRH.byte   = 0xFF;
+  sfr_TS.ARRL.byte   = 0xFF;
+  sfr_TS.CNTRH.byte  = 0x00;
+  sfr_TS.CNTRL.byte  = 0x00;
+  sfr_TS.EGR.UG      = 1;
+  sfr_TS.SR1.UIF     = 0;
+
+  // enable overflow interrupt
+  sfr_TS.IER.UIE = 1;
+
+  // start the timer
+  sfr_TS.CR1.CEN = 1;
+
+} // TS_begin
+
+
+
+/**
+  \fn uint32_t TS_ticks(void)
+
+  \brief get 32-bit timer ticks
+
+  \return timer ticks (2^TS_PSC/16MHz) since TS_begin(). Wraps after 2^32 ticks
+*/
+uint32_t TS_ticks(void) {
+
+  uint32_t  hi;
+  uint16_t  cnt;
+
+  TS_read(&hi, &cnt);
+  return((hi << 16) | cnt);
+
+} // TS_ticks
+
+
+
+/**
+  \fn uint32_t TS_micros(void)
+
+  \brief get microseconds since TS_begin()
+
+  \return microseconds since TS_begin(). Wraps after 2^32us
+
+  calculated from 48-bit ticks via shift, i.e. no division. Requires fMaster=16MHz
+*/
+uint32_t TS_micros(void) {
+
+  uint32_t  hi;
+  uint16_t  cnt;
+
+  TS_read(&hi, &cnt);
+  return((hi << (16 - TS_US_SHIFT)) | (cnt >> TS_US_SHIFT));
+
+} // TS_micros
+
+
+
+/**
+  \fn uint32_t TS_extend(uint16_t capture)
+
+  \brief extend 16-bit capture value to 32-bit ticks
+
+  \param[in]  capture   value of capture register of same timer
+
+  \return timer ticks of capture event
+
+  if capture value is larger than current counter, the counter has wrapped
+  since the capture, i.e. event belongs to previous period. Capture must be
+  read within one timer period after the event.
+*/
+uint32_t TS_extend(uint16_t capture) {
+
+  uint32_t  hi;
+  uint16_t  cnt;
+
+  TS_read(&hi, &cnt);
+  if (capture > cnt)
+    hi--;
+  return((hi << 16) | capture);
+
+} // TS_extend
+
+
+
+/**
+  \fn void TS_UPD_ISR(void)
+
+  \brief ISR for timer overflow
+
+  interrupt service routine for timer overflow. Increment software extension
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+*/
+ISR_HANDLER(TS_UPD_ISR, TS_UPD_VECTOR) {
+
+  // clear overflow flag
+  sfr_TS.SR1.UIF = 0;
+
+  // increment extension
+  m_high++;
+
+} // TS_UPD_ISR
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,95 @@
+/**
+  \file timestamp.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of high-resolution timestamp service
+
+  declaration of a monotonic timestamp service based on a free-running 16-bit
+  timer (TIM2 or TIM3). Timer overflows are counted in a 32-bit software
+  extension, i.e. the total tick counter has 48 bit. The counter is never
+  stopped for reading, and a consistent value is obtained via re-read of the
+  extension and check of a pending overflow.
+
+  Resolution at fMaster=16MHz and TS_PSC=0 is 62.5ns. TS_ticks() wraps after
+  2^32 ticks (~268s), TS_micros() after 2^32 us (~71.6min).
+
+  \note
+  - all functions can be called from main and from any ISR
+  - in ISRs which block the overflow ISR for >1/2 timer period (2ms at 16MHz),
+    a pending overflow may not be detected
+  - 16-bit capture values of the same timer can be extended via TS_extend(),
+    if read within one timer period after the capture event
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _TIMESTAMP_H_
+#define _TIMESTAMP_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+
+/*-----------------------------------------------------------------------------
+    DEFINITION OF GLOBAL MACROS/#DEFINES
+-----------------------------------------------------------------------------*/
+
+// used timer (2 or 3). Default can be overwritten in config.h
+#ifndef TS_TIMER
+  #define TS_TIMER          2
+#endif
+
+// timer prescaler exponent [0..4] (tick=2^TS_PSC/16MHz). Default can be overwritten in config.h
+#ifndef TS_PSC
+  #define TS_PSC            0
+#endif
+
+/// shift from ticks to microseconds (requires fMaster=16MHz)
+#define TS_US_SHIFT         (4 - TS_PSC)
+
+// select timer registers and vectors
+#if (TS_TIMER == 2)
+  #define sfr_TS            sfr_TIM2
+  #define TS_UPD_VECTOR     _TIM2_OVR_UIF_VECTOR_
+  #define TS_CC_VECTOR      _TIM2_CAPCOM_CC1IF_VECTOR_
+#elif (TS_TIMER == 3)
+  #define sfr_TS            sfr_TIM3
+  #define TS_UPD_VECTOR     _TIM3_OVR_UIF_VECTOR_
+  #define TS_CC_VECTOR      _TIM3_CAPCOM_CC1IF_VECTOR_
+#else
+  #error TS_TIMER must be 2 or 3
+#endif
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// init timer as free-running 16-bit counter with overflow interrupt
+void TS_begin(void);
+
+/// get 32-bit timer ticks (2^TS_PSC/16MHz)
+uint32_t TS_ticks(void);
+
+/// get microseconds since TS_begin()
+uint32_t TS_micros(void);
+
+/// extend 16-bit capture value of same timer to 32-bit ticks
+uint32_t TS_extend(uint16_t capture);
+
+/// ISR for timer overflow (software extension)
+ISR_HANDLER(TS_UPD_ISR, TS_UPD_VECTOR);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _TIMESTAMP_H_
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+
+"""
+Decode binary trace stream from STM8 trace logger to text
+
+Reads records from serial port or file, checks the checksum and formats
+them using the string table created by trace_table.py. For the record
+format see trace.h
+
+usage:
+  trace_decode.py -t trace_table.json -p /dev/ttyUSB0 [-b 230400]
+  trace_decode.py -t trace_table.json -f capture.bin
+"""
+
+import sys
+import re
+import json
+import argparse
+
+# must match trace.h
+TRACE_SYNC = 0xA5
+TRACE_MAX_ARGS = 4
+
+
+def load_table(filename):
+  """ load string table and convert format strings to Python syntax """
+  with open(filename, 'r') as f:
+    events = json.load(f)['events']
+  table = {}
+  for e in events:
+    # remove C length modifiers, e.g. %ld -> %d
+    fmt = re.sub(r'%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l)([diouxXc])', r'%\1\2', e['format'])
+    # find conversion types, e.g. for sign extension of %d
+    conv = re.findall(r'%[-+ #0]*\d*(?:\.\d+)?([diouxXcs%])', fmt)
+    table[e['id']] = (e['name'], fmt, [c for c in conv if c != '%'])
+  return table
+
+
+def format_record(table, rec_id, args):
+  """ convert single record to text """
+  if rec_id not in table:
+    return "unknown event %d, args %s" % (rec_id, args)
+  name, fmt, conv = table[rec_id]
+  values = []
+  for i, a in enumerate(args):
+    c = conv[i] if i < len(conv) else 'u'
+    if c in 'di' and a >= 0x8000:
+      a -= 0x10000
+    elif c == 'c':
+      a = chr(a & 0xFF) if 32 <= (a & 0xFF) < 127 else '.'
+    values.append(a)
+  try:
+    return fmt % tuple(values[:len(conv)])
+  except (TypeError, ValueError):
+    return "%s %s" % (name, args)
+
+
+def decode_stream(read, table, out=sys.stdout):
+  """ read bytes via read(n) and print decoded records until EOF """
+  time_high = 0
+  time_last = None
+  errors = 0
+
+  # bytes pushed back after an invalid record, consumed before new data
+  pending = bytearray()
+
+  def get(n):
+    """ read n bytes, first from pushed back data """
+    data = bytes(pending[:n])
+    del pending[:n]
+    if len(data) < n:
+      data += read(n - len(data))
+    return data
+
+  while True:
+
+    # sync to start of record
+    b = get(1)
+    if len(b) == 0:
+      break
+    if b[0] != TRACE_SYNC:
+      continue
+
+    # read header: ID, num args, ms (16b), 4us ticks
+    hdr = get(5)
+    if len(hdr) < 5:
+      pending[0:0] = hdr
+      continue
+    rec_id, num, ms, ticks = hdr[0], hdr[1], (hdr[2] << 8) | hdr[3], hdr[4]
+    if num > TRACE_MAX_ARGS:
+      errors += 1
+      out.write("length error (%d)\n" % errors)
+      pending[0:0] = hdr          # resync within bytes after false sync byte
+      continue
+
+    # read arguments and checksum
+    body = get(2 * num + 1)
+    if len(body) < 2 * num + 1:
+      pending[0:0] = hdr + body
+      continue
+    chk = 0
+    for x in hdr + body[:-1]:
+      chk ^= x
+    if chk != body[-1]:
+      errors += 1
+      out.write("checksum error (%d)\n" % errors)
+      pending[0:0] = hdr + body   # resync within bytes after false sync byte
+      continue
+    args = [(body[2 * i] << 8) | body[2 * i + 1] for i in range(num)]
+
+    # extend 16-bit ms timestamp to full range
+    if time_last is not None and ms < time_last:
+      time_high += 0x10000
+    time_last = ms
+    t = (time_high + ms) * 1000 + 4 * ticks
+
+    out.write("%10.3fms  %s\n" % (t / 1000.0, format_record(table, rec_id, args)))
+    out.flush()
+
+
+if __name__ == "__main__":
+
+  parser = argparse.ArgumentParser(description='decode STM8 binary trace stream')
+  parser.add_argument('-t', '--table', required=True, help='string table created by trace_table.py')
+  parser.add_argument('-p', '--port', help='serial port')
+  parser.add_argument('-b', '--baudrate', type=int, default=230400, help='serial baudrate')
+  parser.add_argument('-f', '--file', help='binary capture file')
+  args = parser.parse_args()
+
+  table = load_table(args.table)
+
+  if args.file:
+    with open(args.file, 'rb') as f:
+      decode_stream(f.read, table)
+  elif args.port:
+    import serial
+    with serial.Serial(port=args.port, baudrate=args.baudrate, timeout=None) as port:
+      decode_stream(port.read, table)
+  else:
+    parser.print_help()
+    sys.exit(1)
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+
+"""
+Extract trace string table from trace_events.h
+
+The event ID is the position of an entry in the X-macro list TRACE_EVENTS().
+The resulting JSON file is used by trace_decode.py to convert the binary
+trace stream back to text. Called by Makefile at build time.
+
+usage: trace_table.py trace_events.h trace_table.json
+"""
+
+import sys
+import re
+import json
+
+
+def extract_table(text):
+  """ return list of (name, format) tuples in order of appearance """
+
+  # remove C comments
+  text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+  text = re.sub(r'//[^\n]*', '', text)
+
+  # find all TRACE_EVENT(name, "format") entries
+  pattern = re.compile(r'TRACE_EVENT\s*\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+  table = []
+  for name, fmt in pattern.findall(text):
+    table.append((name, bytes(fmt, 'utf-8').decode('unicode_escape')))
+  return table
+
+
+if __name__ == "__main__":
+
+  if len(sys.argv) != 3:
+    print(__doc__)
+    sys.exit(1)
+
+  with open(sys.argv[1], 'r') as f:
+    table = extract_table(f.read())
+
+  if len(table) == 0:
+    print("error: no TRACE_EVENT() entries found in '%s'" % sys.argv[1])
+    sys.exit(1)
+  if len(table) > 256:
+    print("error: max. 256 trace events supported")
+    sys.exit(1)
+
+  events = [{'id': i, 'name': name, 'format': fmt} for i, (name, fmt) in enumerate(table)]
+  with open(sys.argv[2], 'w') as f:
+    json.dump({'source': sys.argv[1], 'events': events}, f, indent=2)
+
+  print("wrote %d trace events to '%s'" % (len(events), sys.argv[2]))
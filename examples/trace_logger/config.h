@@ -0,0 +1,40 @@
+/**
+  \file config.h
+
+  \brief set project configurations
+
+  set project configurations like used device or board etc.
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "../../include/STM8S105K6.h"
+
+
+/*----------------------------------------------------------
+    PROJECT SETTINGS
+----------------------------------------------------------*/
+
+// select UART for trace output
+#define sfr_UART_TRACE                sfr_UART2
+#define _UART_TRACE_T_TXE_VECTOR_     _UART2_T_TXE_VECTOR_
+
+// trace buffer size in bytes (must be power of 2 and <=256)
+#define TRACE_BUFFER_SIZE             128
+
+// max. number of 16-bit arguments per trace record
+#define TRACE_MAX_ARGS                4
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _CONFIG_H_
@@ -0,0 +1,93 @@
+/**********************
+  Binary trace logger as light-weight replacement for printf()
+
+  supported hardware:
+    - Sduino Uno (https://github.com/roybaer/sduino_uno)
+
+  Functionality:
+    - store compact binary trace records (ID, timestamp, args) in ring buffer
+    - send records via UART2 TXE interrupt
+    - decode on PC via "python3 Utils/trace_decode.py -t SDCC/trace_table.json -p /dev/ttyUSB0"
+    - string table is extracted from trace_events.h by "make"
+**********************/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#define _MAIN_          // required for global variables
+  #include "timer4.h"
+  #include "trace.h"
+#undef _MAIN_
+
+
+
+/////////////////
+//    main routine
+/////////////////
+void main (void) {
+
+  uint32_t  nextPrint = 0;
+  uint16_t  countLoop = 0;
+  uint8_t   data;
+
+  // disable interrupts
+  DISABLE_INTERRUPTS();
+
+  // switch to 16MHz (default is 2MHz)
+  sfr_CLK.CKDIVR.byte = 0x00;
+
+  // init trace output via UART2 with 230.4kBaud
+  trace_begin(230400);
+
+  // use trace UART receiver for polling
+  sfr_UART_TRACE.CR2.REN = 1;
+
+  // configure pin 13 (=PC5=LED) as output
+  sfr_PORTC.DDR.DDR5 = 1;     // input(=0) or output(=1)
+  sfr_PORTC.CR1.C15  = 1;     // input: 0=float, 1=pull-up; output: 0=open-drain, 1=push-pull
+  sfr_PORTC.CR2.C25  = 1;     // input: 0=no exint, 1=exint; output: 0=2MHz slope, 1=10MHz slope
+
+  // init 1ms interrupt
+  TIM4_init();
+
+  // enable interrupts
+  ENABLE_INTERRUPTS();
+
+  // trace reset source
+  TRACE1(TRC_BOOT, sfr_RST.SR.byte);
+
+  // main loop
+  while(1) {
+
+    // count loop iterations
+    countLoop++;
+
+    // trace received bytes
+    if (sfr_UART_TRACE.SR.RXNE) {
+      data = sfr_UART_TRACE.DR.byte;
+      TRACE2(TRC_RX_BYTE, data, data);
+    }
+
+    // every 500ms toggle LED and trace status
+    if (g_millis >= nextPrint) {
+      nextPrint += 500;
+
+      // toggle pin 13 / LED
+      sfr_PORTC.ODR.ODR5 ^= 1;
+
+      // trace pin state and number of loops
+      TRACE2(TRC_PIN_STATE, 5, sfr_PORTC.ODR.ODR5);
+      TRACE1(TRC_ALIVE, countLoop);
+      countLoop = 0;
+
+    } // 500ms loop
+
+  } // main loop
+
+} // main
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
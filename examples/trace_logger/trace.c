@@ -0,0 +1,297 @@
+/**
+  \file trace.c
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief implementation of binary trace functions/macros
+
+  implementation of a binary trace logger as light-weight replacement for printf().
+  Records are stored in a ring buffer and sent by the UART TXE interrupt.
+  For the record format see trace.h
+*/
+
+/*----------------------------------------------------------
+    INCLUDE FILES
+----------------------------------------------------------*/
+#include "trace.h"
+#include "timer4.h"
+
+
+/*-----------------------------------------------------------------------------
+    MODULE MACROS
+-----------------------------------------------------------------------------*/
+
+/// mask for ring buffer index
+#define TRACE_MASK          ((uint8_t) (TRACE_BUFFER_SIZE-1))
+
+/// store byte in ring buffer and update checksum (index and checksum are local variables)
+#define TRACE_PUT(b)        { m_buf[idx & TRACE_MASK] = (b); chk ^= (b); idx++; }
+
+/// store 16-bit value big-endian in ring buffer
+#define TRACE_PUT16(w)      { TRACE_PUT((uint8_t) ((w) >> 8)); TRACE_PUT((uint8_t) (w)); }
+
+
+/*-----------------------------------------------------------------------------
+    MODULE VARIABLES (for clarity module internal variables start with "m_")
+-----------------------------------------------------------------------------*/
+
+/// trace ring buffer
+static volatile uint8_t   m_buf[TRACE_BUFFER_SIZE];
+
+/// index of next free byte. Only changed by writer
+static volatile uint8_t   m_head = 0;
+
+/// index of next byte to send. Only changed by TXE ISR
+static volatile uint8_t   m_tail = 0;
+
+/// number of records lost due to buffer overflow
+static volatile uint16_t  m_dropped = 0;
+
+
+
+/**
+  \fn uint8_t trace_put_record(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3)
+
+  \brief store a single trace record in ring buffer (no locking)
+
+  \param[in]  id    event ID
+  \param[in]  num   number of arguments
+  \param[in]  a0    argument 0
+  \param[in]  a1    argument 1
+  \param[in]  a2    argument 2
+  \param[in]  a3    argument 3
+
+  \return record stored(=1) or dropped due to full buffer(=0)
+
+  store a single trace record in the ring buffer. Caller must ensure exclusive access.
+*/
+static uint8_t trace_put_record(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3) {
+
+  uint8_t   idx, chk, used, cnt, uif;
+  uint16_t  ms;
+
+  // clip number of arguments
+  if (num > TRACE_MAX_ARGS)
+    num = TRACE_MAX_ARGS;
+
+  // check free space. Keep 1B free to distinguish full from empty
+  used = (uint8_t) (m_head - m_tail) & TRACE_MASK;
+  if ((uint16_t) (TRACE_BUFFER_SIZE - 1 - used) < (uint16_t) TRACE_RECORD_SIZE(num))
+    return(0);
+
+  // get timestamp. Account for pending TIM4 overflow (like micros())
+  ms  = (uint16_t) g_millis;
+  cnt = sfr_TIM4.CNTR.byte;
+  #if defined(FAMILY_STM8L)
+    uif = sfr_TIM4.SR1.UIF;
+  #else
+    uif = sfr_TIM4.SR.UIF;
+  #endif
+  if (uif && (cnt < 128))
+    ms++;
+
+  // write record header. Sync byte is not part of checksum
+  idx = m_head;
+  m_buf[idx & TRACE_MASK] = TRACE_SYNC;
+  idx++;
+  chk = 0;
+  TRACE_PUT(id);
+  TRACE_PUT(num);
+  TRACE_PUT16(ms);
+  TRACE_PUT(cnt);
+
+  // write arguments
+  if (num > 0) TRACE_PUT16(a0);
+  if (num > 1) TRACE_PUT16(a1);
+  if (num > 2) TRACE_PUT16(a2);
+  if (num > 3) TRACE_PUT16(a3);
+
+  // write checksum
+  m_buf[idx & TRACE_MASK] = chk;
+  idx++;
+
+  // publish complete record to TXE ISR and start transmission
+  m_head = idx;
+  sfr_UART_TRACE.CR2.TIEN = 1;
+
+  // record stored
+  return(1);
+
+} // trace_put_record
+
+
+
+/**
+  \fn void trace_begin(uint32_t BR)
+
+  \brief initialize trace buffer and UART (Tx only)
+
+  \param[in]  BR    baudrate [Baud]
+
+  initialize trace ring buffer and UART for interrupt based transmission.
+  Use 1 start, 8 data and 1 stop bit; no parity or flow control.
+  The receiver is not touched, i.e. can be used by application
+*/
+void trace_begin(uint32_t BR) {
+
+  uint16_t  val16;
+
+  // reset trace buffer
+  m_head    = 0;
+  m_tail    = 0;
+  m_dropped = 0;
+
+  // set UART behaviour
+  sfr_UART_TRACE.CR1.byte = 0x00;       // enable UART, 8 data bits, no parity control
+  sfr_UART_TRACE.CR3.byte = 0x00;       // no LIN support, 1 stop bit, no clock output(?)
+
+  // set baudrate (note: BRR2 must be written before BRR1!)
+  val16 = (uint16_t) (((uint32_t) 16000000L)/BR);
+  sfr_UART_TRACE.BRR2.byte = (uint8_t) (((val16 & 0xF000) >> 8) | (val16 & 0x000F));
+  sfr_UART_TRACE.BRR1.byte = (uint8_t) ((val16 & 0x0FF0) >> 4);
+
+  // enable sender. Tx interrupt is enabled when a record is stored
+  sfr_UART_TRACE.CR2.TEN  = 1;
+
+} // trace_begin
+
+
+
+/**
+  \fn uint8_t trace_emit(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3)
+
+  \brief store trace record in buffer (from main context)
+
+  \param[in]  id    event ID
+  \param[in]  num   number of arguments
+  \param[in]  a0    argument 0
+  \param[in]  a1    argument 1
+  \param[in]  a2    argument 2
+  \param[in]  a3    argument 3
+
+  \return record stored(=1) or dropped due to full buffer(=0)
+
+  store trace record in buffer. Interrupts are disabled during write and
+  enabled afterwards, so don't call from ISR (use trace_emit_isr() instead).
+  Preferably use macros TRACE0()..TRACE4()
+*/
+uint8_t trace_emit(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3) {
+
+  uint8_t   result;
+
+  // begin critical section (disable interrupts)
+  DISABLE_INTERRUPTS();
+
+  // store record
+  result = trace_emit_isr(id, num, a0, a1, a2, a3);
+
+  // end critical section (enable interrupts)
+  ENABLE_INTERRUPTS();
+
+  // return status
+  return(result);
+
+} // trace_emit
+
+
+
+/**
+  \fn uint8_t trace_emit_isr(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3)
+
+  \brief store trace record in buffer (from ISR context)
+
+  \param[in]  id    event ID
+  \param[in]  num   number of arguments
+  \param[in]  a0    argument 0
+  \param[in]  a1    argument 1
+  \param[in]  a2    argument 2
+  \param[in]  a3    argument 3
+
+  \return record stored(=1) or dropped due to full buffer(=0)
+
+  store trace record in buffer without changing the interrupt state. Use only
+  within ISRs or with interrupts disabled. If previous records were lost, first
+  store a TRC_DROPPED record. Preferably use macros TRACE_ISR0()..TRACE_ISR4()
+*/
+uint8_t trace_emit_isr(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3) {
+
+  // report previously lost records first
+  if (m_dropped) {
+    if (trace_put_record(TRC_DROPPED, 1, m_dropped, 0, 0, 0))
+      m_dropped = 0;
+    else {
+      m_dropped++;
+      return(0);
+    }
+  }
+
+  // store actual record
+  if (!trace_put_record(id, num, a0, a1, a2, a3)) {
+    m_dropped++;
+    return(0);
+  }
+
+  // record stored
+  return(1);
+
+} // trace_emit_isr
+
+
+
+/**
+  \fn void trace_flush(void)
+
+  \brief wait until all trace records are sent
+
+  wait until trace buffer is empty and last byte was sent, e.g. before entering HALT mode.
+  Requires interrupts to be enabled
+*/
+void trace_flush(void) {
+
+  // wait until buffer is empty
+  while (m_head != m_tail);
+
+  // wait until last byte is sent
+  while (!(sfr_UART_TRACE.SR.TC));
+
+} // trace_flush
+
+
+
+/**
+  \fn void UART_TRACE_TXE_ISR(void)
+
+  \brief ISR for trace UART transmit
+
+  Actions:
+    - called if Tx HW buffer is empty
+    - if trace buffer contains data, send oldest byte
+    - if trace buffer is empty, disable this interrupt
+
+  Note:
+    SDCC: ISR must be declared in file containing main(). Header inclusion is ok
+    Cosmic: interrupt service table is defined in file "stm8_interrupt_vector.c"
+*/
+ISR_HANDLER(UART_TRACE_TXE_ISR, _UART_TRACE_T_TXE_VECTOR_)
+{
+  uint8_t   idx = m_tail;
+
+  // if buffer contains data, send oldest byte. Writing DR clears TXE flag
+  if (idx != m_head) {
+    sfr_UART_TRACE.DR.byte = m_buf[idx & TRACE_MASK];
+    m_tail = ++idx;
+  }
+
+  // if buffer is now empty, deactivate this interrupt
+  if (idx == m_head)
+    sfr_UART_TRACE.CR2.TIEN = 0;
+
+  return;
+
+} // UART_TRACE_TXE_ISR
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE
+-----------------------------------------------------------------------------*/
@@ -0,0 +1,124 @@
+/**
+  \file trace.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief declaration of binary trace functions/macros
+
+  declaration of a binary trace logger as light-weight replacement for printf().
+  Call sites only store event ID, timestamp and up to TRACE_MAX_ARGS 16-bit
+  arguments in a ring buffer, which is drained by the UART TXE interrupt.
+  Formatting to text is done on the host by Utils/trace_decode.py.
+
+  Record format (all values big-endian):
+    - byte 0:      sync byte TRACE_SYNC
+    - byte 1:      event ID, see trace_events.h
+    - byte 2:      number of arguments N
+    - byte 3-4:    timestamp [ms], lower 16 bit of g_millis
+    - byte 5:      sub-ms timestamp [4us], TIM4 counter
+    - byte 6..:    N x 16-bit arguments
+    - last byte:   XOR checksum over bytes 1..(5+2N)
+
+  \note
+  - records are written completely or not at all. Lost records are reported
+    via event TRC_DROPPED with the next successful record
+  - TRACEx() disables interrupts while writing the record, TRACE_ISRx() must
+    be used within interrupt service routines (requires non-nested ISRs)
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+
+/*-----------------------------------------------------------------------------
+    INCLUDE FILES
+-----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+#include "trace_events.h"
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL MACROS
+-----------------------------------------------------------------------------*/
+
+// default trace buffer size in bytes (power of 2, <=256); can be overwritten in config.h
+#ifndef TRACE_BUFFER_SIZE
+  #define TRACE_BUFFER_SIZE   128
+#endif
+
+// default max. number of arguments per record; can be overwritten in config.h
+#ifndef TRACE_MAX_ARGS
+  #define TRACE_MAX_ARGS      4
+#endif
+
+#if ((TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE-1)) != 0) || (TRACE_BUFFER_SIZE > 256)
+  #error TRACE_BUFFER_SIZE must be a power of 2 and <=256
+#endif
+
+#if (TRACE_MAX_ARGS > 4)
+  #error TRACE_MAX_ARGS must be <=4
+#endif
+
+/// start of record marker
+#define TRACE_SYNC            0xA5
+
+/// record size [B] for N arguments
+#define TRACE_RECORD_SIZE(N)  (7 + 2*(N))
+
+/// emit trace record from main context (briefly disables interrupts)
+#define TRACE0(id)            trace_emit(id, 0, 0, 0, 0, 0)
+#define TRACE1(id,a)          trace_emit(id, 1, (uint16_t)(a), 0, 0, 0)
+#define TRACE2(id,a,b)        trace_emit(id, 2, (uint16_t)(a), (uint16_t)(b), 0, 0)
+#define TRACE3(id,a,b,c)      trace_emit(id, 3, (uint16_t)(a), (uint16_t)(b), (uint16_t)(c), 0)
+#define TRACE4(id,a,b,c,d)    trace_emit(id, 4, (uint16_t)(a), (uint16_t)(b), (uint16_t)(c), (uint16_t)(d))
+
+/// emit trace record from within an ISR (no change of interrupt state)
+#define TRACE_ISR0(id)            trace_emit_isr(id, 0, 0, 0, 0, 0)
+#define TRACE_ISR1(id,a)          trace_emit_isr(id, 1, (uint16_t)(a), 0, 0, 0)
+#define TRACE_ISR2(id,a,b)        trace_emit_isr(id, 2, (uint16_t)(a), (uint16_t)(b), 0, 0)
+#define TRACE_ISR3(id,a,b,c)      trace_emit_isr(id, 3, (uint16_t)(a), (uint16_t)(b), (uint16_t)(c), 0)
+#define TRACE_ISR4(id,a,b,c,d)    trace_emit_isr(id, 4, (uint16_t)(a), (uint16_t)(b), (uint16_t)(c), (uint16_t)(d))
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL TYPEDEFS
+-----------------------------------------------------------------------------*/
+
+/// trace event IDs, generated from trace_events.h
+#define TRACE_EVENT_ENUM(name, format)   name,
+typedef enum {
+  TRACE_EVENTS(TRACE_EVENT_ENUM)
+  TRC_NUM_EVENTS
+} trace_id_t;
+
+
+/*-----------------------------------------------------------------------------
+    DECLARATION OF GLOBAL FUNCTIONS
+-----------------------------------------------------------------------------*/
+
+/// initialize trace buffer and UART (Tx only)
+void    trace_begin(uint32_t BR);
+
+/// store trace record in buffer (from main context)
+uint8_t trace_emit(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3);
+
+/// store trace record in buffer (from ISR context)
+uint8_t trace_emit_isr(uint8_t id, uint8_t num, uint16_t a0, uint16_t a1, uint16_t a2, uint16_t a3);
+
+/// wait until all trace records are sent
+void    trace_flush(void);
+
+/// trace UART transmit ISR
+ISR_HANDLER(UART_TRACE_TXE_ISR, _UART_TRACE_T_TXE_VECTOR_);
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _TRACE_H_
@@ -0,0 +1,45 @@
+/**
+  \file trace_events.h
+
+  \author G. Icking-Konert
+  \date 2026-10-18
+  \version 0.1
+
+  \brief list of trace events and their format strings
+
+  List of all trace events as X-macro TRACE_EVENT(name, format). Only the event
+  name (=ID) is compiled into the firmware. The format strings are extracted at
+  build time by Utils/trace_table.py and used by the host side decoder
+  Utils/trace_decode.py to convert the binary stream back to text.
+
+  \note
+  - format strings use printf() syntax. All arguments are 16-bit, use %d for
+    signed, %u/%x for unsigned arguments
+  - max. number of arguments per event is TRACE_MAX_ARGS
+  - only append new events, or re-build string table after changes!
+*/
+
+/*-----------------------------------------------------------------------------
+    MODULE DEFINITION FOR MULTIPLE INCLUSION
+-----------------------------------------------------------------------------*/
+#ifndef _TRACE_EVENTS_H_
+#define _TRACE_EVENTS_H_
+
+
+/*-----------------------------------------------------------------------------
+    LIST OF TRACE EVENTS
+-----------------------------------------------------------------------------*/
+
+/// list of trace events: TRACE_EVENT(name, format). First entry is reserved for trace module
+#define TRACE_EVENTS(TRACE_EVENT) \
+  TRACE_EVENT(TRC_DROPPED,      "trace buffer overflow, %u records lost") \
+  TRACE_EVENT(TRC_BOOT,         "boot, reset status 0x%02x") \
+  TRACE_EVENT(TRC_ALIVE,        "alive, loop count %u") \
+  TRACE_EVENT(TRC_RX_BYTE,      "received byte 0x%02x ('%c')") \
+  TRACE_EVENT(TRC_PIN_STATE,    "pin PC%u state %u")
+
+
+/*-----------------------------------------------------------------------------
+    END OF MODULE DEFINITION FOR MULTIPLE INLUSION
+-----------------------------------------------------------------------------*/
+#endif // _TRACE_EVENTS_H_